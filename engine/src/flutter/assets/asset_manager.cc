@@ -9,6 +9,32 @@
 
 namespace flutter {
 
+namespace {
+
+// Reads one byte of every page of |mapping| so that the pages of a file
+// backed mapping are read in before the asset is used.
+void ReadAhead(const fml::Mapping& mapping) {
+  constexpr size_t kPageSize = 4096;
+  const volatile uint8_t* data = mapping.GetMapping();
+  if (data == nullptr) {
+    return;
+  }
+  const size_t size = mapping.GetSize();
+  for (size_t offset = 0; offset < size; offset += kPageSize) {
+    static_cast<void>(data[offset]);
+  }
+}
+
+// Whether assets can appear in or disappear from |resolver| after it has been
+// added to the queue. The tool adds and removes files in the asset directory
+// during a hot reload, and a nested asset manager may hold such a directory.
+bool IsMutable(const AssetResolver& resolver) {
+  return resolver.as_directory_asset_bundle() != nullptr ||
+         resolver.as_asset_manager() != nullptr;
+}
+
+}  // namespace
+
 AssetManager::AssetManager() = default;
 
 AssetManager::~AssetManager() = default;
@@ -18,7 +44,9 @@ bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  std::unique_lock lock(resolvers_mutex_);
   resolvers_.push_front(std::move(resolver));
+  InvalidateCaches();
   return true;
 }
 
@@ -27,7 +55,9 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  std::unique_lock lock(resolvers_mutex_);
   resolvers_.push_back(std::move(resolver));
+  InvalidateCaches();
   return true;
 }
 
@@ -37,6 +67,7 @@ void AssetManager::UpdateResolverByType(
   if (updated_asset_resolver == nullptr) {
     return;
   }
+  std::unique_lock lock(resolvers_mutex_);
   bool updated = false;
   std::deque<std::unique_ptr<AssetResolver>> new_resolvers;
   for (auto& old_resolver : resolvers_) {
@@ -53,12 +84,125 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  InvalidateCaches();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  std::unique_lock lock(resolvers_mutex_);
+  InvalidateCaches();
   return std::move(resolvers_);
 }
 
+void AssetManager::Prefetch(std::vector<std::string> asset_names,
+                            const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  if (asset_names.empty()) {
+    return;
+  }
+  std::shared_ptr<const AssetManager> self = weak_from_this().lock();
+  if (!task_runner || !self) {
+    PrefetchMappings(asset_names);
+    return;
+  }
+  task_runner->PostTask(
+      [self = std::move(self), asset_names = std::move(asset_names)]() {
+        self->PrefetchMappings(asset_names);
+      });
+}
+
+void AssetManager::InvalidateCaches() {
+  std::scoped_lock lock(cache_mutex_);
+  cache_generation_++;
+  resolver_index_.clear();
+  missing_asset_names_.clear();
+  prefetched_mappings_.clear();
+  prefetched_bytes_ = 0;
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::FindMapping(
+    const std::string& asset_name) const {
+  std::shared_lock resolvers_lock(resolvers_mutex_);
+  const AssetResolver* indexed_resolver = nullptr;
+  {
+    std::scoped_lock lock(cache_mutex_);
+    if (missing_asset_names_.count(asset_name) > 0) {
+      return nullptr;
+    }
+    auto found = resolver_index_.find(asset_name);
+    if (found != resolver_index_.end()) {
+      indexed_resolver = found->second;
+    }
+  }
+
+  if (indexed_resolver != nullptr) {
+    auto mapping = indexed_resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+  }
+
+  // The lookup is only cached if none of the resolvers it went past can
+  // start providing the asset later on.
+  bool passed_mutable_resolver = false;
+  for (const auto& resolver : resolvers_) {
+    auto mapping = resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      std::scoped_lock lock(cache_mutex_);
+      if (passed_mutable_resolver) {
+        resolver_index_.erase(asset_name);
+      } else {
+        resolver_index_[asset_name] = resolver.get();
+      }
+      return mapping;
+    }
+    passed_mutable_resolver |= IsMutable(*resolver);
+  }
+
+  std::scoped_lock lock(cache_mutex_);
+  resolver_index_.erase(asset_name);
+  if (!passed_mutable_resolver) {
+    if (missing_asset_names_.size() >= kMaxMissingAssetNames) {
+      missing_asset_names_.clear();
+    }
+    missing_asset_names_.insert(asset_name);
+  }
+  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+  return nullptr;
+}
+
+void AssetManager::PrefetchMappings(
+    const std::vector<std::string>& asset_names) const {
+  TRACE_EVENT0("flutter", "AssetManager::Prefetch");
+  for (const auto& asset_name : asset_names) {
+    if (asset_name.empty()) {
+      continue;
+    }
+    uint64_t generation;
+    {
+      std::scoped_lock lock(cache_mutex_);
+      if (prefetched_mappings_.count(asset_name) > 0) {
+        continue;
+      }
+      generation = cache_generation_;
+    }
+
+    auto mapping = FindMapping(asset_name);
+    if (mapping == nullptr) {
+      continue;
+    }
+    ReadAhead(*mapping);
+
+    // Mappings past the budget are still read ahead, but are looked up
+    // again when they are used rather than pinned until then.
+    std::scoped_lock lock(cache_mutex_);
+    const size_t size = mapping->GetSize();
+    if (generation == cache_generation_ &&
+        prefetched_bytes_ + size <= kMaxPrefetchedBytes) {
+      prefetched_bytes_ += size;
+      prefetched_mappings_.emplace(asset_name, std::move(mapping));
+    }
+  }
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,14 +211,17 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
-  for (const auto& resolver : resolvers_) {
-    auto mapping = resolver->GetAsMapping(asset_name);
-    if (mapping != nullptr) {
+  {
+    std::scoped_lock lock(cache_mutex_);
+    auto prefetched = prefetched_mappings_.find(asset_name);
+    if (prefetched != prefetched_mappings_.end()) {
+      auto mapping = std::move(prefetched->second);
+      prefetched_mappings_.erase(prefetched);
+      prefetched_bytes_ -= mapping->GetSize();
       return mapping;
     }
   }
-  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
-  return nullptr;
+  return FindMapping(asset_name);
 }
 
 // |AssetResolver|
@@ -87,6 +234,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMappings", "pattern",
                asset_pattern.c_str());
+  std::shared_lock lock(resolvers_mutex_);
   for (const auto& resolver : resolvers_) {
     auto resolver_mappings = resolver->GetAsMappings(asset_pattern, subdir);
     mappings.insert(mappings.end(),
@@ -98,6 +246,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
 
 // |AssetResolver|
 bool AssetManager::IsValid() const {
+  std::shared_lock lock(resolvers_mutex_);
   return !resolvers_.empty();
 }
 
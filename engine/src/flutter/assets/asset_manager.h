@@ -7,16 +7,38 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
-class AssetManager final : public AssetResolver {
+//------------------------------------------------------------------------------
+/// @brief      An ordered queue of asset resolvers. An asset is loaded from
+///             the first resolver in the queue that provides it.
+///
+///             Lookups are cached until the queue changes. The resolver that
+///             provided an asset is remembered so that later lookups of the
+///             same asset skip the resolvers in front of it, and assets that
+///             no resolver provides are not looked up again. Both caches are
+///             dropped whenever a resolver is added, replaced or taken.
+///
+///             Files can be added to or removed from an asset directory at
+///             any time, for example during a hot reload, so a lookup is only
+///             cached if it did not go past a `DirectoryAssetBundle` or a
+///             nested `AssetManager`.
+///
+class AssetManager final : public AssetResolver,
+                           public std::enable_shared_from_this<AssetManager> {
  public:
   AssetManager();
 
@@ -70,6 +92,25 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Looks up the named assets on `task_runner` and reads their
+  ///             contents ahead of time. The next `GetAsMapping` call for
+  ///             each of the assets returns the warmed mapping instead of
+  ///             going back to the resolvers.
+  ///
+  ///             Assets are loaded in the order given, so the assets needed
+  ///             first should come first. The prefetch keeps the asset
+  ///             manager alive while it runs. If the task runner is null or
+  ///             the asset manager is not owned by a `std::shared_ptr`, the
+  ///             assets are prefetched on the calling thread.
+  ///
+  /// @param[in]  asset_names  The names of the assets to prefetch.
+  ///
+  /// @param[in]  task_runner  The task runner to load the assets on.
+  ///
+  void Prefetch(std::vector<std::string> asset_names,
+                const fml::RefPtr<fml::TaskRunner>& task_runner);
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -95,8 +136,45 @@ class AssetManager final : public AssetResolver {
   const AssetManager* as_asset_manager() const override { return this; }
 
  private:
+  // The number of missing asset names that are remembered. The set is
+  // cleared when it grows past this size.
+  static constexpr size_t kMaxMissingAssetNames = 1024;
+
+  // The total size of the prefetched mappings that are held until they are
+  // used. Assets prefetched past this budget are only read ahead.
+  static constexpr size_t kMaxPrefetchedBytes = 16 * 1024 * 1024;
+
+  // Guards |resolvers_| against changes to the queue while a prefetch is
+  // looking up assets on another thread.
+  mutable std::shared_mutex resolvers_mutex_;
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  mutable std::mutex cache_mutex_;
+  // Incremented every time the caches are dropped so that lookups that raced
+  // with a change to the queue do not populate the new caches.
+  mutable uint64_t cache_generation_ = 0;
+  // The resolver that provided each asset found so far.
+  mutable std::unordered_map<std::string, const AssetResolver*>
+      resolver_index_;
+  // The assets that none of the resolvers provide.
+  mutable std::unordered_set<std::string> missing_asset_names_;
+  // Mappings loaded by |Prefetch| that have not been handed out yet.
+  mutable std::unordered_map<std::string, std::unique_ptr<fml::Mapping>>
+      prefetched_mappings_;
+  // The total size of |prefetched_mappings_|.
+  mutable size_t prefetched_bytes_ = 0;
+
+  // Drops the cached lookups. Requires |resolvers_mutex_| to be held
+  // exclusively.
+  void InvalidateCaches();
+
+  // Finds the asset in the resolver queue, consulting and updating the
+  // resolver index and the missing asset names.
+  std::unique_ptr<fml::Mapping> FindMapping(
+      const std::string& asset_name) const;
+
+  void PrefetchMappings(const std::vector<std::string>& asset_names) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
@@ -0,0 +1,216 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <map>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Serves a fixed set of assets and counts the lookups made against it.
+class CountingAssetResolver : public AssetResolver {
+ public:
+  explicit CountingAssetResolver(
+      std::map<std::string, std::string> assets,
+      AssetResolverType type = AssetResolverType::kDirectoryAssetBundle)
+      : assets_(std::move(assets)), type_(type) {}
+
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  AssetResolverType GetType() const override { return type_; }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookup_count++;
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+  bool operator==(const AssetResolver& other) const override {
+    return this == &other;
+  }
+
+  mutable size_t lookup_count = 0u;
+
+ private:
+  const std::map<std::string, std::string> assets_;
+  const AssetResolverType type_;
+};
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+}  // namespace
+
+TEST(AssetManagerTest, RemembersTheResolverOfAnAsset) {
+  auto front = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "front a"}});
+  auto back = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "back a"}, {"b", "back b"}});
+  CountingAssetResolver* front_resolver = front.get();
+  CountingAssetResolver* back_resolver = back.get();
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(front)));
+  ASSERT_TRUE(asset_manager.PushBack(std::move(back)));
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "front a");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("b")), "back b");
+  EXPECT_EQ(front_resolver->lookup_count, 2u);
+  EXPECT_EQ(back_resolver->lookup_count, 1u);
+
+  // Later lookups go straight to the resolver that provided the asset.
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "front a");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("b")), "back b");
+  EXPECT_EQ(front_resolver->lookup_count, 3u);
+  EXPECT_EQ(back_resolver->lookup_count, 2u);
+}
+
+TEST(AssetManagerTest, MissingAssetsAreOnlyLookedUpOnce) {
+  auto resolver = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "a"}});
+  CountingAssetResolver* counting_resolver = resolver.get();
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(resolver)));
+
+  EXPECT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(counting_resolver->lookup_count, 1u);
+}
+
+TEST(AssetManagerTest, AssetsAddedToADirectoryAreFound) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  auto back = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "back a"}});
+  CountingAssetResolver* back_resolver = back.get();
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::Duplicate(asset_dir.fd().get()), false)));
+  ASSERT_TRUE(asset_manager.PushBack(std::move(back)));
+
+  EXPECT_EQ(asset_manager.GetAsMapping("b"), nullptr);
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "back a");
+
+  // Files written to the directory, as during a hot reload, are picked up
+  // without changing the resolver queue.
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(), "a",
+                                   fml::DataMapping(std::string("dir a"))));
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(), "b",
+                                   fml::DataMapping(std::string("dir b"))));
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "dir a");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("b")), "dir b");
+
+  ASSERT_TRUE(fml::UnlinkFile(asset_dir.fd(), "a"));
+  ASSERT_TRUE(fml::UnlinkFile(asset_dir.fd(), "b"));
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "back a");
+  EXPECT_EQ(asset_manager.GetAsMapping("b"), nullptr);
+  EXPECT_EQ(back_resolver->lookup_count, 4u);
+}
+
+TEST(AssetManagerTest, UpdatingAResolverDropsCachedLookups) {
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "old a"}})));
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "old a");
+  EXPECT_EQ(asset_manager.GetAsMapping("b"), nullptr);
+
+  asset_manager.UpdateResolverByType(
+      std::make_unique<CountingAssetResolver>(
+          std::map<std::string, std::string>{{"a", "new a"}, {"b", "new b"}}),
+      AssetResolver::AssetResolverType::kDirectoryAssetBundle);
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "new a");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("b")), "new b");
+}
+
+TEST(AssetManagerTest, PrefetchedAssetsAreHandedOutOnce) {
+  auto resolver = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "a"}, {"b", "b"}});
+  CountingAssetResolver* counting_resolver = resolver.get();
+
+  auto asset_manager = std::make_shared<AssetManager>();
+  ASSERT_TRUE(asset_manager->PushBack(std::move(resolver)));
+
+  fml::Thread thread("prefetch");
+  asset_manager->Prefetch({"a", "b", "missing"}, thread.GetTaskRunner());
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+  EXPECT_EQ(counting_resolver->lookup_count, 3u);
+
+  EXPECT_EQ(ToString(asset_manager->GetAsMapping("a")), "a");
+  EXPECT_EQ(ToString(asset_manager->GetAsMapping("b")), "b");
+  EXPECT_EQ(asset_manager->GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(counting_resolver->lookup_count, 3u);
+
+  // The prefetched mapping is handed out to the first lookup only.
+  EXPECT_EQ(ToString(asset_manager->GetAsMapping("a")), "a");
+  EXPECT_EQ(counting_resolver->lookup_count, 4u);
+}
+
+TEST(AssetManagerTest, PrefetchedMappingsAreBounded) {
+  // Larger than the total size of the mappings held by the prefetch.
+  const std::string large(32 * 1024 * 1024, 'x');
+  auto resolver = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"small", "small"},
+                                         {"large", large}});
+  CountingAssetResolver* counting_resolver = resolver.get();
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(resolver)));
+
+  asset_manager.Prefetch({"small", "large"}, nullptr);
+  EXPECT_EQ(counting_resolver->lookup_count, 2u);
+
+  // Only the asset that fits in the budget is held until it is used.
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("small")), "small");
+  EXPECT_EQ(counting_resolver->lookup_count, 2u);
+  EXPECT_EQ(asset_manager.GetAsMapping("large")->GetSize(), large.size());
+  EXPECT_EQ(counting_resolver->lookup_count, 3u);
+}
+
+TEST(AssetManagerTest, PrefetchWithoutTaskRunnerRunsInline) {
+  auto resolver = std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "a"}});
+  CountingAssetResolver* counting_resolver = resolver.get();
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(resolver)));
+
+  asset_manager.Prefetch({"a"}, nullptr);
+  EXPECT_EQ(counting_resolver->lookup_count, 1u);
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "a");
+  EXPECT_EQ(counting_resolver->lookup_count, 1u);
+
+  // Changing the resolvers drops the prefetched mappings.
+  ASSERT_TRUE(asset_manager.PushFront(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{})));
+  asset_manager.Prefetch({"a"}, nullptr);
+  asset_manager.PushBack(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{}));
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a")), "a");
+  EXPECT_EQ(counting_resolver->lookup_count, 3u);
+}
+
+}  // namespace testing
+}  // namespace flutter
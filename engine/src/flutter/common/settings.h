@@ -159,6 +159,13 @@ struct Settings {
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool profile_startup = false;
+  // The file that records which pages of the Dart snapshots are touched
+  // during startup. When recording is disabled, the pages in this file are
+  // read ahead in the background before the root isolate runs.
+  std::string snapshot_page_profile_path;
+  bool record_snapshot_page_profile = false;
+  // How long after the VM is launched snapshot pages are recorded for.
+  int64_t snapshot_page_profile_duration_ms = 3000;
   bool disable_dart_asserts = false;
   bool enable_serial_gc = false;
   bool profile_microtasks = false;
@@ -211,6 +211,7 @@ class ComplexityCalculatorHelper
 
   inline bool IsAntiAliased() { return current_paint_.isAntiAlias(); }
   inline bool IsHairline() { return current_paint_.getStrokeWidth() == 0.0f; }
+  inline DlScalar StrokeWidth() { return current_paint_.getStrokeWidth(); }
   inline DlDrawStyle DrawStyle() { return current_paint_.getDrawStyle(); }
   inline bool IsComplex() { return is_complex_; }
   inline unsigned int Ceiling() { return ceiling_; }
@@ -0,0 +1,627 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/display_list/effects/dl_image_filters.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+
+// The costs in this file are those of the individual pieces of work Impeller
+// does to render an op rather than fits of the timings of whole ops. The
+// vertex counts follow Impeller's tessellator and the per-pixel costs were
+// scaled so that simple fills land close to the GL calculator, whose units
+// the cache threshold below is expressed in. They have not been fitted to
+// measurements yet.
+//
+// The Impeller dl_complexity_benchmarks suite runs with the engine
+// benchmarks and reports a TimePerUnit counter for each op: the measured
+// time divided by the score computed here. Once the table is calibrated
+// that counter is the same for every benchmark, so a benchmark whose
+// TimePerUnit stands out points at the entry that needs to change. Only the
+// table below should need to change when recalibrating.
+//
+// See the comments in dl_complexity_helper.h for the units used.
+
+namespace {
+
+// The fixed cost of recording one draw: choosing the pipeline, writing the
+// uniforms into the host buffer and binding everything.
+constexpr float kDrawCallCost = 100.0f;
+
+// The fixed cost of beginning and ending a render pass, including fetching
+// its attachments from the render target cache.
+constexpr float kRenderPassCost = 6000.0f;
+
+// The number of pixels of solid or gradient fill that cost 1 unit.
+constexpr float kFillPixelsPerUnit = 200.0f;
+
+// The number of pixels sampled from a texture that cost 1 unit.
+constexpr float kTexturePixelsPerUnit = 100.0f;
+
+// The number of pixels of a non-texture-backed image that cost 1 unit to
+// upload before drawing.
+constexpr float kUploadPixelsPerUnit = 20.0f;
+
+// Anti-aliased draws are rendered into a multisampled attachment.
+constexpr float kAntiAliasedPixelPenalty = 1.25f;
+
+// The cost of generating and uploading one vertex of tessellated geometry.
+constexpr float kVertexCost = 2.0f;
+
+// The vertices the tessellator typically generates for each path verb.
+constexpr float kLineVerbVertices = 1.0f;
+constexpr float kQuadVerbVertices = 8.0f;
+constexpr float kConicVerbVertices = 10.0f;
+constexpr float kCubicVerbVertices = 12.0f;
+
+// Strokes generate vertices on both sides of the path plus the joins
+// between segments. Hairlines are drawn without joins.
+constexpr float kStrokeVertexMultiplier = 2.0f;
+constexpr float kStrokeJoinVertices = 4.0f;
+
+// Circles and ovals are subdivided based on their size. This is a linear
+// fit of the vertex count for radii between 10 and 500 pixels.
+constexpr float kMinCircleVertices = 16.0f;
+constexpr float kCircleVerticesPerPixelRadius = 0.5f;
+constexpr float kMaxCircleVertices = 1024.0f;
+
+// Round points are drawn as small circles, square points as quads.
+constexpr float kRoundPointVertices = 16.0f;
+constexpr float kSquarePointVertices = 6.0f;
+
+// Rounded rects and superellipses tessellate each of their corners.
+constexpr float kRoundRectVertices = 64.0f;
+constexpr float kRoundSuperellipseVertices = 96.0f;
+
+// The number of pixels of an analytic (SDF) blur or shadow that cost 1 unit.
+constexpr float kAnalyticBlurPixelsPerUnit = 100.0f;
+
+// The Gaussian blur downsamples its input, blurs it in two separable
+// passes and composites the result. Sigmas up to kFullResolutionBlurSigma
+// are blurred at full resolution.
+constexpr float kBlurPassCount = 3.0f;
+constexpr float kFullResolutionBlurSigma = 4.0f;
+constexpr float kMinBlurScale = 1.0f / 16.0f;
+// The number of pixel-samples of a blur pass that cost 1 unit.
+constexpr float kBlurSamplesPerUnit = 1000.0f;
+
+// The cost of a text run whose glyphs are already in the atlas.
+constexpr float kTextRunCost = 300.0f;
+// The cost of rasterizing new glyphs and uploading the atlas, which happens
+// at most once per frame no matter how many runs are drawn.
+constexpr float kGlyphAtlasUpdateCost = 40000.0f;
+
+constexpr float kMaxComplexity = 4.0e9f;
+
+unsigned int ToComplexity(float complexity) {
+  return static_cast<unsigned int>(
+      std::clamp(complexity, 0.0f, kMaxComplexity));
+}
+
+float AreaOf(const flutter::DlRect& rect) {
+  return std::max(rect.Area(), 0.0f);
+}
+
+float CircleVertices(flutter::DlScalar radius) {
+  return std::min(kMinCircleVertices + radius * kCircleVerticesPerPixelRadius,
+                  kMaxCircleVertices);
+}
+
+float BlurCost(const flutter::DlRect& bounds, flutter::DlScalar sigma) {
+  float scale = 1.0f;
+  if (sigma > kFullResolutionBlurSigma) {
+    scale = std::max(kFullResolutionBlurSigma / sigma, kMinBlurScale);
+  }
+  float blurred_area = AreaOf(bounds.Expand(sigma * 3.0f));
+  float scaled_area = blurred_area * scale * scale;
+  // The kernel radius each blur pass samples across.
+  float samples = sigma * scale * 3.0f + 1.0f;
+  return kBlurPassCount * (kRenderPassCost + kDrawCallCost) +
+         scaled_area / kTexturePixelsPerUnit +
+         2.0f * scaled_area * samples / kBlurSamplesPerUnit +
+         kDrawCallCost + blurred_area / kTexturePixelsPerUnit;
+}
+
+}  // namespace
+
+namespace flutter {
+
+DisplayListImpellerComplexityCalculator*
+    DisplayListImpellerComplexityCalculator::instance_ = nullptr;
+
+DisplayListImpellerComplexityCalculator*
+DisplayListImpellerComplexityCalculator::GetInstance() {
+  if (instance_ == nullptr) {
+    instance_ = new DisplayListImpellerComplexityCalculator();
+  }
+  return instance_;
+}
+
+unsigned int
+DisplayListImpellerComplexityCalculator::ImpellerHelper::BatchedComplexity() {
+  if (draw_text_count_ == 0) {
+    return 0;
+  }
+  // All the glyphs used in a frame share one atlas. Only the first run pays
+  // for updating it, the rest just sample it.
+  return ToComplexity(kGlyphAtlasUpdateCost +
+                      draw_text_count_ * (kDrawCallCost + kTextRunCost) +
+                      draw_text_area_ / kTexturePixelsPerUnit);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::setImageFilter(
+    const DlImageFilter* filter) {
+  const DlBlurImageFilter* blur = filter ? filter->asBlur() : nullptr;
+  image_filter_blur_sigma_ =
+      blur ? std::max(blur->sigma_x(), blur->sigma_y()) : 0.0f;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::setMaskFilter(
+    const DlMaskFilter* filter) {
+  const DlBlurMaskFilter* blur = filter ? filter->asBlur() : nullptr;
+  mask_blur_sigma_ = blur ? blur->sigma() : 0.0f;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::AccumulateDraw(
+    float vertex_cost,
+    float pixels,
+    const DlRect& bounds,
+    bool is_simple_shape) {
+  float pixel_cost = pixels / kFillPixelsPerUnit;
+  if (IsAntiAliased()) {
+    pixel_cost *= kAntiAliasedPixelPenalty;
+  }
+  float complexity = kDrawCallCost + vertex_cost + pixel_cost;
+  if (mask_blur_sigma_ > 0.0f) {
+    if (is_simple_shape) {
+      complexity += AreaOf(bounds.Expand(mask_blur_sigma_ * 3.0f)) /
+                    kAnalyticBlurPixelsPerUnit;
+    } else {
+      complexity += kRenderPassCost + BlurCost(bounds, mask_blur_sigma_);
+    }
+  }
+  if (image_filter_blur_sigma_ > 0.0f) {
+    complexity += kRenderPassCost + BlurCost(bounds, image_filter_blur_sigma_);
+  }
+  AccumulateComplexity(ToComplexity(complexity));
+}
+
+float DisplayListImpellerComplexityCalculator::ImpellerHelper::StrokePixels(
+    float length) {
+  // Anti-aliased strokes are widened by a pixel for the coverage ramp.
+  float width = std::max(StrokeWidth(), 1.0f) + (IsAntiAliased() ? 1 : 0);
+  return length * width;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::AccumulatePath(
+    const DlPath& path) {
+  DlRect bounds = path.GetBounds();
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    float vertex_cost = CalculatePathComplexity(
+        path, ToComplexity(kLineVerbVertices * kVertexCost),
+        ToComplexity(kQuadVerbVertices * kVertexCost),
+        ToComplexity(kConicVerbVertices * kVertexCost),
+        ToComplexity(kCubicVerbVertices * kVertexCost));
+    if (path.IsConvex()) {
+      AccumulateDraw(vertex_cost, AreaOf(bounds), bounds, false);
+      return;
+    }
+    // Stencil-then-cover: the first draw writes the winding of the path into
+    // the stencil buffer and the second one covers its bounds.
+    AccumulateDraw(vertex_cost + kDrawCallCost + 4 * kVertexCost,
+                   2 * AreaOf(bounds), bounds, false);
+    return;
+  }
+  float join_vertices = IsHairline() ? 0.0f : kStrokeJoinVertices;
+  auto verb_cost = [join_vertices](float vertices) {
+    return ToComplexity(
+        (vertices * kStrokeVertexMultiplier + join_vertices) * kVertexCost);
+  };
+  float vertex_cost = CalculatePathComplexity(
+      path, verb_cost(kLineVerbVertices), verb_cost(kQuadVerbVertices),
+      verb_cost(kConicVerbVertices), verb_cost(kCubicVerbVertices));
+  float length = 2.0f * (bounds.GetWidth() + bounds.GetHeight());
+  AccumulateDraw(vertex_cost, StrokePixels(length), bounds, false);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::saveLayer(
+    const DlRect& bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop,
+    std::optional<int64_t> backdrop_id) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // Flutter does not offer this operation so this value can only ever be
+    // non-null for a frame-wide builder which is not currently evaluated for
+    // complexity.
+    AccumulateComplexity(Ceiling());
+  }
+  // The layer is rendered into its own pass, which is then composited back
+  // into the parent with a textured draw.
+  float complexity =
+      kRenderPassCost + kDrawCallCost + AreaOf(bounds) / kTexturePixelsPerUnit;
+  if (options.renders_with_attributes() && image_filter_blur_sigma_ > 0.0f) {
+    complexity += BlurCost(bounds, image_filter_blur_sigma_);
+  }
+  AccumulateComplexity(ToComplexity(complexity));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawLine(
+    const DlPoint& p0,
+    const DlPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  // Use an approximation for the distance to avoid floating point or
+  // sqrt() calls.
+  DlScalar length = std::abs(p0.x - p1.x) + std::abs(p0.y - p1.y);
+  float vertices = kLineVerbVertices * kStrokeVertexMultiplier +
+                   (IsHairline() ? 0.0f : kStrokeJoinVertices);
+  AccumulateDraw(vertices * kVertexCost, StrokePixels(length),
+                 DlRect::MakeLTRB(std::min(p0.x, p1.x), std::min(p0.y, p1.y),
+                                  std::max(p0.x, p1.x), std::max(p0.y, p1.y)),
+                 true);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDashedLine(
+    const DlPoint& p0,
+    const DlPoint& p1,
+    DlScalar on_length,
+    DlScalar off_length) {
+  if (IsComplex()) {
+    return;
+  }
+  // Each dash is tessellated as its own segment, but only the "on" part of
+  // the line is shaded.
+  DlScalar length = std::abs(p0.x - p1.x) + std::abs(p0.y - p1.y);
+  DlScalar period = on_length + off_length;
+  float dashes = period > 0.0f ? std::ceil(length / period) : 1.0f;
+  float on_length_fraction = period > 0.0f ? on_length / period : 1.0f;
+  float vertices = dashes * (kLineVerbVertices * kStrokeVertexMultiplier +
+                             (IsHairline() ? 0.0f : kStrokeJoinVertices));
+  AccumulateDraw(vertices * kVertexCost,
+                 StrokePixels(length * on_length_fraction),
+                 DlRect::MakeLTRB(std::min(p0.x, p1.x), std::min(p0.y, p1.y),
+                                  std::max(p0.x, p1.x), std::max(p0.y, p1.y)),
+                 true);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRect(
+    const DlRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(4 * kVertexCost, AreaOf(rect), rect, true);
+  } else {
+    float length = 2.0f * (rect.GetWidth() + rect.GetHeight());
+    float vertices = 4 * (kLineVerbVertices * kStrokeVertexMultiplier +
+                          (IsHairline() ? 0.0f : kStrokeJoinVertices));
+    AccumulateDraw(vertices * kVertexCost, StrokePixels(length), rect, true);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawOval(
+    const DlRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  DlScalar radius = std::max(bounds.GetWidth(), bounds.GetHeight()) / 2;
+  float vertices = CircleVertices(radius);
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(vertices * kVertexCost, AreaOf(bounds), bounds, true);
+  } else {
+    // Ramanujan would not approve, but this is close enough for ovals that
+    // are not too eccentric.
+    float length = 1.6f * (bounds.GetWidth() + bounds.GetHeight());
+    AccumulateDraw(vertices * kStrokeVertexMultiplier * kVertexCost,
+                   StrokePixels(length), bounds, true);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawCircle(
+    const DlPoint& center,
+    DlScalar radius) {
+  drawOval(DlRect::MakeLTRB(center.x - radius, center.y - radius,
+                            center.x + radius, center.y + radius));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRoundRect(
+    const DlRoundRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  const DlRect& bounds = rrect.GetBounds();
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(kRoundRectVertices * kVertexCost, AreaOf(bounds), bounds,
+                   true);
+  } else {
+    float length = 2.0f * (bounds.GetWidth() + bounds.GetHeight());
+    AccumulateDraw(kRoundRectVertices * kStrokeVertexMultiplier * kVertexCost,
+                   StrokePixels(length), bounds, true);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::
+    drawDiffRoundRect(const DlRoundRect& outer, const DlRoundRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  // The two round rects are converted into a single path with a hole, which
+  // is never convex.
+  const DlRect& bounds = outer.GetBounds();
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    // Drawn with stencil-then-cover, see AccumulatePath.
+    float vertex_cost = (2 * kRoundRectVertices + 4) * kVertexCost;
+    AccumulateDraw(vertex_cost + kDrawCallCost, 2 * AreaOf(bounds), bounds,
+                   false);
+  } else {
+    float length = 2.0f * (bounds.GetWidth() + bounds.GetHeight() +
+                           inner.GetBounds().GetWidth() +
+                           inner.GetBounds().GetHeight());
+    AccumulateDraw(
+        2 * kRoundRectVertices * kStrokeVertexMultiplier * kVertexCost,
+        StrokePixels(length), bounds, false);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::
+    drawRoundSuperellipse(const DlRoundSuperellipse& rse) {
+  if (IsComplex()) {
+    return;
+  }
+  const DlRect& bounds = rse.GetBounds();
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(kRoundSuperellipseVertices * kVertexCost, AreaOf(bounds),
+                   bounds, true);
+  } else {
+    float length = 2.0f * (bounds.GetWidth() + bounds.GetHeight());
+    AccumulateDraw(
+        kRoundSuperellipseVertices * kStrokeVertexMultiplier * kVertexCost,
+        StrokePixels(length), bounds, true);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPath(
+    const DlPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  // Paths that are really simple shapes skip the tessellator.
+  DlRect rect;
+  if (path.IsRect(&rect)) {
+    drawRect(rect);
+    return;
+  }
+  if (path.IsOval(&rect)) {
+    drawOval(rect);
+    return;
+  }
+  DlRoundRect rrect;
+  if (path.IsRoundRect(&rrect)) {
+    drawRoundRect(rrect);
+    return;
+  }
+  AccumulatePath(path);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawArc(
+    const DlRect& oval_bounds,
+    DlScalar start_degrees,
+    DlScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  // Arcs are tessellated from the same subdivisions as the full oval.
+  float fraction = std::min(std::abs(sweep_degrees) / 360.0f, 1.0f);
+  DlScalar radius = std::max(oval_bounds.GetWidth(), oval_bounds.GetHeight()) /
+                    2;
+  float vertices = CircleVertices(radius) * fraction + (use_center ? 1 : 0);
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(vertices * kVertexCost, AreaOf(oval_bounds) * fraction,
+                   oval_bounds, true);
+  } else {
+    float length =
+        1.6f * (oval_bounds.GetWidth() + oval_bounds.GetHeight()) * fraction;
+    AccumulateDraw(vertices * kStrokeVertexMultiplier * kVertexCost,
+                   StrokePixels(length), oval_bounds, true);
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPoints(
+    DlPointMode mode,
+    uint32_t count,
+    const DlPoint points[]) {
+  if (IsComplex() || count == 0) {
+    return;
+  }
+  DlRect bounds = DlRect::MakeLTRB(points[0].x, points[0].y, points[0].x,
+                                   points[0].y);
+  for (uint32_t i = 1; i < count; i++) {
+    bounds = bounds.Union(DlRect::MakeLTRB(points[i].x, points[i].y,
+                                           points[i].x, points[i].y));
+  }
+  if (mode == DlPointMode::kPoints) {
+    // All the points are generated into a single draw.
+    DlScalar size = std::max(StrokeWidth(), 1.0f);
+    float vertices = IsAntiAliased() ? kRoundPointVertices
+                                     : kSquarePointVertices;
+    AccumulateDraw(count * vertices * kVertexCost, count * size * size,
+                   bounds, true);
+    return;
+  }
+  uint32_t step = mode == DlPointMode::kLines ? 2 : 1;
+  float length = 0.0f;
+  uint32_t segments = 0;
+  for (uint32_t i = 0; i + 1 < count; i += step) {
+    length += std::abs(points[i].x - points[i + 1].x) +
+              std::abs(points[i].y - points[i + 1].y);
+    segments++;
+  }
+  float vertices =
+      segments * (kLineVerbVertices * kStrokeVertexMultiplier +
+                  (IsHairline() ? 0.0f : kStrokeJoinVertices));
+  AccumulateDraw(vertices * kVertexCost, StrokePixels(length), bounds, true);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawVertices(
+    const std::shared_ptr<DlVertices>& vertices,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  // The vertices are copied into the host buffer as they are, and the
+  // triangles cover roughly their bounds.
+  DlRect bounds = vertices->GetBounds();
+  AccumulateDraw(vertices->vertex_count() * kVertexCost, AreaOf(bounds),
+                 bounds, true);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const DlPoint& point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  ImageRect(image->GetSize(), image->isTextureBacked(), render_with_attributes,
+            false);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::ImageRect(
+    const DlISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    bool enforce_src_edges) {
+  if (IsComplex()) {
+    return;
+  }
+  // Strict source rects are honored in the fragment shader, which costs a
+  // little extra per pixel.
+  float area = size.Area();
+  float complexity = kDrawCallCost + area / kTexturePixelsPerUnit;
+  if (enforce_src_edges) {
+    complexity *= 1.1f;
+  }
+  if (!texture_backed) {
+    complexity += area / kUploadPixelsPerUnit;
+  }
+  if (render_with_attributes && image_filter_blur_sigma_ > 0.0f) {
+    DlRect bounds = DlRect::MakeWH(size.width, size.height);
+    complexity += kRenderPassCost + BlurCost(bounds, image_filter_blur_sigma_);
+  }
+  AccumulateComplexity(ToComplexity(complexity));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImageNine(
+    const sk_sp<DlImage> image,
+    const DlIRect& center,
+    const DlRect& dst,
+    DlFilterMode filter,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  // The nine patch is drawn as nine separate image rects.
+  float complexity = 9 * kDrawCallCost + AreaOf(dst) / kTexturePixelsPerUnit;
+  if (!image->isTextureBacked()) {
+    complexity += image->GetSize().Area() / kUploadPixelsPerUnit;
+  }
+  AccumulateComplexity(ToComplexity(complexity));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawAtlas(
+    const sk_sp<DlImage> atlas,
+    const DlRSTransform xform[],
+    const DlRect tex[],
+    const DlColor colors[],
+    int count,
+    DlBlendMode mode,
+    DlImageSampling sampling,
+    const DlRect* cull_rect,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  // Unlike Skia, all the sprites are generated into a single draw.
+  float area = 0.0f;
+  for (int i = 0; i < count; i++) {
+    area += AreaOf(tex[i]);
+  }
+  float complexity = kDrawCallCost + count * 6 * kVertexCost +
+                     area / kTexturePixelsPerUnit;
+  if (colors) {
+    // Per-sprite colors are blended in an additional pass.
+    complexity += kDrawCallCost + area / kFillPixelsPerUnit;
+  }
+  AccumulateComplexity(ToComplexity(complexity));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list,
+    DlScalar opacity) {
+  if (IsComplex()) {
+    return;
+  }
+  ImpellerHelper helper(Ceiling() - CurrentComplexityScore());
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    auto bounds = display_list->GetBounds();
+    helper.saveLayer(bounds, SaveLayerOptions::kWithAttributes, nullptr,
+                     /*backdrop_id=*/-1);
+  }
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawText(
+    const std::shared_ptr<DlText>& text,
+    DlScalar x,
+    DlScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  // The glyph atlas is shared by all the runs, so the cost is calculated at
+  // the end.
+  draw_text_count_++;
+  draw_text_area_ += AreaOf(text->GetBounds());
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawShadow(
+    const DlPath& path,
+    const DlColor color,
+    const DlScalar elevation,
+    bool transparent_occluder,
+    DlScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  DlRect bounds = path.GetBounds();
+  DlScalar sigma = elevation * dpr / 2;
+  DlRect shadow_bounds = bounds.Expand(sigma * 3.0f);
+  // Rects, ovals and round rects have an analytic shadow. Anything else is
+  // filled into an offscreen and blurred.
+  if (path.IsRect() || path.IsOval() || path.IsRoundRect()) {
+    AccumulateComplexity(ToComplexity(
+        kDrawCallCost + kRoundRectVertices * kVertexCost +
+        AreaOf(shadow_bounds) / kAnalyticBlurPixelsPerUnit));
+    return;
+  }
+  float vertex_cost = CalculatePathComplexity(
+      path, ToComplexity(kLineVerbVertices * kVertexCost),
+      ToComplexity(kQuadVerbVertices * kVertexCost),
+      ToComplexity(kConicVerbVertices * kVertexCost),
+      ToComplexity(kCubicVerbVertices * kVertexCost));
+  AccumulateComplexity(ToComplexity(
+      kRenderPassCost + 2 * kDrawCallCost + vertex_cost +
+      AreaOf(bounds) / kFillPixelsPerUnit + BlurCost(bounds, sigma)));
+}
+
+}  // namespace flutter
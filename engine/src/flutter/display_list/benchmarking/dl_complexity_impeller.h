@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
+
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+// Unlike the GL and Metal calculators, which fit curves to the timings of
+// Skia ops, this calculator models the work Impeller does for each op: the
+// draw calls it records, the vertices it tessellates on the CPU, the pixels
+// it shades and the extra render passes needed for stencil-then-cover fills,
+// blurs and saveLayers. The cost of each of those is kept in a single table
+// in dl_complexity_impeller.cc. The costs are provisional estimates that have
+// not been calibrated against the Impeller dl_complexity_benchmarks suite.
+//
+// Impeller doesn't use the raster cache, so nothing consumes these scores
+// in the engine yet. The calculator is only used to evaluate the model.
+class DisplayListImpellerComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  static DisplayListImpellerComplexityCalculator* GetInstance();
+
+  unsigned int Compute(const DisplayList* display_list) override {
+    ImpellerHelper helper(ceiling_);
+    display_list->Dispatch(helper);
+    return helper.ComplexityScore();
+  }
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Provisional: copied from the GL calculator, where it is about 1ms. The
+    // Impeller costs have not been calibrated to the same scale yet.
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class ImpellerHelper : public ComplexityCalculatorHelper {
+   public:
+    explicit ImpellerHelper(unsigned int ceiling)
+        : ComplexityCalculatorHelper(ceiling) {}
+
+    void setImageFilter(const DlImageFilter* filter) override;
+    void setMaskFilter(const DlMaskFilter* filter) override;
+
+    void saveLayer(const DlRect& bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop,
+                   std::optional<int64_t> backdrop_id) override;
+
+    void drawLine(const DlPoint& p0, const DlPoint& p1) override;
+    void drawDashedLine(const DlPoint& p0,
+                        const DlPoint& p1,
+                        DlScalar on_length,
+                        DlScalar off_length) override;
+    void drawRect(const DlRect& rect) override;
+    void drawOval(const DlRect& bounds) override;
+    void drawCircle(const DlPoint& center, DlScalar radius) override;
+    void drawRoundRect(const DlRoundRect& rrect) override;
+    void drawDiffRoundRect(const DlRoundRect& outer,
+                           const DlRoundRect& inner) override;
+    void drawRoundSuperellipse(const DlRoundSuperellipse& rse) override;
+    void drawPath(const DlPath& path) override;
+    void drawArc(const DlRect& oval_bounds,
+                 DlScalar start_degrees,
+                 DlScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlPointMode mode,
+                    uint32_t count,
+                    const DlPoint points[]) override;
+    void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                      DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const DlPoint& point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const DlIRect& center,
+                       const DlRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawAtlas(const sk_sp<DlImage> atlas,
+                   const DlRSTransform xform[],
+                   const DlRect tex[],
+                   const DlColor colors[],
+                   int count,
+                   DlBlendMode mode,
+                   DlImageSampling sampling,
+                   const DlRect* cull_rect,
+                   bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list,
+                         DlScalar opacity) override;
+    void drawText(const std::shared_ptr<DlText>& text,
+                  DlScalar x,
+                  DlScalar y) override;
+    void drawShadow(const DlPath& path,
+                    const DlColor color,
+                    const DlScalar elevation,
+                    bool transparent_occluder,
+                    DlScalar dpr) override;
+
+   protected:
+    void ImageRect(const DlISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   bool enforce_src_edges) override;
+
+    unsigned int BatchedComplexity() override;
+
+   private:
+    // Accumulates one draw call that tessellates |vertex_cost| worth of
+    // geometry and shades |pixels| pixels within |bounds|. Draws with a
+    // blur mask filter are rendered analytically when |is_simple_shape| and
+    // through an offscreen blur otherwise.
+    void AccumulateDraw(float vertex_cost,
+                        float pixels,
+                        const DlRect& bounds,
+                        bool is_simple_shape);
+
+    // Accumulates a filled or stroked path. Non-convex fills are drawn with
+    // stencil-then-cover, which doubles both the draws and the pixels
+    // touched.
+    void AccumulatePath(const DlPath& path);
+
+    // The number of pixels touched by a stroke of |length| pixels.
+    float StrokePixels(float length);
+
+    DlScalar image_filter_blur_sigma_ = 0.0f;
+    DlScalar mask_blur_sigma_ = 0.0f;
+
+    unsigned int draw_text_count_ = 0;
+    float draw_text_area_ = 0.0f;
+  };
+
+  DisplayListImpellerComplexityCalculator()
+      : ceiling_(std::numeric_limits<unsigned int>::max()) {}
+  static DisplayListImpellerComplexityCalculator* instance_;
+
+  unsigned int ceiling_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
@@ -21,12 +22,14 @@ namespace {
 std::vector<DisplayListComplexityCalculator*> Calculators() {
   return {DisplayListMetalComplexityCalculator::GetInstance(),
           DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListImpellerComplexityCalculator::GetInstance(),
           DisplayListNaiveComplexityCalculator::GetInstance()};
 }
 
 std::vector<DisplayListComplexityCalculator*> AccumulatorCalculators() {
   return {DisplayListMetalComplexityCalculator::GetInstance(),
-          DisplayListGLComplexityCalculator::GetInstance()};
+          DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListImpellerComplexityCalculator::GetInstance()};
 }
 
 std::vector<DlPoint> GetTestPoints() {
@@ -418,5 +421,74 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, ImpellerNonConvexFillIsStencilThenCover) {
+  DlPathBuilder convex_path_builder;
+  convex_path_builder.MoveTo(DlPoint(0, 0));
+  convex_path_builder.LineTo(DlPoint(100, 0));
+  convex_path_builder.LineTo(DlPoint(100, 100));
+  convex_path_builder.LineTo(DlPoint(50, 150));
+  convex_path_builder.LineTo(DlPoint(0, 100));
+  convex_path_builder.Close();
+  DisplayListBuilder builder_convex;
+  builder_convex.DrawPath(convex_path_builder.TakePath(), DlPaint());
+  auto display_list_convex = builder_convex.Build();
+
+  DlPathBuilder concave_path_builder;
+  concave_path_builder.MoveTo(DlPoint(0, 0));
+  concave_path_builder.LineTo(DlPoint(100, 0));
+  concave_path_builder.LineTo(DlPoint(100, 150));
+  concave_path_builder.LineTo(DlPoint(50, 50));
+  concave_path_builder.LineTo(DlPoint(0, 150));
+  concave_path_builder.Close();
+  DisplayListBuilder builder_concave;
+  builder_concave.DrawPath(concave_path_builder.TakePath(), DlPaint());
+  auto display_list_concave = builder_concave.Build();
+
+  auto calculator = DisplayListImpellerComplexityCalculator::GetInstance();
+  ASSERT_GT(calculator->Compute(display_list_concave.get()),
+            calculator->Compute(display_list_convex.get()));
+}
+
+TEST(DisplayListComplexity, ImpellerBlurredSaveLayer) {
+  DisplayListBuilder builder;
+  builder.SaveLayer(DlRect::MakeWH(500, 500), nullptr);
+  builder.DrawRect(DlRect::MakeWH(500, 500), DlPaint());
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  DisplayListBuilder builder_blurred;
+  DlPaint blur_paint;
+  blur_paint.setImageFilter(
+      DlImageFilter::MakeBlur(20.0f, 20.0f, DlTileMode::kDecal));
+  builder_blurred.SaveLayer(DlRect::MakeWH(500, 500), &blur_paint);
+  builder_blurred.DrawRect(DlRect::MakeWH(500, 500), DlPaint());
+  builder_blurred.Restore();
+  auto display_list_blurred = builder_blurred.Build();
+
+  auto calculator = DisplayListImpellerComplexityCalculator::GetInstance();
+  ASSERT_GT(calculator->Compute(display_list_blurred.get()),
+            calculator->Compute(display_list.get()));
+}
+
+TEST(DisplayListComplexity, ImpellerTextRunsShareTheGlyphAtlas) {
+  auto text_blob =
+      GetTestTextBlob("The quick brown fox jumps over the lazy dog.", 20.0f);
+  auto text = DlTextSkia::Make(text_blob);
+  DisplayListBuilder builder;
+  builder.DrawText(text, 0.0f, 0.0f, DlPaint());
+  auto display_list = builder.Build();
+
+  DisplayListBuilder builder_multiple;
+  builder_multiple.DrawText(text, 0.0f, 0.0f, DlPaint());
+  builder_multiple.DrawText(text, 0.0f, 0.0f, DlPaint());
+  auto display_list_multiple = builder_multiple.Build();
+
+  // The atlas is only updated once, so the second run is much cheaper than
+  // the first.
+  auto calculator = DisplayListImpellerComplexityCalculator::GetInstance();
+  ASSERT_LT(calculator->Compute(display_list_multiple.get()),
+            2 * calculator->Compute(display_list.get()));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -19,6 +19,7 @@
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/testing/dl_test_surface_provider.h"
 #include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/display_list/utils/dl_optimizer.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/math.h"
 #include "flutter/testing/display_list_testing.h"
@@ -4529,6 +4530,134 @@ TEST_F(DisplayListRendering, BlendColorFilterOpacityCommuteCheck) {
 #undef TEST_MODE
 }
 
+TEST_F(DisplayListRendering, OptimizerPreservesRendering) {
+  auto test_optimizer = [](const sk_sp<DisplayList>& display_list,
+                           const std::string& desc) {
+    auto optimized = DisplayListOptimizer::Optimize(display_list);
+    for (auto& back_end : CanvasCompareTester::TestBackends) {
+      auto provider = CanvasCompareTester::GetProvider(back_end);
+      auto env = std::make_unique<RenderEnvironment>(
+          provider.get(), PixelFormat::kN32PremulPixelFormat);
+      auto ref_results = env->getResult(display_list);
+      auto test_results = env->getResult(optimized);
+      CanvasCompareTester::compareToReference(
+          test_results.get(), ref_results.get(), desc, nullptr, nullptr,
+          DlColor::kTransparent(), true, kTestWidth, kTestHeight, true);
+    }
+  };
+
+  const sk_sp<DlImage> test_image =
+      MakeTestImage(kRenderWidth, kRenderHeight, 5);
+  const DlRect quadrants[] = {
+      DlRect::MakeLTRB(kRenderLeft, kRenderTop,  //
+                       kRenderCenterX, kRenderCenterY),
+      DlRect::MakeLTRB(kRenderCenterX, kRenderTop,  //
+                       kRenderRight, kRenderCenterY),
+      DlRect::MakeLTRB(kRenderLeft, kRenderCenterY,  //
+                       kRenderCenterX, kRenderBottom),
+      DlRect::MakeLTRB(kRenderCenterX, kRenderCenterY,  //
+                       kRenderRight, kRenderBottom),
+  };
+
+  {
+    DisplayListBuilder builder;
+    builder.Save();
+    builder.Translate(5, 5);
+    builder.ClipRect(kRenderBounds);
+    builder.Restore();
+    builder.Save();
+    builder.Translate(5, 5);
+    builder.DrawRect(quadrants[0], DlPaint(DlColor::kBlue()));
+    builder.ClipRect(quadrants[1]);
+    builder.Restore();
+    builder.DrawRect(quadrants[3], DlPaint(DlColor::kRed()));
+    builder.Scale(2, 2);
+    test_optimizer(builder.Build(), "no-op save/restore and transforms");
+  }
+
+  for (DlScalar opacity : {0.0f, 0.25f, 0.5f, 1.0f}) {
+    std::string desc = "opacity layer " + std::to_string(opacity);
+    DisplayListBuilder builder;
+    DlPaint layer_paint = DlPaint().setOpacity(opacity);
+    builder.SaveLayer(kRenderBounds, &layer_paint);
+    builder.DrawRect(quadrants[0], DlPaint(DlColor::kYellow()));
+    builder.DrawOval(quadrants[1],
+                     DlPaint(DlColor::kBlue()).setAntiAlias(true));
+    builder.DrawImageRect(test_image, quadrants[2],
+                          DlImageSampling::kNearestNeighbor);
+    builder.Restore();
+    test_optimizer(builder.Build(), desc);
+
+    DisplayListBuilder nested_builder;
+    nested_builder.SaveLayer(std::nullopt, &layer_paint);
+    nested_builder.Translate(kRenderLeft, 0);
+    nested_builder.SaveLayer(std::nullopt, &layer_paint);
+    nested_builder.DrawRect(quadrants[0], DlPaint(DlColor::kMagenta()));
+    nested_builder.Restore();
+    nested_builder.Restore();
+    test_optimizer(nested_builder.Build(), "nested " + desc);
+  }
+
+  {
+    DisplayListBuilder builder;
+    DlPaint paint(DlColor::kCyan());
+    for (int i = 0; i < 10; i++) {
+      builder.DrawRect(DlRect::MakeXYWH(kRenderLeft + i * 7, kRenderTop + i * 9,
+                                        12, 10),
+                       paint);
+    }
+    paint.setColor(DlColor::kMagenta());
+    for (int i = 0; i < 10; i++) {
+      builder.DrawRect(DlRect::MakeXYWH(kRenderRight - i * 7.5f,
+                                        kRenderTop + i * 9.25f, 12.5f, 10),
+                       paint);
+    }
+    test_optimizer(builder.Build(), "batched rects");
+  }
+
+  for (DlImageSampling sampling : {DlImageSampling::kNearestNeighbor,
+                                   DlImageSampling::kLinear}) {
+    std::string desc = "batched image rects";
+    if (sampling == DlImageSampling::kLinear) {
+      desc += " linear";
+    }
+    DlPaint paint = DlPaint().setAlpha(0x80);
+    DisplayListBuilder builder;
+    for (int i = 0; i < 4; i++) {
+      DlRect src = DlRect::MakeXYWH(i * 20, i * 10, 20, 20);
+      DlRect dst = DlRect::MakeXYWH(kRenderLeft + i * 25, kRenderTop + i * 20,
+                                    20 * (i + 1) * 0.5f, 20 * (i + 1) * 0.5f);
+      builder.DrawImageRect(test_image, src, dst, sampling, &paint);
+    }
+    test_optimizer(builder.Build(), desc);
+  }
+
+  // Overlapping sprites whose paints blend or filter each draw separately
+  // must keep rendering one sprite at a time.
+  {
+    auto color_filter =
+        DlColorFilter::MakeBlend(DlColor::kCyan(), DlBlendMode::kSrcATop);
+    std::vector<std::pair<std::string, DlPaint>> paints = {
+        {"multiply", DlPaint().setBlendMode(DlBlendMode::kMultiply)},
+        {"screen", DlPaint().setBlendMode(DlBlendMode::kScreen)},
+        {"color filter", DlPaint().setColorFilter(color_filter)},
+        {"invert colors", DlPaint().setInvertColors(true)},
+    };
+    for (const auto& [name, paint] : paints) {
+      DisplayListBuilder builder;
+      builder.DrawRect(kRenderBounds, DlPaint(DlColor::kYellow()));
+      for (int i = 0; i < 4; i++) {
+        DlRect src = DlRect::MakeXYWH(i * 20, i * 10, 40, 40);
+        DlRect dst = DlRect::MakeXYWH(kRenderLeft + i * 15,
+                                      kRenderTop + i * 15, 40, 40);
+        builder.DrawImageRect(test_image, src, dst,
+                              DlImageSampling::kNearestNeighbor, &paint);
+      }
+      test_optimizer(builder.Build(), "overlapping image rects " + name);
+    }
+  }
+}
+
 class DisplayListNopTest : public DisplayListRendering {
   // The following code uses the acronym MTB for "modifies_transparent_black"
 
@@ -0,0 +1,627 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_optimizer.h"
+
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+
+namespace flutter {
+
+namespace {
+
+enum class OpAction {
+  // Replay the op into the new builder.
+  kEmit,
+  // Drop the op, it has no effect on the rendered pixels.
+  kSkip,
+  // Replace the saveLayer with a save and fold its alpha into the children.
+  kFoldLayer,
+};
+
+// Tracks the rendering attributes of the stream in a |DlPaint| so that
+// they can be handed to the |DlCanvas| methods of the new builder.
+class PaintTrackingReceiver : public virtual DlOpReceiver {
+ public:
+  void setAntiAlias(bool aa) override { paint_.setAntiAlias(aa); }
+  void setInvertColors(bool invert) override {
+    paint_.setInvertColors(invert);
+  }
+  void setStrokeCap(DlStrokeCap cap) override { paint_.setStrokeCap(cap); }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    paint_.setStrokeJoin(join);
+  }
+  void setDrawStyle(DlDrawStyle style) override { paint_.setDrawStyle(style); }
+  void setStrokeWidth(float width) override { paint_.setStrokeWidth(width); }
+  void setStrokeMiter(float limit) override { paint_.setStrokeMiter(limit); }
+  void setColor(DlColor color) override { paint_.setColor(color); }
+  void setBlendMode(DlBlendMode mode) override { paint_.setBlendMode(mode); }
+  void setColorSource(const DlColorSource* source) override {
+    paint_.setColorSource(source);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    paint_.setImageFilter(filter);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    paint_.setColorFilter(filter);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    paint_.setMaskFilter(filter);
+  }
+
+ protected:
+  DlPaint paint_;
+};
+
+// Walks the stream once to decide which ops can be dropped and which
+// saveLayers can be folded into their children.
+//
+// A transform or clip is only needed if some rendering op follows it
+// before its save level is restored. A save level (or a saveLayer that
+// would composite nothing when empty) is only needed if some rendering
+// op happens inside it.
+class OptimizationPlanner : public PaintTrackingReceiver,
+                            public IgnoreClipDispatchHelper,
+                            public IgnoreTransformDispatchHelper,
+                            public IgnoreDrawDispatchHelper {
+ public:
+  std::vector<OpAction> Plan(const DisplayList& display_list) {
+    const DlIndex count = display_list.GetRecordCount();
+    actions_.assign(count, OpAction::kEmit);
+    scopes_.clear();
+    scopes_.emplace_back();
+    for (index_ = 0u; index_ < count; index_++) {
+      switch (display_list.GetOpCategory(index_)) {
+        case DisplayListOpCategory::kAttribute:
+        case DisplayListOpCategory::kSaveLayer:
+          display_list.Dispatch(*this, index_);
+          break;
+        case DisplayListOpCategory::kTransform:
+        case DisplayListOpCategory::kClip:
+          scopes_.back().pending_state_ops.push_back(index_);
+          break;
+        case DisplayListOpCategory::kSave:
+          scopes_.push_back({.save_index = index_, .removable = true});
+          break;
+        case DisplayListOpCategory::kRestore:
+          CloseScope();
+          break;
+        case DisplayListOpCategory::kRendering:
+        case DisplayListOpCategory::kSubDisplayList:
+          MarkContent(scopes_.back());
+          break;
+        case DisplayListOpCategory::kInvalidCategory:
+          break;
+      }
+    }
+    // The builder balances every save before it builds the list, but the
+    // loop is written defensively so that a trailing unrestored save level
+    // simply keeps its ops.
+    while (scopes_.size() > 1u) {
+      MarkContent(scopes_.back());
+      scopes_.pop_back();
+    }
+    SkipPendingStateOps(scopes_.back());
+    return std::move(actions_);
+  }
+
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    bool renders_with_attributes = options.renders_with_attributes();
+    const DlColorFilter* color_filter = paint_.getColorFilterPtr();
+    const DlImageFilter* image_filter = paint_.getImageFilterPtr();
+    bool alpha_only = paint_.getBlendMode() == DlBlendMode::kSrcOver &&
+                      !paint_.isInvertColors() && !color_filter &&
+                      !image_filter;
+    bool empty_is_invisible =
+        paint_.getBlendMode() == DlBlendMode::kSrcOver &&
+        !paint_.isInvertColors() &&
+        !(color_filter && color_filter->modifies_transparent_black()) &&
+        !(image_filter && image_filter->modifies_transparent_black());
+    if (backdrop == nullptr && !options.content_is_clipped() &&
+        options.can_distribute_opacity() &&
+        (!renders_with_attributes || alpha_only)) {
+      actions_[index_] = OpAction::kFoldLayer;
+    }
+    scopes_.push_back({
+        .save_index = index_,
+        .removable = backdrop == nullptr &&
+                     (!renders_with_attributes || empty_is_invisible),
+    });
+  }
+
+ private:
+  struct Scope {
+    DlIndex save_index = 0u;
+    bool removable = false;
+    bool has_content = false;
+    // Transforms and clips seen since the last rendering op at this level.
+    std::vector<DlIndex> pending_state_ops;
+  };
+
+  void MarkContent(Scope& scope) {
+    scope.has_content = true;
+    scope.pending_state_ops.clear();
+  }
+
+  void SkipPendingStateOps(Scope& scope) {
+    for (DlIndex index : scope.pending_state_ops) {
+      actions_[index] = OpAction::kSkip;
+    }
+    scope.pending_state_ops.clear();
+  }
+
+  void CloseScope() {
+    if (scopes_.size() <= 1u) {
+      return;
+    }
+    Scope& scope = scopes_.back();
+    SkipPendingStateOps(scope);
+    if (!scope.has_content && scope.removable) {
+      actions_[scope.save_index] = OpAction::kSkip;
+      actions_[index_] = OpAction::kSkip;
+      scopes_.pop_back();
+    } else {
+      scopes_.pop_back();
+      MarkContent(scopes_.back());
+    }
+  }
+
+  DlIndex index_ = 0u;
+  std::vector<OpAction> actions_;
+  std::vector<Scope> scopes_;
+};
+
+// Replays the planned stream into a |DisplayListBuilder|, applying the
+// folded layer opacities and merging runs of compatible draws.
+class OptimizingReceiver : public PaintTrackingReceiver {
+ public:
+  explicit OptimizingReceiver(DisplayListBuilder& builder)
+      : builder_(builder) {}
+
+  void set_action(OpAction action) { action_ = action; }
+
+  void save() override {
+    FlushBatch();
+    builder_.Save();
+    opacity_stack_.push_back(opacity());
+  }
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    FlushBatch();
+    if (action_ == OpAction::kFoldLayer) {
+      // The same peephole as DlSkCanvasDispatcher::saveLayer, the children
+      // inherit the alpha of the layer instead of rendering into it.
+      builder_.Save();
+      opacity_stack_.push_back(options.renders_with_attributes()
+                                   ? opacity() * paint_.getOpacity()
+                                   : opacity());
+      return;
+    }
+    std::optional<DlRect> layer_bounds;
+    if (options.bounds_from_caller()) {
+      layer_bounds = bounds;
+    }
+    std::optional<DlPaint> paint = options.renders_with_attributes()
+                                       ? EffectivePaint()
+                                       : OpacityPaint();
+    builder_.SaveLayer(layer_bounds, paint ? &paint.value() : nullptr,
+                       backdrop, backdrop_id);
+    // The layer applies the inherited opacity on behalf of its children.
+    opacity_stack_.push_back(1.0f);
+  }
+  void restore() override {
+    FlushBatch();
+    builder_.Restore();
+    if (opacity_stack_.size() > 1u) {
+      opacity_stack_.pop_back();
+    }
+  }
+
+  void translate(DlScalar tx, DlScalar ty) override {
+    FlushBatch();
+    builder_.Translate(tx, ty);
+  }
+  void scale(DlScalar sx, DlScalar sy) override {
+    FlushBatch();
+    builder_.Scale(sx, sy);
+  }
+  void rotate(DlScalar degrees) override {
+    FlushBatch();
+    builder_.Rotate(degrees);
+  }
+  void skew(DlScalar sx, DlScalar sy) override {
+    FlushBatch();
+    builder_.Skew(sx, sy);
+  }
+  // clang-format off
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override {
+    FlushBatch();
+    builder_.Transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override {
+    FlushBatch();
+    builder_.TransformFullPerspective(mxx, mxy, mxz, mxt,
+                                      myx, myy, myz, myt,
+                                      mzx, mzy, mzz, mzt,
+                                      mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override {
+    FlushBatch();
+    builder_.TransformReset();
+  }
+
+  void clipRect(const DlRect& rect, DlClipOp clip_op, bool is_aa) override {
+    FlushBatch();
+    builder_.ClipRect(rect, clip_op, is_aa);
+  }
+  void clipOval(const DlRect& bounds, DlClipOp clip_op, bool is_aa) override {
+    FlushBatch();
+    builder_.ClipOval(bounds, clip_op, is_aa);
+  }
+  void clipRoundRect(const DlRoundRect& rrect,
+                     DlClipOp clip_op,
+                     bool is_aa) override {
+    FlushBatch();
+    builder_.ClipRoundRect(rrect, clip_op, is_aa);
+  }
+  void clipRoundSuperellipse(const DlRoundSuperellipse& rse,
+                             DlClipOp clip_op,
+                             bool is_aa) override {
+    FlushBatch();
+    builder_.ClipRoundSuperellipse(rse, clip_op, is_aa);
+  }
+  void clipPath(const DlPath& path, DlClipOp clip_op, bool is_aa) override {
+    FlushBatch();
+    builder_.ClipPath(path, clip_op, is_aa);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    FlushBatch();
+    builder_.DrawColor(color.withAlphaF(color.getAlphaF() * opacity()), mode);
+  }
+  void drawPaint() override {
+    FlushBatch();
+    builder_.DrawPaint(EffectivePaint());
+  }
+  void drawLine(const DlPoint& p0, const DlPoint& p1) override {
+    FlushBatch();
+    builder_.DrawLine(p0, p1, EffectivePaint());
+  }
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    FlushBatch();
+    builder_.DrawDashedLine(p0, p1, on_length, off_length, EffectivePaint());
+  }
+  void drawRect(const DlRect& rect) override {
+    DlPaint paint = EffectivePaint();
+    if (!CanBatchRect(paint)) {
+      FlushBatch();
+      builder_.DrawRect(rect, paint);
+      return;
+    }
+    if (batch_.type != BatchType::kRect || !(batch_.paint == paint)) {
+      FlushBatch();
+      batch_.type = BatchType::kRect;
+      batch_.paint = paint;
+    }
+    batch_.rects.push_back(rect);
+  }
+  void drawOval(const DlRect& bounds) override {
+    FlushBatch();
+    builder_.DrawOval(bounds, EffectivePaint());
+  }
+  void drawCircle(const DlPoint& center, DlScalar radius) override {
+    FlushBatch();
+    builder_.DrawCircle(center, radius, EffectivePaint());
+  }
+  void drawRoundRect(const DlRoundRect& rrect) override {
+    FlushBatch();
+    builder_.DrawRoundRect(rrect, EffectivePaint());
+  }
+  void drawDiffRoundRect(const DlRoundRect& outer,
+                         const DlRoundRect& inner) override {
+    FlushBatch();
+    builder_.DrawDiffRoundRect(outer, inner, EffectivePaint());
+  }
+  void drawRoundSuperellipse(const DlRoundSuperellipse& rse) override {
+    FlushBatch();
+    builder_.DrawRoundSuperellipse(rse, EffectivePaint());
+  }
+  void drawPath(const DlPath& path) override {
+    FlushBatch();
+    builder_.DrawPath(path, EffectivePaint());
+  }
+  void drawArc(const DlRect& oval_bounds,
+               DlScalar start_degrees,
+               DlScalar sweep_degrees,
+               bool use_center) override {
+    FlushBatch();
+    builder_.DrawArc(oval_bounds, start_degrees, sweep_degrees, use_center,
+                     EffectivePaint());
+  }
+  void drawPoints(DlPointMode mode,
+                  uint32_t count,
+                  const DlPoint points[]) override {
+    FlushBatch();
+    builder_.DrawPoints(mode, count, points, EffectivePaint());
+  }
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    FlushBatch();
+    builder_.DrawVertices(vertices, mode, EffectivePaint());
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const DlPoint& point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    FlushBatch();
+    std::optional<DlPaint> paint = ImagePaint(render_with_attributes);
+    builder_.DrawImage(image, point, sampling, Ptr(paint));
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     DlSrcRectConstraint constraint) override {
+    std::optional<DlPaint> paint = ImagePaint(render_with_attributes);
+    if (!CanBatchImageRect(image, src, dst, constraint, paint)) {
+      FlushBatch();
+      builder_.DrawImageRect(image, src, dst, sampling, Ptr(paint),
+                             constraint);
+      return;
+    }
+    if (batch_.type != BatchType::kImageRect ||
+        batch_.image.get() != image.get() || batch_.sampling != sampling ||
+        !(batch_.image_paint == paint)) {
+      FlushBatch();
+      batch_.type = BatchType::kImageRect;
+      batch_.image = image;
+      batch_.sampling = sampling;
+      batch_.image_paint = paint;
+    }
+    batch_.rects.push_back(src);
+    batch_.dst_rects.push_back(dst);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    FlushBatch();
+    std::optional<DlPaint> paint = ImagePaint(render_with_attributes);
+    builder_.DrawImageNine(image, center, dst, filter, Ptr(paint));
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const DlRSTransform xform[],
+                 const DlRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override {
+    FlushBatch();
+    std::optional<DlPaint> paint = ImagePaint(render_with_attributes);
+    builder_.DrawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                       cull_rect, Ptr(paint));
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    FlushBatch();
+    builder_.DrawDisplayList(display_list, opacity * this->opacity());
+  }
+  void drawText(const std::shared_ptr<DlText>& text,
+                DlScalar x,
+                DlScalar y) override {
+    FlushBatch();
+    builder_.DrawText(text, x, y, EffectivePaint());
+  }
+  void drawShadow(const DlPath& path,
+                  const DlColor color,
+                  const DlScalar elevation,
+                  bool transparent_occluder,
+                  DlScalar dpr) override {
+    FlushBatch();
+    builder_.DrawShadow(path, color.withAlphaF(color.getAlphaF() * opacity()),
+                        elevation, transparent_occluder, dpr);
+  }
+
+  void FlushBatch() {
+    int count = static_cast<int>(batch_.rects.size());
+    switch (batch_.type) {
+      case BatchType::kNone:
+        break;
+      case BatchType::kRect:
+        if (count < DisplayListOptimizer::kMinBatchCount) {
+          for (const DlRect& rect : batch_.rects) {
+            builder_.DrawRect(rect, batch_.paint);
+          }
+        } else {
+          std::vector<DlPoint> vertices;
+          vertices.reserve(count * 6);
+          for (const DlRect& rect : batch_.rects) {
+            vertices.push_back(rect.GetLeftTop());
+            vertices.push_back(rect.GetRightTop());
+            vertices.push_back(rect.GetRightBottom());
+            vertices.push_back(rect.GetLeftTop());
+            vertices.push_back(rect.GetRightBottom());
+            vertices.push_back(rect.GetLeftBottom());
+          }
+          builder_.DrawVertices(
+              DlVertices::Make(DlVertexMode::kTriangles,
+                               static_cast<int>(vertices.size()),
+                               vertices.data(), nullptr, nullptr),
+              DlBlendMode::kSrcOver, batch_.paint);
+        }
+        break;
+      case BatchType::kImageRect:
+        if (count < DisplayListOptimizer::kMinBatchCount) {
+          for (int i = 0; i < count; i++) {
+            builder_.DrawImageRect(batch_.image, batch_.rects[i],
+                                   batch_.dst_rects[i], batch_.sampling,
+                                   Ptr(batch_.image_paint));
+          }
+        } else {
+          std::vector<DlRSTransform> xforms;
+          xforms.reserve(count);
+          for (int i = 0; i < count; i++) {
+            const DlRect& src = batch_.rects[i];
+            const DlRect& dst = batch_.dst_rects[i];
+            DlScalar scale = dst.GetWidth() / src.GetWidth();
+            xforms.emplace_back(scale, 0.0f, dst.GetLeft(), dst.GetTop());
+          }
+          builder_.DrawAtlas(batch_.image, xforms.data(), batch_.rects.data(),
+                             nullptr, count, DlBlendMode::kSrcOver,
+                             batch_.sampling, nullptr,
+                             Ptr(batch_.image_paint));
+        }
+        break;
+    }
+    batch_.type = BatchType::kNone;
+    batch_.image = nullptr;
+    batch_.rects.clear();
+    batch_.dst_rects.clear();
+  }
+
+ private:
+  enum class BatchType {
+    kNone,
+    kRect,
+    kImageRect,
+  };
+
+  struct Batch {
+    BatchType type = BatchType::kNone;
+    DlPaint paint;
+    std::optional<DlPaint> image_paint;
+    sk_sp<DlImage> image;
+    DlImageSampling sampling = DlImageSampling::kNearestNeighbor;
+    // The rects of a kRect batch or the source rects of a kImageRect batch.
+    std::vector<DlRect> rects;
+    std::vector<DlRect> dst_rects;
+  };
+
+  static const DlPaint* Ptr(const std::optional<DlPaint>& paint) {
+    return paint.has_value() ? &paint.value() : nullptr;
+  }
+
+  DlScalar opacity() const { return opacity_stack_.back(); }
+
+  // The current attributes with the inherited opacity of any folded
+  // layers applied.
+  DlPaint EffectivePaint() const {
+    DlScalar opacity = this->opacity();
+    if (opacity >= 1.0f) {
+      return paint_;
+    }
+    DlPaint paint = paint_;
+    DlColor color = paint.getColor();
+    paint.setColor(color.withAlphaF(color.getAlphaF() * opacity));
+    return paint;
+  }
+
+  // A paint carrying only the inherited opacity, for ops that do not
+  // render with the current attributes.
+  std::optional<DlPaint> OpacityPaint() const {
+    DlScalar opacity = this->opacity();
+    if (opacity >= 1.0f) {
+      return std::nullopt;
+    }
+    return DlPaint(DlColor::kBlack().withAlphaF(opacity));
+  }
+
+  std::optional<DlPaint> ImagePaint(bool render_with_attributes) const {
+    return render_with_attributes ? EffectivePaint() : OpacityPaint();
+  }
+
+  // A run of opaque non-antialiased fills produces the same pixels whether
+  // the rects are drawn one at a time or as the triangles of one mesh
+  // since any pixels covered twice are simply overwritten with the same
+  // color.
+  static bool CanBatchRect(const DlPaint& paint) {
+    return paint.getDrawStyle() == DlDrawStyle::kFill &&
+           !paint.isAntiAlias() && paint.getColor().isOpaque() &&
+           paint.getBlendMode() == DlBlendMode::kSrcOver &&
+           !paint.isInvertColors() && !paint.getColorSourcePtr() &&
+           !paint.getColorFilterPtr() && !paint.getMaskFilterPtr() &&
+           !paint.getImageFilterPtr();
+  }
+
+  // A drawAtlas sprite can only express a uniform scale of its source
+  // rect and does not clip the source rect to the image bounds or apply
+  // per-draw filters. Blending, color filters and color inversion are
+  // applied to the atlas as a whole rather than to each sprite in turn,
+  // so overlapping sprites only render the same with plain srcOver.
+  static bool CanBatchImageRect(const sk_sp<DlImage>& image,
+                                const DlRect& src,
+                                const DlRect& dst,
+                                DlSrcRectConstraint constraint,
+                                const std::optional<DlPaint>& paint) {
+    if (!image || constraint != DlSrcRectConstraint::kFast ||
+        src.IsEmpty() || dst.IsEmpty() ||
+        !DlRect::MakeSize(image->GetSize()).Contains(src)) {
+      return false;
+    }
+    if (paint.has_value() &&
+        (paint->isAntiAlias() ||
+         paint->getBlendMode() != DlBlendMode::kSrcOver ||
+         paint->isInvertColors() || paint->getColorSourcePtr() ||
+         paint->getColorFilterPtr() || paint->getMaskFilterPtr() ||
+         paint->getImageFilterPtr())) {
+      return false;
+    }
+    DlScalar scale_x = dst.GetWidth() / src.GetWidth();
+    DlScalar scale_y = dst.GetHeight() / src.GetHeight();
+    return impeller::ScalarNearlyEqual(scale_x, scale_y);
+  }
+
+  DisplayListBuilder& builder_;
+  OpAction action_ = OpAction::kEmit;
+  std::vector<DlScalar> opacity_stack_ = {1.0f};
+  Batch batch_;
+};
+
+}  // namespace
+
+sk_sp<DisplayList> DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list) {
+  if (!display_list || display_list->GetRecordCount() == 0u) {
+    return display_list;
+  }
+
+  std::vector<OpAction> actions = OptimizationPlanner().Plan(*display_list);
+
+  DisplayListBuilder builder(display_list->has_rtree());
+  OptimizingReceiver receiver(builder);
+  for (DlIndex i = 0u; i < actions.size(); i++) {
+    if (actions[i] == OpAction::kSkip) {
+      continue;
+    }
+    receiver.set_action(actions[i]);
+    display_list->Dispatch(receiver, i);
+  }
+  receiver.FlushBatch();
+  return builder.Build();
+}
+
+}  // namespace flutter
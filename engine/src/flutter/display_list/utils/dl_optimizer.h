@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_OPTIMIZER_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_OPTIMIZER_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+/// @brief  An optional post-build pass that rewrites a |DisplayList| into
+///         an equivalent one that is cheaper to dispatch and render.
+///
+/// The |DisplayListBuilder| records most operations verbatim. This pass
+/// replays a finished |DisplayList| into a new builder while applying the
+/// following rewrites, each of which produces the same pixels as the
+/// original list:
+///
+///   - transforms and clips that are not followed by any rendering before
+///     the enclosing restore are dropped, along with any save/restore pair
+///     or empty saveLayer/restore pair that then has nothing left to do.
+///   - saveLayers that the builder marked as able to distribute their
+///     opacity to their children, and whose attributes consist of nothing
+///     but an alpha, are replaced by a save and the alpha is folded into
+///     the paint of each child. This mirrors the opacity peephole that the
+///     |DlSkCanvasDispatcher| applies at dispatch time, but makes it
+///     available to every backend.
+///   - runs of adjacent drawImageRect calls that sample the same image with
+///     the same attributes and a uniform scale are merged into a single
+///     drawAtlas call.
+///   - runs of adjacent non-antialiased opaque fills of rectangles with the
+///     same attributes are merged into a single drawVertices call.
+///
+/// Nested display lists are passed through unmodified.
+class DisplayListOptimizer {
+ public:
+  /// The minimum number of adjacent compatible draws that will be merged
+  /// into a single batched operation.
+  static constexpr int kMinBatchCount = 2;
+
+  /// Returns an optimized copy of |display_list|, or |display_list|
+  /// itself if it is null or empty.
+  static sk_sp<DisplayList> Optimize(const sk_sp<DisplayList>& display_list);
+
+ private:
+  DisplayListOptimizer() = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_OPTIMIZER_H_
@@ -0,0 +1,258 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_optimizer.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::vector<DisplayListOpType> OpTypes(const sk_sp<DisplayList>& dl) {
+  std::vector<DisplayListOpType> types;
+  for (DlIndex i : *dl) {
+    types.push_back(dl->GetOpType(i));
+  }
+  return types;
+}
+
+int CountCategory(const sk_sp<DisplayList>& dl,
+                  DisplayListOpCategory category) {
+  int count = 0;
+  for (DlIndex i : *dl) {
+    if (dl->GetOpCategory(i) == category) {
+      count++;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(DisplayListOptimizer, NullAndEmptyListsArePassedThrough) {
+  EXPECT_EQ(DisplayListOptimizer::Optimize(nullptr), nullptr);
+
+  auto empty = DisplayListBuilder().Build();
+  EXPECT_EQ(DisplayListOptimizer::Optimize(empty), empty);
+}
+
+TEST(DisplayListOptimizer, SaveRestoreWithoutRenderingIsRemoved) {
+  DisplayListBuilder builder;
+  builder.Save();
+  builder.Translate(10, 10);
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 50, 50));
+  builder.Restore();
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto dl = builder.Build();
+  ASSERT_EQ(dl->op_count(), 5u);
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(OpTypes(optimized),
+            std::vector<DisplayListOpType>{DisplayListOpType::kDrawRect});
+  EXPECT_EQ(optimized->GetBounds(), dl->GetBounds());
+}
+
+TEST(DisplayListOptimizer, TransformsAfterTheLastDrawAreRemoved) {
+  DisplayListBuilder builder;
+  builder.Save();
+  builder.Translate(10, 10);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  builder.Scale(2, 2);
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 50, 50));
+  builder.Restore();
+  builder.Rotate(45);
+  auto dl = builder.Build();
+  ASSERT_EQ(dl->op_count(), 7u);
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(OpTypes(optimized), (std::vector<DisplayListOpType>{
+                                    DisplayListOpType::kSave,
+                                    DisplayListOpType::kTranslate,
+                                    DisplayListOpType::kDrawRect,
+                                    DisplayListOpType::kRestore,
+                                }));
+}
+
+TEST(DisplayListOptimizer, EmptySaveLayerIsRemoved) {
+  DisplayListBuilder builder;
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.Translate(10, 10);
+  builder.Restore();
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSaveLayer), 0);
+  EXPECT_EQ(optimized->op_count(), 1u);
+}
+
+TEST(DisplayListOptimizer, EmptySaveLayerThatFloodsIsKept) {
+  DisplayListBuilder builder;
+  DlPaint paint = DlPaint().setColorFilter(
+      DlColorFilter::MakeBlend(DlColor::kRed(), DlBlendMode::kSrc));
+  builder.SaveLayer(std::nullopt, &paint);
+  builder.Restore();
+  auto dl = builder.Build();
+  ASSERT_EQ(CountCategory(dl, DisplayListOpCategory::kSaveLayer), 1);
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSaveLayer), 1);
+}
+
+TEST(DisplayListOptimizer, OpacitySaveLayerIsFoldedIntoChildren) {
+  DisplayListBuilder builder;
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(std::nullopt, &layer_paint);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20),
+                   DlPaint(DlColor::kRed()));
+  builder.DrawOval(DlRect::MakeLTRB(30, 30, 40, 40),
+                   DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  auto dl = builder.Build();
+  ASSERT_EQ(CountCategory(dl, DisplayListOpCategory::kSaveLayer), 1);
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSaveLayer), 0);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSave), 0);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kRendering), 2);
+  EXPECT_EQ(optimized->GetBounds(), dl->GetBounds());
+}
+
+TEST(DisplayListOptimizer, OverlappingChildrenKeepTheirSaveLayer) {
+  DisplayListBuilder builder;
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(std::nullopt, &layer_paint);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 30, 30),
+                   DlPaint(DlColor::kRed()));
+  builder.DrawRect(DlRect::MakeLTRB(20, 20, 40, 40),
+                   DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSaveLayer), 1);
+}
+
+TEST(DisplayListOptimizer, FilteredSaveLayerIsNotFolded) {
+  DisplayListBuilder builder;
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f).setColorFilter(
+      DlColorFilter::MakeBlend(DlColor::kRed(), DlBlendMode::kSrcATop));
+  builder.SaveLayer(std::nullopt, &layer_paint);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20),
+                   DlPaint(DlColor::kRed()));
+  builder.Restore();
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kSaveLayer), 1);
+}
+
+TEST(DisplayListOptimizer, AdjacentImageRectsMergeIntoAtlas) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 4; i++) {
+    builder.DrawImageRect(kTestImage1, DlRect::MakeXYWH(i * 10, 0, 10, 10),
+                          DlRect::MakeXYWH(i * 25, 50, 20, 20),
+                          DlImageSampling::kNearestNeighbor);
+  }
+  auto dl = builder.Build();
+  ASSERT_EQ(dl->op_count(), 4u);
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(OpTypes(optimized),
+            std::vector<DisplayListOpType>{DisplayListOpType::kDrawAtlas});
+  EXPECT_EQ(optimized->GetBounds(), dl->GetBounds());
+}
+
+TEST(DisplayListOptimizer, NonUniformImageRectsAreNotMerged) {
+  DisplayListBuilder builder;
+  builder.DrawImageRect(kTestImage1, DlRect::MakeXYWH(0, 0, 10, 10),
+                        DlRect::MakeXYWH(0, 0, 20, 10),
+                        DlImageSampling::kNearestNeighbor);
+  builder.DrawImageRect(kTestImage1, DlRect::MakeXYWH(10, 0, 10, 10),
+                        DlRect::MakeXYWH(30, 0, 20, 10),
+                        DlImageSampling::kNearestNeighbor);
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(OpTypes(optimized), (std::vector<DisplayListOpType>{
+                                    DisplayListOpType::kDrawImageRect,
+                                    DisplayListOpType::kDrawImageRect,
+                                }));
+}
+
+TEST(DisplayListOptimizer, ImageRectsWithDifferentImagesAreNotMerged) {
+  DisplayListBuilder builder;
+  builder.DrawImageRect(kTestImage1, DlRect::MakeXYWH(0, 0, 10, 10),
+                        DlRect::MakeXYWH(0, 0, 10, 10),
+                        DlImageSampling::kNearestNeighbor);
+  builder.DrawImageRect(kTestImage2, DlRect::MakeXYWH(0, 0, 10, 10),
+                        DlRect::MakeXYWH(20, 0, 10, 10),
+                        DlImageSampling::kNearestNeighbor);
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kRendering), 2);
+}
+
+TEST(DisplayListOptimizer, ImageRectsWithPerDrawBlendingAreNotMerged) {
+  auto color_filter =
+      DlColorFilter::MakeBlend(DlColor::kRed(), DlBlendMode::kSrcATop);
+  std::vector<DlPaint> paints = {
+      DlPaint().setBlendMode(DlBlendMode::kMultiply),
+      DlPaint().setColorFilter(color_filter),
+      DlPaint().setInvertColors(true),
+  };
+  for (const DlPaint& paint : paints) {
+    DisplayListBuilder builder;
+    for (int i = 0; i < 3; i++) {
+      builder.DrawImageRect(kTestImage1, DlRect::MakeXYWH(0, 0, 10, 10),
+                            DlRect::MakeXYWH(i * 5, 0, 10, 10),
+                            DlImageSampling::kNearestNeighbor, &paint);
+    }
+    auto dl = builder.Build();
+
+    auto optimized = DisplayListOptimizer::Optimize(dl);
+    EXPECT_EQ(OpTypes(optimized), (std::vector<DisplayListOpType>{
+                                      DisplayListOpType::kDrawImageRect,
+                                      DisplayListOpType::kDrawImageRect,
+                                      DisplayListOpType::kDrawImageRect,
+                                  }));
+  }
+}
+
+TEST(DisplayListOptimizer, AdjacentOpaqueRectsMergeIntoVertices) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kGreen());
+  for (int i = 0; i < 5; i++) {
+    builder.DrawRect(DlRect::MakeXYWH(i * 12, 0, 10, 10), paint);
+  }
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kRendering), 1);
+  EXPECT_EQ(OpTypes(optimized).back(), DisplayListOpType::kDrawVertices);
+  EXPECT_EQ(optimized->GetBounds(), dl->GetBounds());
+}
+
+TEST(DisplayListOptimizer, TranslucentOrAntiAliasedRectsAreNotMerged) {
+  DisplayListBuilder builder;
+  DlPaint translucent(DlColor::kGreen().withAlpha(0x80));
+  builder.DrawRect(DlRect::MakeXYWH(0, 0, 10, 10), translucent);
+  builder.DrawRect(DlRect::MakeXYWH(5, 5, 10, 10), translucent);
+  DlPaint aa = DlPaint(DlColor::kGreen()).setAntiAlias(true);
+  builder.DrawRect(DlRect::MakeXYWH(20, 0, 10, 10), aa);
+  builder.DrawRect(DlRect::MakeXYWH(25, 5, 10, 10), aa);
+  auto dl = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_EQ(CountCategory(optimized, DisplayListOpCategory::kRendering), 4);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -16,10 +16,12 @@ std::optional<DlRect> FrameDamage::ComputeClipRect(
     bool impeller_enabled) {
   if (layer_tree.root_layer()) {
     PaintRegionMap empty_paint_region_map;
+    layer_tree.retained_layers().clear();
     DiffContext context(layer_tree.frame_size(), layer_tree.paint_region_map(),
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
-                        has_raster_cache, impeller_enabled);
+                        has_raster_cache, impeller_enabled,
+                        &layer_tree.retained_layers());
     context.PushCullRect(DlRect::MakeSize(layer_tree.frame_size()));
     {
       DiffContext::AutoSubtreeRestore subtree(&context);
@@ -80,6 +80,12 @@ class FrameDamage {
     return damage_ ? std::make_optional(damage_->frame_damage) : std::nullopt;
   }
 
+  // See Damage::readback_damage.
+  std::optional<DlIRect> GetReadbackDamage() const {
+    return damage_ ? std::make_optional(damage_->readback_damage)
+                   : std::nullopt;
+  }
+
   // See Damage::buffer_damage.
   std::optional<DlIRect> GetBufferDamage() {
     return (damage_ && !ignore_damage_)
@@ -13,13 +13,15 @@ DiffContext::DiffContext(DlISize frame_size,
                          PaintRegionMap& this_frame_paint_region_map,
                          const PaintRegionMap& last_frame_paint_region_map,
                          bool has_raster_cache,
-                         bool impeller_enabled)
+                         bool impeller_enabled,
+                         RetainedLayerSet* retained_layers)
     : rects_(std::make_shared<std::vector<DlRect>>()),
       frame_size_(frame_size),
       this_frame_paint_region_map_(this_frame_paint_region_map),
       last_frame_paint_region_map_(last_frame_paint_region_map),
       has_raster_cache_(has_raster_cache),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      retained_layers_(retained_layers) {}
 
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
@@ -126,6 +128,8 @@ Damage DiffContext::ComputeDamage(const DlIRect& accumulated_buffer_damage,
       DlIRect::RoundOut(buffer_damage).IntersectionOrEmpty(frame_clip);
   res.frame_damage =
       DlIRect::RoundOut(frame_damage).IntersectionOrEmpty(frame_clip);
+  res.readback_damage =
+      DlIRect::RoundOut(readback_damage_).IntersectionOrEmpty(frame_clip);
 
   if (horizontal_clip_alignment > 1 || vertical_clip_alignment > 1) {
     AlignRect(res.buffer_damage, horizontal_clip_alignment,
@@ -210,6 +214,24 @@ void DiffContext::AddExistingPaintRegion(const PaintRegion& region) {
 
 void DiffContext::AddReadbackRegion(const DlIRect& paint_rect,
                                     const DlIRect& readback_rect) {
+  // Everything diffed so far is painted before this region is read back.
+  // Earlier readbacks that are damaged repaint their whole paint rect, which
+  // may in turn be read back here.
+  DlRect damage(damage_);
+  for (const auto& r : readbacks_) {
+    DlRect earlier_paint_rect = DlRect::Make(r.paint_rect);
+    DlRect earlier_readback_rect = DlRect::Make(r.readback_rect);
+    if (earlier_paint_rect.IntersectsWithRect(damage) ||
+        earlier_readback_rect.IntersectsWithRect(damage)) {
+      damage = damage.Union(earlier_readback_rect).Union(earlier_paint_rect);
+    }
+  }
+  std::optional<DlRect> damage_under_readback =
+      DlRect::Make(readback_rect).Intersection(damage);
+  if (damage_under_readback.has_value()) {
+    readback_damage_ = readback_damage_.Union(damage_under_readback.value());
+  }
+
   Readback readback;
   readback.paint_rect = paint_rect;
   readback.readback_rect = readback_rect;
@@ -254,6 +276,12 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   }
 }
 
+void DiffContext::MarkLayerRetained(const Layer* layer) {
+  if (retained_layers_) {
+    retained_layers_->insert(layer->unique_id());
+  }
+}
+
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
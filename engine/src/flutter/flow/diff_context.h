@@ -8,6 +8,7 @@
 #include <functional>
 #include <map>
 #include <optional>
+#include <unordered_set>
 #include <vector>
 #include "display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/paint_region.h"
@@ -32,11 +33,23 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   DlIRect buffer_damage;
+
+  // The part of frame_damage that lies inside a readback region and was
+  // painted before that region was read back (i.e. underneath a backdrop
+  // filter). A backdrop filter whose readback region does not intersect this
+  // rect samples the same pixels as in the previous frame, so its result
+  // may be reused. Damage painted on top of a backdrop filter is not
+  // included.
+  DlIRect readback_damage;
 };
 
 // Layer Unique Id to PaintRegion
 using PaintRegionMap = std::map<uint64_t, PaintRegion>;
 
+// Unique Ids of retained layers whose subtrees render identically to the
+// previous frame
+using RetainedLayerSet = std::unordered_set<uint64_t>;
+
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
  public:
@@ -44,7 +57,8 @@ class DiffContext {
                        PaintRegionMap& this_frame_paint_region_map,
                        const PaintRegionMap& last_frame_paint_region_map,
                        bool has_raster_cache,
-                       bool impeller_enabled);
+                       bool impeller_enabled,
+                       RetainedLayerSet* retained_layers = nullptr);
 
   // Starts a new subtree.
   void BeginSubtree();
@@ -123,6 +137,9 @@ class DiffContext {
   //              coordinates)
   // readback_rect - rectangle where the filter samples from (in screen
   //                 coordinates)
+  //
+  // Any damage accumulated so far that intersects readback_rect is recorded
+  // as readback damage, see Damage::readback_damage.
   void AddReadbackRegion(const DlIRect& paint_rect,
                          const DlIRect& readback_rect);
 
@@ -157,6 +174,12 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Records that the specified retained layer was not diffed because its
+  // subtree will render identically to previous frame. Layers recorded here
+  // may reuse the results of their previous Preroll, see
+  // Layer::PrerollUnlessRetained.
+  void MarkLayerRetained(const Layer* layer);
+
   // Whether or not a raster cache is being used. If so, we must snap
   // all transformations to physical pixels if the layer may be raster
   // cached.
@@ -243,11 +266,13 @@ class DiffContext {
   DlRect ApplyFilterBoundsAdjustment(DlRect rect) const;
 
   DlRect damage_;
+  DlRect readback_damage_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
   bool has_raster_cache_;
   bool impeller_enabled_;
+  RetainedLayerSet* retained_layers_;
 
   void AddDamage(const DlRect& rect);
 
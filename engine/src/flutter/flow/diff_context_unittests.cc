@@ -69,5 +69,29 @@ TEST_F(DiffContextTest, DisjointDamage) {
   EXPECT_EQ(damage.buffer_damage, DlIRect());
 }
 
+TEST_F(DiffContextTest, RecordsRetainedLayers) {
+  auto retained = CreateContainerLayer(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(0, 0, 50, 50))));
+  auto changed = CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(100, 100, 150, 150)));
+
+  MockLayerTree t1;
+  t1.root()->Add(retained);
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(DlRect::MakeLTRB(200, 200, 250, 250))));
+  DiffLayerTree(t1, MockLayerTree());
+
+  MockLayerTree t2;
+  t2.root()->Add(retained);
+  t2.root()->Add(changed);
+
+  RetainedLayerSet retained_layers;
+  DiffContext dc(t2.size(), t2.paint_region_map(), t1.paint_region_map(), true,
+                 false, &retained_layers);
+  t2.root()->Diff(&dc, t1.root());
+
+  EXPECT_EQ(retained_layers, RetainedLayerSet{retained->unique_id()});
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -495,6 +495,59 @@ TEST_F(BackdropLayerDiffTest, ReadbackOutsideOfPaintArea) {
   EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(60 - 50, 60 - 50, 80, 80));
 }
 
+TEST_F(BackdropLayerDiffTest, ReadbackDamageOnlyIncludesContentBelow) {
+  auto filter = DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp);
+  auto background =
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100));
+  auto clip = std::make_shared<ClipRectLayer>(DlRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::kHardEdge);
+  clip->Add(
+      std::make_shared<BackdropFilterLayer>(filter, DlBlendMode::kSrcOver));
+
+  MockLayerTree l1(DlISize(100, 100));
+  l1.root()->Add(background);
+  l1.root()->Add(clip);
+  // Without a previous frame the whole readback region is damaged.
+  auto damage = DiffLayerTree(l1, MockLayerTree(DlISize(100, 100)));
+  EXPECT_EQ(damage.readback_damage, DlIRect::MakeLTRB(0, 0, 90, 90));
+
+  // Changes painted on top of the backdrop filter don't change what it reads.
+  MockLayerTree l2(DlISize(100, 100));
+  l2.root()->Add(background);
+  l2.root()->Add(clip);
+  l2.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(30, 30, 40, 40)));
+  damage = DiffLayerTree(l2, l1);
+  EXPECT_FALSE(damage.frame_damage.IsEmpty());
+  EXPECT_TRUE(damage.readback_damage.IsEmpty());
+
+  // Changes painted underneath the backdrop filter are read back.
+  MockLayerTree l3(DlISize(100, 100));
+  l3.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 100, 100)));
+  l3.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(80, 80, 85, 85)));
+  l3.root()->Add(clip);
+  damage = DiffLayerTree(l3, l2);
+  EXPECT_EQ(damage.readback_damage, DlIRect::MakeLTRB(0, 0, 90, 90));
+
+  // Changes underneath the backdrop filter but outside of the readback
+  // region are not read back.
+  MockLayerTree l4(DlISize(100, 100));
+  l4.root()->Add(background);
+  l4.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(92, 92, 98, 98)));
+  l4.root()->Add(clip);
+  MockLayerTree l5(DlISize(100, 100));
+  l5.root()->Add(background);
+  l5.root()->Add(
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(94, 94, 98, 98)));
+  l5.root()->Add(clip);
+  DiffLayerTree(l4, MockLayerTree(DlISize(100, 100)));
+  damage = DiffLayerTree(l5, l4);
+  EXPECT_TRUE(damage.readback_damage.IsEmpty());
+}
+
 TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   auto filter = DlImageFilter::MakeBlur(10, 10, DlTileMode::kClamp);
 
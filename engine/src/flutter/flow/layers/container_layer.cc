@@ -91,6 +91,10 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+
+        // For the same reason the retained subtree does not need to be
+        // prerolled again, as long as nothing else about the frame changed
+        context->MarkLayerRetained(layer.get());
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -141,7 +145,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    layer->PrerollUnlessRetained(context);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (child_paint_bounds->IntersectsWithRect(layer->paint_bounds())) {
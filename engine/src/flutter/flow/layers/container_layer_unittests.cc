@@ -549,6 +549,70 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, RetainedChildReusesPreroll) {
+  const DlRect child_path_bounds = DlRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer =
+      MockLayer::MakeOpacityCompatible(DlPath::MakeRect(child_path_bounds));
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  RetainedLayerSet retained_layers = {retained->unique_id()};
+  preroll_context()->retained_layers = &retained_layers;
+
+  // The first Preroll has nothing to reuse.
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+
+  // Changing the cull rect does not affect the paint bounds of a retained
+  // subtree, so it is not visited again.
+  const DlRect cull_rect = DlRect::MakeLTRB(0, 0, 100, 100);
+  preroll_context()->state_stack.set_preroll_delegate(cull_rect, DlMatrix());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+  EXPECT_EQ(retained->paint_bounds(), child_path_bounds);
+  EXPECT_EQ(layer->paint_bounds(), child_path_bounds);
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  // A different transform may change the Preroll results.
+  const DlMatrix matrix = DlMatrix::MakeTranslation({10, 10});
+  preroll_context()->state_stack.set_preroll_delegate(cull_rect, matrix);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), matrix);
+
+  // Layers that are not retained are always visited.
+  retained_layers.clear();
+  preroll_context()->state_stack.set_preroll_delegate(
+      DlRect::MakeLTRB(0, 0, 200, 200), matrix);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_cull_rect(),
+            DlRect::MakeLTRB(-10, -10, 190, 190));
+}
+
+TEST_F(ContainerLayerTest, RetainedChildWithPlatformViewIsPrerolled) {
+  auto mock_layer = MockLayer::Make(DlPath::MakeRect(DlRect::MakeWH(10, 10)));
+  mock_layer->set_fake_has_platform_view(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  RetainedLayerSet retained_layers = {retained->unique_id()};
+  preroll_context()->retained_layers = &retained_layers;
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(layer->subtree_has_platform_view());
+
+  // Platform views must be reported to the embedder every frame.
+  const DlRect cull_rect = DlRect::MakeLTRB(0, 0, 100, 100);
+  preroll_context()->state_stack.set_preroll_delegate(cull_rect, DlMatrix());
+  preroll_context()->has_platform_view = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_cull_rect(), cull_rect);
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -21,6 +21,53 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+bool Layer::CanReusePreroll(const PrerollContext* context,
+                            const DlMatrix& matrix) const {
+  if (!preroll_is_reusable_ || !context->retained_layers) {
+    return false;
+  }
+  // Clip layers report their clips to the platform views visited so far in
+  // the frame, so the whole tree is prerolled when there is an embedder.
+  if (context->view_embedder) {
+    return false;
+  }
+#if !SLIMPELLER
+  // A subtree that was prerolled without a raster cache might contain
+  // candidates for caching that were never registered.
+  if (context->raster_cache && !preroll_had_raster_cache_) {
+    return false;
+  }
+#endif  //  !SLIMPELLER
+  return preroll_matrix_ == matrix &&
+         context->retained_layers->find(unique_id_) !=
+             context->retained_layers->end();
+}
+
+void Layer::PrerollUnlessRetained(PrerollContext* context) {
+  const DlMatrix matrix = context->state_stack.matrix();
+  if (CanReusePreroll(context, matrix)) {
+    context->renderable_state_flags = preroll_renderable_state_flags_;
+    return;
+  }
+
+  const size_t raster_cache_item_count =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  Preroll(context);
+
+  preroll_matrix_ = matrix;
+  preroll_renderable_state_flags_ = context->renderable_state_flags;
+  preroll_is_reusable_ =
+      !context->has_platform_view && !context->has_texture_layer &&
+      !context->surface_needs_readback &&
+      raster_cache_item_count == (context->raster_cached_entries
+                                      ? context->raster_cached_entries->size()
+                                      : 0);
+#if !SLIMPELLER
+  preroll_had_raster_cache_ = context->raster_cache != nullptr;
+#endif  //  !SLIMPELLER
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
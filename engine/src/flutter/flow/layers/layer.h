@@ -73,6 +73,10 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // The layers that the DiffContext found to be retained unchanged from the
+  // previous frame, or nullptr if the layer tree was not diffed.
+  const RetainedLayerSet* retained_layers = nullptr;
 };
 
 struct PaintContext {
@@ -154,6 +158,16 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls Preroll unless this layer is retained unchanged from the previous
+  // frame (see |PrerollContext::retained_layers|) and its previous Preroll
+  // can be reused. That is the case when it was performed under the same
+  // transform and had no effect outside of this layer other than its paint
+  // bounds and renderable state flags, i.e. its subtree contains no
+  // platform views, texture layers, readback or raster cache candidates.
+  // The results of the previous Preroll are then left in place and the
+  // renderable state flags are restored into the context.
+  void PrerollUnlessRetained(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -257,6 +271,16 @@ class Layer {
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
 
+  // The conditions and results of the last Preroll performed through
+  // |PrerollUnlessRetained|.
+  DlMatrix preroll_matrix_;
+  int preroll_renderable_state_flags_ = 0;
+  bool preroll_is_reusable_ = false;
+  NOT_SLIMPELLER(bool preroll_had_raster_cache_ = false);
+
+  bool CanReusePreroll(const PrerollContext* context,
+                       const DlMatrix& matrix) const;
+
   static uint64_t NextUniqueID();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
@@ -56,10 +56,15 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time = frame.context().ui_time(),
       .texture_registry = frame.context().texture_registry(),
       .raster_cached_entries = &raster_cache_items_,
+      .retained_layers = &retained_layers_,
   };
 
   root_layer_->Preroll(&context);
 
+  // The retained layers are only valid relative to the frame that was
+  // diffed, so they must be recomputed before the next Preroll.
+  retained_layers_.clear();
+
   return context.surface_needs_readback;
 }
 
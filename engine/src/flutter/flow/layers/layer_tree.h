@@ -56,11 +56,17 @@ class LayerTree {
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  // The layers of this tree that were found to be retained unchanged when
+  // the tree was diffed against the previous frame.
+  const RetainedLayerSet& retained_layers() const { return retained_layers_; }
+  RetainedLayerSet& retained_layers() { return retained_layers_; }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   DlISize frame_size_;  // Physical pixels.
 
   PaintRegionMap paint_region_map_;
+  RetainedLayerSet retained_layers_;
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
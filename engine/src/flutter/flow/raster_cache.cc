@@ -226,6 +226,7 @@ void RasterCache::EvictUnusedCacheEntries() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.eviction_count++;
       metrics.eviction_bytes += it->second.image->image_bytes();
+      memory_usage_.Subtract(it->second.image->image_bytes());
     }
     cache_.erase(it);
   }
@@ -233,6 +234,8 @@ void RasterCache::EvictUnusedCacheEntries() {
 
 void RasterCache::EndFrame() {
   UpdateMetrics();
+  memory_usage_.Set(layer_metrics_.total_bytes() +
+                    picture_metrics_.total_bytes());
   TraceStatsToTimeline();
 }
 
@@ -240,6 +243,7 @@ void RasterCache::Clear() {
   cache_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
+  memory_usage_.Set(0u);
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
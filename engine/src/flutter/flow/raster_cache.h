@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -266,6 +267,7 @@ class RasterCache {
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  fml::MemoryUsageCounter memory_usage_{fml::MemoryCategory::kRasterCache};
 
   void TraceStatsToTimeline() const;
 
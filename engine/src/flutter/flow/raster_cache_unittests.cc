@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -26,6 +27,14 @@
 namespace flutter {
 namespace testing {
 
+namespace {
+
+size_t RasterCacheMemoryUsage() {
+  return fml::GetMemoryUsage().GetBytes(fml::MemoryCategory::kRasterCache);
+}
+
+}  // namespace
+
 TEST(RasterCache, SimpleInitialization) {
   flutter::RasterCache cache;
   ASSERT_TRUE(true);
@@ -286,11 +295,15 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
   ASSERT_EQ(cache.picture_metrics().total_count(), 2u);
   ASSERT_EQ(cache.picture_metrics().total_bytes(), 51248u);
+  ASSERT_EQ(RasterCacheMemoryUsage(), 51248u);
 
   cache.BeginFrame();
+  // Starting a frame doesn't release any cached images.
+  ASSERT_EQ(RasterCacheMemoryUsage(), 51248u);
   RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
   cache.EvictUnusedCacheEntries();
   ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(RasterCacheMemoryUsage(), 25624u);
   ASSERT_TRUE(
       RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
   ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
@@ -304,6 +317,7 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.BeginFrame();
   cache.EvictUnusedCacheEntries();
   ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(RasterCacheMemoryUsage(), 0u);
   cache.EndFrame();
 
   ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
@@ -21,7 +21,8 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            const SubmitCallback& submit_callback,
                            DlISize frame_size,
                            std::unique_ptr<GLContextResult> context_result,
-                           bool display_list_fallback)
+                           bool display_list_fallback,
+                           bool prepare_rtree)
     : surface_(std::move(surface)),
       framebuffer_info_(framebuffer_info),
       encode_callback_(encode_callback),
@@ -43,8 +44,10 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
     // further culling during `DisplayList::Dispatch`. Further, this canvas
     // will live underneath any platform views so we do not need to compute
     // exact coverage to describe "pixel ownership" to the platform.
+    // Surfaces that render the frame in tiles can still ask for an rtree
+    // so that each tile only dispatches the ops that touch it.
     dl_builder_ = sk_make_sp<DisplayListBuilder>(DlRect::MakeSize(frame_size),
-                                                 /*prepare_rtree=*/false);
+                                                 prepare_rtree);
     canvas_ = dl_builder_.get();
   }
 }
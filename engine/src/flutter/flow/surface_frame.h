@@ -66,7 +66,8 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                DlISize frame_size,
                std::unique_ptr<GLContextResult> context_result = nullptr,
-               bool display_list_fallback = false);
+               bool display_list_fallback = false,
+               bool prepare_rtree = false);
 
   struct SubmitInfo {
     // The frame damage for frame n is the difference between frame n and
@@ -82,6 +83,11 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<DlIRect> buffer_damage;
 
+    // The part of the frame damage that is read back by backdrop filters,
+    // see Damage::readback_damage. Backdrop filters that read outside of this
+    // area see the same content as in the previous frame.
+    std::optional<DlIRect> readback_damage;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
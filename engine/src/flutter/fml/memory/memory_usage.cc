@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_usage.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+std::atomic<size_t> gCategoryBytes[kMemoryCategoryCount];
+
+std::atomic<size_t>& CategoryBytes(MemoryCategory category) {
+  return gCategoryBytes[static_cast<size_t>(category)];
+}
+
+}  // namespace
+
+const char* MemoryCategoryToString(MemoryCategory category) {
+  switch (category) {
+    case MemoryCategory::kRasterCache:
+      return "RasterCache";
+    case MemoryCategory::kRenderTargetCache:
+      return "RenderTargetCache";
+    case MemoryCategory::kGlyphAtlas:
+      return "GlyphAtlas";
+    case MemoryCategory::kHostBuffer:
+      return "HostBuffer";
+    case MemoryCategory::kDecodedImages:
+      return "DecodedImages";
+    case MemoryCategory::kDeviceAllocator:
+      return "DeviceAllocator";
+  }
+  FML_UNREACHABLE();
+}
+
+MemoryUsage GetMemoryUsage() {
+  MemoryUsage usage;
+  for (size_t i = 0; i < kMemoryCategoryCount; i++) {
+    usage.bytes[i] = gCategoryBytes[i].load(std::memory_order_relaxed);
+  }
+  return usage;
+}
+
+void TraceMemoryUsage() {
+#if !FLUTTER_RELEASE
+  constexpr double kMegaByteSizeInBytes = (1 << 20);
+  MemoryUsage usage = GetMemoryUsage();
+  auto megabytes = [&usage](MemoryCategory category) {
+    return usage.GetBytes(category) / kMegaByteSizeInBytes;
+  };
+  FML_TRACE_COUNTER(
+      "flutter", "MemoryUsage", /*counter_id=*/0,                            //
+      "RasterCacheMB", megabytes(MemoryCategory::kRasterCache),              //
+      "RenderTargetCacheMB", megabytes(MemoryCategory::kRenderTargetCache),  //
+      "GlyphAtlasMB", megabytes(MemoryCategory::kGlyphAtlas),                //
+      "HostBufferMB", megabytes(MemoryCategory::kHostBuffer),                //
+      "DecodedImagesMB", megabytes(MemoryCategory::kDecodedImages),          //
+      "DeviceAllocatorMB", megabytes(MemoryCategory::kDeviceAllocator));
+#endif  // !FLUTTER_RELEASE
+}
+
+MemoryUsageCounter::MemoryUsageCounter(MemoryCategory category)
+    : category_(category) {}
+
+MemoryUsageCounter::~MemoryUsageCounter() {
+  Set(0u);
+}
+
+void MemoryUsageCounter::Set(size_t bytes) {
+  size_t previous = bytes_.exchange(bytes, std::memory_order_relaxed);
+  if (bytes >= previous) {
+    CategoryBytes(category_).fetch_add(bytes - previous,
+                                       std::memory_order_relaxed);
+  } else {
+    CategoryBytes(category_).fetch_sub(previous - bytes,
+                                       std::memory_order_relaxed);
+  }
+}
+
+void MemoryUsageCounter::Add(size_t bytes) {
+  bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  CategoryBytes(category_).fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryUsageCounter::Subtract(size_t bytes) {
+  bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  CategoryBytes(category_).fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+}  // namespace fml
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Process-wide accounting of the memory held by the caches and allocators of
+// the engine.
+//
+// Every cache or allocator owns a |MemoryUsageCounter| for its category and
+// keeps it up to date as it grows and shrinks. The counters of a category are
+// summed as they change, so taking a snapshot of the usage of the process is
+// cheap enough to do every frame and safe to do from any thread.
+
+#ifndef FLUTTER_FML_MEMORY_MEMORY_USAGE_H_
+#define FLUTTER_FML_MEMORY_MEMORY_USAGE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+enum class MemoryCategory {
+  // Layers and pictures rasterized by the |RasterCache|.
+  kRasterCache,
+  // Offscreen textures kept alive across frames by the render target cache.
+  kRenderTargetCache,
+  // Textures of the glyph atlases.
+  kGlyphAtlas,
+  // Device buffers of the per-frame host buffer arenas.
+  kHostBuffer,
+  // Textures of the images decoded for the framework.
+  kDecodedImages,
+  // All device memory allocated by the GPU allocator. This includes the
+  // memory of the other GPU categories that the allocator backs.
+  kDeviceAllocator,
+};
+
+constexpr size_t kMemoryCategoryCount =
+    static_cast<size_t>(MemoryCategory::kDeviceAllocator) + 1;
+
+//------------------------------------------------------------------------------
+/// @brief      The name of a category as it appears in traces and in the
+///             service protocol, e.g. "RasterCache".
+///
+const char* MemoryCategoryToString(MemoryCategory category);
+
+//------------------------------------------------------------------------------
+/// @brief      The bytes held in each category at some point in time.
+///
+struct MemoryUsage {
+  std::array<size_t, kMemoryCategoryCount> bytes = {};
+
+  size_t GetBytes(MemoryCategory category) const {
+    return bytes[static_cast<size_t>(category)];
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The bytes currently held in each category by all of the
+///             counters of the process.
+///
+MemoryUsage GetMemoryUsage();
+
+//------------------------------------------------------------------------------
+/// @brief      Emits the current usage of every category as a trace counter,
+///             in megabytes. Does nothing in release builds.
+///
+void TraceMemoryUsage();
+
+//------------------------------------------------------------------------------
+/// @brief      The bytes held by one cache or allocator. The bytes of the
+///             counter are removed from its category when the counter is
+///             destroyed.
+///
+///             All methods are thread-safe.
+///
+class MemoryUsageCounter {
+ public:
+  explicit MemoryUsageCounter(MemoryCategory category);
+
+  ~MemoryUsageCounter();
+
+  MemoryCategory GetCategory() const { return category_; }
+
+  size_t GetBytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+  void Set(size_t bytes);
+
+  void Add(size_t bytes);
+
+  void Subtract(size_t bytes);
+
+ private:
+  const MemoryCategory category_;
+  std::atomic<size_t> bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryUsageCounter);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_MEMORY_USAGE_H_
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_usage.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+size_t CategoryBytes(MemoryCategory category) {
+  return GetMemoryUsage().GetBytes(category);
+}
+
+TEST(MemoryUsageTest, CountersAreSummedByCategory) {
+  const size_t images = CategoryBytes(MemoryCategory::kDecodedImages);
+  const size_t glyphs = CategoryBytes(MemoryCategory::kGlyphAtlas);
+  {
+    MemoryUsageCounter a(MemoryCategory::kDecodedImages);
+    MemoryUsageCounter b(MemoryCategory::kDecodedImages);
+    MemoryUsageCounter c(MemoryCategory::kGlyphAtlas);
+    a.Set(100);
+    b.Add(30);
+    b.Add(20);
+    c.Set(7);
+    EXPECT_EQ(CategoryBytes(MemoryCategory::kDecodedImages), images + 150);
+    EXPECT_EQ(CategoryBytes(MemoryCategory::kGlyphAtlas), glyphs + 7);
+
+    a.Set(40);
+    b.Subtract(50);
+    EXPECT_EQ(a.GetBytes(), 40u);
+    EXPECT_EQ(b.GetBytes(), 0u);
+    EXPECT_EQ(CategoryBytes(MemoryCategory::kDecodedImages), images + 40);
+  }
+  // Destroyed counters no longer contribute to their category.
+  EXPECT_EQ(CategoryBytes(MemoryCategory::kDecodedImages), images);
+  EXPECT_EQ(CategoryBytes(MemoryCategory::kGlyphAtlas), glyphs);
+}
+
+TEST(MemoryUsageTest, CountersCanBeUpdatedFromManyThreads) {
+  const size_t host_buffers = CategoryBytes(MemoryCategory::kHostBuffer);
+  MemoryUsageCounter counter(MemoryCategory::kHostBuffer);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 1000; j++) {
+        counter.Add(3);
+        counter.Subtract(1);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.GetBytes(), 8000u);
+  EXPECT_EQ(CategoryBytes(MemoryCategory::kHostBuffer), host_buffers + 8000);
+}
+
+TEST(MemoryUsageTest, CategoriesHaveNames) {
+  EXPECT_STREQ(MemoryCategoryToString(MemoryCategory::kRasterCache),
+               "RasterCache");
+  EXPECT_STREQ(MemoryCategoryToString(MemoryCategory::kDeviceAllocator),
+               "DeviceAllocator");
+}
+
+}  // namespace
+}  // namespace fml
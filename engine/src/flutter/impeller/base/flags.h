@@ -9,6 +9,9 @@ namespace impeller {
 struct Flags {
   /// When turned on DrawLine will use the experimental antialiased path.
   bool antialiased_lines = false;
+  /// When turned on large gaussian blurs will use the experimental dual
+  /// Kawase downsample pyramid.
+  bool pyramid_blur = false;
 };
 }  // namespace impeller
 
@@ -63,7 +63,9 @@ class Allocator {
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
   /// @brief Write debug memory usage information to the dart timeline in debug
-  ///        and profile modes.
+  ///        and profile modes, and report the device memory in use to the
+  ///        `fml::MemoryCategory::kDeviceAllocator` category. Called once per
+  ///        frame.
   ///
   ///        This is supported on both the Metal and Vulkan backends.
   virtual void DebugTraceMemoryStatistics() const {};
@@ -40,6 +40,7 @@ HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator,
     FML_CHECK(device_buffer) << "Failed to allocate device buffer.";
     device_buffers_[i].push_back(device_buffer);
   }
+  memory_usage_.Add(kHostBufferArenaSize * kAllocatorBlockSize);
 }
 
 HostBuffer::~HostBuffer() {
@@ -110,6 +111,7 @@ bool HostBuffer::MaybeCreateNewBuffer() {
       return false;
     }
     device_buffers_[frame_index_].push_back(std::move(buffer));
+    memory_usage_.Add(kAllocatorBlockSize);
   }
   offset_ = 0;
   return true;
@@ -231,6 +233,7 @@ void HostBuffer::Reset() {
   // there are any unused buffers and remove them.
   while (device_buffers_[frame_index_].size() > current_buffer_ + 1) {
     device_buffers_[frame_index_].pop_back();
+    memory_usage_.Subtract(kAllocatorBlockSize);
   }
 
   offset_ = 0u;
@@ -11,6 +11,7 @@
 #include <memory>
 #include <type_traits>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
 
@@ -173,6 +174,7 @@ class HostBuffer {
   size_t offset_ = 0u;
   size_t frame_index_ = 0u;
   size_t minimum_uniform_alignment_ = 0u;
+  fml::MemoryUsageCounter memory_usage_{fml::MemoryCategory::kHostBuffer};
 };
 
 }  // namespace impeller
@@ -18,6 +18,7 @@
 #include "flutter/impeller/display_list/aiks_unittests.h"
 
 #include "gmock/gmock.h"
+#include "impeller/display_list/backdrop_filter_cache.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/playground/widgets.h"
@@ -268,6 +269,88 @@ TEST_P(AiksTest, CanRenderBackdropBlur) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(AiksTest, BackdropFilterCacheReusesUndamagedBackdrop) {
+  AiksContext aiks_context(GetContext(), nullptr);
+  RenderTargetAllocator allocator(GetContext()->GetResourceAllocator());
+  RenderTarget render_target =
+      allocator.CreateOffscreen(*GetContext(), {400, 400}, /*mip_count=*/1);
+  ASSERT_TRUE(render_target.IsValid());
+
+  DisplayListBuilder builder;
+  DlPaint paint;
+  paint.setColor(DlColor::kOrangeRed());
+  builder.DrawCircle(DlPoint(180, 120), 100, paint);
+  builder.Save();
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 400, 100));
+  auto backdrop_filter = DlImageFilter::MakeBlur(20, 20, DlTileMode::kClamp);
+  builder.SaveLayer(std::nullopt, nullptr, backdrop_filter.get());
+  builder.Restore();
+  builder.Restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  BackdropFilterCache cache;
+  auto render = [&](const sk_sp<DisplayList>& display_list) {
+    return RenderToTarget(aiks_context.GetContentContext(), render_target,
+                          display_list, Rect::MakeWH(400, 400),
+                          /*reset_host_buffer=*/true,
+                          /*is_onscreen=*/false, &cache);
+  };
+
+  // Without damage information the backdrop is filtered and not retained.
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 0u);
+  EXPECT_EQ(cache.GetStats().misses, 1u);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+
+  // With damage information it is retained for the next frame.
+  cache.SetFrameDamage(IRect());
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 0u);
+  EXPECT_EQ(cache.GetStats().misses, 2u);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+
+  // Nothing underneath the backdrop filter changed.
+  cache.SetFrameDamage(IRect());
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 1u);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+
+  // Damage that the blur does not read from.
+  cache.SetFrameDamage(IRect::MakeXYWH(0, 350, 10, 10));
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+
+  // Damage underneath the backdrop filter, for two frames in a row. The
+  // backdrop is not retained while its content changes.
+  cache.SetFrameDamage(IRect::MakeXYWH(100, 50, 10, 10));
+  ASSERT_TRUE(render(display_list));
+  cache.SetFrameDamage(IRect::MakeXYWH(100, 50, 10, 10));
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+  EXPECT_EQ(cache.GetStats().misses, 4u);
+
+  // Once the content stops changing, the backdrop is retained again.
+  cache.SetFrameDamage(IRect());
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().misses, 5u);
+  cache.SetFrameDamage(IRect());
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().hits, 3u);
+
+  // Damage only applies to the next frame.
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().misses, 6u);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+
+  // Frames that don't draw the backdrop filter drop its entry.
+  cache.SetFrameDamage(IRect());
+  ASSERT_TRUE(render(display_list));
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+  DisplayListBuilder empty_builder;
+  ASSERT_TRUE(render(empty_builder.Build()));
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+}
+
 TEST_P(AiksTest, CanRenderBackdropBlurWithSingleBackdropId) {
   auto image = DlImageImpeller::Make(CreateTextureForFixture("kalimba.jpg"));
 
@@ -827,14 +827,104 @@ TEST_P(AiksTest, MultipleTextWithShadowCache) {
 
   DisplayListToTexture(builder.Build(), {400, 400}, aiks_context);
 
-  // Text should be cached. Each text gets its own entry as we don't analyze the
-  // strings.
+  // Text should be cached. Each text gets its own entry as each draw creates a
+  // new typeface instance.
   EXPECT_EQ(aiks_context.GetContentContext()
                 .GetTextShadowCache()
                 .GetCacheSizeForTesting(),
             5u);
 }
 
+TEST_P(AiksTest, IdenticalTextWithShadowCacheSharesEntry) {
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+
+  AiksContext aiks_context(GetContext(),
+                           std::make_shared<TypographerContextSkia>());
+
+  // Create font instance outside loop so all draws use identical font instance.
+  auto c_font_fixture = std::string(kFontFixture);
+  auto mapping = flutter::testing::OpenFixtureAsSkData(c_font_fixture.c_str());
+  ASSERT_TRUE(mapping);
+  sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
+  SkFont sk_font(font_mgr->makeFromData(mapping), 50);
+
+  for (auto i = 0; i < 5; i++) {
+    ASSERT_TRUE(RenderTextInCanvasSkia(
+        GetContext(), builder, "Hello World", kFontFixture,
+        TextRenderOptions{
+            .color = DlColor::kBlue(),
+            .filter = DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 4)},
+        sk_font));
+  }
+
+  DisplayListToTexture(builder.Build(), {400, 400}, aiks_context);
+
+  // Each draw creates a distinct text frame, but the glyph content is the same
+  // so all of them share a single cache entry.
+  EXPECT_EQ(aiks_context.GetContentContext()
+                .GetTextShadowCache()
+                .GetCacheSizeForTesting(),
+            1u);
+}
+
+TEST_P(AiksTest, TextShadowCacheRetainsEntriesAcrossIdleFrames) {
+  AiksContext aiks_context(GetContext(),
+                           std::make_shared<TypographerContextSkia>());
+  TextShadowCache& cache = aiks_context.GetContentContext().GetTextShadowCache();
+
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+  ASSERT_TRUE(RenderTextInCanvasSkia(
+      GetContext(), builder, "Hello World", kFontFixture,
+      TextRenderOptions{
+          .color = DlColor::kBlue(),
+          .filter = DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 4)}));
+  sk_sp<DisplayList> text_display_list = builder.Build();
+
+  DisplayListToTexture(text_display_list, {400, 400}, aiks_context);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 1u);
+  EXPECT_EQ(cache.GetStats().misses, 1u);
+  EXPECT_GT(cache.GetStats().bytes_used, 0u);
+
+  // A frame that does not draw the shadowed text keeps the entry.
+  DisplayListBuilder empty_builder;
+  DisplayListToTexture(empty_builder.Build(), {400, 400}, aiks_context);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 1u);
+
+  // Drawing the text again re-uses the cached texture.
+  DisplayListToTexture(text_display_list, {400, 400}, aiks_context);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 1u);
+  EXPECT_EQ(cache.GetStats().hits, 1u);
+  EXPECT_EQ(cache.GetStats().misses, 1u);
+}
+
+TEST_P(AiksTest, TextShadowCacheEvictsUnusedEntriesOverBudget) {
+  AiksContext aiks_context(GetContext(),
+                           std::make_shared<TypographerContextSkia>());
+  TextShadowCache& cache = aiks_context.GetContentContext().GetTextShadowCache();
+  cache.SetMaxBytes(0u);
+
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+  ASSERT_TRUE(RenderTextInCanvasSkia(
+      GetContext(), builder, "Hello World", kFontFixture,
+      TextRenderOptions{
+          .color = DlColor::kBlue(),
+          .filter = DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 4)}));
+
+  // Entries used during the current frame are never evicted.
+  DisplayListToTexture(builder.Build(), {400, 400}, aiks_context);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 1u);
+  EXPECT_EQ(cache.GetStats().evictions, 0u);
+
+  DisplayListBuilder empty_builder;
+  DisplayListToTexture(empty_builder.Build(), {400, 400}, aiks_context);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 0u);
+  EXPECT_EQ(cache.GetStats().evictions, 1u);
+  EXPECT_EQ(cache.GetStats().bytes_used, 0u);
+}
+
 TEST_P(AiksTest, MultipleColorWithShadowCache) {
   DisplayListBuilder builder;
   builder.Scale(GetContentScale().x, GetContentScale().y);
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/backdrop_filter_cache.h"
+
+#include <algorithm>
+
+#include "fml/trace_event.h"
+
+namespace impeller {
+
+BackdropFilterCache::BackdropFilterCache() = default;
+
+BackdropFilterCache::~BackdropFilterCache() = default;
+
+void BackdropFilterCache::SetFrameDamage(std::optional<IRect> damage) {
+  pending_damage_ = damage;
+}
+
+void BackdropFilterCache::MarkFrameStart() {
+  frame_count_++;
+  frame_damage_ = pending_damage_;
+  pending_damage_ = std::nullopt;
+  for (Entry& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+}
+
+void BackdropFilterCache::MarkFrameEnd() {
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [](const Entry& entry) {
+                                  return !entry.used_this_frame;
+                                }),
+                 entries_.end());
+  frame_damage_ = std::nullopt;
+  FML_TRACE_COUNTER("impeller", "BackdropFilterCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Entries", entries_.size(),       //
+                    "Hits", hits_,                    //
+                    "Misses", misses_);
+}
+
+BackdropFilterCache::LookupResult BackdropFilterCache::Lookup(
+    const flutter::DlImageFilter& filter,
+    const Matrix& transform,
+    const Rect& coverage) {
+  // Without damage information, the next frame most likely won't have any
+  // either.
+  if (!frame_damage_.has_value()) {
+    misses_++;
+    return {};
+  }
+  // Entries are matched in the order they were drawn, and each entry may only
+  // be claimed once per frame. An entry claimed or inserted earlier in this
+  // frame may have been filtered from different content than what is
+  // underneath this backdrop filter.
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    Entry& entry = *it;
+    if (entry.used_this_frame) {
+      continue;
+    }
+    if (entry.transform != transform || !entry.coverage.Contains(coverage) ||
+        *entry.filter != filter) {
+      continue;
+    }
+    // The first matching entry is the one that corresponds to this backdrop
+    // filter in the previous frame.
+    if (entry.input_coverage.IntersectsWithRect(frame_damage_.value())) {
+      // The content underneath is likely animating. Keep the entry without
+      // its snapshot until the content stops changing.
+      entry.snapshot.reset();
+      entry.used_this_frame = true;
+      misses_++;
+      return {};
+    }
+    if (!entry.snapshot.has_value()) {
+      // The content stopped changing. The entry is inserted again with the
+      // snapshot filtered this frame.
+      entries_.erase(it);
+      misses_++;
+      return {.should_retain = true};
+    }
+    entry.used_this_frame = true;
+    hits_++;
+    return {.snapshot = entry.snapshot};
+  }
+  misses_++;
+  return {.should_retain = true};
+}
+
+void BackdropFilterCache::Insert(const flutter::DlImageFilter& filter,
+                                 const Matrix& transform,
+                                 const Rect& coverage,
+                                 const Rect& input_coverage,
+                                 Snapshot snapshot) {
+  entries_.push_back(Entry{
+      .filter = filter.shared(),
+      .transform = transform,
+      .coverage = coverage,
+      .input_coverage = IRect::RoundOut(input_coverage),
+      .snapshot = std::move(snapshot),
+      .used_this_frame = true,
+  });
+}
+
+BackdropFilterCache::Stats BackdropFilterCache::GetStats() const {
+  return Stats{
+      .hits = hits_,
+      .misses = misses_,
+      .entry_count = entries_.size(),
+  };
+}
+
+}  // namespace impeller
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_DISPLAY_LIST_BACKDROP_FILTER_CACHE_H_
+#define FLUTTER_IMPELLER_DISPLAY_LIST_BACKDROP_FILTER_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+/// @brief A cache of filtered backdrops that re-uses them across consecutive
+///        frames rendered to the same target.
+///
+/// Backdrop filters read back everything rendered underneath them and filter
+/// it, which requires ending the current render pass and running the filter
+/// every frame. When the content underneath a backdrop filter is unchanged
+/// (for example, a frosted glass app bar over a static page) the previous
+/// frame's result can be drawn instead.
+///
+/// Whether the content underneath changed is supplied by the caller as the
+/// readback damage of each frame (see `SetFrameDamage`). An entry is only
+/// re-used if it was drawn in the immediately preceding frame, its filter,
+/// transform and coverage match, and the region that the filter read from
+/// does not intersect the damage. Entries that are not drawn in a frame are
+/// dropped at the end of that frame, so the cache never holds more than one
+/// frame's worth of backdrops.
+///
+/// Retaining a backdrop requires filtering it into a texture that outlives
+/// the frame, so a miss only retains the result if the next frame is likely
+/// to re-use it. Nothing is retained in frames without damage information.
+/// Backdrops whose content was damaged are only retained once a later frame
+/// leaves their content undamaged, as the content is likely animating.
+///
+/// A cache must only be used for a single render target, as damage is
+/// relative to the previous frame rendered to that target.
+class BackdropFilterCache {
+ public:
+  /// @brief Statistics describing the effectiveness of the cache.
+  struct Stats {
+    /// The number of backdrop filters that re-used a previous frame's result.
+    size_t hits = 0u;
+    /// The number of backdrop filters that had to be read back and filtered.
+    size_t misses = 0u;
+    /// The number of entries currently held by the cache.
+    size_t entry_count = 0u;
+  };
+
+  /// @brief The result of looking up a backdrop filter in the cache.
+  struct LookupResult {
+    /// The filtered backdrop from the previous frame, if it can be re-used.
+    std::optional<Snapshot> snapshot;
+    /// Whether the filtered backdrop should be inserted into the cache if it
+    /// has to be filtered this frame.
+    bool should_retain = false;
+  };
+
+  BackdropFilterCache();
+
+  ~BackdropFilterCache();
+
+  /// @brief Set the area of the target, in pixels, whose content underneath
+  ///        backdrop filters may differ from the previous frame.
+  ///
+  /// Applies to the next frame started with `MarkFrameStart`. If no damage
+  /// is provided for a frame, it is unknown and no entries are re-used.
+  void SetFrameDamage(std::optional<IRect> damage);
+
+  /// @brief Begin a new frame.
+  void MarkFrameStart();
+
+  /// @brief Drop all entries that were not drawn during the current frame.
+  void MarkFrameEnd();
+
+  /// @brief Find the filtered backdrop drawn in the previous frame by a
+  ///        backdrop filter equal to `filter`, drawn with `transform`, whose
+  ///        coverage contains `coverage`.
+  ///
+  /// The snapshot is std::nullopt if there is no such entry or if the
+  /// content that the entry was filtered from may have changed.
+  LookupResult Lookup(const flutter::DlImageFilter& filter,
+                      const Matrix& transform,
+                      const Rect& coverage);
+
+  /// @brief Record the filtered backdrop drawn this frame so that it may be
+  ///        re-used in the next frame.
+  ///
+  /// `input_coverage` is the area of the backdrop that was read to produce
+  /// the snapshot.
+  void Insert(const flutter::DlImageFilter& filter,
+              const Matrix& transform,
+              const Rect& coverage,
+              const Rect& input_coverage,
+              Snapshot snapshot);
+
+  /// @brief Retrieve the cache statistics accumulated since creation.
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<flutter::DlImageFilter> filter;
+    Matrix transform;
+    Rect coverage;
+    IRect input_coverage;
+    /// Not set if the content underneath was damaged in the last frame that
+    /// drew this backdrop filter.
+    std::optional<Snapshot> snapshot;
+    bool used_this_frame = false;
+  };
+
+  std::vector<Entry> entries_;
+  std::optional<IRect> pending_damage_;
+  std::optional<IRect> frame_damage_;
+  uint64_t frame_count_ = 0u;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+
+  BackdropFilterCache(const BackdropFilterCache&) = delete;
+
+  BackdropFilterCache& operator=(const BackdropFilterCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_DISPLAY_LIST_BACKDROP_FILTER_CACHE_H_
@@ -16,10 +16,12 @@
 #include "display_list/effects/dl_color_source.h"
 #include "display_list/effects/dl_image_filter.h"
 #include "display_list/image/dl_image.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/display_list/backdrop_filter_cache.h"
 #include "impeller/display_list/color_filter.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/display_list/image_filter.h"
@@ -179,6 +181,21 @@ static std::unique_ptr<EntityPassTarget> CreateRenderTarget(
   );
 }
 
+/// @brief Create contents that draw the part of a filtered backdrop snapshot
+///        covered by a backdrop filter save layer.
+static std::shared_ptr<Contents> MakeBackdropSnapshotContents(
+    const Snapshot& snapshot,
+    const Rect& subpass_coverage,
+    Point global_pass_position) {
+  std::shared_ptr<TextureContents> contents =
+      TextureContents::MakeRect(subpass_coverage.Shift(-global_pass_position));
+  contents->SetTexture(snapshot.texture);
+  contents->SetSourceRect(
+      subpass_coverage.TransformBounds(snapshot.transform.Invert()));
+  contents->SetSamplerDescriptor(snapshot.sampler_descriptor);
+  return contents;
+}
+
 }  // namespace
 
 class Canvas::RRectBlurShape : public BlurShape {
@@ -1024,6 +1041,7 @@ void Canvas::DrawCircle(const Point& center,
 void Canvas::ClipGeometry(const Geometry& geometry,
                           Entity::ClipOperation clip_op,
                           bool is_aa) {
+  FlushImageRectBatch();
   if (IsSkipping()) {
     return;
   }
@@ -1170,6 +1188,11 @@ void Canvas::DrawImageRect(const std::shared_ptr<Texture>& image,
     dest = clipped_source->TransformBounds(src_to_dest);
   }
 
+  if (CanBatchImageRect(image, paint, src_rect_constraint)) {
+    BatchImageRect(image, *clipped_source, dest, paint, sampler);
+    return;
+  }
+
   auto texture_contents = TextureContents::MakeRect(dest);
   texture_contents->SetTexture(image);
   texture_contents->SetSourceRect(*clipped_source);
@@ -1196,6 +1219,96 @@ void Canvas::DrawImageRect(const std::shared_ptr<Texture>& image,
   AddRenderEntityToCurrentPass(entity);
 }
 
+bool Canvas::CanBatchImageRect(const std::shared_ptr<Texture>& image,
+                               const Paint& paint,
+                               SourceRectConstraint src_rect_constraint) {
+  // Batches are rendered with the simple texture pipeline of AtlasContents,
+  // which has no strict source rect, filter or external texture variant.
+  return src_rect_constraint == SourceRectConstraint::kFast &&  //
+         !paint.color_filter &&                                 //
+         paint.image_filter == nullptr &&                       //
+         !paint.invert_colors &&                                //
+         !paint.mask_blur_descriptor.has_value() &&             //
+         paint.blend_mode <= Entity::kLastPipelineBlendMode &&  //
+         image->GetTextureDescriptor().type == TextureType::kTexture2D;
+}
+
+void Canvas::BatchImageRect(const std::shared_ptr<Texture>& image,
+                            const Rect& source,
+                            const Rect& dest,
+                            const Paint& paint,
+                            const SamplerDescriptor& sampler) {
+  if (IsSkipping()) {
+    return;
+  }
+
+  const Matrix& transform = GetCurrentTransform();
+  ImageRectBatch& batch = image_rect_batch_;
+  if (!batch.destinations.empty() &&
+      (batch.texture != image ||
+       SamplerDescriptor::ToKey(batch.sampler) !=
+           SamplerDescriptor::ToKey(sampler) ||
+       batch.transform != transform || batch.blend_mode != paint.blend_mode ||
+       batch.alpha != paint.color.alpha)) {
+    FlushImageRectBatch();
+  }
+  if (batch.destinations.empty()) {
+    batch.texture = image;
+    batch.sampler = sampler;
+    batch.transform = transform;
+    batch.blend_mode = paint.blend_mode;
+    batch.alpha = paint.color.alpha;
+  }
+  batch.sources.push_back(source);
+  batch.destinations.push_back(dest);
+
+  // Reserve the depth this draw would have been rendered at so that the
+  // depths of the draws that follow the batch are not affected by it.
+  ++current_depth_;
+  FML_DCHECK(current_depth_ <= transform_stack_.back().clip_depth)
+      << current_depth_ << " <=? " << transform_stack_.back().clip_depth;
+}
+
+void Canvas::FlushImageRectBatch() {
+  if (image_rect_batch_.destinations.empty()) {
+    return;
+  }
+  // Empty the pending batch before rendering it, rendering the batch adds an
+  // entity to the current pass which flushes again.
+  ImageRectBatch batch;
+  std::swap(batch, image_rect_batch_);
+
+  Entity entity;
+  entity.SetBlendMode(batch.blend_mode);
+  entity.SetTransform(batch.transform);
+
+  if (batch.destinations.size() == 1u) {
+    auto texture_contents = TextureContents::MakeRect(batch.destinations[0]);
+    texture_contents->SetTexture(batch.texture);
+    texture_contents->SetSourceRect(batch.sources[0]);
+    texture_contents->SetSamplerDescriptor(batch.sampler);
+    texture_contents->SetOpacity(batch.alpha);
+    entity.SetContents(std::move(texture_contents));
+    AddRenderEntityToCurrentPass(entity, /*reuse_depth=*/true);
+    return;
+  }
+
+  batching_stats_.batched_draw_count += batch.destinations.size();
+  batching_stats_.batch_count++;
+
+  BatchedImageRectAtlasGeometry geometry(
+      std::move(batch.texture), std::move(batch.sources),
+      std::move(batch.destinations), batch.sampler);
+  auto atlas_contents = std::make_shared<AtlasContents>();
+  atlas_contents->SetGeometry(&geometry);
+  atlas_contents->SetAlpha(batch.alpha);
+  entity.SetContents(atlas_contents);
+
+  // The draws of the batch reserved their depths as they were recorded, the
+  // batch is rendered at the depth of its last draw.
+  AddRenderEntityToCurrentPass(entity, /*reuse_depth=*/true);
+}
+
 size_t Canvas::GetClipHeight() const {
   return transform_stack_.back().clip_height;
 }
@@ -1383,6 +1496,7 @@ void Canvas::SkipUntilMatchingRestore(size_t total_content_depth) {
 }
 
 void Canvas::Save(uint32_t total_content_depth) {
+  FlushImageRectBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -1444,6 +1558,7 @@ void Canvas::SaveLayer(const Paint& paint,
                        bool can_distribute_opacity,
                        std::optional<int64_t> backdrop_id) {
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
+  FlushImageRectBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -1520,7 +1635,7 @@ void Canvas::SaveLayer(const Paint& paint,
                                       ->GetMaximumRenderPassAttachmentSize());
 
   // Backdrop filter state, ignored if there is no BDF.
-  std::shared_ptr<FilterContents> backdrop_filter_contents;
+  std::shared_ptr<Contents> backdrop_contents;
   Point local_position = Point(0, 0);
   if (backdrop_filter) {
     local_position = subpass_coverage.GetOrigin() - GetGlobalPassPosition();
@@ -1556,7 +1671,24 @@ void Canvas::SaveLayer(const Paint& paint,
       }
     }
 
-    if (!will_cache_backdrop_texture || !backdrop_data->texture_slot) {
+    // A backdrop filter drawn directly into the onscreen pass may re-use the
+    // previous frame's result if nothing underneath it has changed. Backdrops
+    // that share a backdrop id are already only filtered once.
+    const bool can_use_backdrop_filter_cache =
+        backdrop_filter_cache_ != nullptr && !will_cache_backdrop_texture &&
+        render_passes_.size() == 1u;
+    BackdropFilterCache::LookupResult cache_result;
+    if (can_use_backdrop_filter_cache) {
+      cache_result = backdrop_filter_cache_->Lookup(
+          *backdrop_filter, GetCurrentTransform(), subpass_coverage);
+    }
+    const std::optional<Snapshot>& cached_backdrop = cache_result.snapshot;
+
+    if (cached_backdrop.has_value()) {
+      // The backdrop is not read back, but it no longer needs to be accounted
+      // for by later flips.
+      backdrop_count_ -= backdrop_count;
+    } else if (!will_cache_backdrop_texture || !backdrop_data->texture_slot) {
       backdrop_count_ -= backdrop_count;
 
       // The onscreen texture can be flipped to if:
@@ -1583,14 +1715,52 @@ void Canvas::SaveLayer(const Paint& paint,
       input_texture = backdrop_data->texture_slot;
     }
 
-    backdrop_filter_contents = backdrop_filter_proc(
-        FilterInput::Make(std::move(input_texture)),
-        transform_stack_.back().transform.Basis(),
-        // When the subpass has a translation that means the math with
-        // the snapshot has to be different.
-        transform_stack_.back().transform.HasTranslation()
-            ? Entity::RenderingMode::kSubpassPrependSnapshotTransform
-            : Entity::RenderingMode::kSubpassAppendSnapshotTransform);
+    std::shared_ptr<FilterContents> backdrop_filter_contents;
+    if (cached_backdrop.has_value()) {
+      backdrop_contents = MakeBackdropSnapshotContents(
+          cached_backdrop.value(), subpass_coverage, GetGlobalPassPosition());
+    } else {
+      const Matrix effect_transform = transform_stack_.back().transform.Basis();
+      backdrop_filter_contents = backdrop_filter_proc(
+          FilterInput::Make(std::move(input_texture)), effect_transform,
+          // When the subpass has a translation that means the math with
+          // the snapshot has to be different.
+          transform_stack_.back().transform.HasTranslation()
+              ? Entity::RenderingMode::kSubpassPrependSnapshotTransform
+              : Entity::RenderingMode::kSubpassAppendSnapshotTransform);
+      backdrop_contents = backdrop_filter_contents;
+
+      // Only backdrops the next frame is likely to re-use are retained. The
+      // rest are filtered directly into the subpass as usual.
+      std::optional<Rect> input_coverage =
+          cache_result.should_retain
+              ? backdrop_filter_contents->GetSourceCoverage(effect_transform,
+                                                            subpass_coverage)
+              : std::nullopt;
+      if (input_coverage.has_value()) {
+        // Filter into a snapshot that is drawn both now and next frame, so the
+        // filter still only runs once. To prevent this texture from being
+        // re-used by the render target cache, we temporarily disable any RT
+        // caching.
+        std::optional<Snapshot> snapshot;
+        {
+          renderer_.GetRenderTargetCache()->DisableCache();
+          fml::ScopedCleanupClosure restore_cache(
+              [&] { renderer_.GetRenderTargetCache()->EnableCache(); });
+          snapshot = backdrop_filter_contents->RenderToSnapshot(
+              renderer_, {},
+              {.coverage_limit = subpass_coverage,
+               .label = "Backdrop Filter Snapshot"});
+        }
+        if (snapshot.has_value()) {
+          backdrop_contents = MakeBackdropSnapshotContents(
+              snapshot.value(), subpass_coverage, GetGlobalPassPosition());
+          backdrop_filter_cache_->Insert(
+              *backdrop_filter, GetCurrentTransform(), subpass_coverage,
+              input_coverage.value(), std::move(snapshot.value()));
+        }
+      }
+    }
 
     if (will_cache_backdrop_texture) {
       FML_DCHECK(backdrop_data);
@@ -1606,19 +1776,11 @@ void Canvas::SaveLayer(const Paint& paint,
       std::optional<Snapshot> maybe_snapshot =
           backdrop_data->shared_filter_snapshot;
       if (maybe_snapshot.has_value()) {
-        const Snapshot& snapshot = maybe_snapshot.value();
-        std::shared_ptr<TextureContents> contents = TextureContents::MakeRect(
-            subpass_coverage.Shift(-GetGlobalPassPosition()));
-        auto scaled =
-            subpass_coverage.TransformBounds(snapshot.transform.Invert());
-        contents->SetTexture(snapshot.texture);
-        contents->SetSourceRect(scaled);
-        contents->SetSamplerDescriptor(snapshot.sampler_descriptor);
-
         // This backdrop entity sets a depth value as it is written to the newly
         // flipped backdrop and not into a new saveLayer.
         Entity backdrop_entity;
-        backdrop_entity.SetContents(std::move(contents));
+        backdrop_entity.SetContents(MakeBackdropSnapshotContents(
+            maybe_snapshot.value(), subpass_coverage, GetGlobalPassPosition()));
         backdrop_entity.SetClipDepth(++current_depth_);
         backdrop_entity.SetBlendMode(paint.blend_mode);
 
@@ -1661,13 +1823,13 @@ void Canvas::SaveLayer(const Paint& paint,
   // the subpass will affect in the parent pass.
   clip_coverage_stack_.PushSubpass(subpass_coverage, GetClipHeight());
 
-  if (!backdrop_filter_contents) {
+  if (!backdrop_contents) {
     return;
   }
 
   // Render the backdrop entity.
   Entity backdrop_entity;
-  backdrop_entity.SetContents(std::move(backdrop_filter_contents));
+  backdrop_entity.SetContents(std::move(backdrop_contents));
   backdrop_entity.SetTransform(
       Matrix::MakeTranslation(Vector3(-local_position)));
   backdrop_entity.SetClipDepth(std::numeric_limits<uint32_t>::max());
@@ -1676,6 +1838,7 @@ void Canvas::SaveLayer(const Paint& paint,
 
 bool Canvas::Restore() {
   FML_DCHECK(transform_stack_.size() > 0);
+  FlushImageRectBatch();
   if (transform_stack_.size() == 1) {
     return false;
   }
@@ -1839,17 +2002,23 @@ bool Canvas::AttemptBlurredTextOptimization(
           FilterInput::Make(text_contents),
           /*is_solid_color=*/true, GetCurrentTransform());
 
+  // Key multi-glyph frames on their glyph content rather than the frame
+  // identity so that shadows survive text being re-shaped or scrolled back
+  // into view.
   std::optional<Glyph> maybe_glyph = text_frame->AsSingleGlyph();
-  int64_t identifier = maybe_glyph.has_value()
-                           ? maybe_glyph.value().index
-                           : reinterpret_cast<int64_t>(text_frame.get());
+  int64_t identifier =
+      maybe_glyph.has_value()
+          ? maybe_glyph.value().index
+          : TextShadowCache::TextShadowCacheKey::ComputeContentIdentifier(
+                *text_frame);
   TextShadowCache::TextShadowCacheKey cache_key(
       /*p_max_basis=*/entity.GetTransform().GetMaxBasisLengthXY(),
       /*p_identifier=*/identifier,
       /*p_is_single_glyph=*/maybe_glyph.has_value(),
       /*p_font=*/text_frame->GetFont(),
       /*p_sigma=*/paint.mask_blur_descriptor->sigma,
-      /*p_color=*/paint.color);
+      /*p_color=*/paint.color,
+      /*p_frame=*/maybe_glyph.has_value() ? nullptr : text_frame);
 
   std::optional<Entity> result = renderer_.GetTextShadowCache().Lookup(
       renderer_, entity, filter, cache_key);
@@ -1988,6 +2157,8 @@ void Canvas::AddRenderEntityWithFiltersToCurrentPass(Entity& entity,
 }
 
 void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
+  // Draws that were deferred into a batch precede this entity.
+  FlushImageRectBatch();
   if (IsSkipping()) {
     return;
   }
@@ -2096,6 +2267,10 @@ void Canvas::SetBackdropData(
   backdrop_count_ = backdrop_count;
 }
 
+void Canvas::SetBackdropFilterCache(BackdropFilterCache* cache) {
+  backdrop_filter_cache_ = cache;
+}
+
 std::shared_ptr<Texture> Canvas::FlipBackdrop(Point global_pass_position,
                                               bool should_remove_texture,
                                               bool should_use_onscreen,
@@ -2289,6 +2464,7 @@ bool Canvas::EnsureFinalMipmapGeneration() const {
 }
 
 void Canvas::EndReplay() {
+  FlushImageRectBatch();
   FML_DCHECK(render_passes_.size() == 1u);
   render_passes_.back().GetInlinePassContext()->GetRenderPass();
   render_passes_.back().GetInlinePassContext()->EndPass(
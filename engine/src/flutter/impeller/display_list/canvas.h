@@ -37,6 +37,8 @@
 
 namespace impeller {
 
+class BackdropFilterCache;
+
 struct BackdropData {
   size_t backdrop_count = 0;
   bool all_filters_equal = true;
@@ -148,6 +150,13 @@ class Canvas {
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop_data,
                        size_t backdrop_count);
 
+  /// @brief Set the cache used to re-use backdrop filter results from the
+  ///        previous frame rendered to the same target, or nullptr to always
+  ///        re-filter the backdrop.
+  ///
+  /// The cache must outlive this canvas.
+  void SetBackdropFilterCache(BackdropFilterCache* cache);
+
   /// @brief Return the culling bounds of the current render target, or nullopt
   ///        if there is no coverage.
   std::optional<Rect> GetLocalCoverageLimit() const;
@@ -265,6 +274,19 @@ class Canvas {
     Rect coverage;
   };
 
+  /// Counters for the |DrawImageRect| calls that were coalesced into atlas
+  /// draws.
+  struct BatchingStats {
+    /// The number of |DrawImageRect| calls that were rendered as part of a
+    /// batch of two or more draws.
+    size_t batched_draw_count = 0u;
+    /// The number of draws issued for those batches.
+    size_t batch_count = 0u;
+  };
+
+  // Visible for testing.
+  const BatchingStats& GetBatchingStats() const { return batching_stats_; }
+
   // Visible for testing.
   bool RequiresReadback() const { return requires_readback_; }
 
@@ -323,6 +345,10 @@ class Canvas {
   /// fetch (iOS Simulator and certain OpenGLES devices).
   size_t backdrop_count_ = 0u;
 
+  /// Filtered backdrops from the previous frame, if the caller tracks what
+  /// changed between frames.
+  BackdropFilterCache* backdrop_filter_cache_ = nullptr;
+
   // All geometry objects created for regular draws can be stack allocated,
   // but clip geometries must be cached for record/replay for backdrop filters
   // and so must be kept alive longer.
@@ -330,6 +356,23 @@ class Canvas {
 
   uint64_t current_depth_ = 0u;
 
+  /// A run of |DrawImageRect| calls that sample the same texture with the
+  /// same sampler, transform, blend mode and opacity, and that have not been
+  /// rendered yet. Every draw in the run reserves its own depth so the run can
+  /// be rendered as a single atlas draw at the depth of its last draw.
+  struct ImageRectBatch {
+    std::shared_ptr<Texture> texture;
+    SamplerDescriptor sampler;
+    Matrix transform;
+    BlendMode blend_mode = BlendMode::kSrcOver;
+    Scalar alpha = 1.0f;
+    std::vector<Rect> sources;
+    std::vector<Rect> destinations;
+  };
+
+  ImageRectBatch image_rect_batch_;
+  BatchingStats batching_stats_;
+
   Point GetGlobalPassPosition() const;
 
   // clip depth of the previous save or 0.
@@ -342,6 +385,27 @@ class Canvas {
   /// @brief Skip all rendering/clipping entities until next restore.
   void SkipUntilMatchingRestore(size_t total_content_depth);
 
+  /// @brief Whether a |DrawImageRect| call with these arguments can be
+  ///        deferred into an |ImageRectBatch|.
+  static bool CanBatchImageRect(const std::shared_ptr<Texture>& image,
+                                const Paint& paint,
+                                SourceRectConstraint src_rect_constraint);
+
+  /// @brief Adds a draw to the pending |ImageRectBatch|, rendering the
+  ///        pending batch first if the draw is not compatible with it.
+  void BatchImageRect(const std::shared_ptr<Texture>& image,
+                      const Rect& source,
+                      const Rect& dest,
+                      const Paint& paint,
+                      const SamplerDescriptor& sampler);
+
+  /// @brief Renders the pending |ImageRectBatch|, if any.
+  ///
+  ///        This must be called before any other entity is added to the
+  ///        current pass and before the pass, the clip or the save stack
+  ///        changes.
+  void FlushImageRectBatch();
+
   void SetupRenderPass();
 
   /// @brief  Ends the current render pass, saving the result as a texture, and
@@ -389,6 +389,54 @@ TEST_P(AiksTest, SupportsBlitToOnscreen) {
   }
 }
 
+TEST_P(AiksTest, ConsecutiveImageRectsAreBatched) {
+  ContentContext context(GetContext(), nullptr);
+  auto canvas = CreateTestCanvas(context);
+  auto texture = CreateTextureForFixture("bay_bridge.jpg");
+
+  Paint paint;
+  for (int i = 0; i < 3; i++) {
+    canvas->DrawImageRect(texture, Rect::MakeXYWH(i * 10, 0, 10, 10),
+                          Rect::MakeXYWH(i * 30, 0, 20, 20), paint);
+  }
+  // Each draw reserves its depth before the batch is rendered.
+  EXPECT_EQ(canvas->GetOpDepth(), 3u);
+  EXPECT_EQ(canvas->GetBatchingStats().batch_count, 0u);
+
+  canvas->EndReplay();
+  EXPECT_EQ(canvas->GetBatchingStats().batched_draw_count, 3u);
+  EXPECT_EQ(canvas->GetBatchingStats().batch_count, 1u);
+}
+
+TEST_P(AiksTest, IncompatibleImageRectsAreNotBatched) {
+  ContentContext context(GetContext(), nullptr);
+  auto canvas = CreateTestCanvas(context);
+  auto texture = CreateTextureForFixture("bay_bridge.jpg");
+  auto other_texture = CreateTextureForFixture("boston.jpg");
+  const Rect source = Rect::MakeXYWH(0, 0, 10, 10);
+  const Rect dest = Rect::MakeXYWH(0, 0, 20, 20);
+
+  Paint paint;
+  canvas->DrawImageRect(texture, source, dest, paint);
+  canvas->DrawImageRect(texture, source, dest, paint);
+  canvas->DrawImageRect(other_texture, source, dest, paint);
+  canvas->DrawImageRect(texture, source, dest, paint);
+  canvas->DrawRect(dest, paint);
+  canvas->DrawImageRect(texture, source, dest, paint);
+  Paint translucent_paint;
+  translucent_paint.color = Color::White().WithAlpha(0.5);
+  canvas->DrawImageRect(texture, source, dest, translucent_paint);
+  canvas->DrawImageRect(texture, source, dest, paint,
+                        SamplerDescriptor{}, SourceRectConstraint::kStrict);
+  canvas->DrawImageRect(texture, source, dest, paint,
+                        SamplerDescriptor{}, SourceRectConstraint::kStrict);
+  EXPECT_EQ(canvas->GetOpDepth(), 9u);
+  canvas->EndReplay();
+
+  EXPECT_EQ(canvas->GetBatchingStats().batched_draw_count, 2u);
+  EXPECT_EQ(canvas->GetBatchingStats().batch_count, 1u);
+}
+
 TEST_P(AiksTest, RoundSuperellipseShadowComparison) {
   // Config
   Size default_size(600, 400);
@@ -0,0 +1,323 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdlib>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/fml/native_library.h"
+#include "impeller/display_list/aiks_context.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/display_list/dl_image_impeller.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+// Renders DisplayLists with the Vulkan backend and reports the score the
+// Impeller complexity calculator gives each of them next to the measured
+// time. The TimePerUnit counter is the ratio of the two, in seconds. The
+// costs in dl_complexity_impeller.cc are provisional; once they are
+// calibrated, it should stay roughly constant across all of the benchmarks.
+//
+// On machines without a GPU, point the loader at SwiftShader or llvmpipe
+// with VK_ICD_FILENAMES. The loader itself can be overridden with the
+// IMPELLER_VULKAN_LIBRARY environment variable. run_tests.py and
+// generate_metrics.sh use the SwiftShader build from the output directory.
+//
+// Text is not covered yet as it needs fonts and the timings are dominated
+// by glyph rasterization on the first frame.
+
+namespace impeller {
+
+namespace {
+
+constexpr ISize kRenderSize(1024, 1024);
+
+// Each DisplayList repeats its op this many times so that the fixed cost of
+// a frame doesn't drown out the cost of the op itself.
+constexpr int kOpsPerDisplayList = 100;
+
+struct BenchmarkRenderer {
+  fml::RefPtr<fml::NativeLibrary> vulkan_library;
+  std::shared_ptr<ContextVK> context;
+  std::unique_ptr<AiksContext> aiks_context;
+};
+
+// Created on first use and intentionally leaked, Vulkan doesn't like being
+// torn down from static destructors.
+BenchmarkRenderer* GetRenderer() {
+  static BenchmarkRenderer* renderer = []() -> BenchmarkRenderer* {
+    const char* library_path = std::getenv("IMPELLER_VULKAN_LIBRARY");
+    auto vulkan_library =
+        fml::NativeLibrary::Create(library_path ? library_path
+                                                : "libvulkan.so.1");
+    if (!vulkan_library) {
+      return nullptr;
+    }
+    auto proc_address =
+        vulkan_library->ResolveFunction<PFN_vkGetInstanceProcAddr>(
+            "vkGetInstanceProcAddr");
+    if (!proc_address.has_value()) {
+      return nullptr;
+    }
+
+    ContextVK::Settings settings;
+    settings.proc_address_callback = proc_address.value();
+    settings.shader_libraries_data = {
+        std::make_shared<fml::NonOwnedMapping>(
+            impeller_entity_shaders_vk_data,
+            impeller_entity_shaders_vk_length),
+        std::make_shared<fml::NonOwnedMapping>(
+            impeller_modern_shaders_vk_data,
+            impeller_modern_shaders_vk_length),
+        std::make_shared<fml::NonOwnedMapping>(
+            impeller_framebuffer_blend_shaders_vk_data,
+            impeller_framebuffer_blend_shaders_vk_length),
+    };
+    auto context = ContextVK::Create(std::move(settings));
+    if (!context || !context->IsValid()) {
+      return nullptr;
+    }
+    auto aiks_context =
+        std::make_unique<AiksContext>(context, TypographerContextSkia::Make());
+    if (!aiks_context->IsValid()) {
+      return nullptr;
+    }
+    return new BenchmarkRenderer{std::move(vulkan_library), std::move(context),
+                                 std::move(aiks_context)};
+  }();
+  return renderer;
+}
+
+void RenderDisplayList(benchmark::State& state,
+                       const sk_sp<flutter::DisplayList>& display_list) {
+  BenchmarkRenderer* renderer = GetRenderer();
+  if (!renderer) {
+    state.SkipWithError("Could not create a Vulkan context.");
+    return;
+  }
+  // Render once outside of the timed loop so that pipelines are created and
+  // render targets are in the cache.
+  if (!DisplayListToTexture(display_list, kRenderSize,
+                            *renderer->aiks_context)) {
+    state.SkipWithError("Could not render the DisplayList.");
+    return;
+  }
+  [[maybe_unused]] auto result = renderer->context->GetDevice().waitIdle();
+
+  while (state.KeepRunning()) {
+    auto texture = DisplayListToTexture(display_list, kRenderSize,
+                                        *renderer->aiks_context);
+    benchmark::DoNotOptimize(texture);
+    result = renderer->context->GetDevice().waitIdle();
+  }
+
+  unsigned int complexity =
+      flutter::DisplayListImpellerComplexityCalculator::GetInstance()->Compute(
+          display_list.get());
+  state.counters["Complexity"] = complexity;
+  state.counters["TimePerUnit"] = benchmark::Counter(
+      complexity, benchmark::Counter::kIsIterationInvariantRate |
+                      benchmark::Counter::kInvert);
+  state.counters["Ops"] = display_list->op_count(true);
+}
+
+sk_sp<flutter::DlImage> MakeTestImage(int size) {
+  BenchmarkRenderer* renderer = GetRenderer();
+  if (!renderer) {
+    return nullptr;
+  }
+  flutter::DisplayListBuilder builder;
+  builder.DrawColor(flutter::DlColor::kBlue(), flutter::DlBlendMode::kSrc);
+  builder.DrawCircle(flutter::DlPoint(size / 2, size / 2), size / 4,
+                     flutter::DlPaint(flutter::DlColor::kRed()));
+  auto texture = DisplayListToTexture(builder.Build(), ISize(size, size),
+                                      *renderer->aiks_context);
+  if (!texture) {
+    return nullptr;
+  }
+  return DlImageImpeller::Make(texture);
+}
+
+flutter::DlPath MakeStarPath(flutter::DlScalar size) {
+  // A five pointed star drawn in one contour, which is not convex.
+  flutter::DlPathBuilder path_builder;
+  path_builder.MoveTo(flutter::DlPoint(size * 0.5f, 0));
+  path_builder.LineTo(flutter::DlPoint(size * 0.8f, size));
+  path_builder.LineTo(flutter::DlPoint(0, size * 0.35f));
+  path_builder.LineTo(flutter::DlPoint(size, size * 0.35f));
+  path_builder.LineTo(flutter::DlPoint(size * 0.2f, size));
+  path_builder.Close();
+  return path_builder.TakePath();
+}
+
+flutter::DlPath MakeConvexPath(flutter::DlScalar size) {
+  flutter::DlPathBuilder path_builder;
+  path_builder.MoveTo(flutter::DlPoint(size * 0.5f, 0));
+  path_builder.LineTo(flutter::DlPoint(size, size * 0.35f));
+  path_builder.LineTo(flutter::DlPoint(size * 0.8f, size));
+  path_builder.LineTo(flutter::DlPoint(size * 0.2f, size));
+  path_builder.LineTo(flutter::DlPoint(0, size * 0.35f));
+  path_builder.Close();
+  return path_builder.TakePath();
+}
+
+flutter::DlPath MakeCurvedPath(flutter::DlScalar size) {
+  flutter::DlPathBuilder path_builder;
+  path_builder.MoveTo(flutter::DlPoint(0, 0));
+  path_builder.CubicCurveTo(flutter::DlPoint(size, 0),
+                            flutter::DlPoint(0, size),
+                            flutter::DlPoint(size, size));
+  path_builder.QuadraticCurveTo(flutter::DlPoint(0, size),
+                                flutter::DlPoint(0, size * 0.5f));
+  return path_builder.TakePath();
+}
+
+}  // namespace
+
+static void BM_DrawRect(benchmark::State& state) {
+  flutter::DlScalar size = state.range(0);
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawRect(flutter::DlRect::MakeWH(size, size), flutter::DlPaint());
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_DrawCircle(benchmark::State& state) {
+  flutter::DlScalar radius = state.range(0);
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawCircle(flutter::DlPoint(radius, radius), radius,
+                       flutter::DlPaint().setAntiAlias(true));
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_FillConvexPath(benchmark::State& state) {
+  auto path = MakeConvexPath(state.range(0));
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawPath(path, flutter::DlPaint());
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+// Drawn with stencil-then-cover.
+static void BM_FillConcavePath(benchmark::State& state) {
+  auto path = MakeStarPath(state.range(0));
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawPath(path, flutter::DlPaint());
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_StrokeCurvedPath(benchmark::State& state) {
+  auto path = MakeCurvedPath(state.range(0));
+  flutter::DlPaint paint;
+  paint.setDrawStyle(flutter::DlDrawStyle::kStroke);
+  paint.setStrokeWidth(4.0f);
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawPath(path, paint);
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_SaveLayer(benchmark::State& state) {
+  flutter::DlScalar size = state.range(0);
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.SaveLayer(flutter::DlRect::MakeWH(size, size), nullptr);
+    builder.DrawRect(flutter::DlRect::MakeWH(size, size), flutter::DlPaint());
+    builder.Restore();
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_BlurredSaveLayer(benchmark::State& state) {
+  flutter::DlScalar sigma = state.range(0);
+  flutter::DlPaint layer_paint;
+  layer_paint.setImageFilter(flutter::DlImageFilter::MakeBlur(
+      sigma, sigma, flutter::DlTileMode::kDecal));
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.SaveLayer(flutter::DlRect::MakeWH(512, 512), &layer_paint);
+    builder.DrawRect(flutter::DlRect::MakeWH(512, 512), flutter::DlPaint());
+    builder.Restore();
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_MaskBlurredPath(benchmark::State& state) {
+  flutter::DlScalar sigma = state.range(0);
+  auto path = MakeStarPath(256);
+  flutter::DlPaint paint;
+  paint.setMaskFilter(flutter::DlBlurMaskFilter::Make(
+      flutter::DlBlurStyle::kNormal, sigma));
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawPath(path, paint);
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_DrawImageRect(benchmark::State& state) {
+  auto image = MakeTestImage(256);
+  if (!image) {
+    state.SkipWithError("Could not create the test image.");
+    return;
+  }
+  flutter::DlScalar size = state.range(0);
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawImageRect(image, flutter::DlRect::MakeWH(256, 256),
+                          flutter::DlRect::MakeWH(size, size),
+                          flutter::DlImageSampling::kLinear);
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+static void BM_DrawAtlas(benchmark::State& state) {
+  auto image = MakeTestImage(256);
+  if (!image) {
+    state.SkipWithError("Could not create the test image.");
+    return;
+  }
+  int count = state.range(0);
+  std::vector<flutter::DlRSTransform> xforms;
+  std::vector<flutter::DlRect> rects;
+  for (int i = 0; i < count; i++) {
+    xforms.push_back(
+        flutter::DlRSTransform(1, 0, (i % 32) * 32, (i / 32) * 32));
+    rects.push_back(flutter::DlRect::MakeXYWH((i % 8) * 32, 0, 32, 32));
+  }
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < kOpsPerDisplayList; i++) {
+    builder.DrawAtlas(image, xforms.data(), rects.data(), nullptr, count,
+                      flutter::DlBlendMode::kSrcOver,
+                      flutter::DlImageSampling::kNearestNeighbor, nullptr);
+  }
+  RenderDisplayList(state, builder.Build());
+}
+
+BENCHMARK(BM_DrawRect)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_DrawCircle)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(BM_FillConvexPath)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_FillConcavePath)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_StrokeCurvedPath)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_SaveLayer)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_BlurredSaveLayer)->RangeMultiplier(2)->Range(2, 64);
+BENCHMARK(BM_MaskBlurredPath)->RangeMultiplier(2)->Range(2, 64);
+BENCHMARK(BM_DrawImageRect)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_DrawAtlas)->RangeMultiplier(4)->Range(16, 1024);
+
+}  // namespace impeller
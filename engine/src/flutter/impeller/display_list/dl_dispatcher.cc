@@ -961,6 +961,10 @@ void CanvasDlDispatcher::SetBackdropData(
   GetCanvas().SetBackdropData(std::move(backdrop), backdrop_count);
 }
 
+void CanvasDlDispatcher::SetBackdropFilterCache(BackdropFilterCache* cache) {
+  GetCanvas().SetBackdropFilterCache(cache);
+}
+
 //// Text Frame Dispatcher
 
 FirstPassDispatcher::FirstPassDispatcher(const ContentContext& renderer,
@@ -1282,12 +1286,14 @@ std::shared_ptr<Texture> DisplayListToTexture(
   const auto& [data, count] = collector.TakeBackdropData();
   impeller_dispatcher.SetBackdropData(data, count);
   context.GetContentContext().GetTextShadowCache().MarkFrameStart();
+  context.GetContentContext().GetGradientTextureCache().MarkFrameStart();
   fml::ScopedCleanupClosure cleanup([&] {
     if (reset_host_buffer) {
       context.GetContentContext().GetTransientsDataBuffer().Reset();
       context.GetContentContext().GetTransientsIndexesBuffer().Reset();
     }
     context.GetContentContext().GetTextShadowCache().MarkFrameEnd();
+    context.GetContentContext().GetGradientTextureCache().MarkFrameEnd();
     context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
     context.GetContext()->DisposeThreadLocalCachedResources();
   });
@@ -1303,7 +1309,8 @@ bool RenderToTarget(ContentContext& context,
                     const sk_sp<flutter::DisplayList>& display_list,
                     Rect cull_rect,
                     bool reset_host_buffer,
-                    bool is_onscreen) {
+                    bool is_onscreen,
+                    BackdropFilterCache* backdrop_filter_cache) {
   FirstPassDispatcher collector(context, impeller::Matrix(), cull_rect);
   display_list->Dispatch(collector, cull_rect);
 
@@ -1317,12 +1324,21 @@ bool RenderToTarget(ContentContext& context,
   );
   const auto& [data, count] = collector.TakeBackdropData();
   impeller_dispatcher.SetBackdropData(data, count);
+  impeller_dispatcher.SetBackdropFilterCache(backdrop_filter_cache);
   context.GetTextShadowCache().MarkFrameStart();
+  context.GetGradientTextureCache().MarkFrameStart();
+  if (backdrop_filter_cache) {
+    backdrop_filter_cache->MarkFrameStart();
+  }
   fml::ScopedCleanupClosure cleanup([&] {
     if (reset_host_buffer) {
       context.ResetTransientsBuffers();
     }
     context.GetTextShadowCache().MarkFrameEnd();
+    context.GetGradientTextureCache().MarkFrameEnd();
+    if (backdrop_filter_cache) {
+      backdrop_filter_cache->MarkFrameEnd();
+    }
   });
 
   display_list->Dispatch(impeller_dispatcher, cull_rect);
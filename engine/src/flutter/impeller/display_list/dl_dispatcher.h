@@ -13,6 +13,7 @@
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "fml/logging.h"
 #include "impeller/display_list/aiks_context.h"
+#include "impeller/display_list/backdrop_filter_cache.h"
 #include "impeller/display_list/canvas.h"
 #include "impeller/display_list/paint.h"
 #include "impeller/entity/contents/content_context.h"
@@ -274,6 +275,8 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop,
                        size_t backdrop_count);
 
+  void SetBackdropFilterCache(BackdropFilterCache* cache);
+
   // |flutter::DlOpReceiver|
   void save() override {
     // This dispatcher should never be used with the save() variant
@@ -410,12 +413,17 @@ std::shared_ptr<Texture> DisplayListToTexture(
 ///
 /// If [is_onscreen] is true, then the onscreen command buffer will be
 /// submitted via Context::SubmitOnscreen.
+///
+/// If [backdrop_filter_cache] is provided, backdrop filters whose content was
+/// not damaged since the previous frame rendered with the same cache re-use
+/// that frame's result. See [BackdropFilterCache::SetFrameDamage].
 bool RenderToTarget(ContentContext& context,
                     RenderTarget render_target,
                     const sk_sp<flutter::DisplayList>& display_list,
                     Rect cull_rect,
                     bool reset_host_buffer,
-                    bool is_onscreen = true);
+                    bool is_onscreen = true,
+                    BackdropFilterCache* backdrop_filter_cache = nullptr);
 
 }  // namespace impeller
 
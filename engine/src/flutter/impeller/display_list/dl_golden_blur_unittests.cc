@@ -4,8 +4,13 @@
 
 #include "impeller/display_list/dl_golden_unittests.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/fml/logging.h"
 #include "flutter/impeller/display_list/testing/render_text_in_canvas.h"
 #include "flutter/impeller/display_list/testing/rmse.h"
 #include "flutter/impeller/geometry/round_rect.h"
@@ -152,6 +157,123 @@ TEST_P(DlGoldenTest, ShimmerTest) {
   EXPECT_TRUE(average_rmse >= 0.0) << "average_rmse: " << average_rmse;
 }
 
+// A frosted glass backdrop blur that is large enough to be rendered with the
+// downsample pyramid.
+TEST_P(DlGoldenTest, BackdropBlurExperimentPyramidBlur) {
+  impeller::Point content_scale = GetContentScale();
+  auto draw = [&](DlCanvas* canvas, const std::vector<sk_sp<DlImage>>& images) {
+    canvas->DrawColor(DlColor(0xff111111));
+    canvas->Scale(content_scale.x, content_scale.y);
+
+    DlPaint paint;
+    canvas->DrawImage(images[0], DlPoint(0, 0), DlImageSampling::kLinear,
+                      &paint);
+
+    auto blur = DlImageFilter::MakeBlur(40, 40, DlTileMode::kClamp);
+    canvas->ClipRect(DlRect::MakeLTRB(100, 100, 900, 600));
+    canvas->SaveLayer(std::nullopt, /*paint=*/nullptr, blur.get());
+    canvas->Restore();
+  };
+
+  std::vector<sk_sp<DlImage>> images;
+  images.emplace_back(CreateDlImageForFixture("boston.jpg"));
+
+  DisplayListBuilder builder;
+  draw(&builder, images);
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
+namespace {
+
+struct PixelDifference {
+  int max_channel_difference = 0;
+  double rms_channel_difference = 0.0;
+};
+
+/// Compares the pixels of two screenshots of the same size, ignoring a
+/// border of `margin` pixels.
+PixelDifference CompareInterior(const impeller::testing::Screenshot* left,
+                                const impeller::testing::Screenshot* right,
+                                size_t margin) {
+  FML_CHECK(left->GetWidth() == right->GetWidth());
+  FML_CHECK(left->GetHeight() == right->GetHeight());
+  FML_CHECK(left->GetWidth() > 2 * margin && left->GetHeight() > 2 * margin);
+
+  PixelDifference result;
+  double tally = 0.0;
+  size_t channels = 0u;
+  for (size_t y = margin; y < left->GetHeight() - margin; y++) {
+    const uint8_t* left_row = left->GetBytes() + y * left->GetBytesPerRow();
+    const uint8_t* right_row = right->GetBytes() + y * right->GetBytesPerRow();
+    for (size_t x = margin * 4; x < (left->GetWidth() - margin) * 4; x++) {
+      int difference = std::abs(static_cast<int>(left_row[x]) - right_row[x]);
+      result.max_channel_difference =
+          std::max(result.max_channel_difference, difference);
+      tally += difference * difference;
+      channels++;
+    }
+  }
+  result.rms_channel_difference = std::sqrt(tally / channels);
+  return result;
+}
+
+}  // namespace
+
+// Makes sure the downsample pyramid is visually close to the separable kernel
+// by rendering the same sigma with both of them.
+TEST_P(DlGoldenTest, PyramidMatchesSeparableExperimentPyramidBlur) {
+  impeller::Point content_scale = GetContentScale();
+  auto draw = [&](DlCanvas* canvas, const std::vector<sk_sp<DlImage>>& images,
+                  float device_sigma, DlTileMode tile_mode) {
+    canvas->DrawColor(DlColor(0xff111111));
+    canvas->Scale(content_scale.x, content_scale.y);
+
+    DlPaint paint;
+    canvas->DrawImage(images[0], DlPoint(0, 0), DlImageSampling::kLinear,
+                      &paint);
+
+    // Undo the content scale so the sigma lands where intended in device
+    // space regardless of the display density.
+    float sigma = device_sigma / content_scale.x;
+    auto blur = DlImageFilter::MakeBlur(sigma, sigma, tile_mode);
+    canvas->SaveLayer(std::nullopt, /*paint=*/nullptr, blur.get());
+    canvas->Restore();
+  };
+
+  std::vector<sk_sp<DlImage>> images;
+  images.emplace_back(CreateDlImageForFixture("boston.jpg"));
+
+  auto make_screenshot = [&](float device_sigma, DlTileMode tile_mode) {
+    DisplayListBuilder builder;
+    draw(&builder, images, device_sigma, tile_mode);
+    return MakeScreenshot(builder.Build());
+  };
+
+  // After scaling, this is well above impeller::kGaussianBlurPyramidMinSigma.
+  // The pyramid only implements the clamp tile mode, so the decal blur of the
+  // same sigma is rendered with the separable kernel.
+  const float device_sigma = 32.0f;
+  std::unique_ptr<impeller::testing::Screenshot> pyramid =
+      make_screenshot(device_sigma, DlTileMode::kClamp);
+  if (!pyramid) {
+    GTEST_SKIP() << "making screenshots not supported.";
+  }
+  std::unique_ptr<impeller::testing::Screenshot> separable =
+      make_screenshot(device_sigma, DlTileMode::kDecal);
+  ASSERT_TRUE(separable);
+
+  // The tile modes only differ within a few sigmas of the edges of the
+  // screen, which are left out of the comparison.
+  PixelDifference difference =
+      CompareInterior(pyramid.get(), separable.get(),
+                      /*margin=*/static_cast<size_t>(device_sigma * 4));
+  EXPECT_LE(difference.max_channel_difference, 16)
+      << "rms: " << difference.rms_channel_difference;
+  EXPECT_LT(difference.rms_channel_difference, 2.0)
+      << "max: " << difference.max_channel_difference;
+}
+
 TEST_P(DlGoldenTest, StrokedRRectFastBlur) {
   impeller::Point content_scale = GetContentScale();
   DlRect rect = DlRect::MakeXYWH(50, 50, 100, 100);
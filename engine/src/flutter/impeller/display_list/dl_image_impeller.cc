@@ -83,6 +83,11 @@ DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
 // |DlImage|
 DlImageImpeller::~DlImageImpeller() = default;
 
+void DlImageImpeller::ReportMemoryUsage(fml::MemoryCategory category) {
+  memory_usage_ = std::make_unique<fml::MemoryUsageCounter>(category);
+  memory_usage_->Set(GetApproximateByteSize());
+}
+
 // |DlImage|
 sk_sp<SkImage> DlImageImpeller::skia_image() const {
   return nullptr;
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_DISPLAY_LIST_DL_IMAGE_IMPELLER_H_
 
 #include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/core/texture.h"
 
 namespace impeller {
@@ -56,6 +57,12 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   OwningContext owning_context() const override { return owning_context_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Counts the texture of this image towards |category| for as
+  ///             long as the image is alive.
+  ///
+  void ReportMemoryUsage(fml::MemoryCategory category);
+
 #if FML_OS_IOS_SIMULATOR
   // |DlImage|
   bool IsFakeImage() const override { return is_fake_image_; }
@@ -64,6 +71,7 @@ class DlImageImpeller final : public flutter::DlImage {
  private:
   std::shared_ptr<Texture> texture_;
   OwningContext owning_context_;
+  std::unique_ptr<fml::MemoryUsageCounter> memory_usage_;
 #if FML_OS_IOS_SIMULATOR
   bool is_fake_image_ = false;
 #endif  // FML_OS_IOS_SIMULATOR
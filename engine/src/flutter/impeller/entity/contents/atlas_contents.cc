@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include <optional>
+#include <utility>
 
+#include "flutter/fml/logging.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -137,6 +139,122 @@ std::optional<Rect> DrawImageRectAtlasGeometry::GetStrictSrcRect() const {
 
 ////
 
+BatchedImageRectAtlasGeometry::BatchedImageRectAtlasGeometry(
+    std::shared_ptr<Texture> texture,
+    std::vector<Rect> sources,
+    std::vector<Rect> destinations,
+    const SamplerDescriptor& desc)
+    : texture_(std::move(texture)),
+      sources_(std::move(sources)),
+      destinations_(std::move(destinations)),
+      desc_(desc) {
+  FML_DCHECK(sources_.size() == destinations_.size());
+}
+
+BatchedImageRectAtlasGeometry::~BatchedImageRectAtlasGeometry() = default;
+
+bool BatchedImageRectAtlasGeometry::ShouldUseBlend() const {
+  return false;
+}
+
+bool BatchedImageRectAtlasGeometry::ShouldSkip() const {
+  return destinations_.empty();
+}
+
+VertexBuffer BatchedImageRectAtlasGeometry::CreateSimpleVertexBuffer(
+    HostBuffer& data_host_buffer) const {
+  using VS = TextureFillVertexShader;
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+
+  BufferView buffer_view = data_host_buffer.Emplace(
+      sizeof(VS::PerVertexData) * destinations_.size() * 6,
+      alignof(VS::PerVertexData), [&](uint8_t* raw_data) {
+        VS::PerVertexData* data =
+            reinterpret_cast<VS::PerVertexData*>(raw_data);
+        Rect texture_rect = Rect::MakeSize(texture_->GetSize());
+        int offset = 0;
+        for (size_t i = 0; i < destinations_.size(); i++) {
+          std::array<TPoint<float>, 4> destination_points =
+              destinations_[i].GetPoints();
+          std::array<TPoint<float>, 4> texture_coords =
+              texture_rect.Project(sources_[i]).GetPoints();
+          for (size_t j = 0; j < 6; j++) {
+            data[offset].position = destination_points[indices[j]];
+            data[offset].texture_coords = texture_coords[indices[j]];
+            offset++;
+          }
+        }
+      });
+
+  return VertexBuffer{
+      .vertex_buffer = buffer_view,
+      .index_buffer = {},
+      .vertex_count = destinations_.size() * 6,
+      .index_type = IndexType::kNone,
+  };
+}
+
+VertexBuffer BatchedImageRectAtlasGeometry::CreateBlendVertexBuffer(
+    HostBuffer& data_host_buffer) const {
+  using VS = PorterDuffBlendVertexShader;
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+
+  BufferView buffer_view = data_host_buffer.Emplace(
+      sizeof(VS::PerVertexData) * destinations_.size() * 6,
+      alignof(VS::PerVertexData), [&](uint8_t* raw_data) {
+        VS::PerVertexData* data =
+            reinterpret_cast<VS::PerVertexData*>(raw_data);
+        Rect texture_rect = Rect::MakeSize(texture_->GetSize());
+        int offset = 0;
+        for (size_t i = 0; i < destinations_.size(); i++) {
+          std::array<TPoint<float>, 4> texture_coords =
+              texture_rect.Project(sources_[i]).GetPoints();
+          std::array<TPoint<float>, 4> destination_points =
+              destinations_[i].GetPoints();
+          for (size_t j = 0; j < 6; j++) {
+            data[offset].vertices = destination_points[indices[j]];
+            data[offset].texture_coords = texture_coords[indices[j]];
+            data[offset].color = Color::White();
+            offset++;
+          }
+        }
+      });
+
+  return VertexBuffer{
+      .vertex_buffer = buffer_view,
+      .index_buffer = {},
+      .vertex_count = destinations_.size() * 6,
+      .index_type = IndexType::kNone,
+  };
+}
+
+Rect BatchedImageRectAtlasGeometry::ComputeBoundingBox() const {
+  if (destinations_.empty()) {
+    return Rect();
+  }
+  Rect bounding_box = destinations_[0];
+  for (size_t i = 1; i < destinations_.size(); i++) {
+    bounding_box = bounding_box.Union(destinations_[i]);
+  }
+  return bounding_box;
+}
+
+const std::shared_ptr<Texture>& BatchedImageRectAtlasGeometry::GetAtlas()
+    const {
+  return texture_;
+}
+
+const SamplerDescriptor& BatchedImageRectAtlasGeometry::GetSamplerDescriptor()
+    const {
+  return desc_;
+}
+
+BlendMode BatchedImageRectAtlasGeometry::GetBlendMode() const {
+  return BlendMode::kSrcOver;
+}
+
+////
+
 AtlasContents::AtlasContents() = default;
 
 AtlasContents::~AtlasContents() = default;
@@ -156,6 +274,10 @@ void AtlasContents::SetAlpha(Scalar alpha) {
   alpha_ = alpha;
 }
 
+void AtlasContents::SetInheritedOpacity(Scalar opacity) {
+  alpha_ *= opacity;
+}
+
 bool AtlasContents::Render(const ContentContext& renderer,
                            const Entity& entity,
                            RenderPass& pass) const {
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_ATLAS_CONTENTS_H_
 
 #include <memory>
+#include <vector>
 
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/contents.h"
@@ -90,6 +91,40 @@ class DrawImageRectAtlasGeometry : public AtlasGeometry {
   const bool use_strict_src_rect_;
 };
 
+/// @brief An atlas geometry for a run of drawImageRect calls that sample the
+///        same texture with the same sampler, see `Canvas::DrawImageRect`.
+class BatchedImageRectAtlasGeometry : public AtlasGeometry {
+ public:
+  BatchedImageRectAtlasGeometry(std::shared_ptr<Texture> texture,
+                                std::vector<Rect> sources,
+                                std::vector<Rect> destinations,
+                                const SamplerDescriptor& desc);
+
+  ~BatchedImageRectAtlasGeometry();
+
+  bool ShouldUseBlend() const override;
+
+  bool ShouldSkip() const override;
+
+  VertexBuffer CreateSimpleVertexBuffer(HostBuffer& host_buffer) const override;
+
+  VertexBuffer CreateBlendVertexBuffer(HostBuffer& host_buffer) const override;
+
+  Rect ComputeBoundingBox() const override;
+
+  const std::shared_ptr<Texture>& GetAtlas() const override;
+
+  const SamplerDescriptor& GetSamplerDescriptor() const override;
+
+  BlendMode GetBlendMode() const override;
+
+ private:
+  const std::shared_ptr<Texture> texture_;
+  const std::vector<Rect> sources_;
+  const std::vector<Rect> destinations_;
+  const SamplerDescriptor desc_;
+};
+
 class AtlasContents final : public Contents {
  public:
   explicit AtlasContents();
@@ -108,6 +143,9 @@ class AtlasContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  void SetInheritedOpacity(Scalar opacity) override;
+
  private:
   AtlasGeometry* geometry_ = nullptr;
   Scalar alpha_ = 1.0;
@@ -6,6 +6,7 @@
 
 #include <format>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "fml/trace_event.h"
@@ -21,6 +22,7 @@
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/texture_util.h"
 #include "impeller/tessellator/tessellator.h"
@@ -30,9 +32,61 @@ namespace impeller {
 
 namespace {
 
+class GenericVariants;
+
+/// Tracks all variant containers of a content context and records which
+/// variants were requested during its first frames.
+class VariantsRegistry {
+ public:
+  void Register(GenericVariants* variants) { variants_.push_back(variants); }
+
+  const std::vector<GenericVariants*>& GetVariants() const { return variants_; }
+
+  void StartRecording(size_t frame_count) { frames_remaining_ = frame_count; }
+
+  bool IsRecording() const { return frames_remaining_ > 0u; }
+
+  void RecordUsage(const GenericVariants& variants,
+                   const ContentContextOptions& options);
+
+  /// Returns the record once the last frame to record has ended.
+  std::optional<PipelineUsageRecord> MarkFrameEnd();
+
+ private:
+  std::vector<GenericVariants*> variants_;
+  size_t frames_remaining_ = 0u;
+  std::set<std::pair<const GenericVariants*, uint64_t>> recorded_;
+  PipelineUsageRecord record_;
+};
+
+/// The name of the family of pipelines created from a default pipeline
+/// descriptor. Several containers share the same shaders and only differ in
+/// their specialization constants, so those are part of the name.
+std::string GetVariantsFamily(const PipelineDescriptor& desc) {
+  std::string family = desc.GetLabel();
+  for (Scalar constant : desc.GetSpecializationConstants()) {
+    family += std::format(" {}", constant);
+  }
+  return family;
+}
+
 /// A generic version of `Variants` which mostly exists to reduce code size.
 class GenericVariants {
  public:
+  explicit GenericVariants(VariantsRegistry& registry) : registry_(registry) {
+    registry_.Register(this);
+  }
+
+  virtual ~GenericVariants() = default;
+
+  /// Start creating the pipeline for the given options in the background
+  /// unless it already exists.
+  ///
+  /// Returns the descriptor of the pipeline for the options.
+  virtual std::optional<PipelineDescriptor> Prewarm(
+      const Context& context,
+      const ContentContextOptions& options) = 0;
+
   void Set(const ContentContextOptions& options,
            std::unique_ptr<GenericRenderPipelineHandle> pipeline) {
     uint64_t p_key = options.ToKey();
@@ -63,9 +117,20 @@ class GenericVariants {
   }
 
   void SetDefaultDescriptor(std::optional<PipelineDescriptor> desc) {
+    family_ = desc.has_value() ? GetVariantsFamily(desc.value()) : "";
     desc_ = std::move(desc);
   }
 
+  /// A name for this container that is stable across runs. Empty if there is
+  /// no default descriptor.
+  const std::string& GetFamily() const { return family_; }
+
+  void RecordUsage(const ContentContextOptions& options) const {
+    if (registry_.IsRecording()) {
+      registry_.RecordUsage(*this, options);
+    }
+  }
+
   size_t GetPipelineCount() const { return pipelines_.size(); }
 
   bool IsDefault(const ContentContextOptions& opts) {
@@ -74,12 +139,37 @@ class GenericVariants {
   }
 
  protected:
+  VariantsRegistry& registry_;
   std::optional<PipelineDescriptor> desc_;
+  std::string family_;
   std::optional<ContentContextOptions> default_options_;
   std::vector<std::pair<uint64_t, std::unique_ptr<GenericRenderPipelineHandle>>>
       pipelines_;
 };
 
+void VariantsRegistry::RecordUsage(const GenericVariants& variants,
+                                   const ContentContextOptions& options) {
+  if (variants.GetFamily().empty()) {
+    return;
+  }
+  if (recorded_.emplace(&variants, options.ToKey()).second) {
+    record_.Add(variants.GetFamily(), options.ToKey());
+  }
+}
+
+std::optional<PipelineUsageRecord> VariantsRegistry::MarkFrameEnd() {
+  if (frames_remaining_ == 0u || --frames_remaining_ > 0u) {
+    return std::nullopt;
+  }
+  recorded_.clear();
+  if (record_.IsEmpty()) {
+    // Don't replace the record of a previous run with one that has nothing
+    // to offer.
+    return std::nullopt;
+  }
+  return std::move(record_);
+}
+
 /// Holds multiple Pipelines associated with the same PipelineHandle types.
 ///
 /// For example, it may have multiple
@@ -103,7 +193,7 @@ class Variants : public GenericVariants {
       "vertex shader's output slots. This will result in a linker error.");
 
  public:
-  Variants() = default;
+  explicit Variants(VariantsRegistry& registry) : GenericVariants(registry) {}
 
   void Set(const ContentContextOptions& options,
            std::unique_ptr<PipelineHandleT> pipeline) {
@@ -127,7 +217,7 @@ class Variants : public GenericVariants {
     }
     context.GetPipelineLibrary()->LogPipelineCreation(*desc);
     options.ApplyToPipelineDescriptor(*desc);
-    desc_ = desc;
+    SetDefaultDescriptor(desc);
     SetDefault(options, std::make_unique<PipelineHandleT>(context, desc_,
                                                           /*async=*/true));
   }
@@ -150,6 +240,25 @@ class Variants : public GenericVariants {
     return Get(default_options_.value());
   }
 
+  std::optional<PipelineDescriptor> Prewarm(
+      const Context& context,
+      const ContentContextOptions& options) override {
+    if (GenericRenderPipelineHandle* existing = GenericVariants::Get(options)) {
+      return existing->GetDescriptor();
+    }
+    if (!desc_.has_value()) {
+      return std::nullopt;
+    }
+    // Mirrors the variant creation in `CreateIfNeeded` but doesn't wait for
+    // the default pipeline or the variant itself.
+    PipelineDescriptor desc = desc_.value();
+    options.ApplyToPipelineDescriptor(desc);
+    desc.SetLabel(std::format("{} V#{}", desc.GetLabel(), GetPipelineCount()));
+    Set(options,
+        std::make_unique<PipelineHandleT>(context, desc, /*async=*/true));
+    return desc;
+  }
+
  private:
   Variants(const Variants&) = delete;
 
@@ -208,115 +317,152 @@ PipelineRef GetPipeline(const ContentContext* context,
   if (!pipeline) {
     return raw_ptr<Pipeline<PipelineDescriptor>>();
   }
+  container.RecordUsage(opts);
   return raw_ptr(pipeline->WaitAndGet(compile_queue));
 }
 
 }  // namespace
 
 struct ContentContext::Pipelines {
+  // Must be declared before all variants.
+  VariantsRegistry registry;
+
   // clang-format off
-  Variants<BlendColorBurnPipeline> blend_colorburn;
-  Variants<BlendColorDodgePipeline> blend_colordodge;
-  Variants<BlendColorPipeline> blend_color;
-  Variants<BlendDarkenPipeline> blend_darken;
-  Variants<BlendDifferencePipeline> blend_difference;
-  Variants<BlendExclusionPipeline> blend_exclusion;
-  Variants<BlendHardLightPipeline> blend_hardlight;
-  Variants<BlendHuePipeline> blend_hue;
-  Variants<BlendLightenPipeline> blend_lighten;
-  Variants<BlendLuminosityPipeline> blend_luminosity;
-  Variants<BlendMultiplyPipeline> blend_multiply;
-  Variants<BlendOverlayPipeline> blend_overlay;
-  Variants<BlendSaturationPipeline> blend_saturation;
-  Variants<BlendScreenPipeline> blend_screen;
-  Variants<BlendSoftLightPipeline> blend_softlight;
-  Variants<BorderMaskBlurPipeline> border_mask_blur;
-  Variants<CirclePipeline> circle;
-  Variants<ClipPipeline> clip;
-  Variants<ColorMatrixColorFilterPipeline> color_matrix_color_filter;
-  Variants<ConicalGradientFillConicalPipeline> conical_gradient_fill;
-  Variants<ConicalGradientFillRadialPipeline> conical_gradient_fill_radial;
-  Variants<ConicalGradientFillStripPipeline> conical_gradient_fill_strip;
-  Variants<ConicalGradientFillStripRadialPipeline> conical_gradient_fill_strip_and_radial;
-  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill;
-  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_radial;
-  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_strip_and_radial;
-  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_strip;
-  Variants<ConicalGradientUniformFillConicalPipeline> conical_gradient_uniform_fill;
-  Variants<ConicalGradientUniformFillRadialPipeline> conical_gradient_uniform_fill_radial;
-  Variants<ConicalGradientUniformFillStripPipeline> conical_gradient_uniform_fill_strip;
-  Variants<ConicalGradientUniformFillStripRadialPipeline> conical_gradient_uniform_fill_strip_and_radial;
-  Variants<FastGradientPipeline> fast_gradient;
-  Variants<FramebufferBlendColorBurnPipeline> framebuffer_blend_colorburn;
-  Variants<FramebufferBlendColorDodgePipeline> framebuffer_blend_colordodge;
-  Variants<FramebufferBlendColorPipeline> framebuffer_blend_color;
-  Variants<FramebufferBlendDarkenPipeline> framebuffer_blend_darken;
-  Variants<FramebufferBlendDifferencePipeline> framebuffer_blend_difference;
-  Variants<FramebufferBlendExclusionPipeline> framebuffer_blend_exclusion;
-  Variants<FramebufferBlendHardLightPipeline> framebuffer_blend_hardlight;
-  Variants<FramebufferBlendHuePipeline> framebuffer_blend_hue;
-  Variants<FramebufferBlendLightenPipeline> framebuffer_blend_lighten;
-  Variants<FramebufferBlendLuminosityPipeline> framebuffer_blend_luminosity;
-  Variants<FramebufferBlendMultiplyPipeline> framebuffer_blend_multiply;
-  Variants<FramebufferBlendOverlayPipeline> framebuffer_blend_overlay;
-  Variants<FramebufferBlendSaturationPipeline> framebuffer_blend_saturation;
-  Variants<FramebufferBlendScreenPipeline> framebuffer_blend_screen;
-  Variants<FramebufferBlendSoftLightPipeline> framebuffer_blend_softlight;
-  Variants<GaussianBlurPipeline> gaussian_blur;
-  Variants<GlyphAtlasPipeline> glyph_atlas;
-  Variants<LinePipeline> line;
-  Variants<LinearGradientFillPipeline> linear_gradient_fill;
-  Variants<LinearGradientSSBOFillPipeline> linear_gradient_ssbo_fill;
-  Variants<LinearGradientUniformFillPipeline> linear_gradient_uniform_fill;
-  Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter;
-  Variants<MorphologyFilterPipeline> morphology_filter;
-  Variants<PorterDuffBlendPipeline> clear_blend;
-  Variants<PorterDuffBlendPipeline> destination_a_top_blend;
-  Variants<PorterDuffBlendPipeline> destination_blend;
-  Variants<PorterDuffBlendPipeline> destination_in_blend;
-  Variants<PorterDuffBlendPipeline> destination_out_blend;
-  Variants<PorterDuffBlendPipeline> destination_over_blend;
-  Variants<PorterDuffBlendPipeline> modulate_blend;
-  Variants<PorterDuffBlendPipeline> plus_blend;
-  Variants<PorterDuffBlendPipeline> screen_blend;
-  Variants<PorterDuffBlendPipeline> source_a_top_blend;
-  Variants<PorterDuffBlendPipeline> source_blend;
-  Variants<PorterDuffBlendPipeline> source_in_blend;
-  Variants<PorterDuffBlendPipeline> source_out_blend;
-  Variants<PorterDuffBlendPipeline> source_over_blend;
-  Variants<PorterDuffBlendPipeline> xor_blend;
-  Variants<RadialGradientFillPipeline> radial_gradient_fill;
-  Variants<RadialGradientSSBOFillPipeline> radial_gradient_ssbo_fill;
-  Variants<RadialGradientUniformFillPipeline> radial_gradient_uniform_fill;
-  Variants<RRectBlurPipeline> rrect_blur;
-  Variants<RSuperellipseBlurPipeline> rsuperellipse_blur;
-  Variants<ShadowVerticesShader> shadow_vertices_;
-  Variants<SolidFillPipeline> solid_fill;
-  Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter;
-  Variants<SweepGradientFillPipeline> sweep_gradient_fill;
-  Variants<SweepGradientSSBOFillPipeline> sweep_gradient_ssbo_fill;
-  Variants<SweepGradientUniformFillPipeline> sweep_gradient_uniform_fill;
-  Variants<TextureDownsamplePipeline> texture_downsample;
-  Variants<TextureDownsampleBoundedPipeline> texture_downsample_bounded;
-  Variants<TexturePipeline> texture;
-  Variants<TextureStrictSrcPipeline> texture_strict_src;
-  Variants<TiledTexturePipeline> tiled_texture;
-  Variants<VerticesUber1Shader> vertices_uber_1_;
-  Variants<VerticesUber2Shader> vertices_uber_2_;
-  Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter;
+  Variants<BlendColorBurnPipeline> blend_colorburn{registry};
+  Variants<BlendColorDodgePipeline> blend_colordodge{registry};
+  Variants<BlendColorPipeline> blend_color{registry};
+  Variants<BlendDarkenPipeline> blend_darken{registry};
+  Variants<BlendDifferencePipeline> blend_difference{registry};
+  Variants<BlendExclusionPipeline> blend_exclusion{registry};
+  Variants<BlendHardLightPipeline> blend_hardlight{registry};
+  Variants<BlendHuePipeline> blend_hue{registry};
+  Variants<BlendLightenPipeline> blend_lighten{registry};
+  Variants<BlendLuminosityPipeline> blend_luminosity{registry};
+  Variants<BlendMultiplyPipeline> blend_multiply{registry};
+  Variants<BlendOverlayPipeline> blend_overlay{registry};
+  Variants<BlendSaturationPipeline> blend_saturation{registry};
+  Variants<BlendScreenPipeline> blend_screen{registry};
+  Variants<BlendSoftLightPipeline> blend_softlight{registry};
+  Variants<BorderMaskBlurPipeline> border_mask_blur{registry};
+  Variants<CirclePipeline> circle{registry};
+  Variants<ClipPipeline> clip{registry};
+  Variants<ColorMatrixColorFilterPipeline> color_matrix_color_filter{registry};
+  Variants<ConicalGradientFillConicalPipeline> conical_gradient_fill{registry};
+  Variants<ConicalGradientFillRadialPipeline> conical_gradient_fill_radial{registry};
+  Variants<ConicalGradientFillStripPipeline> conical_gradient_fill_strip{registry};
+  Variants<ConicalGradientFillStripRadialPipeline> conical_gradient_fill_strip_and_radial{registry};
+  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill{registry};
+  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_radial{registry};
+  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_strip_and_radial{registry};
+  Variants<ConicalGradientSSBOFillPipeline> conical_gradient_ssbo_fill_strip{registry};
+  Variants<ConicalGradientUniformFillConicalPipeline> conical_gradient_uniform_fill{registry};
+  Variants<ConicalGradientUniformFillRadialPipeline> conical_gradient_uniform_fill_radial{registry};
+  Variants<ConicalGradientUniformFillStripPipeline> conical_gradient_uniform_fill_strip{registry};
+  Variants<ConicalGradientUniformFillStripRadialPipeline> conical_gradient_uniform_fill_strip_and_radial{registry};
+  Variants<FastGradientPipeline> fast_gradient{registry};
+  Variants<FramebufferBlendColorBurnPipeline> framebuffer_blend_colorburn{registry};
+  Variants<FramebufferBlendColorDodgePipeline> framebuffer_blend_colordodge{registry};
+  Variants<FramebufferBlendColorPipeline> framebuffer_blend_color{registry};
+  Variants<FramebufferBlendDarkenPipeline> framebuffer_blend_darken{registry};
+  Variants<FramebufferBlendDifferencePipeline> framebuffer_blend_difference{registry};
+  Variants<FramebufferBlendExclusionPipeline> framebuffer_blend_exclusion{registry};
+  Variants<FramebufferBlendHardLightPipeline> framebuffer_blend_hardlight{registry};
+  Variants<FramebufferBlendHuePipeline> framebuffer_blend_hue{registry};
+  Variants<FramebufferBlendLightenPipeline> framebuffer_blend_lighten{registry};
+  Variants<FramebufferBlendLuminosityPipeline> framebuffer_blend_luminosity{registry};
+  Variants<FramebufferBlendMultiplyPipeline> framebuffer_blend_multiply{registry};
+  Variants<FramebufferBlendOverlayPipeline> framebuffer_blend_overlay{registry};
+  Variants<FramebufferBlendSaturationPipeline> framebuffer_blend_saturation{registry};
+  Variants<FramebufferBlendScreenPipeline> framebuffer_blend_screen{registry};
+  Variants<FramebufferBlendSoftLightPipeline> framebuffer_blend_softlight{registry};
+  Variants<GaussianBlurPipeline> gaussian_blur{registry};
+  Variants<GlyphAtlasPipeline> glyph_atlas{registry};
+  Variants<KawaseDownsamplePipeline> kawase_downsample{registry};
+  Variants<KawaseUpsamplePipeline> kawase_upsample{registry};
+  Variants<LinePipeline> line{registry};
+  Variants<LinearGradientFillPipeline> linear_gradient_fill{registry};
+  Variants<LinearGradientSSBOFillPipeline> linear_gradient_ssbo_fill{registry};
+  Variants<LinearGradientUniformFillPipeline> linear_gradient_uniform_fill{registry};
+  Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter{registry};
+  Variants<MorphologyFilterPipeline> morphology_filter{registry};
+  Variants<PorterDuffBlendPipeline> clear_blend{registry};
+  Variants<PorterDuffBlendPipeline> destination_a_top_blend{registry};
+  Variants<PorterDuffBlendPipeline> destination_blend{registry};
+  Variants<PorterDuffBlendPipeline> destination_in_blend{registry};
+  Variants<PorterDuffBlendPipeline> destination_out_blend{registry};
+  Variants<PorterDuffBlendPipeline> destination_over_blend{registry};
+  Variants<PorterDuffBlendPipeline> modulate_blend{registry};
+  Variants<PorterDuffBlendPipeline> plus_blend{registry};
+  Variants<PorterDuffBlendPipeline> screen_blend{registry};
+  Variants<PorterDuffBlendPipeline> source_a_top_blend{registry};
+  Variants<PorterDuffBlendPipeline> source_blend{registry};
+  Variants<PorterDuffBlendPipeline> source_in_blend{registry};
+  Variants<PorterDuffBlendPipeline> source_out_blend{registry};
+  Variants<PorterDuffBlendPipeline> source_over_blend{registry};
+  Variants<PorterDuffBlendPipeline> xor_blend{registry};
+  Variants<RadialGradientFillPipeline> radial_gradient_fill{registry};
+  Variants<RadialGradientSSBOFillPipeline> radial_gradient_ssbo_fill{registry};
+  Variants<RadialGradientUniformFillPipeline> radial_gradient_uniform_fill{registry};
+  Variants<RRectBlurPipeline> rrect_blur{registry};
+  Variants<RSuperellipseBlurPipeline> rsuperellipse_blur{registry};
+  Variants<ShadowVerticesShader> shadow_vertices_{registry};
+  Variants<SolidFillPipeline> solid_fill{registry};
+  Variants<SolidFillInstancedPipeline> solid_fill_instanced{registry};
+  Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter{registry};
+  Variants<SweepGradientFillPipeline> sweep_gradient_fill{registry};
+  Variants<SweepGradientSSBOFillPipeline> sweep_gradient_ssbo_fill{registry};
+  Variants<SweepGradientUniformFillPipeline> sweep_gradient_uniform_fill{registry};
+  Variants<TextureDownsamplePipeline> texture_downsample{registry};
+  Variants<TextureDownsampleBoundedPipeline> texture_downsample_bounded{registry};
+  Variants<TexturePipeline> texture{registry};
+  Variants<TextureStrictSrcPipeline> texture_strict_src{registry};
+  Variants<TiledTexturePipeline> tiled_texture{registry};
+  Variants<VerticesUber1Shader> vertices_uber_1_{registry};
+  Variants<VerticesUber2Shader> vertices_uber_2_{registry};
+  Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter{registry};
 
 // Web doesn't support external texture OpenGL extensions
 #if defined(IMPELLER_ENABLE_OPENGLES) && !defined(FML_OS_EMSCRIPTEN)
-  Variants<TiledTextureExternalPipeline> tiled_texture_external;
-  Variants<TiledTextureUvExternalPipeline> tiled_texture_uv_external;
+  Variants<TiledTextureExternalPipeline> tiled_texture_external{registry};
+  Variants<TiledTextureUvExternalPipeline> tiled_texture_uv_external{registry};
 #endif
 
 #if defined(IMPELLER_ENABLE_OPENGLES)
-  Variants<TextureDownsampleGlesPipeline> texture_downsample_gles;
+  Variants<TextureDownsampleGlesPipeline> texture_downsample_gles{registry};
 #endif  // IMPELLER_ENABLE_OPENGLES
   // clang-format on
 };
 
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  auto field = [key](int shift) -> uint8_t { return (key >> shift) & 0xFF; };
+  if (field(8) > static_cast<uint8_t>(PixelFormat::kD32FloatS8UInt) ||
+      field(16) > static_cast<uint8_t>(PrimitiveType::kTriangleFan) ||
+      field(24) > static_cast<uint8_t>(StencilMode::kCoverCompareInverted) ||
+      field(32) > static_cast<uint8_t>(CompareFunction::kGreaterEqual) ||
+      field(40) > static_cast<uint8_t>(BlendMode::kLastMode) ||
+      (field(48) != static_cast<uint8_t>(SampleCount::kCount1) &&
+       field(48) != static_cast<uint8_t>(SampleCount::kCount4))) {
+    return std::nullopt;
+  }
+  ContentContextOptions options{
+      .sample_count = static_cast<SampleCount>(field(48)),
+      .blend_mode = static_cast<BlendMode>(field(40)),
+      .depth_compare = static_cast<CompareFunction>(field(32)),
+      .stencil_mode = static_cast<StencilMode>(field(24)),
+      .primitive_type = static_cast<PrimitiveType>(field(16)),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(field(8)),
+      .has_depth_stencil_attachments = ((key >> 2) & 1u) != 0u,
+      .depth_write_enabled = ((key >> 3) & 1u) != 0u,
+      .is_for_rrect_blur_clear = (key & 1u) != 0u,
+  };
+  // Catches any bits `ToKey` never sets.
+  if (options.ToKey() != key) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -564,7 +710,8 @@ ContentContext::ContentContext(
           context_->GetResourceAllocator(),
           context_->GetIdleWaiter(),
           context_->GetCapabilities()->GetMinimumUniformAlignment())),
-      text_shadow_cache_(std::make_unique<TextShadowCache>()) {
+      text_shadow_cache_(std::make_unique<TextShadowCache>()),
+      gradient_texture_cache_(std::make_unique<GradientTextureCache>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -647,6 +794,7 @@ ContentContext::ContentContext(
       pipelines_->conical_gradient_ssbo_fill_strip_and_radial.CreateDefault(
           *context_, options, {0.0});
       pipelines_->sweep_gradient_ssbo_fill.CreateDefault(*context_, options);
+      pipelines_->solid_fill_instanced.CreateDefault(*context_, options);
     } else {
       pipelines_->linear_gradient_uniform_fill.CreateDefault(*context_,
                                                              options);
@@ -692,6 +840,7 @@ ContentContext::ContentContext(
     }
     clip_pipeline_descriptor->SetColorAttachmentDescriptors(
         std::move(clip_color_attachments));
+    pipelines_->clip.SetDefaultDescriptor(clip_pipeline_descriptor);
     pipelines_->clip.SetDefault(
         options,
         std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor));
@@ -707,6 +856,12 @@ ContentContext::ContentContext(
                                             {supports_decal});
     pipelines_->gaussian_blur.CreateDefault(
         *context_, options_no_msaa_no_depth_stencil, {supports_decal});
+    if (context_->GetFlags().pyramid_blur) {
+      pipelines_->kawase_downsample.CreateDefault(
+          *context_, options_no_msaa_no_depth_stencil, {supports_decal});
+      pipelines_->kawase_upsample.CreateDefault(
+          *context_, options_no_msaa_no_depth_stencil, {supports_decal});
+    }
     pipelines_->border_mask_blur.CreateDefault(*context_,
                                                options_trianglestrip);
     pipelines_->color_matrix_color_filter.CreateDefault(*context_,
@@ -867,10 +1022,102 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_OPENGLES
   }
 
+  PrewarmPersistedPipelines();
+  pipelines_->registry.StartRecording(kPipelineUsageRecordFrameCount);
+
   is_valid_ = true;
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
+void ContentContext::PrewarmPersistedPipelines() {
+  const std::shared_ptr<PipelineLibrary>& library =
+      context_->GetPipelineLibrary();
+  std::optional<PipelineUsageRecord> record =
+      library->GetPersistedPipelineUsage();
+  if (!record.has_value()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::PrewarmPersistedPipelines");
+
+  std::unordered_map<std::string_view, GenericVariants*> variants_by_family;
+  for (GenericVariants* variants : pipelines_->registry.GetVariants()) {
+    if (!variants->GetFamily().empty()) {
+      variants_by_family.emplace(variants->GetFamily(), variants);
+    }
+  }
+
+  std::vector<PipelineDescriptor> descriptors;
+  for (const PipelineUsageRecord::Entry& entry : record->GetEntries()) {
+    auto found = variants_by_family.find(entry.family);
+    if (found == variants_by_family.end()) {
+      continue;
+    }
+    std::optional<ContentContextOptions> options =
+        ContentContextOptions::FromKey(entry.variant_key);
+    if (!options.has_value()) {
+      continue;
+    }
+    std::optional<PipelineDescriptor> desc =
+        found->second->Prewarm(*context_, options.value());
+    if (desc.has_value()) {
+      descriptors.push_back(std::move(desc.value()));
+    }
+  }
+
+  // The defaults were posted in the order they are likely to be needed in
+  // general. The record knows better.
+  if (PipelineCompileQueue* compile_queue =
+          library->GetPipelineCompileQueue()) {
+    compile_queue->PrioritizeJobs(descriptors);
+  }
+}
+
+size_t ContentContext::CreatePipelineVariants(
+    const std::vector<ContentContextOptions>& options_list) {
+  TRACE_EVENT0("impeller", "ContentContext::CreatePipelineVariants");
+  if (!IsValid()) {
+    return 0u;
+  }
+  const std::shared_ptr<PipelineLibrary>& library =
+      context_->GetPipelineLibrary();
+
+  // Post everything before waiting on anything so that all workers are kept
+  // busy.
+  std::vector<PipelineDescriptor> descriptors;
+  for (GenericVariants* variants : pipelines_->registry.GetVariants()) {
+    for (const ContentContextOptions& options : options_list) {
+      std::optional<PipelineDescriptor> desc =
+          variants->Prewarm(*context_, options);
+      if (desc.has_value()) {
+        descriptors.push_back(std::move(desc.value()));
+      }
+    }
+  }
+
+  PipelineCompileQueue* compile_queue = library->GetPipelineCompileQueue();
+  size_t created = 0u;
+  for (const PipelineDescriptor& desc : descriptors) {
+    if (compile_queue) {
+      compile_queue->PerformJobEagerly(desc);
+    }
+    // The library hands out the future of the pipeline that is already being
+    // created for this descriptor.
+    std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+        library->GetPipeline(desc).Get();
+    if (pipeline && pipeline->IsValid()) {
+      created++;
+    }
+  }
+  return created;
+}
+
+void ContentContext::MarkFrameEnd() {
+  if (std::optional<PipelineUsageRecord> record =
+          pipelines_->registry.MarkFrameEnd()) {
+    context_->GetPipelineLibrary()->PersistPipelineUsage(record.value());
+  }
+}
+
 ContentContext::~ContentContext() = default;
 
 bool ContentContext::IsValid() const {
@@ -1138,6 +1385,12 @@ PipelineRef ContentContext::GetSolidFillPipeline(
   return GetPipeline(this, pipelines_->solid_fill, opts);
 }
 
+PipelineRef ContentContext::GetSolidFillInstancedPipeline(
+    ContentContextOptions opts) const {
+  FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+  return GetPipeline(this, pipelines_->solid_fill_instanced, opts);
+}
+
 PipelineRef ContentContext::GetTexturePipeline(
     ContentContextOptions opts) const {
   return GetPipeline(this, pipelines_->texture, opts);
@@ -1158,6 +1411,16 @@ PipelineRef ContentContext::GetGaussianBlurPipeline(
   return GetPipeline(this, pipelines_->gaussian_blur, opts);
 }
 
+PipelineRef ContentContext::GetKawaseDownsamplePipeline(
+    ContentContextOptions opts) const {
+  return GetPipeline(this, pipelines_->kawase_downsample, opts);
+}
+
+PipelineRef ContentContext::GetKawaseUpsamplePipeline(
+    ContentContextOptions opts) const {
+  return GetPipeline(this, pipelines_->kawase_upsample, opts);
+}
+
 PipelineRef ContentContext::GetBorderMaskBlurPipeline(
     ContentContextOptions opts) const {
   return GetPipeline(this, pipelines_->border_mask_blur, opts);
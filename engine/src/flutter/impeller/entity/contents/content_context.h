@@ -16,6 +16,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/contents/gradient_texture_cache.h"
 #include "impeller/entity/contents/text_shadow_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/renderer/capabilities.h"
@@ -106,6 +107,12 @@ struct ContentContextOptions {
            static_cast<uint64_t>(sample_count) << 48;
   }
 
+  /// Reconstruct the options from a key returned by `ToKey`.
+  ///
+  /// Returns std::nullopt if the key could not have been produced by `ToKey`,
+  /// e.g. if it was persisted by a different version of the engine.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
@@ -183,6 +190,8 @@ class ContentContext {
   PipelineRef GetFramebufferBlendSoftLightPipeline(ContentContextOptions opts) const;
   PipelineRef GetGaussianBlurPipeline(ContentContextOptions opts) const;
   PipelineRef GetGlyphAtlasPipeline(ContentContextOptions opts) const;
+  PipelineRef GetKawaseDownsamplePipeline(ContentContextOptions opts) const;
+  PipelineRef GetKawaseUpsamplePipeline(ContentContextOptions opts) const;
   PipelineRef GetLinePipeline(ContentContextOptions opts) const;
   PipelineRef GetLinearGradientFillPipeline(ContentContextOptions opts) const;
   PipelineRef GetLinearGradientSSBOFillPipeline(ContentContextOptions opts) const;
@@ -199,6 +208,7 @@ class ContentContext {
   PipelineRef GetRSuperellipseBlurPipeline(ContentContextOptions opts) const;
   PipelineRef GetScreenBlendPipeline(ContentContextOptions opts) const;
   PipelineRef GetSolidFillPipeline(ContentContextOptions opts) const;
+  PipelineRef GetSolidFillInstancedPipeline(ContentContextOptions opts) const;
   PipelineRef GetSourceATopBlendPipeline(ContentContextOptions opts) const;
   PipelineRef GetSourceBlendPipeline(ContentContextOptions opts) const;
   PipelineRef GetSourceInBlendPipeline(ContentContextOptions opts) const;
@@ -303,6 +313,33 @@ class ContentContext {
 
   TextShadowCache& GetTextShadowCache() const { return *text_shadow_cache_; }
 
+  GradientTextureCache& GetGradientTextureCache() const {
+    return *gradient_texture_cache_;
+  }
+
+  /// @brief Notify the content context that a frame has been rendered.
+  ///
+  /// Call this once per onscreen frame, after its last render target has
+  /// been rendered. Offscreen renders such as snapshots must not call it.
+  ///
+  /// The pipeline variants requested during the first
+  /// `kPipelineUsageRecordFrameCount` frames are persisted with the pipeline
+  /// library (if it supports it). The next content context created with that
+  /// library starts compiling them before its first frame.
+  void MarkFrameEnd();
+
+  static constexpr size_t kPipelineUsageRecordFrameCount = 120u;
+
+  /// @brief Create the variant of every pipeline for each of the given options
+  ///        and wait for all of them to finish compiling.
+  ///
+  /// This is meant for tools that prime a pipeline cache ahead of time. Regular
+  /// rendering creates variants lazily as they are needed.
+  ///
+  /// @return The number of pipelines that were created successfully.
+  size_t CreatePipelineVariants(
+      const std::vector<ContentContextOptions>& options_list);
+
  protected:
   // Visible for testing.
   void SetTransientsIndexesBuffer(std::shared_ptr<HostBuffer> host_buffer) {
@@ -326,6 +363,10 @@ class ContentContext {
   /// shader variants, as well as forcing driver initialization.
   void InitializeCommonlyUsedShadersIfNeeded() const;
 
+  /// Create the pipeline variants recorded by a previous run in the background
+  /// and move them to the front of the pipeline compile queue.
+  void PrewarmPersistedPipelines();
+
   struct RuntimeEffectPipelineKey {
     std::string unique_entrypoint_name;
     ContentContextOptions options;
@@ -362,6 +403,7 @@ class ContentContext {
   std::shared_ptr<HostBuffer> indexes_host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
   std::unique_ptr<TextShadowCache> text_shadow_cache_;
+  std::unique_ptr<GradientTextureCache> gradient_texture_cache_;
 
   ContentContext(const ContentContext&) = delete;
 
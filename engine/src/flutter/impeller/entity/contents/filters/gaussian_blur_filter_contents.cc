@@ -5,11 +5,14 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 
 #include <cmath>
+#include <vector>
 
 #include "flutter/fml/make_copyable.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/kawase_downsample.frag.h"
+#include "impeller/entity/kawase_upsample.frag.h"
 #include "impeller/entity/texture_downsample.frag.h"
 #include "impeller/entity/texture_downsample_bounded.frag.h"
 #include "impeller/entity/texture_fill.frag.h"
@@ -314,17 +317,13 @@ struct DownsamplePassArgs {
 
 /// Calculates info required for the down-sampling pass.
 DownsamplePassArgs CalculateDownsamplePassArgs(
-    Vector2 scaled_sigma,
+    Scalar desired_scalar,
     Vector2 padding,
     const Snapshot& input_snapshot,
     const std::optional<Rect>& source_expanded_coverage_hint,
     const std::optional<Quad>& source_bounds,
     const std::shared_ptr<FilterInput>& input,
     const Entity& snapshot_entity) {
-  Scalar desired_scalar =
-      std::min(GaussianBlurFilterContents::CalculateScale(scaled_sigma.x),
-               GaussianBlurFilterContents::CalculateScale(scaled_sigma.y));
-
   // TODO(jonahwilliams): If desired_scalar is 1.0 and we fully acquired the
   // gutter from the expanded_coverage_hint, we can skip the downsample pass.
   // pass.
@@ -661,6 +660,151 @@ int ScaleBlurRadius(Scalar radius, Scalar scalar) {
   return static_cast<int>(std::round(radius * scalar));
 }
 
+/// Makes a subpass that renders one level of the dual Kawase pyramid.
+///
+/// Downsample passes render into a new texture of half the size of the input,
+/// upsample passes render into `destination_target`, which is the target of
+/// the matching downsample level.
+fml::StatusOr<RenderTarget> MakeKawaseSubpass(
+    const ContentContext& renderer,
+    const std::shared_ptr<CommandBuffer>& command_buffer,
+    const RenderTarget& input_pass,
+    const SamplerDescriptor& sampler_descriptor,
+    Scalar offset,
+    std::optional<RenderTarget> destination_target) {
+  using VS = TextureFillVertexShader;
+
+  const bool is_downsample = !destination_target.has_value();
+  const std::shared_ptr<Texture>& input_texture =
+      input_pass.GetRenderTargetTexture();
+  ISize input_size = input_texture->GetSize();
+
+  ContentContext::SubpassCallback subpass_callback =
+      [&](const ContentContext& renderer, RenderPass& pass) {
+        HostBuffer& data_host_buffer = renderer.GetTransientsDataBuffer();
+
+        ContentContextOptions options = OptionsFromPass(pass);
+        options.primitive_type = PrimitiveType::kTriangleStrip;
+        if (is_downsample) {
+          pass.SetCommandLabel("Gaussian blur pyramid downsample");
+          pass.SetPipeline(renderer.GetKawaseDownsamplePipeline(options));
+        } else {
+          pass.SetCommandLabel("Gaussian blur pyramid upsample");
+          pass.SetPipeline(renderer.GetKawaseUpsamplePipeline(options));
+        }
+
+        VS::FrameInfo frame_info;
+        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+        frame_info.texture_sampler_y_coord_scale =
+            input_texture->GetYCoordScale();
+
+        // Both fragment shaders share the same FragInfo layout.
+        static_assert(sizeof(KawaseDownsampleFragmentShader::FragInfo) ==
+                      sizeof(KawaseUpsampleFragmentShader::FragInfo));
+        KawaseDownsampleFragmentShader::FragInfo frag_info;
+        frag_info.half_pixel = Vector2(0.5f / Size(input_size));
+        frag_info.offset = offset;
+
+        std::array<VS::PerVertexData, 4> vertices = {
+            VS::PerVertexData{Point(0, 0), Point(0, 0)},
+            VS::PerVertexData{Point(1, 0), Point(1, 0)},
+            VS::PerVertexData{Point(0, 1), Point(0, 1)},
+            VS::PerVertexData{Point(1, 1), Point(1, 1)},
+        };
+        pass.SetVertexBuffer(CreateVertexBuffer(vertices, data_host_buffer));
+
+        // The pyramid is only used with the clamp tile mode, which the
+        // samples that fall outside of the input must match.
+        SamplerDescriptor linear_sampler_descriptor = sampler_descriptor;
+        linear_sampler_descriptor.mag_filter = MinMagFilter::kLinear;
+        linear_sampler_descriptor.min_filter = MinMagFilter::kLinear;
+        linear_sampler_descriptor.width_address_mode =
+            SamplerAddressMode::kClampToEdge;
+        linear_sampler_descriptor.height_address_mode =
+            SamplerAddressMode::kClampToEdge;
+        raw_ptr<const Sampler> sampler =
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                linear_sampler_descriptor);
+
+        VS::BindFrameInfo(pass, data_host_buffer.EmplaceUniform(frame_info));
+        if (is_downsample) {
+          KawaseDownsampleFragmentShader::BindFragInfo(
+              pass, data_host_buffer.EmplaceUniform(frag_info));
+          KawaseDownsampleFragmentShader::BindTextureSampler(
+              pass, input_texture, sampler);
+        } else {
+          KawaseUpsampleFragmentShader::BindFragInfo(
+              pass, data_host_buffer.EmplaceUniform(frag_info));
+          KawaseUpsampleFragmentShader::BindTextureSampler(pass, input_texture,
+                                                           sampler);
+        }
+        return pass.Draw().ok();
+      };
+
+  if (destination_target.has_value()) {
+    return renderer.MakeSubpass("Gaussian Blur Filter",
+                                destination_target.value(), command_buffer,
+                                subpass_callback);
+  }
+  ISize subpass_size = ISize(std::max<int64_t>(1, (input_size.width + 1) / 2),
+                             std::max<int64_t>(1, (input_size.height + 1) / 2));
+  return renderer.MakeSubpass(
+      "Gaussian Blur Filter", subpass_size, command_buffer, subpass_callback,
+      /*msaa_enabled=*/false, /*depth_stencil_enabled=*/false);
+}
+
+/// Runs the downsample and upsample chains of the dual Kawase pyramid over
+/// `base_pass`, returning a render target of the same size as `base_pass`.
+///
+/// The upsample chain renders back into the targets allocated by the
+/// downsample chain, so the pyramid allocates no more than one texture per
+/// level.
+fml::StatusOr<RenderTarget> MakePyramidBlurSubpasses(
+    const ContentContext& renderer,
+    const RenderTarget& base_pass,
+    const SamplerDescriptor& sampler_descriptor,
+    const PyramidBlurParameters& parameters) {
+  // Like the separable blur, the passes are split across command buffers to
+  // avoid deviceLost errors on older Adreno devices.
+  std::shared_ptr<CommandBuffer> downsample_command_buffer =
+      renderer.GetContext()->CreateCommandBuffer();
+  std::shared_ptr<CommandBuffer> upsample_command_buffer =
+      renderer.GetContext()->CreateCommandBuffer();
+  if (!downsample_command_buffer || !upsample_command_buffer) {
+    return fml::Status(fml::StatusCode::kUnknown, "");
+  }
+
+  std::vector<RenderTarget> levels;
+  levels.reserve(parameters.levels + 1);
+  levels.push_back(base_pass);
+  for (int32_t i = 0; i < parameters.levels; i++) {
+    fml::StatusOr<RenderTarget> level = MakeKawaseSubpass(
+        renderer, downsample_command_buffer, levels.back(), sampler_descriptor,
+        parameters.offset, /*destination_target=*/std::nullopt);
+    if (!level.ok()) {
+      return level;
+    }
+    levels.push_back(level.value());
+  }
+
+  for (int32_t i = parameters.levels; i > 0; i--) {
+    fml::StatusOr<RenderTarget> level = MakeKawaseSubpass(
+        renderer, upsample_command_buffer, levels[i], sampler_descriptor,
+        parameters.offset, /*destination_target=*/levels[i - 1]);
+    if (!level.ok()) {
+      return level;
+    }
+  }
+
+  if (!(renderer.GetContext()->EnqueueCommandBuffer(
+            std::move(downsample_command_buffer)) &&
+        renderer.GetContext()->EnqueueCommandBuffer(
+            std::move(upsample_command_buffer)))) {
+    return fml::Status(fml::StatusCode::kUnknown, "");
+  }
+  return levels[0];
+}
+
 Entity ApplyClippedBlurStyle(Entity::ClipOperation clip_operation,
                              const Entity& entity,
                              const std::shared_ptr<FilterInput>& input,
@@ -907,9 +1051,33 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  DownsamplePassArgs downsample_pass_args = CalculateDownsamplePassArgs(
-      blur_info.scaled_sigma, blur_info.padding, input_snapshot.value(),
-      source_expanded_coverage_hint, source_bounds, inputs[0], snapshot_entity);
+  // Large isotropic blurs are rendered with a downsample pyramid that starts
+  // from a half resolution copy of the input. Bounded blurs rely on the lerp
+  // hack of the separable kernel and always use it, as do the tile modes
+  // other than clamp, which the pyramid doesn't implement.
+  std::optional<PyramidBlurParameters> pyramid_parameters;
+  DownsamplePassArgs downsample_pass_args;
+  if (renderer.GetContext()->GetFlags().pyramid_blur && !bounds_.has_value() &&
+      ShouldUsePyramidBlur(blur_info.scaled_sigma, tile_mode_)) {
+    downsample_pass_args = CalculateDownsamplePassArgs(
+        /*desired_scalar=*/0.5f, blur_info.padding, input_snapshot.value(),
+        source_expanded_coverage_hint, source_bounds, inputs[0],
+        snapshot_entity);
+    pyramid_parameters = CalculatePyramidBlurParameters(
+        std::max(blur_info.scaled_sigma.x *
+                     downsample_pass_args.effective_scalar.x,
+                 blur_info.scaled_sigma.y *
+                     downsample_pass_args.effective_scalar.y),
+        downsample_pass_args.subpass_size);
+  }
+  if (!pyramid_parameters.has_value()) {
+    downsample_pass_args = CalculateDownsamplePassArgs(
+        std::min(CalculateScale(blur_info.scaled_sigma.x),
+                 CalculateScale(blur_info.scaled_sigma.y)),
+        blur_info.padding, input_snapshot.value(),
+        source_expanded_coverage_hint, source_bounds, inputs[0],
+        snapshot_entity);
+  }
 
   fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
       renderer, command_buffer_1, input_snapshot->texture,
@@ -919,6 +1087,25 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  if (pyramid_parameters.has_value()) {
+    if (!renderer.GetContext()->EnqueueCommandBuffer(
+            std::move(command_buffer_1))) {
+      return std::nullopt;
+    }
+    fml::StatusOr<RenderTarget> pyramid_out = MakePyramidBlurSubpasses(
+        renderer, pass1_out.value(), input_snapshot->sampler_descriptor,
+        pyramid_parameters.value());
+    if (!pyramid_out.ok()) {
+      return std::nullopt;
+    }
+    return MakeBlurOutputEntity(entity, inputs[0], input_snapshot.value(),
+                                blur_info.source_space_scalar,
+                                blur_info.source_space_offset,
+                                downsample_pass_args.transform,
+                                downsample_pass_args.effective_scalar,
+                                pyramid_out.value().GetRenderTargetTexture());
+  }
+
   Vector2 pass1_pixel_size =
       1.0 / Vector2(pass1_out.value().GetRenderTargetTexture()->GetSize());
 
@@ -994,26 +1181,53 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
              (pass2_out.value().GetRenderTargetSize() ==
               pass3_out.value().GetRenderTargetSize()));
 
+  return MakeBlurOutputEntity(
+      entity, inputs[0], input_snapshot.value(), blur_info.source_space_scalar,
+      blur_info.source_space_offset, downsample_pass_args.transform,
+      downsample_pass_args.effective_scalar,
+      pass3_out.value().GetRenderTargetTexture());
+}
+
+Entity GaussianBlurFilterContents::MakeBlurOutputEntity(
+    const Entity& entity,
+    const std::shared_ptr<FilterInput>& input,
+    const Snapshot& input_snapshot,
+    Vector2 source_space_scalar,
+    Vector2 source_space_offset,
+    const Matrix& downsample_transform,
+    Vector2 downsample_scalar,
+    const std::shared_ptr<Texture>& blurred_texture) const {
   SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
       MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
 
   Entity blur_output_entity = Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
-               .transform =
-                   entity.GetTransform() *                                   //
-                   Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
-                   Matrix::MakeTranslation(-1 * blur_info.source_space_offset) *
-                   downsample_pass_args.transform *  //
-                   Matrix::MakeScale(1 / downsample_pass_args.effective_scalar),
+      Snapshot{.texture = blurred_texture,
+               .transform = entity.GetTransform() *                       //
+                            Matrix::MakeScale(1.f / source_space_scalar) *  //
+                            Matrix::MakeTranslation(-1 * source_space_offset) *
+                            downsample_transform *  //
+                            Matrix::MakeScale(1 / downsample_scalar),
                .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity,
+               .opacity = input_snapshot.opacity,
                .needs_rasterization_for_runtime_effects = true},
       entity.GetBlendMode());
 
-  return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
-                        input_snapshot.value(), std::move(blur_output_entity),
-                        mask_geometry_, blur_info.source_space_scalar,
-                        blur_info.source_space_offset);
+  return ApplyBlurStyle(mask_blur_style_, entity, input, input_snapshot,
+                        std::move(blur_output_entity), mask_geometry_,
+                        source_space_scalar, source_space_offset);
+}
+
+bool GaussianBlurFilterContents::ShouldUsePyramidBlur(
+    Vector2 scaled_sigma,
+    Entity::TileMode tile_mode) {
+  if (tile_mode != Entity::TileMode::kClamp) {
+    return false;
+  }
+  Scalar min_sigma = std::min(scaled_sigma.x, scaled_sigma.y);
+  Scalar max_sigma = std::max(scaled_sigma.x, scaled_sigma.y);
+  // The pyramid is isotropic, only use it when both directions are close.
+  return min_sigma >= kGaussianBlurPyramidMinSigma &&
+         max_sigma - min_sigma <= max_sigma * 0.1f;
 }
 
 Scalar GaussianBlurFilterContents::CalculateBlurRadius(Scalar sigma) {
@@ -1091,6 +1305,54 @@ KernelSamples GenerateBlurInfo(BlurParameters parameters) {
   return result;
 }
 
+Scalar CalculatePyramidBlurSigma(const PyramidBlurParameters& parameters) {
+  // The sum of the squared texel sizes of the inputs of each downsample pass
+  // is (4^levels - 1) / 3, and the upsample passes sample inputs with twice
+  // the texel size of the matching downsample.
+  Scalar texel_area_sum = (std::pow(4.0f, parameters.levels) - 1.0f) / 3.0f;
+  Scalar offset_squared = parameters.offset * parameters.offset;
+  Scalar downsample_variance = 0.25f + offset_squared / 8.0f;
+  Scalar upsample_variance = 4.0f * (0.125f + offset_squared / 3.0f);
+  return std::sqrt(texel_area_sum * (downsample_variance + upsample_variance));
+}
+
+std::optional<PyramidBlurParameters> CalculatePyramidBlurParameters(
+    Scalar sigma,
+    ISize base_size) {
+  // Spreads below a texel visibly lose strength and spreads much above two
+  // texels produce ringing, so prefer the deepest pyramid that reaches the
+  // requested sigma with at least a one texel spread.
+  static constexpr Scalar kMinOffset = 1.0f;
+  static constexpr Scalar kMaxOffset = 3.0f;
+
+  // Keep at least 2 pixels in the smallest level.
+  int64_t min_dimension = std::min(base_size.width, base_size.height);
+  int32_t max_levels = 0;
+  while (max_levels < kGaussianBlurPyramidMaxLevels &&
+         (min_dimension >> (max_levels + 1)) >= 2) {
+    max_levels++;
+  }
+  if (max_levels == 0 || sigma <= 0.0f) {
+    return std::nullopt;
+  }
+
+  for (int32_t levels = max_levels; levels > 0; levels--) {
+    // Invert CalculatePyramidBlurSigma for the offset.
+    Scalar texel_area_sum = (std::pow(4.0f, levels) - 1.0f) / 3.0f;
+    Scalar offset_squared =
+        (sigma * sigma / texel_area_sum - 0.75f) / (1.0f / 8.0f + 4.0f / 3.0f);
+    if (offset_squared >= kMinOffset * kMinOffset || levels == 1) {
+      Scalar offset = std::sqrt(std::max(offset_squared, 0.0f));
+      if (offset > kMaxOffset) {
+        // Even the deepest allowed pyramid can't reach the sigma.
+        return std::nullopt;
+      }
+      return PyramidBlurParameters{.levels = levels, .offset = offset};
+    }
+  }
+  return std::nullopt;
+}
+
 // This works by shrinking the kernel size by 2 and relying on lerp to read
 // between the samples.
 GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
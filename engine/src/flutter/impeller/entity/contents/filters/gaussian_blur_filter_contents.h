@@ -50,6 +50,40 @@ KernelSamples GenerateBlurInfo(BlurParameters parameters);
 GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
     KernelSamples samples);
 
+/// The smallest scaled sigma (in source space pixels) that is rendered with
+/// the downsample pyramid instead of the separable kernel.
+static constexpr Scalar kGaussianBlurPyramidMinSigma = 24.0f;
+
+/// The maximum number of levels in the downsample pyramid.
+static constexpr int32_t kGaussianBlurPyramidMaxLevels = 6;
+
+/// The parameters of a dual Kawase blur pyramid.
+struct PyramidBlurParameters {
+  /// The number of downsample passes performed after the initial half
+  /// resolution downsample. Each is matched by an upsample pass.
+  int32_t levels = 0;
+  /// The spread of the samples of each pass, in half texels of the pass input.
+  Scalar offset = 0.0f;
+};
+
+/// Calculates the number of levels and sample spread of a dual Kawase pyramid
+/// that approximates a gaussian with the given `sigma`, expressed in pixels of
+/// the pyramid's base level of `base_size`.
+///
+/// Returns std::nullopt if the base level is too small to build a pyramid.
+std::optional<PyramidBlurParameters> CalculatePyramidBlurParameters(
+    Scalar sigma,
+    ISize base_size);
+
+/// The standard deviation, in pixels of the base level, of the blur applied by
+/// a dual Kawase pyramid.
+///
+/// Each downsample pass with an input texel size of p contributes a variance
+/// of about p^2 * (1/4 + offset^2 / 8) and each upsample pass about
+/// p^2 * (1/8 + offset^2 / 3). Summing the geometric series of texel sizes
+/// gives the result.
+Scalar CalculatePyramidBlurSigma(const PyramidBlurParameters& parameters);
+
 /// Performs a bidirectional Gaussian blur.
 //
 // ## Implementation notes
@@ -60,6 +94,21 @@ GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
 // 2. A Y-direction blur pass (in canvas coordinates).
 // 3. An X-direction blur pass (in canvas coordinates).
 //
+// ### Pyramid Blur
+//
+// When `Flags::pyramid_blur` is set, isotropic, unbounded blurs with the
+// clamp tile mode and a scaled sigma of at least
+// `kGaussianBlurPyramidMinSigma` (such as frosted glass backdrop filters)
+// instead use a dual Kawase pyramid:
+// 1. A downsampling pass to half resolution.
+// 2. A chain of downsample passes, each halving the resolution again.
+// 3. A matching chain of upsample passes that render back into the targets
+//    of the downsample chain.
+//
+// Every pass takes a handful of bilinear samples, so the cost is dominated by
+// the first pass and doesn't grow with the sigma. entity_benchmarks compares
+// the passes rendered by each approach.
+//
 // ### Lerp Hack
 //
 // The blur passes use a "lerp hack" to optimize the number of texture
@@ -139,6 +188,14 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// equation that puts the minima there and a f(0)=1.
   static Scalar ScaleSigma(Scalar sigma);
 
+  /// Whether a blur with the given scaled sigma and tile mode should use the
+  /// downsample pyramid.
+  ///
+  /// The Kawase passes sample with clamp to edge addressing, so other tile
+  /// modes always use the separable kernel.
+  static bool ShouldUsePyramidBlur(Vector2 scaled_sigma,
+                                   Entity::TileMode tile_mode);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -149,6 +206,18 @@ class GaussianBlurFilterContents final : public FilterContents {
       const Rect& coverage,
       const std::optional<Rect>& coverage_hint) const override;
 
+  /// Positions the blurred, downsampled texture over the input and applies
+  /// the mask blur style.
+  Entity MakeBlurOutputEntity(
+      const Entity& entity,
+      const std::shared_ptr<FilterInput>& input,
+      const Snapshot& input_snapshot,
+      Vector2 source_space_scalar,
+      Vector2 source_space_offset,
+      const Matrix& downsample_transform,
+      Vector2 downsample_scalar,
+      const std::shared_ptr<Texture>& blurred_texture) const;
+
   const Vector2 sigma_ = Vector2(0.0, 0.0);
   const Entity::TileMode tile_mode_;
   const std::optional<Rect> bounds_ = std::nullopt;
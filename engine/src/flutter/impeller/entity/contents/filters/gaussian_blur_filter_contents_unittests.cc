@@ -644,5 +644,59 @@ TEST(GaussianBlurFilterContentsTest, ChopHugeBlurs) {
   EXPECT_TRUE(frag_kernel_samples.sample_count <= kGaussianBlurMaxKernelSize);
 }
 
+TEST(GaussianBlurFilterContentsTest, ShouldUsePyramidBlur) {
+  const Entity::TileMode clamp = Entity::TileMode::kClamp;
+  EXPECT_FALSE(GaussianBlurFilterContents::ShouldUsePyramidBlur(
+      Vector2(kGaussianBlurPyramidMinSigma - 1, kGaussianBlurPyramidMinSigma),
+      clamp));
+  EXPECT_TRUE(GaussianBlurFilterContents::ShouldUsePyramidBlur(
+      Vector2(kGaussianBlurPyramidMinSigma, kGaussianBlurPyramidMinSigma),
+      clamp));
+  EXPECT_TRUE(
+      GaussianBlurFilterContents::ShouldUsePyramidBlur(Vector2(60, 64), clamp));
+  // The pyramid is isotropic.
+  EXPECT_FALSE(GaussianBlurFilterContents::ShouldUsePyramidBlur(
+      Vector2(30, 60), clamp));
+  // The pyramid only implements the clamp tile mode.
+  for (Entity::TileMode tile_mode :
+       {Entity::TileMode::kDecal, Entity::TileMode::kMirror,
+        Entity::TileMode::kRepeat}) {
+    EXPECT_FALSE(GaussianBlurFilterContents::ShouldUsePyramidBlur(
+        Vector2(60, 64), tile_mode));
+  }
+}
+
+TEST(GaussianBlurFilterContentsTest, PyramidBlurParametersMatchSigma) {
+  for (Scalar sigma : {4.0f, 12.0f, 20.0f, 37.5f, 60.0f}) {
+    std::optional<PyramidBlurParameters> parameters =
+        CalculatePyramidBlurParameters(sigma, ISize(1000, 1000));
+    ASSERT_TRUE(parameters.has_value()) << sigma;
+    EXPECT_GE(parameters->levels, 1);
+    EXPECT_LE(parameters->levels, kGaussianBlurPyramidMaxLevels);
+    EXPECT_GE(parameters->offset, 1.0f) << sigma;
+    EXPECT_LE(parameters->offset, 3.0f) << sigma;
+    EXPECT_NEAR(CalculatePyramidBlurSigma(parameters.value()), sigma, 0.01f);
+  }
+}
+
+TEST(GaussianBlurFilterContentsTest, PyramidBlurParametersDeepenWithSigma) {
+  std::optional<PyramidBlurParameters> small =
+      CalculatePyramidBlurParameters(8.0f, ISize(1000, 1000));
+  std::optional<PyramidBlurParameters> large =
+      CalculatePyramidBlurParameters(64.0f, ISize(1000, 1000));
+  ASSERT_TRUE(small.has_value());
+  ASSERT_TRUE(large.has_value());
+  EXPECT_LT(small->levels, large->levels);
+}
+
+TEST(GaussianBlurFilterContentsTest, PyramidBlurParametersTinyBase) {
+  // There isn't enough room for a single level.
+  EXPECT_FALSE(
+      CalculatePyramidBlurParameters(12.0f, ISize(3, 100)).has_value());
+  // The number of levels is limited so that a large sigma can't be reached.
+  EXPECT_FALSE(
+      CalculatePyramidBlurParameters(60.0f, ISize(8, 8)).has_value());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/gradient_texture_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+std::size_t GradientTextureCache::Hash::operator()(
+    const GradientView& view) const {
+  std::size_t seed = fml::HashCombine(view.colors->size(), view.stops->size());
+  for (const Color& color : *view.colors) {
+    fml::HashCombineSeed(seed, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (Scalar stop : *view.stops) {
+    fml::HashCombineSeed(seed, stop);
+  }
+  return seed;
+}
+
+GradientTextureCache::GradientTextureCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+void GradientTextureCache::MarkFrameStart() {
+  frame_count_++;
+}
+
+void GradientTextureCache::MarkFrameEnd() {
+  EvictToBudget();
+  FML_TRACE_COUNTER("impeller", "GradientTextureCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Entries", entries_.size(),       //
+                    "Hits", hits_,                    //
+                    "Misses", misses_);
+}
+
+void GradientTextureCache::EvictToBudget() {
+  if (bytes_used_ <= max_bytes_) {
+    return;
+  }
+
+  // Never evict entries that were used during the current frame, their
+  // textures are still referenced by the recorded render passes and evicting
+  // them would not free any memory.
+  using EntryIterator = decltype(entries_)::iterator;
+  std::vector<EntryIterator> candidates;
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->second.last_used_frame != frame_count_) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EntryIterator& lhs, const EntryIterator& rhs) {
+              return lhs->second.last_used_frame <
+                     rhs->second.last_used_frame;
+            });
+
+  for (const EntryIterator& it : candidates) {
+    if (bytes_used_ <= max_bytes_) {
+      break;
+    }
+    bytes_used_ -= it->second.byte_size;
+    // Erasing by iterator does not invalidate other iterators into the
+    // flat_hash_map.
+    entries_.erase(it);
+    evictions_++;
+  }
+}
+
+GradientTextureCache::Stats GradientTextureCache::GetStats() const {
+  return Stats{.hits = hits_,
+               .misses = misses_,
+               .evictions = evictions_,
+               .entry_count = entries_.size(),
+               .bytes_used = bytes_used_};
+}
+
+std::shared_ptr<Texture> GradientTextureCache::GetOrCreate(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  auto it = entries_.find(GradientView{.colors = &colors, .stops = &stops});
+  if (it != entries_.end()) {
+    hits_++;
+    it->second.last_used_frame = frame_count_;
+    return it->second.texture;
+  }
+  misses_++;
+
+  GradientData gradient_data = CreateGradientBuffer(colors, stops);
+  std::shared_ptr<Texture> texture =
+      CreateGradientTexture(gradient_data, context);
+  if (!texture) {
+    return nullptr;
+  }
+
+  size_t byte_size = gradient_data.color_bytes.size();
+  bytes_used_ += byte_size;
+  entries_[GradientKey{.colors = colors, .stops = stops}] =
+      GradientTextureData{.texture = texture,
+                          .byte_size = byte_size,
+                          .last_used_frame = frame_count_};
+  return texture;
+}
+
+}  // namespace impeller
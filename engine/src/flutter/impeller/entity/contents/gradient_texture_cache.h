@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_TEXTURE_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_TEXTURE_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+
+namespace impeller {
+
+class Context;
+
+/// @brief A cache for the color ramp textures of gradients that re-uses them
+///        across draws and frames.
+///
+/// Gradients with more stops than fit in the uniform data of the gradient
+/// shaders, and all gradients on devices without storage buffers, sample
+/// their colors from a ramp texture. The ramp only depends on the colors and
+/// stops of the gradient, the tile mode and geometry are applied by the
+/// shader, so every gradient with the same colors and stops shares a ramp.
+///
+/// Entries are retained across frames until the total size of the cached
+/// textures exceeds the byte budget, at which point the least recently used
+/// entries are evicted.
+class GradientTextureCache {
+ public:
+  /// The default upper bound on the size of all cached ramp textures.
+  static constexpr size_t kDefaultMaxBytes = 1u * 1024u * 1024u;
+
+  explicit GradientTextureCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~GradientTextureCache() = default;
+
+  /// @brief Statistics describing the effectiveness of the cache.
+  struct Stats {
+    /// The number of lookups that were satisfied by a cached texture.
+    size_t hits = 0u;
+    /// The number of lookups that required uploading a new texture.
+    size_t misses = 0u;
+    /// The number of entries removed to satisfy the byte budget.
+    size_t evictions = 0u;
+    /// The number of entries currently held by the cache.
+    size_t entry_count = 0u;
+    /// The size of all textures currently held by the cache.
+    size_t bytes_used = 0u;
+  };
+
+  /// @brief Begin a new frame.
+  void MarkFrameStart();
+
+  /// @brief Evict least recently used ramp textures until the cache is within
+  ///        its byte budget.
+  void MarkFrameEnd();
+
+  /// @brief Retrieve the ramp texture for a gradient with the given colors
+  ///        and stops, creating and uploading it if it is not cached.
+  ///
+  /// @return The ramp texture, or nullptr if the gradient is invalid or the
+  ///         texture could not be created.
+  std::shared_ptr<Texture> GetOrCreate(
+      const std::vector<Color>& colors,
+      const std::vector<Scalar>& stops,
+      const std::shared_ptr<Context>& context);
+
+  /// @brief Update the upper bound on the size of all cached textures. Takes
+  ///        effect at the next call to [MarkFrameEnd].
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  /// @brief Retrieve the cache statistics accumulated since creation.
+  Stats GetStats() const;
+
+ private:
+  GradientTextureCache(const GradientTextureCache&) = delete;
+
+  GradientTextureCache& operator=(const GradientTextureCache&) = delete;
+
+  /// @brief The colors and stops of a gradient, used to look up entries
+  ///        without copying them.
+  struct GradientView {
+    const std::vector<Color>* colors;
+    const std::vector<Scalar>* stops;
+  };
+
+  struct GradientKey {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+
+    GradientView AsView() const { return {&colors, &stops}; }
+  };
+
+  struct Hash {
+    using is_transparent = void;
+
+    std::size_t operator()(const GradientView& view) const;
+
+    std::size_t operator()(const GradientKey& key) const {
+      return (*this)(key.AsView());
+    }
+  };
+
+  struct Equal {
+    using is_transparent = void;
+
+    bool operator()(const GradientView& lhs, const GradientView& rhs) const {
+      return *lhs.colors == *rhs.colors && *lhs.stops == *rhs.stops;
+    }
+
+    bool operator()(const GradientKey& lhs, const GradientView& rhs) const {
+      return (*this)(lhs.AsView(), rhs);
+    }
+
+    bool operator()(const GradientView& lhs, const GradientKey& rhs) const {
+      return (*this)(lhs, rhs.AsView());
+    }
+
+    bool operator()(const GradientKey& lhs, const GradientKey& rhs) const {
+      return (*this)(lhs.AsView(), rhs.AsView());
+    }
+  };
+
+  struct GradientTextureData {
+    std::shared_ptr<Texture> texture;
+    size_t byte_size = 0u;
+    uint64_t last_used_frame = 0u;
+  };
+
+  void EvictToBudget();
+
+  absl::flat_hash_map<GradientKey, GradientTextureData, Hash, Equal> entries_;
+  size_t max_bytes_;
+  size_t bytes_used_ = 0u;
+  uint64_t frame_count_ = 0u;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+  size_t evictions_ = 0u;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_TEXTURE_CACHE_H_
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "impeller/entity/contents/gradient_texture_cache.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/playground/playground_test.h"
+#include "third_party/googletest/googletest/include/gtest/gtest.h"
+
+namespace impeller {
+namespace testing {
+
+using EntityTest = EntityPlayground;
+
+namespace {
+
+std::vector<Color> MakeColors(Scalar alpha) {
+  return {Color::Red().WithAlpha(alpha), Color::Green(), Color::Blue()};
+}
+
+const std::vector<Scalar> kStops = {0.0f, 0.3f, 1.0f};
+
+}  // namespace
+
+TEST_P(EntityTest, GradientTextureCacheReusesRampsForIdenticalStops) {
+  GradientTextureCache cache;
+  cache.MarkFrameStart();
+  std::shared_ptr<Texture> first =
+      cache.GetOrCreate(MakeColors(1.0f), kStops, GetContext());
+  ASSERT_NE(first, nullptr);
+  cache.MarkFrameEnd();
+
+  cache.MarkFrameStart();
+  EXPECT_EQ(cache.GetOrCreate(MakeColors(1.0f), kStops, GetContext()), first);
+  std::shared_ptr<Texture> other =
+      cache.GetOrCreate(MakeColors(0.5f), kStops, GetContext());
+  EXPECT_NE(other, first);
+  std::shared_ptr<Texture> other_stops =
+      cache.GetOrCreate(MakeColors(1.0f), {0.0f, 0.5f, 1.0f}, GetContext());
+  EXPECT_NE(other_stops, first);
+  cache.MarkFrameEnd();
+
+  GradientTextureCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.entry_count, 3u);
+  EXPECT_EQ(stats.evictions, 0u);
+  EXPECT_EQ(stats.bytes_used,
+            static_cast<size_t>(first->GetSize().Area() +
+                                other->GetSize().Area() +
+                                other_stops->GetSize().Area()) *
+                4u);
+}
+
+TEST_P(EntityTest, GradientTextureCacheEvictsLeastRecentlyUsedRamps) {
+  GradientTextureCache cache(/*max_bytes=*/0u);
+
+  cache.MarkFrameStart();
+  std::shared_ptr<Texture> old_ramp =
+      cache.GetOrCreate(MakeColors(1.0f), kStops, GetContext());
+  ASSERT_NE(old_ramp, nullptr);
+  // Entries used during the current frame are never evicted.
+  cache.MarkFrameEnd();
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+
+  cache.MarkFrameStart();
+  cache.GetOrCreate(MakeColors(0.5f), kStops, GetContext());
+  cache.MarkFrameEnd();
+
+  GradientTextureCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.entry_count, 1u);
+
+  // The evicted ramp is uploaded again.
+  cache.MarkFrameStart();
+  EXPECT_NE(cache.GetOrCreate(MakeColors(1.0f), kStops, GetContext()),
+            old_ramp);
+  cache.MarkFrameEnd();
+  EXPECT_EQ(cache.GetStats().misses, 3u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -5,6 +5,7 @@
 #include <limits>
 #include <utility>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "impeller/base/validation.h"
@@ -177,6 +178,31 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 }
 
+TEST_P(HostBufferTest, ReportsTheBytesOfItsBlocks) {
+  constexpr size_t kBlockSize = 1024000u;
+  auto host_buffer_bytes = []() {
+    return fml::GetMemoryUsage().GetBytes(fml::MemoryCategory::kHostBuffer);
+  };
+  const size_t initial_bytes = host_buffer_bytes();
+  {
+    auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                     GetContext()->GetIdleWaiter(), 256);
+    EXPECT_EQ(host_buffer_bytes(), initial_bytes + 4 * kBlockSize);
+
+    auto buffer_view_a = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    auto buffer_view_b = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    EXPECT_EQ(host_buffer_bytes(), initial_bytes + 5 * kBlockSize);
+
+    // The second block of the frame is dropped once the frame comes around
+    // again without needing it.
+    for (auto i = 0; i < 8; i++) {
+      buffer->Reset();
+    }
+    EXPECT_EQ(host_buffer_bytes(), initial_bytes + 4 * kBlockSize);
+  }
+  EXPECT_EQ(host_buffer_bytes(), initial_bytes);
+}
+
 TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
   auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
                                    GetContext()->GetIdleWaiter(), 256);
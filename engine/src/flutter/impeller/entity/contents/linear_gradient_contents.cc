@@ -230,9 +230,9 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   return ColorSourceContents::DrawGeometry<VS>(
       renderer, entity, pass, pipeline_callback, frame_info,
       [this, &renderer, &entity](RenderPass& pass) {
-        auto gradient_data = CreateGradientBuffer(colors_, stops_);
         auto gradient_texture =
-            CreateGradientTexture(gradient_data, renderer.GetContext());
+            renderer.GetGradientTextureCache().GetOrCreate(
+                colors_, stops_, renderer.GetContext());
         if (gradient_texture == nullptr) {
           return false;
         }
@@ -33,6 +33,8 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/gradient_fill.vert.h"
+#include "impeller/entity/kawase_downsample.frag.h"
+#include "impeller/entity/kawase_upsample.frag.h"
 #include "impeller/entity/line.frag.h"
 #include "impeller/entity/line.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
@@ -52,6 +54,7 @@
 #include "impeller/entity/shadow_vertices.vert.h"
 #include "impeller/entity/solid_fill.frag.h"
 #include "impeller/entity/solid_fill.vert.h"
+#include "impeller/entity/solid_fill_instanced.vert.h"
 #include "impeller/entity/srgb_to_linear_filter.frag.h"
 #include "impeller/entity/sweep_gradient_fill.frag.h"
 #include "impeller/entity/sweep_gradient_ssbo_fill.frag.h"
@@ -137,6 +140,8 @@ using GaussianBlurPipeline = RenderPipelineHandle<FilterPositionUvVertexShader,
 using GlyphAtlasPipeline = RenderPipelineHandle<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using LinePipeline = RenderPipelineHandle<LineVertexShader, LineFragmentShader>;
 using LinearGradientFillPipeline = GradientPipelineHandle<LinearGradientFillFragmentShader>;
+using KawaseDownsamplePipeline = RenderPipelineHandle<TextureFillVertexShader, KawaseDownsampleFragmentShader>;
+using KawaseUpsamplePipeline = RenderPipelineHandle<TextureFillVertexShader, KawaseUpsampleFragmentShader>;
 using LinearGradientSSBOFillPipeline = GradientPipelineHandle<LinearGradientSsboFillFragmentShader>;
 using LinearGradientUniformFillPipeline = GradientPipelineHandle<LinearGradientUniformFillFragmentShader>;
 using LinearToSrgbFilterPipeline = RenderPipelineHandle<FilterPositionVertexShader, LinearToSrgbFilterFragmentShader>;
@@ -149,6 +154,7 @@ using RRectBlurPipeline = RenderPipelineHandle<RrectLikeBlurVertexShader, RrectB
 using RSuperellipseBlurPipeline = RenderPipelineHandle<RrectLikeBlurVertexShader, RsuperellipseBlurFragmentShader>;
 using ShadowVerticesShader = RenderPipelineHandle<ShadowVerticesVertexShader, ShadowVerticesFragmentShader>;
 using SolidFillPipeline = RenderPipelineHandle<SolidFillVertexShader, SolidFillFragmentShader>;
+using SolidFillInstancedPipeline = RenderPipelineHandle<SolidFillInstancedVertexShader, SolidFillFragmentShader>;
 using SrgbToLinearFilterPipeline = RenderPipelineHandle<FilterPositionVertexShader, SrgbToLinearFilterFragmentShader>;
 using SweepGradientFillPipeline = GradientPipelineHandle<SweepGradientFillFragmentShader>;
 using SweepGradientSSBOFillPipeline = GradientPipelineHandle<SweepGradientSsboFillFragmentShader>;
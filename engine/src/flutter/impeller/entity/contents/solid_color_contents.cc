@@ -47,6 +47,17 @@ std::optional<Rect> SolidColorContents::GetCoverage(
 bool SolidColorContents::Render(const ContentContext& renderer,
                                 const Entity& entity,
                                 RenderPass& pass) const {
+  // Geometries made of many copies of one shape are drawn as instances of
+  // that shape where per-instance data can be read from a storage buffer.
+  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+    std::optional<InstancedGeometryResult> instanced =
+        GetGeometry()->GetInstancedPositionBuffer(renderer, entity, pass);
+    if (instanced.has_value()) {
+      return RenderInstanced(renderer, entity, pass,
+                             std::move(instanced.value()));
+    }
+  }
+
   using VS = SolidFillPipeline::VertexShader;
   using FS = SolidFillPipeline::FragmentShader;
   auto& data_host_buffer = renderer.GetTransientsDataBuffer();
@@ -69,6 +80,40 @@ bool SolidColorContents::Render(const ContentContext& renderer,
       });
 }
 
+bool SolidColorContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    InstancedGeometryResult geometry) const {
+  using VS = SolidFillInstancedPipeline::VertexShader;
+  using FS = SolidFillInstancedPipeline::FragmentShader;
+  auto& data_host_buffer = renderer.GetTransientsDataBuffer();
+
+  VS::FrameInfo frame_info;
+  FS::FragInfo frag_info;
+  frag_info.color = GetColor().Premultiply() *
+                    GetGeometry()->ComputeAlphaCoverage(entity.GetTransform());
+
+  PipelineBuilderCallback pipeline_callback =
+      [&renderer](ContentContextOptions options) {
+        return renderer.GetSolidFillInstancedPipeline(options);
+      };
+  return ColorSourceContents::DrawGeometry<VS>(
+      renderer, entity, pass, pipeline_callback, frame_info,
+      [&frag_info, &data_host_buffer, &geometry](RenderPass& pass) {
+        VS::BindInstanceData(pass, geometry.offsets);
+        FS::BindFragInfo(pass, data_host_buffer.EmplaceUniform(frag_info));
+        pass.SetInstanceCount(geometry.instance_count);
+        pass.SetCommandLabel("Solid Fill Instanced");
+        return true;
+      },
+      /*force_stencil=*/false,
+      [&geometry](const ContentContext& renderer, const Entity& entity,
+                  RenderPass& pass, const Geometry* geom) {
+        return geometry.shape;
+      });
+}
+
 std::optional<Color> SolidColorContents::AsBackgroundColor(
     const Entity& entity,
     ISize target_size) const {
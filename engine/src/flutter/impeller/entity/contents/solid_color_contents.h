@@ -7,6 +7,7 @@
 
 #include "impeller/entity/contents/color_source_contents.h"
 #include "impeller/entity/contents/contents.h"
+#include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/color.h"
 
 namespace impeller {
@@ -43,6 +44,12 @@ class SolidColorContents final : public ColorSourceContents {
       const ColorFilterProc& color_filter_proc) override;
 
  private:
+  /// Draws every instance of |geometry| with a single draw call.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       InstancedGeometryResult geometry) const;
+
   Color color_;
 
   SolidColorContents(const SolidColorContents&) = delete;
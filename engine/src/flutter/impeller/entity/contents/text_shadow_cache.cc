@@ -4,7 +4,12 @@
 
 #include "impeller/entity/contents/text_shadow_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "fml/closure.h"
+#include "fml/trace_event.h"
+#include "impeller/core/formats.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
@@ -15,29 +20,121 @@ namespace impeller {
 // Rounds sigma values for gaussian blur to nearest decimal.
 static constexpr int32_t kMaxSigmaDenominator = 10;
 
-TextShadowCache::TextShadowCacheKey::TextShadowCacheKey(Scalar p_max_basis,
-                                                        int64_t p_identifier,
-                                                        bool p_is_single_glyph,
-                                                        const Font& p_font,
-                                                        Sigma p_sigma,
-                                                        Color p_color)
+TextShadowCache::TextShadowCacheKey::TextShadowCacheKey(
+    Scalar p_max_basis,
+    int64_t p_identifier,
+    bool p_is_single_glyph,
+    const Font& p_font,
+    Sigma p_sigma,
+    Color p_color,
+    std::shared_ptr<const TextFrame> p_frame)
     : max_basis(p_max_basis),
       identifier(p_identifier),
       is_single_glyph(p_is_single_glyph),
       font(p_font),
       rounded_sigma(Rational(std::round(p_sigma.sigma * kMaxSigmaDenominator),
                              kMaxSigmaDenominator)),
-      color(p_color) {}
+      color(p_color),
+      frame(std::move(p_frame)) {}
 
-void TextShadowCache::MarkFrameStart() {
-  for (auto& entry : entries_) {
-    entry.second.used_this_frame = false;
+int64_t TextShadowCache::TextShadowCacheKey::ComputeContentIdentifier(
+    const TextFrame& frame) {
+  std::size_t seed = fml::HashCombine();
+  for (const TextRun& run : frame.GetRuns()) {
+    fml::HashCombineSeed(seed, run.GetFont().GetHash(), run.GetGlyphCount());
+    for (const TextRun::GlyphPosition& glyph_position :
+         run.GetGlyphPositions()) {
+      fml::HashCombineSeed(seed, glyph_position.glyph.index,
+                           glyph_position.position.x,
+                           glyph_position.position.y);
+    }
+  }
+  return static_cast<int64_t>(seed);
+}
+
+bool TextShadowCache::TextShadowCacheKey::IsContentEqual(const TextFrame& lhs,
+                                                         const TextFrame& rhs) {
+  const std::vector<TextRun>& lhs_runs = lhs.GetRuns();
+  const std::vector<TextRun>& rhs_runs = rhs.GetRuns();
+  if (lhs_runs.size() != rhs_runs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs_runs.size(); i++) {
+    const TextRun& lhs_run = lhs_runs[i];
+    const TextRun& rhs_run = rhs_runs[i];
+    if (lhs_run.GetGlyphCount() != rhs_run.GetGlyphCount() ||
+        !lhs_run.GetFont().IsEqual(rhs_run.GetFont())) {
+      return false;
+    }
+    const std::vector<TextRun::GlyphPosition>& lhs_glyphs =
+        lhs_run.GetGlyphPositions();
+    const std::vector<TextRun::GlyphPosition>& rhs_glyphs =
+        rhs_run.GetGlyphPositions();
+    for (size_t j = 0; j < lhs_glyphs.size(); j++) {
+      if (lhs_glyphs[j].glyph.index != rhs_glyphs[j].glyph.index ||
+          lhs_glyphs[j].glyph.type != rhs_glyphs[j].glyph.type ||
+          lhs_glyphs[j].position != rhs_glyphs[j].position) {
+        return false;
+      }
+    }
   }
+  return true;
+}
+
+TextShadowCache::TextShadowCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+void TextShadowCache::MarkFrameStart() {
+  frame_count_++;
 }
 
 void TextShadowCache::MarkFrameEnd() {
-  absl::erase_if(entries_,
-                 [](const auto& pair) { return !pair.second.used_this_frame; });
+  EvictToBudget();
+  FML_TRACE_COUNTER("impeller", "TextShadowCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Entries", entries_.size(),       //
+                    "BytesUsed", bytes_used_,         //
+                    "Evictions", evictions_);
+}
+
+void TextShadowCache::EvictToBudget() {
+  if (bytes_used_ <= max_bytes_) {
+    return;
+  }
+
+  // Never evict entries that were used during the current frame, their
+  // textures are still referenced by the recorded render passes and evicting
+  // them would not free any memory.
+  using EntryIterator = decltype(entries_)::iterator;
+  std::vector<EntryIterator> candidates;
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->second.last_used_frame != frame_count_) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EntryIterator& lhs, const EntryIterator& rhs) {
+              return lhs->second.last_used_frame <
+                     rhs->second.last_used_frame;
+            });
+
+  for (const EntryIterator& it : candidates) {
+    if (bytes_used_ <= max_bytes_) {
+      break;
+    }
+    bytes_used_ -= it->second.byte_size;
+    // Erasing by iterator does not invalidate other iterators into the
+    // flat_hash_map.
+    entries_.erase(it);
+    evictions_++;
+  }
+}
+
+TextShadowCache::Stats TextShadowCache::GetStats() const {
+  return Stats{.hits = hits_,
+               .misses = misses_,
+               .evictions = evictions_,
+               .entry_count = entries_.size(),
+               .bytes_used = bytes_used_};
 }
 
 std::optional<Entity> TextShadowCache::Lookup(
@@ -48,12 +145,14 @@ std::optional<Entity> TextShadowCache::Lookup(
   auto it = entries_.find(text_key);
 
   if (it != entries_.end()) {
-    it->second.used_this_frame = true;
+    hits_++;
+    it->second.last_used_frame = frame_count_;
     Entity cache_entity = it->second.entity.Clone();
     cache_entity.SetClipDepth(entity.GetClipDepth());
     cache_entity.SetTransform(entity.GetTransform() * it->second.key_matrix);
     return cache_entity;
   }
+  misses_++;
 
   std::optional<Rect> filter_coverage = contents->GetCoverage(entity);
   if (!filter_coverage.has_value()) {
@@ -85,10 +184,27 @@ std::optional<Entity> TextShadowCache::Lookup(
   // them.
   Matrix key_matrix =
       entity.GetTransform().Invert() * maybe_entity->GetTransform();
+
+  // The filter result is a texture rendered at the size of its untransformed
+  // coverage, which is used to estimate the memory retained by this entry.
+  Entity local_entity = maybe_entity->Clone();
+  local_entity.SetTransform(Matrix());
+  std::optional<Rect> local_coverage = local_entity.GetCoverage();
+  size_t byte_size = 0u;
+  if (local_coverage.has_value()) {
+    ISize texture_size = ISize::Ceil(local_coverage->GetSize());
+    byte_size = texture_size.Area() *
+                BytesPerPixelForPixelFormat(renderer.GetContext()
+                                                ->GetCapabilities()
+                                                ->GetDefaultColorFormat());
+  }
+
+  bytes_used_ += byte_size;
   entries_[text_key] =
       TextShadowCacheData{.entity = maybe_entity.value().Clone(),
-                          .used_this_frame = true,
-                          .key_matrix = key_matrix};
+                          .key_matrix = key_matrix,
+                          .byte_size = byte_size,
+                          .last_used_frame = frame_count_};
 
   maybe_entity->SetClipDepth(entity.GetClipDepth());
   return maybe_entity;
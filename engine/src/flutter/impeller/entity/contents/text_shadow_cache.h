@@ -11,6 +11,7 @@
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/geometry/sigma.h"
+#include "impeller/typographer/text_frame.h"
 #include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
 
 namespace impeller {
@@ -18,19 +19,23 @@ namespace impeller {
 /// @brief A cache for blurred text that re-uses these across frames.
 ///
 /// Text shadows are generally stable, but expensive to compute as we use a
-/// full gaussian blur. This class caches these shadows by text blob identifier
-/// and holds them for at least one frame.
+/// full gaussian blur. This class caches these shadows by the glyph content of
+/// the text frame, so that text which scrolls out of view or is re-shaped into
+/// a new text frame with identical glyphs can re-use a previously blurred
+/// texture.
 ///
-/// Additionally, there is an optimization for a single glyph (generally an
-/// Icon) that uses the content itself as a key.
+/// Entries are retained across frames (including frames where they are not
+/// drawn) until the total size of the cached textures exceeds the byte
+/// budget, at which point the least recently used entries are evicted.
 ///
-/// If there was a cheaper method of text frame identity, or a per-glyph caching
-/// system this could be more efficient. As it exists, this mostly ameliorate
-/// severe performance degradation for glyph shadows but does not provide
-/// substantially better performance than Skia.
+/// Additionally, there is an optimization for a single glyph (generally an
+/// Icon) that uses the glyph itself as a key, ignoring its position.
 class TextShadowCache {
  public:
-  TextShadowCache() = default;
+  /// The default upper bound on the size of all cached shadow textures.
+  static constexpr size_t kDefaultMaxBytes = 16u * 1024u * 1024u;
+
+  explicit TextShadowCache(size_t max_bytes = kDefaultMaxBytes);
 
   ~TextShadowCache() = default;
 
@@ -42,13 +47,26 @@ class TextShadowCache {
     Font font;
     Rational rounded_sigma;
     Color color;
+    /// The text frame whose glyph content produced [identifier]. Used to
+    /// resolve hash collisions between distinct multi-glyph frames. Null for
+    /// single glyph keys.
+    std::shared_ptr<const TextFrame> frame;
 
     TextShadowCacheKey(Scalar p_max_basis,
                        int64_t p_identifier,
                        bool p_is_single_glyph,
                        const Font& p_font,
                        Sigma p_sigma,
-                       Color p_color);
+                       Color p_color,
+                       std::shared_ptr<const TextFrame> p_frame = nullptr);
+
+    /// @brief Compute an identifier for the text frame that depends only on
+    ///        its runs, fonts, glyphs and glyph positions.
+    static int64_t ComputeContentIdentifier(const TextFrame& frame);
+
+    /// @brief Whether the two text frames have identical runs, fonts, glyphs
+    ///        and glyph positions.
+    static bool IsContentEqual(const TextFrame& lhs, const TextFrame& rhs);
 
     struct Hash {
       std::size_t operator()(const TextShadowCacheKey& key) const {
@@ -60,21 +78,46 @@ class TextShadowCache {
     };
 
     struct Equal {
-      constexpr bool operator()(const TextShadowCacheKey& lhs,
-                                const TextShadowCacheKey& rhs) const {
-        return lhs.max_basis == rhs.max_basis &&
-               lhs.identifier == rhs.identifier &&
-               lhs.is_single_glyph == rhs.is_single_glyph &&
-               lhs.font.IsEqual(rhs.font) &&
-               lhs.rounded_sigma == rhs.rounded_sigma && lhs.color == rhs.color;
+      bool operator()(const TextShadowCacheKey& lhs,
+                      const TextShadowCacheKey& rhs) const {
+        if (!(lhs.max_basis == rhs.max_basis &&
+              lhs.identifier == rhs.identifier &&
+              lhs.is_single_glyph == rhs.is_single_glyph &&
+              lhs.font.IsEqual(rhs.font) &&
+              lhs.rounded_sigma == rhs.rounded_sigma &&
+              lhs.color == rhs.color)) {
+          return false;
+        }
+        if (lhs.frame == rhs.frame) {
+          return true;
+        }
+        if (!lhs.frame || !rhs.frame) {
+          return false;
+        }
+        return IsContentEqual(*lhs.frame, *rhs.frame);
       }
     };
   };
 
-  /// @brief Mark all glyph textures as unused this frame.
+  /// @brief Statistics describing the effectiveness of the cache.
+  struct Stats {
+    /// The number of lookups that were satisfied by a cached texture.
+    size_t hits = 0u;
+    /// The number of lookups that required rendering a new blurred texture.
+    size_t misses = 0u;
+    /// The number of entries removed to satisfy the byte budget.
+    size_t evictions = 0u;
+    /// The number of entries currently held by the cache.
+    size_t entry_count = 0u;
+    /// The estimated size of all textures currently held by the cache.
+    size_t bytes_used = 0u;
+  };
+
+  /// @brief Begin a new frame.
   void MarkFrameStart();
 
-  /// @brief Remove all glyph textures that were not referenced at least once.
+  /// @brief Evict least recently used glyph textures until the cache is within
+  ///        its byte budget.
   void MarkFrameEnd();
 
   /// @brief Lookup the entity in the cache with the given filter/text contents,
@@ -86,6 +129,15 @@ class TextShadowCache {
                                const std::shared_ptr<FilterContents>& contents,
                                const TextShadowCacheKey&);
 
+  /// @brief Update the upper bound on the size of all cached textures. Takes
+  ///        effect at the next call to [MarkFrameEnd].
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  /// @brief Retrieve the cache statistics accumulated since creation.
+  Stats GetStats() const;
+
   // Visible for testing.
   size_t GetCacheSizeForTesting() const { return entries_.size(); }
 
@@ -96,15 +148,24 @@ class TextShadowCache {
 
   struct TextShadowCacheData {
     Entity entity;
-    bool used_this_frame = true;
     Matrix key_matrix;
+    size_t byte_size = 0u;
+    uint64_t last_used_frame = 0u;
   };
 
+  void EvictToBudget();
+
   absl::flat_hash_map<TextShadowCacheKey,
                       TextShadowCacheData,
                       TextShadowCacheKey::Hash,
                       TextShadowCacheKey::Equal>
       entries_;
+  size_t max_bytes_;
+  size_t bytes_used_ = 0u;
+  uint64_t frame_count_ = 0u;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+  size_t evictions_ = 0u;
 };
 
 }  // namespace impeller
@@ -0,0 +1,503 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/native_library.h"
+#include "impeller/core/formats.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+// Renders GaussianBlurFilterContents with the Vulkan backend, once with the
+// separable kernel and once with the dual Kawase pyramid of
+// Flags::pyramid_blur.
+//
+// Besides the time, every benchmark reports the render passes the blur
+// recorded along with the bytes each of them wrote to its attachments and
+// read from the textures it sampled. These come from the Vulkan calls the
+// context makes, which the benchmark intercepts. Each sampled texture is
+// counted once per pass, as if every texel was fetched from memory exactly
+// once, so the read figures are the traffic of a perfect texture cache.
+//
+// On machines without a GPU, point the loader at SwiftShader or llvmpipe
+// with VK_ICD_FILENAMES. The loader itself can be overridden with the
+// IMPELLER_VULKAN_LIBRARY environment variable. run_tests.py and
+// generate_metrics.sh use the SwiftShader build from the output directory.
+
+namespace impeller {
+
+namespace {
+
+struct PassStatistics {
+  size_t bytes_read = 0u;
+  size_t bytes_written = 0u;
+};
+
+struct ImageInfo {
+  VkExtent3D extent;
+  VkFormat format;
+};
+
+/// The state shared by the intercepted Vulkan functions.
+struct PassRecorder {
+  std::mutex mutex;
+
+  PFN_vkGetInstanceProcAddr get_instance_proc_addr = nullptr;
+  PFN_vkGetDeviceProcAddr get_device_proc_addr = nullptr;
+  PFN_vkCreateImage create_image = nullptr;
+  PFN_vkCreateImageView create_image_view = nullptr;
+  PFN_vkCreateFramebuffer create_framebuffer = nullptr;
+  PFN_vkUpdateDescriptorSets update_descriptor_sets = nullptr;
+  PFN_vkCmdBeginRenderPass cmd_begin_render_pass = nullptr;
+  PFN_vkCmdBindDescriptorSets cmd_bind_descriptor_sets = nullptr;
+  PFN_vkCmdEndRenderPass cmd_end_render_pass = nullptr;
+
+  std::unordered_map<VkImage, ImageInfo> images;
+  std::unordered_map<VkImageView, VkImage> image_views;
+  std::unordered_map<VkFramebuffer, std::vector<VkImageView>> framebuffers;
+  std::unordered_map<VkDescriptorSet, std::map<uint32_t, VkImageView>>
+      descriptor_sets;
+
+  bool recording = false;
+  std::vector<PassStatistics> passes;
+  /// The passes that are currently being recorded into each command buffer,
+  /// as indices into `passes`.
+  std::unordered_map<VkCommandBuffer, size_t> open_passes;
+  /// The images already counted as read by each entry of `passes`.
+  std::vector<std::set<VkImage>> sampled_images;
+};
+
+PassRecorder& GetPassRecorder() {
+  static PassRecorder* recorder = new PassRecorder();
+  return *recorder;
+}
+
+// Must be called with the recorder mutex held.
+const ImageInfo* FindImageViewInfo(const PassRecorder& recorder,
+                                   VkImageView view) {
+  auto image = recorder.image_views.find(view);
+  if (image == recorder.image_views.end()) {
+    return nullptr;
+  }
+  auto info = recorder.images.find(image->second);
+  return info == recorder.images.end() ? nullptr : &info->second;
+}
+
+size_t GetBytesPerPixel(const ImageInfo& info) {
+  return BytesPerPixelForPixelFormat(
+      ToPixelFormat(static_cast<vk::Format>(info.format)));
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+RecordCreateImage(VkDevice device,
+                  const VkImageCreateInfo* create_info,
+                  const VkAllocationCallbacks* allocator,
+                  VkImage* image) {
+  PassRecorder& recorder = GetPassRecorder();
+  VkResult result =
+      recorder.create_image(device, create_info, allocator, image);
+  if (result == VK_SUCCESS) {
+    std::scoped_lock lock(recorder.mutex);
+    recorder.images[*image] = {create_info->extent, create_info->format};
+  }
+  return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+RecordCreateImageView(VkDevice device,
+                      const VkImageViewCreateInfo* create_info,
+                      const VkAllocationCallbacks* allocator,
+                      VkImageView* view) {
+  PassRecorder& recorder = GetPassRecorder();
+  VkResult result =
+      recorder.create_image_view(device, create_info, allocator, view);
+  if (result == VK_SUCCESS) {
+    std::scoped_lock lock(recorder.mutex);
+    recorder.image_views[*view] = create_info->image;
+  }
+  return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+RecordCreateFramebuffer(VkDevice device,
+                        const VkFramebufferCreateInfo* create_info,
+                        const VkAllocationCallbacks* allocator,
+                        VkFramebuffer* framebuffer) {
+  PassRecorder& recorder = GetPassRecorder();
+  VkResult result =
+      recorder.create_framebuffer(device, create_info, allocator, framebuffer);
+  if (result == VK_SUCCESS) {
+    std::scoped_lock lock(recorder.mutex);
+    recorder.framebuffers[*framebuffer] = std::vector<VkImageView>(
+        create_info->pAttachments,
+        create_info->pAttachments + create_info->attachmentCount);
+  }
+  return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL
+RecordUpdateDescriptorSets(VkDevice device,
+                           uint32_t write_count,
+                           const VkWriteDescriptorSet* writes,
+                           uint32_t copy_count,
+                           const VkCopyDescriptorSet* copies) {
+  PassRecorder& recorder = GetPassRecorder();
+  {
+    std::scoped_lock lock(recorder.mutex);
+    for (uint32_t i = 0; i < write_count; i++) {
+      const VkWriteDescriptorSet& write = writes[i];
+      if (write.descriptorType != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER &&
+          write.descriptorType != VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE &&
+          write.descriptorType != VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) {
+        continue;
+      }
+      for (uint32_t j = 0; j < write.descriptorCount; j++) {
+        recorder.descriptor_sets[write.dstSet][write.dstBinding + j] =
+            write.pImageInfo[j].imageView;
+      }
+    }
+  }
+  recorder.update_descriptor_sets(device, write_count, writes, copy_count,
+                                  copies);
+}
+
+VKAPI_ATTR void VKAPI_CALL
+RecordCmdBeginRenderPass(VkCommandBuffer command_buffer,
+                         const VkRenderPassBeginInfo* begin_info,
+                         VkSubpassContents contents) {
+  PassRecorder& recorder = GetPassRecorder();
+  {
+    std::scoped_lock lock(recorder.mutex);
+    if (recorder.recording) {
+      PassStatistics pass;
+      // Attachments are assumed to be single sampled and stored in full.
+      size_t area = static_cast<size_t>(begin_info->renderArea.extent.width) *
+                    begin_info->renderArea.extent.height;
+      for (VkImageView view : recorder.framebuffers[begin_info->framebuffer]) {
+        if (const ImageInfo* info = FindImageViewInfo(recorder, view)) {
+          pass.bytes_written += area * GetBytesPerPixel(*info);
+        }
+      }
+      recorder.open_passes[command_buffer] = recorder.passes.size();
+      recorder.passes.push_back(pass);
+      recorder.sampled_images.emplace_back();
+    }
+  }
+  recorder.cmd_begin_render_pass(command_buffer, begin_info, contents);
+}
+
+// Only descriptor sets bound to the primary command buffer are seen, which
+// covers every pass with fewer draws than are recorded in parallel.
+VKAPI_ATTR void VKAPI_CALL
+RecordCmdBindDescriptorSets(VkCommandBuffer command_buffer,
+                            VkPipelineBindPoint bind_point,
+                            VkPipelineLayout layout,
+                            uint32_t first_set,
+                            uint32_t set_count,
+                            const VkDescriptorSet* sets,
+                            uint32_t dynamic_offset_count,
+                            const uint32_t* dynamic_offsets) {
+  PassRecorder& recorder = GetPassRecorder();
+  {
+    std::scoped_lock lock(recorder.mutex);
+    auto pass = recorder.open_passes.find(command_buffer);
+    if (pass != recorder.open_passes.end()) {
+      for (uint32_t i = 0; i < set_count; i++) {
+        for (const auto& [binding, view] : recorder.descriptor_sets[sets[i]]) {
+          const ImageInfo* info = FindImageViewInfo(recorder, view);
+          if (!info ||
+              !recorder.sampled_images[pass->second]
+                   .insert(recorder.image_views[view])
+                   .second) {
+            continue;
+          }
+          recorder.passes[pass->second].bytes_read +=
+              static_cast<size_t>(info->extent.width) * info->extent.height *
+              GetBytesPerPixel(*info);
+        }
+      }
+    }
+  }
+  recorder.cmd_bind_descriptor_sets(command_buffer, bind_point, layout,
+                                    first_set, set_count, sets,
+                                    dynamic_offset_count, dynamic_offsets);
+}
+
+VKAPI_ATTR void VKAPI_CALL
+RecordCmdEndRenderPass(VkCommandBuffer command_buffer) {
+  PassRecorder& recorder = GetPassRecorder();
+  {
+    std::scoped_lock lock(recorder.mutex);
+    recorder.open_passes.erase(command_buffer);
+  }
+  recorder.cmd_end_render_pass(command_buffer);
+}
+
+/// Returns the recording wrapper of the function with the given name, or
+/// nullptr if it isn't intercepted. When `function` is not null it becomes
+/// the function that the wrapper forwards to.
+PFN_vkVoidFunction GetRecordingFunction(const char* name,
+                                        PFN_vkVoidFunction function) {
+  PassRecorder& recorder = GetPassRecorder();
+#define IMPELLER_RECORD_PROC(proc, member, wrapper)               \
+  if (std::strcmp(name, #proc) == 0) {                            \
+    if (function) {                                               \
+      recorder.member = reinterpret_cast<PFN_##proc>(function);   \
+    }                                                             \
+    return recorder.member                                        \
+               ? reinterpret_cast<PFN_vkVoidFunction>(&(wrapper)) \
+               : nullptr;                                         \
+  }
+  IMPELLER_RECORD_PROC(vkCreateImage, create_image, RecordCreateImage);
+  IMPELLER_RECORD_PROC(vkCreateImageView, create_image_view,
+                       RecordCreateImageView);
+  IMPELLER_RECORD_PROC(vkCreateFramebuffer, create_framebuffer,
+                       RecordCreateFramebuffer);
+  IMPELLER_RECORD_PROC(vkUpdateDescriptorSets, update_descriptor_sets,
+                       RecordUpdateDescriptorSets);
+  IMPELLER_RECORD_PROC(vkCmdBeginRenderPass, cmd_begin_render_pass,
+                       RecordCmdBeginRenderPass);
+  IMPELLER_RECORD_PROC(vkCmdBindDescriptorSets, cmd_bind_descriptor_sets,
+                       RecordCmdBindDescriptorSets);
+  IMPELLER_RECORD_PROC(vkCmdEndRenderPass, cmd_end_render_pass,
+                       RecordCmdEndRenderPass);
+#undef IMPELLER_RECORD_PROC
+  return nullptr;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL
+RecordGetDeviceProcAddr(VkDevice device, const char* name) {
+  // Device level functions are only intercepted once the loader trampolines
+  // have been resolved through vkGetInstanceProcAddr, as those work for
+  // every device the benchmark creates.
+  if (PFN_vkVoidFunction recording = GetRecordingFunction(name, nullptr)) {
+    return recording;
+  }
+  return GetPassRecorder().get_device_proc_addr(device, name);
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL
+RecordGetInstanceProcAddr(VkInstance instance, const char* name) {
+  PassRecorder& recorder = GetPassRecorder();
+  if (std::strcmp(name, "vkGetInstanceProcAddr") == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(&RecordGetInstanceProcAddr);
+  }
+  PFN_vkVoidFunction function = recorder.get_instance_proc_addr(instance, name);
+  if (!function) {
+    return nullptr;
+  }
+  if (std::strcmp(name, "vkGetDeviceProcAddr") == 0) {
+    recorder.get_device_proc_addr =
+        reinterpret_cast<PFN_vkGetDeviceProcAddr>(function);
+    return reinterpret_cast<PFN_vkVoidFunction>(&RecordGetDeviceProcAddr);
+  }
+  if (PFN_vkVoidFunction recording = GetRecordingFunction(name, function)) {
+    return recording;
+  }
+  return function;
+}
+
+void StartRecordingPasses() {
+  PassRecorder& recorder = GetPassRecorder();
+  std::scoped_lock lock(recorder.mutex);
+  recorder.recording = true;
+  recorder.passes.clear();
+  recorder.sampled_images.clear();
+  recorder.open_passes.clear();
+}
+
+std::vector<PassStatistics> StopRecordingPasses() {
+  PassRecorder& recorder = GetPassRecorder();
+  std::scoped_lock lock(recorder.mutex);
+  recorder.recording = false;
+  return std::move(recorder.passes);
+}
+
+struct BenchmarkRenderer {
+  std::shared_ptr<ContextVK> context;
+  std::unique_ptr<ContentContext> content_context;
+};
+
+fml::RefPtr<fml::NativeLibrary> LoadVulkanLibrary() {
+  const char* library_path = std::getenv("IMPELLER_VULKAN_LIBRARY");
+  auto vulkan_library = fml::NativeLibrary::Create(
+      library_path ? library_path : "libvulkan.so.1");
+  if (!vulkan_library) {
+    return nullptr;
+  }
+  auto proc_address =
+      vulkan_library->ResolveFunction<PFN_vkGetInstanceProcAddr>(
+          "vkGetInstanceProcAddr");
+  if (!proc_address.has_value()) {
+    return nullptr;
+  }
+  GetPassRecorder().get_instance_proc_addr = proc_address.value();
+  return vulkan_library;
+}
+
+std::unique_ptr<BenchmarkRenderer> CreateRenderer(bool pyramid_blur) {
+  ContextVK::Settings settings;
+  settings.proc_address_callback = &RecordGetInstanceProcAddr;
+  settings.shader_libraries_data = {
+      std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
+                                             impeller_entity_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
+                                             impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_framebuffer_blend_shaders_vk_data,
+          impeller_framebuffer_blend_shaders_vk_length),
+  };
+  settings.flags.pyramid_blur = pyramid_blur;
+  auto context = ContextVK::Create(std::move(settings));
+  if (!context || !context->IsValid()) {
+    return nullptr;
+  }
+  auto content_context =
+      std::make_unique<ContentContext>(context, TypographerContextSkia::Make());
+  if (!content_context->IsValid()) {
+    return nullptr;
+  }
+  return std::make_unique<BenchmarkRenderer>(
+      BenchmarkRenderer{std::move(context), std::move(content_context)});
+}
+
+// Created on first use and intentionally leaked, Vulkan doesn't like being
+// torn down from static destructors.
+BenchmarkRenderer* GetRenderer(bool pyramid_blur) {
+  static fml::RefPtr<fml::NativeLibrary> vulkan_library = LoadVulkanLibrary();
+  if (!vulkan_library) {
+    return nullptr;
+  }
+  if (pyramid_blur) {
+    static BenchmarkRenderer* renderer = CreateRenderer(true).release();
+    return renderer;
+  }
+  static BenchmarkRenderer* renderer = CreateRenderer(false).release();
+  return renderer;
+}
+
+/// Makes an opaque texture for the blur to read from.
+std::shared_ptr<Texture> MakeSourceTexture(const BenchmarkRenderer& renderer,
+                                           ISize size) {
+  RenderTargetAllocator allocator(renderer.context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreen(
+      *renderer.context, size, /*mip_count=*/1, "Blur Source",
+      RenderTarget::AttachmentConfig{
+          .storage_mode = StorageMode::kDevicePrivate,
+          .load_action = LoadAction::kClear,
+          .store_action = StoreAction::kStore,
+          .clear_color = Color::Red(),
+      },
+      /*stencil_attachment_config=*/std::nullopt);
+  if (!target.IsValid()) {
+    return nullptr;
+  }
+  auto command_buffer = renderer.context->CreateCommandBuffer();
+  auto pass = command_buffer->CreateRenderPass(target);
+  if (!pass || !pass->EncodeCommands() ||
+      !renderer.context->GetCommandQueue()->Submit({command_buffer}).ok()) {
+    return nullptr;
+  }
+  return target.GetRenderTargetTexture();
+}
+
+bool RenderBlur(const BenchmarkRenderer& renderer,
+                const FilterContents& blur) {
+  ContentContext& content_context = *renderer.content_context;
+  content_context.GetRenderTargetCache()->Start();
+  std::optional<Entity> result =
+      blur.GetEntity(content_context, Entity(), /*coverage_hint=*/std::nullopt);
+  content_context.GetRenderTargetCache()->End();
+  content_context.ResetTransientsBuffers();
+  bool flushed = renderer.context->FlushCommandBuffers();
+  [[maybe_unused]] auto wait_result = renderer.context->GetDevice().waitIdle();
+  return result.has_value() && flushed;
+}
+
+}  // namespace
+
+/// Blurs an opaque square of `state.range(1)` pixels with a sigma of
+/// `state.range(0)`, clamping at the edges.
+template <class... Args>
+static void BM_GaussianBlur(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  bool pyramid = std::get<bool>(args_tuple);
+
+  BenchmarkRenderer* renderer = GetRenderer(pyramid);
+  if (!renderer) {
+    state.SkipWithError("Could not create a Vulkan context.");
+    return;
+  }
+  Sigma sigma(static_cast<Scalar>(state.range(0)));
+  ISize size(state.range(1), state.range(1));
+  std::shared_ptr<Texture> source = MakeSourceTexture(*renderer, size);
+  if (!source) {
+    state.SkipWithError("Could not create the source texture.");
+    return;
+  }
+  std::shared_ptr<FilterContents> blur = FilterContents::MakeGaussianBlur(
+      FilterInput::Make(source), sigma, sigma, Entity::TileMode::kClamp);
+
+  // Render once outside of the timed loop so that pipelines are created and
+  // render targets are in the cache. Only this frame's passes are recorded.
+  StartRecordingPasses();
+  bool rendered = RenderBlur(*renderer, *blur);
+  std::vector<PassStatistics> passes = StopRecordingPasses();
+  if (!rendered) {
+    state.SkipWithError("Could not render the blur.");
+    return;
+  }
+  // The separable blur always renders three passes, the pyramid at least
+  // five.
+  if (pyramid && passes.size() <= 3u) {
+    state.SkipWithError("The pyramid blur does not apply to this sigma.");
+    return;
+  }
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RenderBlur(*renderer, *blur));
+  }
+
+  size_t bytes_read = 0u;
+  size_t bytes_written = 0u;
+  for (size_t i = 0; i < passes.size(); i++) {
+    std::string prefix = "Pass" + std::to_string(i);
+    state.counters[prefix + "BytesRead"] = passes[i].bytes_read;
+    state.counters[prefix + "BytesWritten"] = passes[i].bytes_written;
+    bytes_read += passes[i].bytes_read;
+    bytes_written += passes[i].bytes_written;
+  }
+  state.counters["PassCount"] = passes.size();
+  state.counters["BytesRead"] = bytes_read;
+  state.counters["BytesWritten"] = bytes_written;
+}
+
+// Sigmas are scaled down before they are compared against
+// kGaussianBlurPyramidMinSigma. All of these are large enough to take the
+// pyramid path when it is enabled.
+#define MAKE_GAUSSIAN_BLUR_BENCHMARK_CAPTURE(name, pyramid) \
+  BENCHMARK_CAPTURE(BM_GaussianBlur, name, pyramid)         \
+      ->ArgsProduct({{32, 64, 128, 256}, {512, 1024, 2048}})
+
+MAKE_GAUSSIAN_BLUR_BENCHMARK_CAPTURE(separable, false);
+MAKE_GAUSSIAN_BLUR_BENCHMARK_CAPTURE(pyramid, true);
+
+}  // namespace impeller
@@ -2170,6 +2170,34 @@ TEST_P(EntityTest, PointFieldGeometryCoverage) {
             Rect::MakeLTRB(35, 15, 135, 205));
 }
 
+TEST_P(EntityTest, PointFieldGeometryInstancedPositionBuffer) {
+  RenderTarget target;
+  testing::MockRenderPass mock_pass(GetContext(), target);
+
+  std::vector<Point> points = {{10, 20}, {100, 200}, {30, 40}};
+  PointFieldGeometry geometry(points.data(), 3, 5.0, false);
+  std::optional<InstancedGeometryResult> result =
+      geometry.GetInstancedPositionBuffer(*GetContentContext(), {}, mock_pass);
+  ASSERT_TRUE(result.has_value());
+
+  // A single square is drawn once per point.
+  EXPECT_EQ(result->shape.type, PrimitiveType::kTriangleStrip);
+  EXPECT_EQ(result->shape.vertex_buffer.vertex_count, 4u);
+  EXPECT_EQ(result->instance_count, 3u);
+  EXPECT_GE(result->offsets.GetRange().length, 3 * sizeof(Point));
+
+  // The tessellated buffer holds every copy of the shape.
+  const Geometry& base = geometry;
+  GeometryResult tessellated =
+      base.GetPositionBuffer(*GetContentContext(), {}, mock_pass);
+  EXPECT_EQ(tessellated.vertex_buffer.vertex_count, 6u * 3u - 2u);
+
+  PointFieldGeometry empty(points.data(), 0, 5.0, false);
+  result =
+      empty.GetInstancedPositionBuffer(*GetContentContext(), {}, mock_pass);
+  EXPECT_FALSE(result.has_value());
+}
+
 TEST_P(EntityTest, ColorFilterContentsWithLargeGeometry) {
   Entity entity;
   entity.SetTransform(Matrix::MakeScale(GetContentScale()));
@@ -2255,6 +2283,35 @@ TEST_P(EntityTest, ContentContextOptionsHasReasonableHashFunctions) {
   EXPECT_NE(hash_c, hash_d);
 }
 
+TEST_P(EntityTest, ContentContextOptionsCanBeReconstructedFromKey) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kLuminosity,
+      .depth_compare = CompareFunction::kGreaterEqual,
+      .stencil_mode = ContentContextOptions::StencilMode::kCoverCompareInverted,
+      .primitive_type = PrimitiveType::kTriangleFan,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_depth_stencil_attachments = false,
+      .depth_write_enabled = true,
+      .is_for_rrect_blur_clear = true,
+  };
+  std::optional<ContentContextOptions> decoded =
+      ContentContextOptions::FromKey(opts.ToKey());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->ToKey(), opts.ToKey());
+
+  decoded = ContentContextOptions::FromKey(ContentContextOptions{}.ToKey());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->ToKey(), ContentContextOptions{}.ToKey());
+
+  // Out of range enums and unused bits.
+  EXPECT_FALSE(ContentContextOptions::FromKey(0xFFllu << 40).has_value());
+  EXPECT_FALSE(
+      ContentContextOptions::FromKey(ContentContextOptions{}.ToKey() | 2llu)
+          .has_value());
+  EXPECT_FALSE(ContentContextOptions::FromKey(1llu << 60).has_value());
+}
+
 #ifdef FML_OS_LINUX
 TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
   // Using framebuffer fetch on Vulkan requires that we maintain a subpass input
@@ -55,6 +55,13 @@ GeometryResult Geometry::ComputePositionGeometry(
   };
 }
 
+std::optional<InstancedGeometryResult> Geometry::GetInstancedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return std::nullopt;
+}
+
 GeometryResult::Mode Geometry::GetResultMode() const {
   return GeometryResult::Mode::kNormal;
 }
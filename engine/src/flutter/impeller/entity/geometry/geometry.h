@@ -40,6 +40,16 @@ struct GeometryResult {
   Mode mode = Mode::kNormal;
 };
 
+/// A shape and the offsets at which copies of it are drawn, for pipelines
+/// that draw instances.
+struct InstancedGeometryResult {
+  /// The vertices of a single instance, relative to its offset.
+  GeometryResult shape;
+  /// The offset of every instance as tightly packed points.
+  BufferView offsets;
+  size_t instance_count = 0u;
+};
+
 static const GeometryResult kEmptyResult = {
     .vertex_buffer =
         {
@@ -97,6 +107,21 @@ class Geometry {
                                            const Entity& entity,
                                            RenderPass& pass) const = 0;
 
+  /// @brief  Generates the geometry as copies of a single shape drawn at a
+  ///         list of offsets.
+  ///
+  ///         Contents that draw with a pipeline that supports instancing may
+  ///         use this instead of `GetPositionBuffer` so that the vertices of
+  ///         every copy don't have to be generated on the CPU. This requires
+  ///         storage buffer support.
+  ///
+  /// @returns `std::nullopt` if the geometry isn't made of copies of one
+  ///          shape, in which case `GetPositionBuffer` must be used.
+  virtual std::optional<InstancedGeometryResult> GetInstancedPositionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const;
+
   virtual GeometryResult::Mode GetResultMode() const;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/point_field_geometry.h"
 
+#include <cstring>
+
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/vertex_buffer.h"
@@ -23,99 +25,99 @@ PointFieldGeometry::PointFieldGeometry(const Point* points,
 
 PointFieldGeometry::~PointFieldGeometry() = default;
 
+std::optional<Scalar> PointFieldGeometry::GetDrawnRadius(
+    const Matrix& transform) const {
+  if (radius_ < 0.0 || point_count_ == 0) {
+    return std::nullopt;
+  }
+  Scalar max_basis = transform.GetMaxBasisLengthXY();
+  if (max_basis == 0) {
+    return std::nullopt;
+  }
+  Scalar min_size = 0.5f / max_basis;
+  return std::max(radius_, min_size);
+}
+
+std::vector<Point> PointFieldGeometry::GenerateShapeVertices(
+    Tessellator& tessellator,
+    const Matrix& transform,
+    Scalar radius,
+    bool round) {
+  if (!round) {
+    // Z pattern from UL -> UR -> LL -> LR
+    return {
+        Point(-radius, -radius),
+        Point(radius, -radius),
+        Point(-radius, radius),
+        Point(radius, radius),
+    };
+  }
+
+  // Get triangulation relative to {0, 0} so we can translate it to each
+  // point in turn.
+  Tessellator::EllipticalVertexGenerator generator =
+      tessellator.FilledCircle(transform, {}, radius);
+  FML_DCHECK(generator.GetTriangleType() == PrimitiveType::kTriangleStrip);
+
+  std::vector<Point> circle_vertices;
+  circle_vertices.reserve(generator.GetVertexCount());
+  generator.GenerateVertices([&circle_vertices](const Point& p) {  //
+    circle_vertices.push_back(p);
+  });
+  FML_DCHECK(circle_vertices.size() == generator.GetVertexCount());
+  return circle_vertices;
+}
+
+size_t PointFieldGeometry::GetTessellatedVertexCount(
+    size_t shape_vertex_count,
+    size_t point_count) {
+  return (shape_vertex_count + 2) * point_count - 2;
+}
+
+void PointFieldGeometry::WriteTessellatedVertices(
+    const std::vector<Point>& shape,
+    const Point* points,
+    size_t point_count,
+    Point* output) {
+  size_t offset = 0;
+
+  Point center = points[0];
+  for (const Point& vertex : shape) {
+    output[offset++] = center + vertex;
+  }
+  // For all subequent points, insert a degenerate triangle to break
+  // the strip. This could be optimized out if we switched to using
+  // primitive restart.
+  Point last_point = shape.back() + center;
+  for (size_t i = 1; i < point_count; i++) {
+    Point center = points[i];
+    output[offset++] = last_point;
+    output[offset++] = center + shape[0];
+    for (const Point& vertex : shape) {
+      output[offset++] = center + vertex;
+    }
+    last_point = shape.back() + center;
+  }
+}
+
 GeometryResult PointFieldGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) const {
-  if (radius_ < 0.0 || point_count_ == 0) {
-    return {};
-  }
   const Matrix& transform = entity.GetTransform();
-  Scalar max_basis = transform.GetMaxBasisLengthXY();
-  if (max_basis == 0) {
+  std::optional<Scalar> radius = GetDrawnRadius(transform);
+  if (!radius.has_value()) {
     return {};
   }
 
-  Scalar min_size = 0.5f / max_basis;
-  Scalar radius = std::max(radius_, min_size);
-  HostBuffer& data_host_buffer = renderer.GetTransientsDataBuffer();
-  BufferView buffer_view;
-  size_t vertex_count = 0;
-
-  if (round_) {
-    // Get triangulation relative to {0, 0} so we can translate it to each
-    // point in turn.
-    Tessellator::EllipticalVertexGenerator generator =
-        renderer.GetTessellator().FilledCircle(transform, {}, radius);
-    FML_DCHECK(generator.GetTriangleType() == PrimitiveType::kTriangleStrip);
-
-    std::vector<Point> circle_vertices;
-    circle_vertices.reserve(generator.GetVertexCount());
-    generator.GenerateVertices([&circle_vertices](const Point& p) {  //
-      circle_vertices.push_back(p);
-    });
-    FML_DCHECK(circle_vertices.size() == generator.GetVertexCount());
-
-    vertex_count = (circle_vertices.size() + 2) * point_count_ - 2;
-    buffer_view = data_host_buffer.Emplace(
-        vertex_count * sizeof(Point), alignof(Point), [&](uint8_t* data) {
-          Point* output = reinterpret_cast<Point*>(data);
-          size_t offset = 0;
-
-          Point center = points_[0];
-          for (auto& vertex : circle_vertices) {
-            output[offset++] = static_cast<Point>(center + vertex);
-          }
-          // For all subequent points, insert a degenerate triangle to break
-          // the strip. This could be optimized out if we switched to using
-          // primitive restart.
-          Point last_point = circle_vertices.back() + center;
-          for (size_t i = 1; i < point_count_; i++) {
-            Point center = points_[i];
-            output[offset++] = last_point;
-            output[offset++] = static_cast<Point>(center + circle_vertices[0]);
-            for (const Point& vertex : circle_vertices) {
-              output[offset++] = static_cast<Point>(center + vertex);
-            }
-            last_point = circle_vertices.back() + center;
-          }
-        });
-  } else {
-    vertex_count = 6 * point_count_ - 2;
-    buffer_view = data_host_buffer.Emplace(
-        vertex_count * sizeof(Point), alignof(Point), [&](uint8_t* data) {
-          Point* output = reinterpret_cast<Point*>(data);
-          size_t offset = 0;
-
-          Point point = points_[0];
-          Point first = Point(point.x - radius, point.y - radius);
-
-          // Z pattern from UL -> UR -> LL -> LR
-          Point last_point = Point(0, 0);
-          output[offset++] = first;
-          output[offset++] = Point(point.x + radius, point.y - radius);
-          output[offset++] = Point(point.x - radius, point.y + radius);
-          output[offset++] = last_point =
-              Point(point.x + radius, point.y + radius);
-
-          // For all subequent points, insert a degenerate triangle to break
-          // the strip. This could be optimized out if we switched to using
-          // primitive restart.
-          for (size_t i = 1; i < point_count_; i++) {
-            Point point = points_[i];
-            Point first = Point(point.x - radius, point.y - radius);
-
-            output[offset++] = last_point;
-            output[offset++] = first;
-
-            output[offset++] = first;
-            output[offset++] = Point(point.x + radius, point.y - radius);
-            output[offset++] = Point(point.x - radius, point.y + radius);
-            output[offset++] = last_point =
-                Point(point.x + radius, point.y + radius);
-          }
-        });
-  }
+  std::vector<Point> shape = GenerateShapeVertices(
+      renderer.GetTessellator(), transform, radius.value(), round_);
+  size_t vertex_count = GetTessellatedVertexCount(shape.size(), point_count_);
+  BufferView buffer_view = renderer.GetTransientsDataBuffer().Emplace(
+      vertex_count * sizeof(Point), alignof(Point), [&](uint8_t* data) {
+        WriteTessellatedVertices(shape, points_, point_count_,
+                                 reinterpret_cast<Point*>(data));
+      });
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -130,6 +132,52 @@ GeometryResult PointFieldGeometry::GetPositionBuffer(
   };
 }
 
+// |Geometry|
+std::optional<InstancedGeometryResult>
+PointFieldGeometry::GetInstancedPositionBuffer(const ContentContext& renderer,
+                                               const Entity& entity,
+                                               RenderPass& pass) const {
+  const Matrix& transform = entity.GetTransform();
+  std::optional<Scalar> radius = GetDrawnRadius(transform);
+  if (!radius.has_value()) {
+    return std::nullopt;
+  }
+
+  std::vector<Point> shape = GenerateShapeVertices(
+      renderer.GetTessellator(), transform, radius.value(), round_);
+  HostBuffer& data_host_buffer = renderer.GetTransientsDataBuffer();
+  BufferView shape_view = data_host_buffer.Emplace(
+      shape.data(), shape.size() * sizeof(Point), alignof(Point));
+
+  // The instanced vertex shader reads two offsets out of every vec4 of the
+  // storage buffer, so round the size up to a whole number of vec4s.
+  size_t offsets_size = (point_count_ + 1) / 2 * 2 * sizeof(Point);
+  BufferView offsets_view = data_host_buffer.Emplace(
+      offsets_size,
+      renderer.GetDeviceCapabilities().GetMinimumStorageBufferAlignment(),
+      [&](uint8_t* data) {
+        memset(data, 0, offsets_size);
+        memcpy(data, points_, point_count_ * sizeof(Point));
+      });
+
+  return InstancedGeometryResult{
+      .shape =
+          GeometryResult{
+              .type = PrimitiveType::kTriangleStrip,
+              .vertex_buffer =
+                  VertexBuffer{
+                      .vertex_buffer = std::move(shape_view),
+                      .index_buffer = {},
+                      .vertex_count = shape.size(),
+                      .index_type = IndexType::kNone,
+                  },
+              .transform = entity.GetShaderTransform(pass),
+          },
+      .offsets = std::move(offsets_view),
+      .instance_count = point_count_,
+  };
+}
+
 // |Geometry|
 std::optional<Rect> PointFieldGeometry::GetCoverage(
     const Matrix& transform) const {
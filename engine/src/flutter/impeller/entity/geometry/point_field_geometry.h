@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_POINT_FIELD_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_POINT_FIELD_GEOMETRY_H_
 
+#include <optional>
+#include <vector>
+
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -25,12 +28,41 @@ class PointFieldGeometry final : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  std::optional<InstancedGeometryResult> GetInstancedPositionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const override;
+
  private:
+  friend class ImpellerBenchmarkAccessor;
+
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const override;
 
+  /// The radius that points are drawn with under |transform|, or
+  /// `std::nullopt` if nothing should be drawn.
+  std::optional<Scalar> GetDrawnRadius(const Matrix& transform) const;
+
+  /// The triangle strip of a single point centered on the origin.
+  static std::vector<Point> GenerateShapeVertices(Tessellator& tessellator,
+                                                  const Matrix& transform,
+                                                  Scalar radius,
+                                                  bool round);
+
+  /// The number of vertices that |WriteTessellatedVertices| writes.
+  static size_t GetTessellatedVertexCount(size_t shape_vertex_count,
+                                          size_t point_count);
+
+  /// Writes a copy of |shape| centered on every point into a single triangle
+  /// strip, with degenerate triangles between the copies.
+  static void WriteTessellatedVertices(const std::vector<Point>& shape,
+                                       const Point* points,
+                                       size_t point_count,
+                                       Point* output);
+
   size_t point_count_;
   Scalar radius_;
   bool round_;
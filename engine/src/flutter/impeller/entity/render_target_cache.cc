@@ -3,11 +3,68 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
+namespace {
+
+// The device memory held by the attachments of |render_target|. Transient
+// attachments have no backing memory.
+size_t GetAttachmentBytes(const RenderTarget& render_target) {
+  size_t bytes = 0u;
+  auto add_texture = [&bytes](const std::shared_ptr<Texture>& texture) {
+    if (!texture) {
+      return;
+    }
+    const TextureDescriptor& desc = texture->GetTextureDescriptor();
+    if (desc.storage_mode != StorageMode::kDeviceTransient) {
+      bytes += desc.GetByteSizeOfAllMipLevels() *
+               static_cast<size_t>(desc.sample_count);
+    }
+  };
+  render_target.IterateAllAttachments(
+      [&add_texture](const Attachment& attachment) {
+        add_texture(attachment.texture);
+        add_texture(attachment.resolve_texture);
+        return true;
+      });
+  return bytes;
+}
+
+// Whether the backend of |context| keeps the textures used by a command
+// buffer referenced until the GPU has finished executing it.
+bool TracksTextureUsage(const Context& context) {
+  return context.GetBackendType() == Context::BackendType::kVulkan;
+}
+
+// Whether the cache holds the only references to the attachments of
+// |render_target|. Only on backends that track texture usage does this mean
+// that whoever rendered into or sampled from it is done with it.
+bool IsOnlyReferencedByCache(const RenderTarget& render_target) {
+  bool only_cache = true;
+  auto check_texture = [&only_cache](const std::shared_ptr<Texture>& texture) {
+    if (texture && texture.use_count() > 1) {
+      only_cache = false;
+    }
+  };
+  render_target.IterateAllAttachments(
+      [&check_texture, &only_cache](const Attachment& attachment) {
+        check_texture(attachment.texture);
+        check_texture(attachment.resolve_texture);
+        return only_cache;
+      });
+  return only_cache;
+}
+
+}  // namespace
+
 RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
                                      uint32_t keep_alive_frame_count)
     : RenderTargetAllocator(std::move(allocator)),
@@ -18,6 +75,7 @@ void RenderTargetCache::Start() {
   for (auto& td : render_target_data_) {
     td.used_this_frame = false;
   }
+  frame_statistics_ = {.peak_bytes = cached_bytes_};
 }
 
 void RenderTargetCache::End() {
@@ -30,9 +88,19 @@ void RenderTargetCache::End() {
     } else if (td.keep_alive_frame_count > 0) {
       td.keep_alive_frame_count--;
       retain.push_back(td);
+    } else {
+      cached_bytes_ -= td.bytes;
     }
   }
   render_target_data_.swap(retain);
+  memory_usage_.Set(cached_bytes_);
+
+  last_frame_statistics_ = frame_statistics_;
+  FML_TRACE_COUNTER("impeller", "RenderTargetCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Allocations", last_frame_statistics_.allocation_count,  //
+                    "Aliases", last_frame_statistics_.alias_count,           //
+                    "PeakBytes", last_frame_statistics_.peak_bytes);
 }
 
 void RenderTargetCache::DisableCache() {
@@ -75,21 +143,17 @@ RenderTarget RenderTargetCache::CreateOffscreen(
   };
 
   if (CacheEnabled()) {
-    for (RenderTargetData& render_target_data : render_target_data_) {
-      const RenderTargetConfig other_config = render_target_data.config;
-      if (!render_target_data.used_this_frame && other_config == config) {
-        render_target_data.used_this_frame = true;
-        render_target_data.keep_alive_frame_count = keep_alive_frame_count_;
-        ColorAttachment color0 =
-            render_target_data.render_target.GetColorAttachment(0);
-        std::optional<DepthAttachment> depth =
-            render_target_data.render_target.GetDepthAttachment();
-        std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-        return RenderTargetAllocator::CreateOffscreen(
-            context, size, mip_count, label, color_attachment_config,
-            stencil_attachment_config, color0.texture, depth_tex,
-            target_pixel_format);
-      }
+    if (RenderTargetData* render_target_data =
+            FindAvailableTarget(config, TracksTextureUsage(context))) {
+      ColorAttachment color0 =
+          render_target_data->render_target.GetColorAttachment(0);
+      std::optional<DepthAttachment> depth =
+          render_target_data->render_target.GetDepthAttachment();
+      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+      return RenderTargetAllocator::CreateOffscreen(
+          context, size, mip_count, label, color_attachment_config,
+          stencil_attachment_config, color0.texture, depth_tex,
+          target_pixel_format);
     }
   }
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreen(
@@ -99,12 +163,7 @@ RenderTarget RenderTargetCache::CreateOffscreen(
     return created_target;
   }
   if (CacheEnabled()) {
-    render_target_data_.push_back(RenderTargetData{
-        .used_this_frame = true,                            //
-        .keep_alive_frame_count = keep_alive_frame_count_,  //
-        .config = config,                                   //
-        .render_target = created_target                     //
-    });
+    AddTarget(config, created_target);
   }
   return created_target;
 }
@@ -134,21 +193,17 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
       .has_depth_stencil = stencil_attachment_config.has_value(),
   };
   if (CacheEnabled()) {
-    for (RenderTargetData& render_target_data : render_target_data_) {
-      const RenderTargetConfig other_config = render_target_data.config;
-      if (!render_target_data.used_this_frame && other_config == config) {
-        render_target_data.used_this_frame = true;
-        render_target_data.keep_alive_frame_count = keep_alive_frame_count_;
-        ColorAttachment color0 =
-            render_target_data.render_target.GetColorAttachment(0);
-        std::optional<DepthAttachment> depth =
-            render_target_data.render_target.GetDepthAttachment();
-        std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-        return RenderTargetAllocator::CreateOffscreenMSAA(
-            context, size, mip_count, label, color_attachment_config,
-            stencil_attachment_config, color0.texture, color0.resolve_texture,
-            depth_tex, target_pixel_format);
-      }
+    if (RenderTargetData* render_target_data =
+            FindAvailableTarget(config, TracksTextureUsage(context))) {
+      ColorAttachment color0 =
+          render_target_data->render_target.GetColorAttachment(0);
+      std::optional<DepthAttachment> depth =
+          render_target_data->render_target.GetDepthAttachment();
+      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+      return RenderTargetAllocator::CreateOffscreenMSAA(
+          context, size, mip_count, label, color_attachment_config,
+          stencil_attachment_config, color0.texture, color0.resolve_texture,
+          depth_tex, target_pixel_format);
     }
   }
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreenMSAA(
@@ -159,18 +214,55 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
     return created_target;
   }
   if (CacheEnabled()) {
-    render_target_data_.push_back(RenderTargetData{
-        .used_this_frame = true,                            //
-        .keep_alive_frame_count = keep_alive_frame_count_,  //
-        .config = config,                                   //
-        .render_target = created_target                     //
-    });
+    AddTarget(config, created_target);
   }
   return created_target;
 }
 
+RenderTargetCache::RenderTargetData* RenderTargetCache::FindAvailableTarget(
+    const RenderTargetConfig& config,
+    bool may_alias) {
+  for (RenderTargetData& render_target_data : render_target_data_) {
+    if (render_target_data.config != config) {
+      continue;
+    }
+    if (render_target_data.used_this_frame) {
+      // The target may still be aliased if its last user has let go of it.
+      if (!may_alias ||
+          !IsOnlyReferencedByCache(render_target_data.render_target)) {
+        continue;
+      }
+      frame_statistics_.alias_count++;
+    }
+    render_target_data.used_this_frame = true;
+    render_target_data.keep_alive_frame_count = keep_alive_frame_count_;
+    return &render_target_data;
+  }
+  return nullptr;
+}
+
+void RenderTargetCache::AddTarget(const RenderTargetConfig& config,
+                                  const RenderTarget& render_target) {
+  const size_t bytes = GetAttachmentBytes(render_target);
+  render_target_data_.push_back(RenderTargetData{
+      .used_this_frame = true,                            //
+      .keep_alive_frame_count = keep_alive_frame_count_,  //
+      .config = config,                                   //
+      .render_target = render_target,                     //
+      .bytes = bytes                                      //
+  });
+  cached_bytes_ += bytes;
+  frame_statistics_.allocation_count++;
+  frame_statistics_.peak_bytes =
+      std::max(frame_statistics_.peak_bytes, cached_bytes_);
+}
+
 size_t RenderTargetCache::CachedTextureCount() const {
   return render_target_data_.size();
 }
 
+size_t RenderTargetCache::CachedTextureBytes() const {
+  return cached_bytes_;
+}
+
 }  // namespace impeller
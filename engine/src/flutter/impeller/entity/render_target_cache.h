@@ -7,6 +7,7 @@
 
 #include <string_view>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -15,8 +16,29 @@ namespace impeller {
 ///        allocated texture data for one frame.
 ///
 ///        Any textures unused after a frame are immediately discarded.
+///
+///        On Vulkan, the textures of a target are also handed out again
+///        within a frame once nothing outside of the cache references them
+///        anymore. Vulkan command buffers hold references to every texture
+///        they use until the GPU has finished executing them, so targets
+///        whose lifetimes don't overlap share the same textures. Other
+///        backends don't track the textures used by encoded passes, so the
+///        reference count is no proof that the GPU is done with a texture and
+///        targets are only reused across frames.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
+  /// @brief Allocation statistics of a single frame.
+  struct FrameStatistics {
+    /// The number of targets that were allocated because no cached target
+    /// was available.
+    size_t allocation_count = 0u;
+    /// The number of targets that reused the textures of a target that was
+    /// also used earlier in the same frame.
+    size_t alias_count = 0u;
+    /// The most bytes held by the cache at any point during the frame.
+    size_t peak_bytes = 0u;
+  };
+
   explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
                              uint32_t keep_alive_frame_count = 4);
 
@@ -64,19 +86,45 @@ class RenderTargetCache : public RenderTargetAllocator {
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  /// @brief The bytes held by the textures that were retained at the end of
+  ///        the last frame.
+  size_t CachedTextureBytes() const;
+
+  /// @brief The statistics of the last frame that ended.
+  const FrameStatistics& GetLastFrameStatistics() const {
+    return last_frame_statistics_;
+  }
+
  private:
   struct RenderTargetData {
     bool used_this_frame;
     uint32_t keep_alive_frame_count;
     RenderTargetConfig config;
     RenderTarget render_target;
+    size_t bytes;
   };
 
   bool CacheEnabled() const;
 
+  /// @brief Finds a cached target with |config| whose textures may be
+  ///        rendered to, and marks it as used this frame.
+  ///
+  /// @param[in]  may_alias  Whether targets already used this frame may be
+  ///                        handed out again.
+  RenderTargetData* FindAvailableTarget(const RenderTargetConfig& config,
+                                        bool may_alias);
+
+  void AddTarget(const RenderTargetConfig& config,
+                 const RenderTarget& render_target);
+
   std::vector<RenderTargetData> render_target_data_;
   uint32_t keep_alive_frame_count_;
   uint32_t cache_disabled_count_ = 0;
+  size_t cached_bytes_ = 0u;
+  FrameStatistics frame_statistics_;
+  FrameStatistics last_frame_statistics_;
+  fml::MemoryUsageCounter memory_usage_{
+      fml::MemoryCategory::kRenderTargetCache};
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
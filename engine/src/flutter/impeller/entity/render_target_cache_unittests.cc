@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/testing/testing.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/allocator.h"
@@ -55,12 +56,17 @@ TEST_P(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
       GetContext()->GetResourceAllocator(), /*keep_alive_frame_count=*/0);
 
   render_target_cache.Start();
-  // Create two render targets of the same exact size/shape. Both should be
-  // marked as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  // Create two render targets of the same exact size/shape that are alive at
+  // the same time. Both should be marked as used this frame, so the cached
+  // data set will contain two.
+  {
+    RenderTarget target1 =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+    RenderTarget target2 =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
 
-  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+    EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  }
 
   render_target_cache.End();
   render_target_cache.Start();
@@ -79,12 +85,17 @@ TEST_P(RenderTargetCacheTest, CachesUsedTexturesAcrossFramesWithKeepAlive) {
       GetContext()->GetResourceAllocator(), /*keep_alive_frame_count=*/3);
 
   render_target_cache.Start();
-  // Create two render targets of the same exact size/shape. Both should be
-  // marked as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  // Create two render targets of the same exact size/shape that are alive at
+  // the same time. Both should be marked as used this frame, so the cached
+  // data set will contain two.
+  {
+    RenderTarget target1 =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+    RenderTarget target2 =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
 
-  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+    EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  }
 
   render_target_cache.End();
   render_target_cache.Start();
@@ -104,6 +115,98 @@ TEST_P(RenderTargetCacheTest, CachesUsedTexturesAcrossFramesWithKeepAlive) {
   EXPECT_EQ(render_target_cache.CachedTextureCount(), 0u);
 }
 
+TEST_P(RenderTargetCacheTest, ReportsTheBytesOfRetainedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/0);
+  const size_t reported_bytes =
+      fml::GetMemoryUsage().GetBytes(fml::MemoryCategory::kRenderTargetCache);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+
+  // At least the 4 byte per pixel color attachment is accounted for.
+  const size_t bytes = render_target_cache.CachedTextureBytes();
+  EXPECT_GE(bytes, 100u * 100u * 4u);
+  EXPECT_EQ(
+      fml::GetMemoryUsage().GetBytes(fml::MemoryCategory::kRenderTargetCache),
+      reported_bytes + bytes);
+
+  render_target_cache.Start();
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureBytes(), 0u);
+  EXPECT_EQ(
+      fml::GetMemoryUsage().GetBytes(fml::MemoryCategory::kRenderTargetCache),
+      reported_bytes);
+}
+
+TEST_P(RenderTargetCacheTest, AliasesTargetsWhoseLifetimesDoNotOverlap) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/0);
+
+  render_target_cache.Start();
+  std::shared_ptr<Texture> texture1 =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1)
+          .GetRenderTargetTexture();
+  // The first target is still referenced through its texture.
+  std::shared_ptr<Texture> texture2 =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1)
+          .GetRenderTargetTexture();
+  EXPECT_NE(texture1, texture2);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Once let go of, the textures of a target are handed out again in the
+  // same frame, but only where the backend keeps the textures used by
+  // encoded passes alive until the GPU is done with them.
+  const bool tracks_textures =
+      GetContext()->GetBackendType() == Context::BackendType::kVulkan;
+  Texture* released_texture = texture1.get();
+  texture1.reset();
+  RenderTarget target3 =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  if (tracks_textures) {
+    EXPECT_EQ(target3.GetRenderTargetTexture().get(), released_texture);
+    EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  } else {
+    EXPECT_EQ(render_target_cache.CachedTextureCount(), 3u);
+  }
+  render_target_cache.End();
+
+  const RenderTargetCache::FrameStatistics& statistics =
+      render_target_cache.GetLastFrameStatistics();
+  EXPECT_EQ(statistics.allocation_count, tracks_textures ? 2u : 3u);
+  EXPECT_EQ(statistics.alias_count, tracks_textures ? 1u : 0u);
+}
+
+TEST_P(RenderTargetCacheTest, ReportsPeakBytesOfEachFrame) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/0);
+
+  render_target_cache.Start();
+  {
+    RenderTarget target1 =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+    RenderTarget target2 =
+        render_target_cache.CreateOffscreen(*GetContext(), {50, 50}, 1);
+  }
+  render_target_cache.End();
+  const size_t bytes = render_target_cache.CachedTextureBytes();
+  EXPECT_EQ(render_target_cache.GetLastFrameStatistics().peak_bytes, bytes);
+  EXPECT_EQ(render_target_cache.GetLastFrameStatistics().allocation_count, 2u);
+
+  // The cached targets count towards the peak of the next frame until they
+  // are evicted at its end.
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+  EXPECT_LT(render_target_cache.CachedTextureBytes(), bytes);
+  EXPECT_EQ(render_target_cache.GetLastFrameStatistics().peak_bytes, bytes);
+  EXPECT_EQ(render_target_cache.GetLastFrameStatistics().allocation_count, 0u);
+}
+
 TEST_P(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   ScopedValidationDisable disable;
   auto allocator = std::make_shared<TestAllocator>();
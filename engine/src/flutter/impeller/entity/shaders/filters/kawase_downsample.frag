@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The downsample half of a dual Kawase blur. Renders at half the resolution of
+// the input, averaging the texel block under the output pixel with four
+// diagonal samples spread by `offset`.
+
+#include <impeller/constants.glsl>
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+uniform f16sampler2D texture_sampler;
+
+layout(constant_id = 0) const float supports_decal = 1.0;
+
+uniform FragInfo {
+  // Half of the size of an input texel in UV space.
+  vec2 half_pixel;
+  // The sample spread, in units of `half_pixel`.
+  float offset;
+}
+frag_info;
+
+f16vec4 Sample(f16sampler2D tex, vec2 coords) {
+  if (supports_decal == 1.0) {
+    return texture(tex, coords);
+  }
+  return IPHalfSampleDecal(tex, coords);
+}
+
+in highp vec2 v_texture_coords;
+
+out f16vec4 frag_color;
+
+void main() {
+  vec2 spread = frag_info.half_pixel * frag_info.offset;
+  f16vec4 total = Sample(texture_sampler, v_texture_coords) * 4.0hf;
+  total += Sample(texture_sampler, v_texture_coords - spread);
+  total += Sample(texture_sampler, v_texture_coords + spread);
+  total += Sample(texture_sampler, v_texture_coords + vec2(spread.x, -spread.y));
+  total += Sample(texture_sampler, v_texture_coords - vec2(spread.x, -spread.y));
+  frag_color = total * 0.125hf;
+}
@@ -0,0 +1,26 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+}
+frame_info;
+
+// The offset of every instance, two to an element so that the array has the
+// same layout as a tightly packed array of points.
+layout(std140) readonly buffer InstanceData {
+  vec4 offsets[];
+}
+instance_data;
+
+// A vertex of the shape that is drawn at every offset.
+in vec2 position;
+
+void main() {
+  vec4 offsets = instance_data.offsets[gl_InstanceIndex / 2];
+  vec2 offset = (gl_InstanceIndex % 2) == 0 ? offsets.xy : offsets.zw;
+  gl_Position = frame_info.mvp * vec4(position + offset, 0.0, 1.0);
+}
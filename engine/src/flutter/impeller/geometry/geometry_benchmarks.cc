@@ -6,6 +6,7 @@
 
 #include "flutter/display_list/geometry/dl_path.h"
 #include "flutter/display_list/geometry/dl_path_builder.h"
+#include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/shadow_path_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/tessellator/tessellator_libtess.h"
@@ -22,6 +23,23 @@ class ImpellerBenchmarkAccessor {
     return StrokePathGeometry::GenerateSolidStrokeVertices(  //
         tessellator, path, stroke, scale);
   }
+
+  static std::vector<Point> GeneratePointFieldShape(Tessellator& tessellator,
+                                                    Scalar radius,
+                                                    bool round) {
+    return PointFieldGeometry::GenerateShapeVertices(tessellator, Matrix(),
+                                                     radius, round);
+  }
+
+  static std::vector<Point> GenerateTessellatedPointField(
+      const std::vector<Point>& shape,
+      const std::vector<Point>& points) {
+    std::vector<Point> vertices(PointFieldGeometry::GetTessellatedVertexCount(
+        shape.size(), points.size()));
+    PointFieldGeometry::WriteTessellatedVertices(
+        shape, points.data(), points.size(), vertices.data());
+    return vertices;
+  }
 };
 
 namespace {
@@ -119,6 +137,40 @@ static void BM_ShadowPathVerticesImpeller(benchmark::State& state,
   }
 }
 
+static void BM_PointField(benchmark::State& state,
+                          bool round,
+                          bool instanced) {
+  Tessellator tessellator;
+  std::vector<Point> points;
+  points.reserve(100000);
+  for (int i = 0; i < 100000; i++) {
+    points.emplace_back((i % 1000) * 2.0f, (i / 1000) * 2.0f);
+  }
+
+  size_t vertex_bytes = 0u;
+  while (state.KeepRunning()) {
+    auto shape = ImpellerBenchmarkAccessor::GeneratePointFieldShape(
+        tessellator, 4.0f, round);
+    if (instanced) {
+      // The instanced draw uploads one copy of the shape plus the points.
+      std::vector<Point> offsets(points);
+      benchmark::DoNotOptimize(offsets.data());
+      vertex_bytes = (shape.size() + offsets.size()) * sizeof(Point);
+    } else {
+      auto vertices = ImpellerBenchmarkAccessor::GenerateTessellatedPointField(
+          shape, points);
+      benchmark::DoNotOptimize(vertices.data());
+      vertex_bytes = vertices.size() * sizeof(Point);
+    }
+  }
+  state.counters["VertexBytes"] = vertex_bytes;
+}
+
+BENCHMARK_CAPTURE(BM_PointField, round_tessellated, true, false);
+BENCHMARK_CAPTURE(BM_PointField, round_instanced, true, true);
+BENCHMARK_CAPTURE(BM_PointField, square_tessellated, false, false);
+BENCHMARK_CAPTURE(BM_PointField, square_instanced, false, true);
+
 #define MAKE_SHADOW_BENCHMARK_CAPTURE(clockwise, shape, backend) \
   BENCHMARK_CAPTURE(BM_ShadowPathVertices##backend,              \
                     shadow_##clockwise##_##shape##_##backend,    \
@@ -165,6 +165,8 @@ void GoldenPlaygroundTest::SetUp() {
       test_name.find("WideGamut_") != std::string::npos;
   switches.flags.antialiased_lines =
       test_name.find("ExperimentAntialiasLines_") != std::string::npos;
+  switches.flags.pyramid_blur =
+      test_name.find("ExperimentPyramidBlur_") != std::string::npos;
   switch (GetParam()) {
     case PlaygroundBackend::kMetal:
       if (!DoesSupportWideGamutTests()) {
@@ -182,6 +184,9 @@ void GoldenPlaygroundTest::SetUp() {
         GTEST_SKIP()
             << "Vulkan doesn't support antialiased lines golden tests.";
       }
+      if (switches.flags.pyramid_blur) {
+        GTEST_SKIP() << "Vulkan doesn't support pyramid blur golden tests.";
+      }
       const std::unique_ptr<PlaygroundImpl>& playground =
           GetSharedVulkanPlayground(/*enable_validations=*/true);
       pimpl_->screenshotter =
@@ -196,6 +201,9 @@ void GoldenPlaygroundTest::SetUp() {
         GTEST_SKIP()
             << "OpenGLES doesn't support antialiased lines golden tests.";
       }
+      if (switches.flags.pyramid_blur) {
+        GTEST_SKIP() << "OpenGLES doesn't support pyramid blur golden tests.";
+      }
       FML_CHECK(::glfwInit() == GLFW_TRUE);
       PlaygroundSwitches playground_switches;
       playground_switches.use_angle = true;
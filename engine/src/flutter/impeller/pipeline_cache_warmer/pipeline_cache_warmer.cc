@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/pipeline_cache_warmer/pipeline_cache_warmer.h"
+
+#include <charconv>
+#include <sstream>
+
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+
+namespace impeller {
+
+namespace {
+
+std::string ToHex(const uint8_t* data, size_t length) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string result;
+  result.reserve(length * 2u);
+  for (size_t i = 0; i < length; i++) {
+    result.push_back(kDigits[data[i] >> 4]);
+    result.push_back(kDigits[data[i] & 0xf]);
+  }
+  return result;
+}
+
+void WriteEscapedString(std::ostream& stream, std::string_view string) {
+  stream << '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          // Driver names are free-form. Drop anything that would need a
+          // \u escape rather than emitting invalid JSON.
+          continue;
+        }
+        stream << c;
+        break;
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+std::vector<ContentContextOptions> GetDefaultWarmUpOptions(
+    PixelFormat color_format,
+    bool all_blend_modes) {
+  const ContentContextOptions base_options[] = {
+      ContentContextOptions{
+          .sample_count = SampleCount::kCount4,
+          .color_attachment_pixel_format = color_format,
+      },
+      ContentContextOptions{
+          .sample_count = SampleCount::kCount4,
+          .primitive_type = PrimitiveType::kTriangleStrip,
+          .color_attachment_pixel_format = color_format,
+      },
+      ContentContextOptions{
+          .sample_count = SampleCount::kCount1,
+          .primitive_type = PrimitiveType::kTriangleStrip,
+          .color_attachment_pixel_format = color_format,
+          .has_depth_stencil_attachments = false,
+      },
+  };
+
+  std::vector<ContentContextOptions> result;
+  for (const ContentContextOptions& options : base_options) {
+    if (!all_blend_modes) {
+      result.push_back(options);
+      continue;
+    }
+    for (auto mode = 0u;
+         mode <= static_cast<uint8_t>(Entity::kLastPipelineBlendMode); mode++) {
+      ContentContextOptions blend_options = options;
+      blend_options.blend_mode = static_cast<BlendMode>(mode);
+      result.push_back(blend_options);
+    }
+  }
+  return result;
+}
+
+std::optional<std::vector<ContentContextOptions>> ParseWarmUpOptionKeys(
+    const std::vector<std::string_view>& keys) {
+  std::vector<ContentContextOptions> result;
+  for (std::string_view key : keys) {
+    if (key.starts_with("0x")) {
+      key.remove_prefix(2u);
+    }
+    uint64_t value = 0u;
+    auto [end, error] =
+        std::from_chars(key.data(), key.data() + key.size(), value, 16);
+    if (key.empty() || error != std::errc() || end != key.data() + key.size()) {
+      return std::nullopt;
+    }
+    std::optional<ContentContextOptions> options =
+        ContentContextOptions::FromKey(value);
+    // Advanced blends are performed in shaders and never reach a pipeline.
+    if (!options.has_value() ||
+        options->blend_mode > Entity::kLastPipelineBlendMode) {
+      return std::nullopt;
+    }
+    result.push_back(options.value());
+  }
+  return result;
+}
+
+std::string PipelineCacheManifest::ToJSON() const {
+  std::stringstream stream;
+  stream << "{\n";
+  stream << "  \"cache_file\": \"flutter.impeller.vkcache\",\n";
+  stream << "  \"magic\": " << header.magic << ",\n";
+  stream << "  \"driver_version\": " << header.driver_version << ",\n";
+  stream << "  \"vendor_id\": " << header.vendor_id << ",\n";
+  stream << "  \"device_id\": " << header.device_id << ",\n";
+  stream << "  \"abi\": " << header.abi << ",\n";
+  stream << "  \"uuid\": \"" << ToHex(header.uuid, sizeof(header.uuid))
+         << "\",\n";
+  stream << "  \"data_size\": " << header.data_size << ",\n";
+  stream << "  \"driver_name\": ";
+  WriteEscapedString(stream, driver_name);
+  stream << ",\n";
+  stream << "  \"api_version\": ";
+  WriteEscapedString(stream, api_version);
+  stream << ",\n";
+  stream << "  \"pipeline_count\": " << pipeline_count << ",\n";
+  stream << "  \"option_keys\": [";
+  for (size_t i = 0; i < option_keys.size(); i++) {
+    stream << (i == 0 ? "" : ", ") << "\"" << std::hex << option_keys[i]
+           << std::dec << "\"";
+  }
+  stream << "]\n";
+  stream << "}\n";
+  return stream.str();
+}
+
+std::optional<PipelineCacheManifest> WarmPipelineCache(
+    const std::shared_ptr<Context>& context,
+    const std::vector<ContentContextOptions>& options,
+    const fml::UniqueFD& output_directory) {
+  if (!context || context->GetBackendType() != Context::BackendType::kVulkan) {
+    return std::nullopt;
+  }
+
+  PipelineCacheManifest manifest;
+  {
+    ContentContext content_context(context, /*typographer_context=*/nullptr);
+    if (!content_context.IsValid()) {
+      return std::nullopt;
+    }
+    manifest.pipeline_count = content_context.CreatePipelineVariants(options);
+  }
+  if (manifest.pipeline_count == 0u) {
+    return std::nullopt;
+  }
+
+  const std::shared_ptr<PipelineCacheVK>& cache =
+      PipelineLibraryVK::Cast(*context->GetPipelineLibrary()).GetPSOCache();
+  if (!cache->PersistCacheToDirectory(output_directory)) {
+    return std::nullopt;
+  }
+
+  const vk::PhysicalDeviceProperties& props =
+      CapabilitiesVK::Cast(*context->GetCapabilities())
+          .GetPhysicalDeviceProperties();
+  std::unique_ptr<fml::Mapping> cache_data =
+      PipelineCacheDataRetrieve(output_directory, props);
+  if (!cache_data) {
+    return std::nullopt;
+  }
+
+  manifest.header = PipelineCacheHeaderVK(props, cache_data->GetSize());
+  for (const ContentContextOptions& option : options) {
+    manifest.option_keys.push_back(option.ToKey());
+  }
+  return manifest;
+}
+
+}  // namespace impeller
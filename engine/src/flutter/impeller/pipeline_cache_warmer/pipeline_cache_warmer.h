@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_PIPELINE_CACHE_WARMER_PIPELINE_CACHE_WARMER_H_
+#define FLUTTER_IMPELLER_PIPELINE_CACHE_WARMER_PIPELINE_CACHE_WARMER_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/unique_fd.h"
+#include "impeller/core/formats.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The options every pipeline is created with by the pipeline cache
+///             warmer unless a different set is requested.
+///
+///             These are the same options `ContentContext` creates its default
+///             pipelines with. Most frames only ever need a handful of variants
+///             beyond these, so priming more than this mostly makes the cache
+///             bigger.
+///
+/// @param[in]  color_format     The default color format of the device.
+/// @param[in]  all_blend_modes  Whether to include a variant for every blend
+///                              mode that can be expressed in a pipeline
+///                              instead of just source-over.
+///
+std::vector<ContentContextOptions> GetDefaultWarmUpOptions(
+    PixelFormat color_format,
+    bool all_blend_modes);
+
+//------------------------------------------------------------------------------
+/// @brief      Parses options from the hexadecimal form of the keys returned by
+///             `ContentContextOptions::ToKey`.
+///
+/// @return     The parsed options or std::nullopt if any of the keys is
+///             malformed or describes options no pipeline can be created with.
+///
+std::optional<std::vector<ContentContextOptions>> ParseWarmUpOptionKeys(
+    const std::vector<std::string_view>& keys);
+
+//------------------------------------------------------------------------------
+/// @brief      Describes a pipeline cache generated ahead of time.
+///
+///             The header fields are the ones `PipelineCacheHeaderVK` checks
+///             for compatibility. A cache may only be shipped to devices whose
+///             driver matches all of them.
+///
+struct PipelineCacheManifest {
+  static constexpr const char* kFileName = "flutter.impeller.vkcache.json";
+
+  PipelineCacheHeaderVK header;
+  std::string driver_name;
+  std::string api_version;
+  size_t pipeline_count = 0u;
+  std::vector<uint64_t> option_keys;
+
+  std::string ToJSON() const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Creates every `ContentContext` pipeline variant for the given
+///             options and writes the resulting pipeline cache to the output
+///             directory.
+///
+/// @param[in]  context           A context using the Vulkan backend.
+/// @param[in]  options           The options to create variants for.
+/// @param[in]  output_directory  Where to write `flutter.impeller.vkcache`.
+///
+/// @return     A manifest describing the cache that was written or
+///             std::nullopt if it could not be written. The driver name and
+///             API version are left for the caller to fill in.
+///
+std::optional<PipelineCacheManifest> WarmPipelineCache(
+    const std::shared_ptr<Context>& context,
+    const std::vector<ContentContextOptions>& options,
+    const fml::UniqueFD& output_directory);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_PIPELINE_CACHE_WARMER_PIPELINE_CACHE_WARMER_H_
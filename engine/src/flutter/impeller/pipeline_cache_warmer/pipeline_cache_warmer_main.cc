@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <filesystem>
+#include <iostream>
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/native_library.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/pipeline_cache_warmer/pipeline_cache_warmer.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/driver_info_vk.h"
+
+namespace impeller {
+
+static std::vector<std::shared_ptr<fml::Mapping>>
+ShaderLibraryMappingsForWarmer() {
+  return {
+      std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
+                                             impeller_entity_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
+                                             impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_framebuffer_blend_shaders_vk_data,
+          impeller_framebuffer_blend_shaders_vk_length),
+  };
+}
+
+static void PrintUsage() {
+  std::cerr
+      << "Usage: impeller_pipeline_cache_warmer --output=<directory>\n"
+         "    [--vulkan-library=<path>]  The Vulkan loader to use. Point the\n"
+         "                               loader at SwiftShader with\n"
+         "                               VK_ICD_FILENAMES to run headless.\n"
+         "    [--options=<hex key>]...   ContentContextOptions keys to create\n"
+         "                               variants for instead of defaults.\n"
+         "    [--all-blend-modes]        Include every pipeline blend mode in\n"
+         "                               the default options.\n"
+         "    [--enable-validation]      Enable Vulkan validation layers.\n";
+}
+
+bool Main(const fml::CommandLine& command_line) {
+  if (command_line.HasOption("help")) {
+    PrintUsage();
+    return true;
+  }
+
+  std::string output;
+  if (!command_line.GetOptionValue("output", &output)) {
+    std::cerr << "Output directory not specified." << std::endl;
+    PrintUsage();
+    return false;
+  }
+
+  auto output_path =
+      std::filesystem::absolute(std::filesystem::current_path() / output);
+  auto output_directory = fml::OpenDirectory(
+      output_path.string().c_str(), true, fml::FilePermission::kReadWrite);
+  if (!output_directory.is_valid()) {
+    std::cerr << "Could not open output directory " << output_path.string()
+              << std::endl;
+    return false;
+  }
+
+  std::string vulkan_library_path = "libvulkan.so.1";
+  command_line.GetOptionValue("vulkan-library", &vulkan_library_path);
+  auto vulkan_library = fml::NativeLibrary::Create(vulkan_library_path.c_str());
+  if (!vulkan_library) {
+    std::cerr << "Could not open the Vulkan library at " << vulkan_library_path
+              << std::endl;
+    return false;
+  }
+  auto proc_address =
+      vulkan_library->ResolveFunction<PFN_vkGetInstanceProcAddr>(
+          "vkGetInstanceProcAddr");
+  if (!proc_address.has_value()) {
+    std::cerr << "Could not resolve vkGetInstanceProcAddr." << std::endl;
+    return false;
+  }
+
+  ContextVK::Settings settings;
+  settings.proc_address_callback = proc_address.value();
+  settings.shader_libraries_data = ShaderLibraryMappingsForWarmer();
+  // The context loads whatever cache is already in the output directory, so
+  // running the tool again adds to the existing cache.
+  settings.cache_directory = fml::Duplicate(output_directory.get());
+  settings.enable_validation = command_line.HasOption("enable-validation");
+
+  auto context = ContextVK::Create(std::move(settings));
+  if (!context || !context->IsValid()) {
+    std::cerr << "Could not create the Vulkan context." << std::endl;
+    return false;
+  }
+
+  bool success = false;
+  [&]() {
+    std::vector<ContentContextOptions> options;
+    std::vector<std::string_view> keys =
+        command_line.GetOptionValues("options");
+    if (keys.empty()) {
+      options = GetDefaultWarmUpOptions(
+          context->GetCapabilities()->GetDefaultColorFormat(),
+          command_line.HasOption("all-blend-modes"));
+    } else {
+      auto parsed = ParseWarmUpOptionKeys(keys);
+      if (!parsed.has_value()) {
+        std::cerr << "Invalid pipeline options." << std::endl;
+        return;
+      }
+      options = std::move(parsed.value());
+    }
+
+    std::optional<PipelineCacheManifest> manifest =
+        WarmPipelineCache(context, options, output_directory);
+    if (!manifest.has_value()) {
+      std::cerr << "Could not create the pipeline cache." << std::endl;
+      return;
+    }
+    manifest->driver_name = context->GetDriverInfo()->GetDriverName();
+    manifest->api_version =
+        context->GetDriverInfo()->GetAPIVersion().ToString();
+
+    fml::DataMapping manifest_data(manifest->ToJSON());
+    if (!fml::WriteAtomically(output_directory,
+                              PipelineCacheManifest::kFileName,
+                              manifest_data)) {
+      std::cerr << "Could not write the pipeline cache manifest." << std::endl;
+      return;
+    }
+
+    std::cout << "Created " << manifest->pipeline_count << " pipelines for "
+              << manifest->driver_name << " (" << manifest->header.data_size
+              << " bytes of cache data) in " << output_path.string()
+              << std::endl;
+    success = true;
+  }();
+
+  context->Shutdown();
+  return success;
+}
+
+}  // namespace impeller
+
+int main(int argc, char const* argv[]) {
+  return impeller::Main(fml::CommandLineFromPlatformOrArgcArgv(argc, argv))
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
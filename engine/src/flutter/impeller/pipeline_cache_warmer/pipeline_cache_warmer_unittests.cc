@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+#include "impeller/entity/entity.h"
+#include "impeller/pipeline_cache_warmer/pipeline_cache_warmer.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineCacheWarmerTest, DefaultOptionsMatchContentContextDefaults) {
+  auto options = GetDefaultWarmUpOptions(PixelFormat::kR8G8B8A8UNormInt,
+                                         /*all_blend_modes=*/false);
+  ASSERT_EQ(options.size(), 3u);
+  for (const ContentContextOptions& option : options) {
+    EXPECT_EQ(option.blend_mode, BlendMode::kSrcOver);
+    EXPECT_EQ(option.color_attachment_pixel_format,
+              PixelFormat::kR8G8B8A8UNormInt);
+  }
+  EXPECT_EQ(options[0].sample_count, SampleCount::kCount4);
+  EXPECT_EQ(options[0].primitive_type, PrimitiveType::kTriangle);
+  EXPECT_EQ(options[1].primitive_type, PrimitiveType::kTriangleStrip);
+  EXPECT_EQ(options[2].sample_count, SampleCount::kCount1);
+  EXPECT_FALSE(options[2].has_depth_stencil_attachments);
+}
+
+TEST(PipelineCacheWarmerTest, AllBlendModesStopAtLastPipelineBlendMode) {
+  auto options = GetDefaultWarmUpOptions(PixelFormat::kR8G8B8A8UNormInt,
+                                         /*all_blend_modes=*/true);
+  const size_t blend_mode_count =
+      static_cast<size_t>(Entity::kLastPipelineBlendMode) + 1u;
+  ASSERT_EQ(options.size(), 3u * blend_mode_count);
+  for (const ContentContextOptions& option : options) {
+    EXPECT_LE(option.blend_mode, Entity::kLastPipelineBlendMode);
+  }
+}
+
+TEST(PipelineCacheWarmerTest, ParsesOptionKeys) {
+  ContentContextOptions expected{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kPlus,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+  };
+  std::stringstream key;
+  key << std::hex << expected.ToKey();
+  std::string prefixed_key = "0x" + key.str();
+
+  auto parsed = ParseWarmUpOptionKeys({key.str(), prefixed_key});
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(parsed->size(), 2u);
+  EXPECT_EQ(parsed->at(0).ToKey(), expected.ToKey());
+  EXPECT_EQ(parsed->at(1).ToKey(), expected.ToKey());
+}
+
+TEST(PipelineCacheWarmerTest, RejectsInvalidOptionKeys) {
+  EXPECT_FALSE(ParseWarmUpOptionKeys({""}).has_value());
+  EXPECT_FALSE(ParseWarmUpOptionKeys({"not a key"}).has_value());
+  EXPECT_FALSE(ParseWarmUpOptionKeys({"ffffffffffffffff"}).has_value());
+
+  ContentContextOptions advanced{.blend_mode = BlendMode::kMultiply};
+  std::stringstream key;
+  key << std::hex << advanced.ToKey();
+  EXPECT_FALSE(ParseWarmUpOptionKeys({key.str()}).has_value());
+}
+
+TEST(PipelineCacheWarmerTest, ManifestRecordsDriverSignature) {
+  PipelineCacheManifest manifest;
+  manifest.header.driver_version = 42u;
+  manifest.header.vendor_id = 0x13b5;
+  manifest.header.device_id = 7u;
+  manifest.header.uuid[0] = 0xab;
+  manifest.header.data_size = 1024u;
+  manifest.driver_name = "Some \"Driver\"";
+  manifest.api_version = "1.1.0";
+  manifest.pipeline_count = 12u;
+  manifest.option_keys = {0x1f};
+
+  std::string json = manifest.ToJSON();
+  EXPECT_NE(json.find("\"driver_version\": 42,"), std::string::npos);
+  EXPECT_NE(json.find("\"vendor_id\": 5045,"), std::string::npos);
+  EXPECT_NE(json.find("\"device_id\": 7,"), std::string::npos);
+  EXPECT_NE(json.find("\"uuid\": \"ab000000000000000000000000000000\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"data_size\": 1024,"), std::string::npos);
+  EXPECT_NE(json.find("\"driver_name\": \"Some \\\"Driver\\\"\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"pipeline_count\": 12,"), std::string::npos);
+  EXPECT_NE(json.find("\"option_keys\": [\"1f\"]"), std::string::npos);
+}
+
+using PipelineCacheWarmerPlaygroundTest = PlaygroundTest;
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheWarmerPlaygroundTest);
+
+TEST_P(PipelineCacheWarmerPlaygroundTest, CreatesPipelinesAndWritesCache) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto options = GetDefaultWarmUpOptions(
+      GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+      /*all_blend_modes=*/false);
+
+  std::optional<PipelineCacheManifest> manifest =
+      WarmPipelineCache(GetContext(), options, temp_dir.fd());
+  ASSERT_TRUE(manifest.has_value());
+
+  // Every registered pipeline has at least one variant per option set.
+  EXPECT_GE(manifest->pipeline_count, options.size());
+  ASSERT_EQ(manifest->option_keys.size(), options.size());
+  for (size_t i = 0; i < options.size(); i++) {
+    EXPECT_EQ(manifest->option_keys[i], options[i].ToKey());
+  }
+
+  const auto& caps = CapabilitiesVK::Cast(*GetContext()->GetCapabilities());
+  ASSERT_TRUE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkcache"));
+  auto cache_data = PipelineCacheDataRetrieve(
+      temp_dir.fd(), caps.GetPhysicalDeviceProperties());
+  ASSERT_NE(cache_data, nullptr);
+  EXPECT_GT(cache_data->GetSize(), 0u);
+  EXPECT_EQ(manifest->header.data_size, cache_data->GetSize());
+  EXPECT_TRUE(manifest->header.IsCompatibleWith(PipelineCacheHeaderVK(
+      caps.GetPhysicalDeviceProperties(), cache_data->GetSize())));
+}
+
+TEST_P(PipelineCacheWarmerPlaygroundTest, FailsWithoutPipelines) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  EXPECT_FALSE(WarmPipelineCache(GetContext(), {}, temp_dir.fd()).has_value());
+  EXPECT_FALSE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkcache"));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -67,6 +67,8 @@ void PlaygroundTest::SetUp() {
 
   switches.flags.antialiased_lines =
       test_name.find("ExperimentAntialiasLines/") != std::string::npos;
+  switches.flags.pyramid_blur =
+      test_name.find("ExperimentPyramidBlur/") != std::string::npos;
 
   SetupContext(GetParam(), switches);
   SetupWindow();
@@ -191,21 +191,23 @@ bool BufferBindingsGLES::ReadUniformsBindingsV2(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindVertexAttributes(StateCacheGLES& state,
                                               size_t binding,
                                               size_t vertex_offset) {
   if (binding >= vertex_attrib_arrays_.size()) {
     return false;
   }
+  const ProcTableGLES& gl = state.GetProcTable();
 
   if (!gl.GetCapabilities()->IsES()) {
     FML_DCHECK(vertex_array_object_ == 0);
     gl.GenVertexArrays(1, &vertex_array_object_);
     gl.BindVertexArray(vertex_array_object_);
+    state.ResetVertexAttribArrays();
   }
 
   for (const auto& array : vertex_attrib_arrays_[binding]) {
-    gl.EnableVertexAttribArray(array.index);
+    state.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -220,22 +222,24 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindUniformData(
-    const ProcTableGLES& gl,
+    StateCacheGLES& state,
     const std::vector<TextureAndSampler>& bound_textures,
     const std::vector<BufferResource>& bound_buffers,
     Range texture_range,
     Range buffer_range) {
+  const ProcTableGLES& gl = state.GetProcTable();
   for (auto i = 0u; i < buffer_range.length; i++) {
     if (!BindUniformBuffer(gl, bound_buffers[buffer_range.offset + i])) {
       return false;
     }
   }
   std::optional<size_t> next_unit_index =
-      BindTextures(gl, bound_textures, texture_range, ShaderStage::kVertex);
+      BindTextures(state, bound_textures, texture_range, ShaderStage::kVertex);
   if (!next_unit_index.has_value()) {
     return false;
   }
-  if (!BindTextures(gl, bound_textures, texture_range, ShaderStage::kFragment,
+  if (!BindTextures(state, bound_textures, texture_range,
+                    ShaderStage::kFragment,
                     *next_unit_index)
            .has_value()) {
     return false;
@@ -244,15 +248,15 @@ bool BufferBindingsGLES::BindUniformData(
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) {
-  for (const auto& array : vertex_attrib_arrays_) {
-    for (const auto& attribute : array) {
-      gl.DisableVertexAttribArray(attribute.index);
-    }
-  }
+bool BufferBindingsGLES::UnbindVertexAttributes(StateCacheGLES& state) {
+  const ProcTableGLES& gl = state.GetProcTable();
+  // The arrays stay enabled in case the next draw uses them too. The state
+  // cache disables them before the next draw that doesn't.
+  state.ReleaseVertexAttribArrays();
   if (!gl.GetCapabilities()->IsES()) {
     gl.DeleteVertexArrays(1, &vertex_array_object_);
     vertex_array_object_ = 0;
+    state.ResetVertexAttribArrays();
   }
 
   return true;
@@ -443,11 +447,12 @@ bool BufferBindingsGLES::BindUniformBufferV2(
 }
 
 std::optional<size_t> BufferBindingsGLES::BindTextures(
-    const ProcTableGLES& gl,
+    StateCacheGLES& state,
     const std::vector<TextureAndSampler>& bound_textures,
     Range texture_range,
     ShaderStage stage,
     size_t unit_start_index) {
+  const ProcTableGLES& gl = state.GetProcTable();
   size_t active_index = unit_start_index;
   for (auto i = 0u; i < texture_range.length; i++) {
     const TextureAndSampler& data = bound_textures[texture_range.offset + i];
@@ -474,28 +479,37 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
                         "this shader stage.";
       return std::nullopt;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
+    const GLenum unit = GL_TEXTURE0 + active_index;
+    state.ActiveTexture(unit);
 
     //--------------------------------------------------------------------------
     /// Bind the texture.
     ///
-    if (!texture_gles.Bind()) {
+    std::optional<GLuint> handle = texture_gles.GetGLHandle();
+    if (!handle.has_value()) {
       return std::nullopt;
     }
+    if (!state.IsTextureBound(unit, handle.value())) {
+      if (!texture_gles.Bind()) {
+        return std::nullopt;
+      }
+      state.DidBindTexture(unit, handle.value());
+    }
 
     //--------------------------------------------------------------------------
     /// If there is a sampler for the texture at the same index, configure the
     /// bound texture using that sampler.
     ///
     const auto& sampler_gles = SamplerGLES::Cast(*data.sampler);
-    if (!sampler_gles.ConfigureBoundTexture(texture_gles, gl)) {
+    if (state.ShouldConfigureSampler(handle.value(), &sampler_gles) &&
+        !sampler_gles.ConfigureBoundTexture(texture_gles, gl)) {
       return std::nullopt;
     }
 
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(location, active_index);
+    state.Uniform1i(program_handle_, location, active_index);
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
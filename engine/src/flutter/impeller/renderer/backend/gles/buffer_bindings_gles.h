@@ -11,6 +11,7 @@
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/command.h"
 #include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
 
@@ -38,17 +39,17 @@ class BufferBindingsGLES {
 
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
-  bool BindVertexAttributes(const ProcTableGLES& gl,
+  bool BindVertexAttributes(StateCacheGLES& state,
                             size_t binding,
                             size_t vertex_offset);
 
-  bool BindUniformData(const ProcTableGLES& gl,
+  bool BindUniformData(StateCacheGLES& state,
                        const std::vector<TextureAndSampler>& bound_textures,
                        const std::vector<BufferResource>& bound_buffers,
                        Range texture_range,
                        Range buffer_range);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl);
+  bool UnbindVertexAttributes(StateCacheGLES& state);
 
  private:
   FML_FRIEND_TEST(testing::BufferBindingsGLESTest, BindUniformData);
@@ -97,7 +98,7 @@ class BufferBindingsGLES {
                            const DeviceBufferGLES& device_buffer_gles);
 
   std::optional<size_t> BindTextures(
-      const ProcTableGLES& gl,
+      StateCacheGLES& state,
       const std::vector<TextureAndSampler>& bound_textures,
       Range texture_range,
       ShaderStage stage,
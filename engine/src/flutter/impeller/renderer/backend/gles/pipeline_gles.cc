@@ -57,7 +57,7 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   return true;
 }
 
-[[nodiscard]] bool PipelineGLES::BindProgram() const {
+[[nodiscard]] bool PipelineGLES::BindProgram(StateCacheGLES& state) const {
   if (!handle_->IsValid()) {
     return false;
   }
@@ -65,7 +65,7 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   if (!handle.has_value()) {
     return false;
   }
-  reactor_->GetProcTable().UseProgram(handle.value());
+  state.UseProgram(handle.value());
   return true;
 }
 
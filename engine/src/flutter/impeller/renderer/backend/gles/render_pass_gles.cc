@@ -18,6 +18,7 @@
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 #include "impeller/renderer/command.h"
 
@@ -43,10 +44,10 @@ void RenderPassGLES::OnSetLabel(std::string_view label) {
   label_ = label;
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateCacheGLES& gl,
                        const ColorAttachmentDescriptor* color) {
+  gl.SetEnabled(GL_BLEND, color->blending_enabled);
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
     gl.BlendFuncSeparate(
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
@@ -57,8 +58,6 @@ void ConfigureBlending(const ProcTableGLES& gl,
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
-  } else {
-    gl.Disable(GL_BLEND);
   }
 
   {
@@ -77,7 +76,7 @@ void ConfigureBlending(const ProcTableGLES& gl,
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateCacheGLES& gl,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
   gl.StencilOpSeparate(
@@ -94,15 +93,15 @@ void ConfigureStencil(GLenum face,
   gl.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateCacheGLES& gl,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    gl.SetEnabled(GL_STENCIL_TEST, false);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  gl.SetEnabled(GL_STENCIL_TEST, true);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
@@ -145,7 +144,7 @@ struct RenderPassData {
   std::string label;
 };
 
-static bool BindVertexBuffer(const ProcTableGLES& gl,
+static bool BindVertexBuffer(StateCacheGLES& state,
                              BufferBindingsGLES* vertex_desc_gles,
                              const BufferView& vertex_buffer_view,
                              size_t buffer_index) {
@@ -169,7 +168,7 @@ static bool BindVertexBuffer(const ProcTableGLES& gl,
   /// Bind the vertex attributes associated with vertex buffer.
   ///
   if (!vertex_desc_gles->BindVertexAttributes(
-          gl, buffer_index, vertex_buffer_view.GetRange().offset)) {
+          state, buffer_index, vertex_buffer_view.GetRange().offset)) {
     return false;
   }
 
@@ -322,9 +321,10 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     }
   }
 
-  CullMode current_cull_mode = CullMode::kNone;
-  WindingOrder current_winding_order = WindingOrder::kClockwise;
-  gl.FrontFace(GL_CW);
+  // Everything the commands set goes through the state cache. The state set
+  // above is left alone as it is only set once per pass.
+  StateCacheGLES state(gl);
+  state.FrontFace(GL_CW);
 
   for (const auto& command : commands) {
 #ifdef IMPELLER_DEBUG
@@ -350,12 +350,13 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -363,22 +364,22 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.SetEnabled(GL_DEPTH_TEST, true);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.SetEnabled(GL_DEPTH_TEST, false);
     }
 
     //--------------------------------------------------------------------------
     /// Setup the viewport.
     ///
     if (command.viewport.has_value()) {
-      gl.Viewport(viewport.rect.GetX(),  // x
-                  target_size.height - viewport.rect.GetY() -
-                      viewport.rect.GetHeight(),  // y
-                  viewport.rect.GetWidth(),       // width
-                  viewport.rect.GetHeight()       // height
+      state.Viewport(viewport.rect.GetX(),  // x
+                     target_size.height - viewport.rect.GetY() -
+                         viewport.rect.GetHeight(),  // y
+                     viewport.rect.GetWidth(),       // width
+                     viewport.rect.GetHeight()       // height
       );
       if (pass_data.depth_attachment) {
         if (gl.DepthRangef.IsAvailable()) {
@@ -396,8 +397,8 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.SetEnabled(GL_SCISSOR_TEST, true);
+      state.Scissor(
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
@@ -408,39 +409,30 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Setup culling.
     ///
-    CullMode pipeline_cull_mode = pipeline.GetDescriptor().GetCullMode();
-    if (current_cull_mode != pipeline_cull_mode) {
-      switch (pipeline_cull_mode) {
-        case CullMode::kNone:
-          gl.Disable(GL_CULL_FACE);
-          break;
-        case CullMode::kFrontFace:
-          gl.Enable(GL_CULL_FACE);
-          gl.CullFace(GL_FRONT);
-          break;
-        case CullMode::kBackFace:
-          gl.Enable(GL_CULL_FACE);
-          gl.CullFace(GL_BACK);
-          break;
-      }
-      current_cull_mode = pipeline_cull_mode;
+    switch (pipeline.GetDescriptor().GetCullMode()) {
+      case CullMode::kNone:
+        state.SetEnabled(GL_CULL_FACE, false);
+        break;
+      case CullMode::kFrontFace:
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_FRONT);
+        break;
+      case CullMode::kBackFace:
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_BACK);
+        break;
     }
 
     //--------------------------------------------------------------------------
     /// Setup winding order.
     ///
-    WindingOrder pipeline_winding_order =
-        pipeline.GetDescriptor().GetWindingOrder();
-    if (current_winding_order != pipeline_winding_order) {
-      switch (pipeline.GetDescriptor().GetWindingOrder()) {
-        case WindingOrder::kClockwise:
-          gl.FrontFace(GL_CW);
-          break;
-        case WindingOrder::kCounterClockwise:
-          gl.FrontFace(GL_CCW);
-          break;
-      }
-      current_winding_order = pipeline_winding_order;
+    switch (pipeline.GetDescriptor().GetWindingOrder()) {
+      case WindingOrder::kClockwise:
+        state.FrontFace(GL_CW);
+        break;
+      case WindingOrder::kCounterClockwise:
+        state.FrontFace(GL_CCW);
+        break;
     }
 
     BufferBindingsGLES* vertex_desc_gles = pipeline.GetBufferBindings();
@@ -453,7 +445,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     ///       when the vertex/index buffers are set on the command.
     ///
     for (size_t i = 0; i < command.vertex_buffers.length; i++) {
-      if (!BindVertexBuffer(gl, vertex_desc_gles,
+      if (!BindVertexBuffer(state, vertex_desc_gles,
                             vertex_buffers[i + command.vertex_buffers.offset],
                             i)) {
         return false;
@@ -463,7 +455,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
+    if (!pipeline.BindProgram(state)) {
       return false;
     }
 
@@ -471,7 +463,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     /// Bind uniform data.
     ///
     if (!vertex_desc_gles->BindUniformData(
-            gl,                                        //
+            state,                                     //
             bound_textures,                            //
             bound_buffers,                             //
             /*texture_range=*/command.bound_textures,  //
@@ -496,6 +488,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Finally! Invoke the draw call.
     ///
+    state.DisableUnusedVertexAttribArrays();
     if (command.index_type == IndexType::kNone) {
       gl.DrawArrays(mode, command.base_vertex, command.element_count);
     } else {
@@ -518,11 +511,17 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Unbind vertex attribs.
     ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
+    if (!vertex_desc_gles->UnbindVertexAttributes(state)) {
       return false;
     }
   }
 
+  // Leave no arrays enabled for whoever uses the context next.
+  state.DisableUnusedVertexAttribArrays();
+  FML_TRACE_COUNTER("impeller", "StateCacheGLES",
+                    reinterpret_cast<int64_t>(&reactor),  // Trace Counter ID
+                    "ElidedCalls", state.GetElidedCallCount());
+
   if (pass_data.resolve_attachment &&
       !gl.GetCapabilities()->SupportsImplicitResolvingMSAA() &&
       !is_wrapped_fbo) {
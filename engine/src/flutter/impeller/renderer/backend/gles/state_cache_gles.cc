@@ -0,0 +1,243 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+namespace impeller {
+
+StateCacheGLES::StateCacheGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateCacheGLES::~StateCacheGLES() = default;
+
+std::optional<bool>* StateCacheGLES::GetCapabilityState(GLenum capability) {
+  switch (capability) {
+    case GL_BLEND:
+      return &blend_enabled_;
+    case GL_CULL_FACE:
+      return &cull_face_enabled_;
+    case GL_DEPTH_TEST:
+      return &depth_test_enabled_;
+    case GL_SCISSOR_TEST:
+      return &scissor_test_enabled_;
+    case GL_STENCIL_TEST:
+      return &stencil_test_enabled_;
+  }
+  return nullptr;
+}
+
+void StateCacheGLES::SetEnabled(GLenum capability, bool enabled) {
+  auto call = [&]() {
+    if (enabled) {
+      gl_.Enable(capability);
+    } else {
+      gl_.Disable(capability);
+    }
+  };
+  std::optional<bool>* state = GetCapabilityState(capability);
+  if (!state) {
+    call();
+    return;
+  }
+  SetIfChanged(*state, enabled, call);
+}
+
+void StateCacheGLES::BlendFuncSeparate(GLenum src_color,
+                                       GLenum dst_color,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  SetIfChanged(blend_func_, {src_color, dst_color, src_alpha, dst_alpha},
+               [&]() {
+                 gl_.BlendFuncSeparate(src_color, dst_color, src_alpha,
+                                       dst_alpha);
+               });
+}
+
+void StateCacheGLES::BlendEquationSeparate(GLenum color_mode,
+                                           GLenum alpha_mode) {
+  SetIfChanged(blend_equation_, {color_mode, alpha_mode}, [&]() {
+    gl_.BlendEquationSeparate(color_mode, alpha_mode);
+  });
+}
+
+void StateCacheGLES::ColorMask(GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  SetIfChanged(color_mask_, {red, green, blue, alpha},
+               [&]() { gl_.ColorMask(red, green, blue, alpha); });
+}
+
+template <class T, class Call>
+void StateCacheGLES::SetStencilFaceState(
+    GLenum face,
+    std::optional<T> StencilFaceState::* member,
+    const T& value,
+    Call call) {
+  std::optional<T>& front = stencil_[0].*member;
+  std::optional<T>& back = stencil_[1].*member;
+  switch (face) {
+    case GL_FRONT:
+      SetIfChanged(front, value, call);
+      return;
+    case GL_BACK:
+      SetIfChanged(back, value, call);
+      return;
+    case GL_FRONT_AND_BACK:
+      if (front == value && back == value) {
+        elided_calls_++;
+        return;
+      }
+      front = value;
+      back = value;
+      call();
+      return;
+  }
+  call();
+}
+
+void StateCacheGLES::StencilOpSeparate(GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_stencil_pass) {
+  SetStencilFaceState(
+      face, &StencilFaceState::op,
+      std::array<GLenum, 3>{stencil_fail, depth_fail, depth_stencil_pass},
+      [&]() {
+        gl_.StencilOpSeparate(face, stencil_fail, depth_fail,
+                              depth_stencil_pass);
+      });
+}
+
+void StateCacheGLES::StencilFuncSeparate(GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  SetStencilFaceState(
+      face, &StencilFaceState::func, std::make_tuple(func, ref, mask),
+      [&]() { gl_.StencilFuncSeparate(face, func, ref, mask); });
+}
+
+void StateCacheGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  SetStencilFaceState(face, &StencilFaceState::write_mask, mask,
+                      [&]() { gl_.StencilMaskSeparate(face, mask); });
+}
+
+void StateCacheGLES::DepthFunc(GLenum func) {
+  SetIfChanged(depth_func_, func, [&]() { gl_.DepthFunc(func); });
+}
+
+void StateCacheGLES::DepthMask(GLboolean flag) {
+  SetIfChanged(depth_mask_, flag, [&]() { gl_.DepthMask(flag); });
+}
+
+void StateCacheGLES::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  SetIfChanged(viewport_, {x, y, width, height},
+               [&]() { gl_.Viewport(x, y, width, height); });
+}
+
+void StateCacheGLES::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  SetIfChanged(scissor_, {x, y, width, height},
+               [&]() { gl_.Scissor(x, y, width, height); });
+}
+
+void StateCacheGLES::CullFace(GLenum mode) {
+  SetIfChanged(cull_face_, mode, [&]() { gl_.CullFace(mode); });
+}
+
+void StateCacheGLES::FrontFace(GLenum mode) {
+  SetIfChanged(front_face_, mode, [&]() { gl_.FrontFace(mode); });
+}
+
+void StateCacheGLES::UseProgram(GLuint program) {
+  SetIfChanged(program_, program, [&]() { gl_.UseProgram(program); });
+}
+
+void StateCacheGLES::ActiveTexture(GLenum unit) {
+  SetIfChanged(active_texture_, unit, [&]() { gl_.ActiveTexture(unit); });
+}
+
+bool StateCacheGLES::IsTextureBound(GLenum unit, GLuint texture) const {
+  const size_t index = unit - GL_TEXTURE0;
+  return index < kTrackedTextureUnits && bound_textures_[index] == texture;
+}
+
+void StateCacheGLES::DidBindTexture(GLenum unit, GLuint texture) {
+  const size_t index = unit - GL_TEXTURE0;
+  if (index < kTrackedTextureUnits) {
+    bound_textures_[index] = texture;
+  }
+}
+
+bool StateCacheGLES::ShouldConfigureSampler(GLuint texture,
+                                            const SamplerGLES* sampler) {
+  auto [it, inserted] = texture_samplers_.try_emplace(texture, sampler);
+  if (inserted) {
+    return true;
+  }
+  if (it->second == sampler) {
+    elided_calls_++;
+    return false;
+  }
+  it->second = sampler;
+  return true;
+}
+
+void StateCacheGLES::Uniform1i(GLuint program, GLint location, GLint value) {
+  const uint64_t key = static_cast<uint64_t>(program) << 32 |
+                       static_cast<uint32_t>(location);
+  auto [it, inserted] = uniform_values_.try_emplace(key, value);
+  if (!inserted) {
+    if (it->second == value) {
+      elided_calls_++;
+      return;
+    }
+    it->second = value;
+  }
+  gl_.Uniform1i(location, value);
+}
+
+void StateCacheGLES::EnableVertexAttribArray(GLuint index) {
+  if (index >= kTrackedVertexAttribs) {
+    untracked_vertex_attribs_.push_back(index);
+    gl_.EnableVertexAttribArray(index);
+    return;
+  }
+  used_vertex_attribs_.set(index);
+  if (enabled_vertex_attribs_.test(index)) {
+    elided_calls_++;
+    return;
+  }
+  enabled_vertex_attribs_.set(index);
+  gl_.EnableVertexAttribArray(index);
+}
+
+void StateCacheGLES::DisableUnusedVertexAttribArrays() {
+  std::bitset<kTrackedVertexAttribs> unused =
+      enabled_vertex_attribs_ & ~used_vertex_attribs_;
+  if (unused.none()) {
+    return;
+  }
+  for (size_t i = 0; i < kTrackedVertexAttribs; i++) {
+    if (unused.test(i)) {
+      gl_.DisableVertexAttribArray(i);
+    }
+  }
+  enabled_vertex_attribs_ &= used_vertex_attribs_;
+}
+
+void StateCacheGLES::ReleaseVertexAttribArrays() {
+  used_vertex_attribs_.reset();
+  for (GLuint index : untracked_vertex_attribs_) {
+    gl_.DisableVertexAttribArray(index);
+  }
+  untracked_vertex_attribs_.clear();
+}
+
+void StateCacheGLES::ResetVertexAttribArrays() {
+  enabled_vertex_attribs_.reset();
+  used_vertex_attribs_.reset();
+  untracked_vertex_attribs_.clear();
+}
+
+}  // namespace impeller
@@ -0,0 +1,187 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+
+namespace impeller {
+
+class SamplerGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the GL state set while encoding a render pass and drops
+///             calls that would set state to the value it already has.
+///
+///             The cache starts out knowing nothing, so the first call to set
+///             any piece of state is always issued. It only stays accurate as
+///             long as all state changes it tracks go through it. Create one
+///             per render pass and don't keep it around after GL calls it
+///             doesn't know about have been made.
+///
+class StateCacheGLES {
+ public:
+  explicit StateCacheGLES(const ProcTableGLES& gl);
+
+  ~StateCacheGLES();
+
+  const ProcTableGLES& GetProcTable() const { return gl_; }
+
+  /// @brief The number of GL calls that were dropped because they would not
+  ///        have changed any state.
+  size_t GetElidedCallCount() const { return elided_calls_; }
+
+  /// @brief Enables or disables one of `GL_BLEND`, `GL_CULL_FACE`,
+  ///        `GL_DEPTH_TEST`, `GL_SCISSOR_TEST` or `GL_STENCIL_TEST`. Other
+  ///        capabilities are not tracked and always passed through.
+  void SetEnabled(GLenum capability, bool enabled);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum color_mode, GLenum alpha_mode);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  void ActiveTexture(GLenum unit);
+
+  /// @brief Whether the texture was the last one bound to the unit through
+  ///        `DidBindTexture`.
+  bool IsTextureBound(GLenum unit, GLuint texture) const;
+
+  /// @brief Records that the texture was bound to the unit. Textures know how
+  ///        to bind themselves, so the cache doesn't issue that call.
+  void DidBindTexture(GLenum unit, GLuint texture);
+
+  /// @brief Whether the parameters of the texture need to be set up for the
+  ///        sampler. Records that they will be if so.
+  bool ShouldConfigureSampler(GLuint texture, const SamplerGLES* sampler);
+
+  void Uniform1i(GLuint program, GLint location, GLint value);
+
+  //----------------------------------------------------------------------------
+  /// Vertex attribute arrays are enabled per draw and released after it. The
+  /// arrays the next draw uses again are not disabled in between.
+  ///
+
+  void EnableVertexAttribArray(GLuint index);
+
+  /// @brief Disables the arrays enabled previously that were not enabled again
+  ///        since the last call to `ReleaseVertexAttribArrays`. Call this right
+  ///        before the draw.
+  void DisableUnusedVertexAttribArrays();
+
+  /// @brief Marks all enabled arrays as unused. They are disabled by the next
+  ///        call to `DisableUnusedVertexAttribArrays` unless they are enabled
+  ///        again first.
+  void ReleaseVertexAttribArrays();
+
+  /// @brief Forgets about enabled arrays. Used when a new vertex array object
+  ///        is bound, which starts out with all arrays disabled.
+  void ResetVertexAttribArrays();
+
+ private:
+  static constexpr size_t kTrackedVertexAttribs = 32u;
+  static constexpr size_t kTrackedTextureUnits = 32u;
+
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::tuple<GLenum, GLint, GLuint>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  size_t elided_calls_ = 0u;
+
+  std::optional<bool> blend_enabled_;
+  std::optional<bool> cull_face_enabled_;
+  std::optional<bool> depth_test_enabled_;
+  std::optional<bool> scissor_test_enabled_;
+  std::optional<bool> stencil_test_enabled_;
+
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  // Front and back faces.
+  std::array<StencilFaceState, 2> stencil_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::optional<GLenum> active_texture_;
+  std::array<std::optional<GLuint>, kTrackedTextureUnits> bound_textures_;
+  absl::flat_hash_map<GLuint, const SamplerGLES*> texture_samplers_;
+  absl::flat_hash_map<uint64_t, GLint> uniform_values_;
+
+  std::bitset<kTrackedVertexAttribs> enabled_vertex_attribs_;
+  std::bitset<kTrackedVertexAttribs> used_vertex_attribs_;
+  std::vector<GLuint> untracked_vertex_attribs_;
+
+  std::optional<bool>* GetCapabilityState(GLenum capability);
+
+  template <class T, class Call>
+  void SetIfChanged(std::optional<T>& current, const T& value, Call call) {
+    if (current.has_value() && current.value() == value) {
+      elided_calls_++;
+      return;
+    }
+    current = value;
+    call();
+  }
+
+  template <class T, class Call>
+  void SetStencilFaceState(GLenum face,
+                           std::optional<T> StencilFaceState::* member,
+                           const T& value,
+                           Call call);
+
+  StateCacheGLES(const StateCacheGLES&) = delete;
+
+  StateCacheGLES& operator=(const StateCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
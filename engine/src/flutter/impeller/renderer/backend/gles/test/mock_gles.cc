@@ -256,6 +256,66 @@ void mockDiscardFramebufferEXT(GLenum target,
 static_assert(CheckSameSignature<decltype(mockDiscardFramebufferEXT),  //
                                  decltype(glDiscardFramebufferEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  CallMockMethod(&IMockGLESImpl::Enable, cap);
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  CallMockMethod(&IMockGLESImpl::Disable, cap);
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockBlendFuncSeparate(GLenum src_color,
+                           GLenum dst_color,
+                           GLenum src_alpha,
+                           GLenum dst_alpha) {
+  CallMockMethod(&IMockGLESImpl::BlendFuncSeparate, src_color, dst_color,
+                 src_alpha, dst_alpha);
+}
+
+static_assert(CheckSameSignature<decltype(mockBlendFuncSeparate),  //
+                                 decltype(glBlendFuncSeparate)>::value);
+
+void mockStencilMaskSeparate(GLenum face, GLuint mask) {
+  CallMockMethod(&IMockGLESImpl::StencilMaskSeparate, face, mask);
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilMaskSeparate),  //
+                                 decltype(glStencilMaskSeparate)>::value);
+
+void mockUseProgram(GLuint program) {
+  CallMockMethod(&IMockGLESImpl::UseProgram, program);
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockUniform1i(GLint location, GLint value) {
+  CallMockMethod(&IMockGLESImpl::Uniform1i, location, value);
+}
+
+static_assert(CheckSameSignature<decltype(mockUniform1i),  //
+                                 decltype(glUniform1i)>::value);
+
+void mockEnableVertexAttribArray(GLuint index) {
+  CallMockMethod(&IMockGLESImpl::EnableVertexAttribArray, index);
+}
+
+static_assert(CheckSameSignature<decltype(mockEnableVertexAttribArray),  //
+                                 decltype(glEnableVertexAttribArray)>::value);
+
+void mockDisableVertexAttribArray(GLuint index) {
+  CallMockMethod(&IMockGLESImpl::DisableVertexAttribArray, index);
+}
+
+static_assert(CheckSameSignature<decltype(mockDisableVertexAttribArray),  //
+                                 decltype(glDisableVertexAttribArray)>::value);
+
 // static
 std::shared_ptr<MockGLES> MockGLES::Init(
     std::unique_ptr<MockGLESImpl> impl,
@@ -331,6 +391,22 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockBindFramebuffer);
   } else if (strcmp(name, "glDiscardFramebufferEXT") == 0) {
     return reinterpret_cast<void*>(mockDiscardFramebufferEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(mockDisable);
+  } else if (strcmp(name, "glBlendFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(mockBlendFuncSeparate);
+  } else if (strcmp(name, "glStencilMaskSeparate") == 0) {
+    return reinterpret_cast<void*>(mockStencilMaskSeparate);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(mockUseProgram);
+  } else if (strcmp(name, "glUniform1i") == 0) {
+    return reinterpret_cast<void*>(mockUniform1i);
+  } else if (strcmp(name, "glEnableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(mockEnableVertexAttribArray);
+  } else if (strcmp(name, "glDisableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(mockDisableVertexAttribArray);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
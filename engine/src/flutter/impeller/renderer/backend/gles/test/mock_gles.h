@@ -70,6 +70,17 @@ class IMockGLESImpl {
                                      GLsizei numAttachments,
                                      const GLenum* attachments) {};
   virtual void GetIntegerv(GLenum name, GLint* attachments) {};
+  virtual void Enable(GLenum cap) {}
+  virtual void Disable(GLenum cap) {}
+  virtual void BlendFuncSeparate(GLenum src_color,
+                                 GLenum dst_color,
+                                 GLenum src_alpha,
+                                 GLenum dst_alpha) {}
+  virtual void StencilMaskSeparate(GLenum face, GLuint mask) {}
+  virtual void UseProgram(GLuint program) {}
+  virtual void Uniform1i(GLint location, GLint value) {}
+  virtual void EnableVertexAttribArray(GLuint index) {}
+  virtual void DisableVertexAttribArray(GLuint index) {}
 };
 
 class MockGLESImpl : public IMockGLESImpl {
@@ -160,6 +171,23 @@ class MockGLESImpl : public IMockGLESImpl {
                const GLenum* attachments),
               (override));
   MOCK_METHOD(void, GetIntegerv, (GLenum name, GLint* value), (override));
+  MOCK_METHOD(void, Enable, (GLenum cap), (override));
+  MOCK_METHOD(void, Disable, (GLenum cap), (override));
+  MOCK_METHOD(void,
+              BlendFuncSeparate,
+              (GLenum src_color,
+               GLenum dst_color,
+               GLenum src_alpha,
+               GLenum dst_alpha),
+              (override));
+  MOCK_METHOD(void,
+              StencilMaskSeparate,
+              (GLenum face, GLuint mask),
+              (override));
+  MOCK_METHOD(void, UseProgram, (GLuint program), (override));
+  MOCK_METHOD(void, Uniform1i, (GLint location, GLint value), (override));
+  MOCK_METHOD(void, EnableVertexAttribArray, (GLuint index), (override));
+  MOCK_METHOD(void, DisableVertexAttribArray, (GLuint index), (override));
 };
 
 /// @brief      Provides a mocked version of the |ProcTableGLES| class.
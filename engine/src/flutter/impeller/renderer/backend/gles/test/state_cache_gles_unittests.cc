@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+using ::testing::_;
+using ::testing::InSequence;
+
+TEST(StateCacheGLESTest, ElidesRedundantCapabilityChanges) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  {
+    InSequence sequence;
+    EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(1);
+    EXPECT_CALL(*mock_gles_impl, Disable(GL_BLEND)).Times(1);
+    EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(1);
+  }
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_BLEND, true);
+  state.SetEnabled(GL_BLEND, true);
+  state.SetEnabled(GL_BLEND, false);
+  state.SetEnabled(GL_BLEND, false);
+  state.SetEnabled(GL_BLEND, true);
+
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateCacheGLESTest, PassesThroughUntrackedCapabilities) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Disable(GL_DITHER)).Times(2);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_DITHER, false);
+  state.SetEnabled(GL_DITHER, false);
+
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateCacheGLESTest, ElidesRedundantBlendFuncsAndPrograms) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl,
+              BlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                GL_ONE_MINUS_SRC_ALPHA))
+      .Times(1);
+  EXPECT_CALL(*mock_gles_impl,
+              BlendFuncSeparate(GL_ZERO, GL_ONE, GL_ZERO, GL_ONE))
+      .Times(1);
+  EXPECT_CALL(*mock_gles_impl, UseProgram(1u)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, UseProgram(2u)).Times(1);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  for (int i = 0; i < 3; i++) {
+    state.BlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                            GL_ONE_MINUS_SRC_ALPHA);
+    state.UseProgram(1u);
+  }
+  state.BlendFuncSeparate(GL_ZERO, GL_ONE, GL_ZERO, GL_ONE);
+  state.UseProgram(2u);
+
+  EXPECT_EQ(state.GetElidedCallCount(), 4u);
+}
+
+TEST(StateCacheGLESTest, TracksStencilFacesSeparately) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  {
+    InSequence sequence;
+    EXPECT_CALL(*mock_gles_impl, StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF))
+        .Times(1);
+    EXPECT_CALL(*mock_gles_impl, StencilMaskSeparate(GL_BACK, 0x0F)).Times(1);
+    EXPECT_CALL(*mock_gles_impl, StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF))
+        .Times(1);
+  }
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  // Both faces are already set.
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  state.StencilMaskSeparate(GL_BACK, 0x0F);
+  // The back face differs, so this can't be dropped.
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateCacheGLESTest, CachesSamplerUniformsPerProgram) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Uniform1i(3, 0)).Times(2);
+  EXPECT_CALL(*mock_gles_impl, Uniform1i(3, 1)).Times(1);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.Uniform1i(/*program=*/1u, /*location=*/3, /*value=*/0);
+  state.Uniform1i(/*program=*/1u, /*location=*/3, /*value=*/0);
+  // Same location in a different program.
+  state.Uniform1i(/*program=*/2u, /*location=*/3, /*value=*/0);
+  state.Uniform1i(/*program=*/1u, /*location=*/3, /*value=*/1);
+
+  EXPECT_EQ(state.GetElidedCallCount(), 1u);
+}
+
+TEST(StateCacheGLESTest, KeepsVertexAttribArraysUsedByConsecutiveDraws) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, EnableVertexAttribArray(0u)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, EnableVertexAttribArray(1u)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, DisableVertexAttribArray(0u)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, DisableVertexAttribArray(1u)).Times(1);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  // First draw uses arrays 0 and 1.
+  state.EnableVertexAttribArray(0u);
+  state.EnableVertexAttribArray(1u);
+  state.DisableUnusedVertexAttribArrays();
+  state.ReleaseVertexAttribArrays();
+
+  // Second draw only uses array 0, so array 1 is disabled before it.
+  state.EnableVertexAttribArray(0u);
+  state.DisableUnusedVertexAttribArrays();
+  state.ReleaseVertexAttribArrays();
+
+  // End of the pass.
+  state.DisableUnusedVertexAttribArrays();
+
+  EXPECT_EQ(state.GetElidedCallCount(), 1u);
+}
+
+TEST(StateCacheGLESTest, ResetVertexAttribArraysForgetsEnabledArrays) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, EnableVertexAttribArray(0u)).Times(2);
+  EXPECT_CALL(*mock_gles_impl, DisableVertexAttribArray(_)).Times(0);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.EnableVertexAttribArray(0u);
+  state.ReleaseVertexAttribArrays();
+  // A new vertex array object was bound.
+  state.ResetVertexAttribArrays();
+  state.EnableVertexAttribArray(0u);
+  state.DisableUnusedVertexAttribArrays();
+
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -8,6 +8,7 @@
 #include <Metal/Metal.h>
 #include <atomic>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/base/thread.h"
 #include "impeller/core/allocator.h"
 
@@ -64,6 +65,8 @@ class AllocatorMTL final : public Allocator {
 #endif  // IMPELLER_DEBUG
 
   ISize max_texture_supported_;
+  mutable fml::MemoryUsageCounter memory_usage_{
+      fml::MemoryCategory::kDeviceAllocator};
 
   // |Allocator|
   bool IsValid() const;
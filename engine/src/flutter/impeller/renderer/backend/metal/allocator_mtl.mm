@@ -223,6 +223,7 @@ Bytes AllocatorMTL::DebugGetHeapUsage() const {
 }
 
 void AllocatorMTL::DebugTraceMemoryStatistics() const {
+  memory_usage_.Set(DebugGetHeapUsage().GetByteSize());
 #ifdef IMPELLER_DEBUG
   FML_TRACE_COUNTER("flutter", "AllocatorMTL",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -563,6 +563,7 @@ Bytes AllocatorVK::DebugGetHeapUsage() const {
 }
 
 void AllocatorVK::DebugTraceMemoryStatistics() const {
+  memory_usage_.Set(DebugGetHeapUsage().GetByteSize());
 #ifdef IMPELLER_DEBUG
   FML_TRACE_COUNTER("flutter", "AllocatorVK",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ALLOCATOR_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ALLOCATOR_VK_H_
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/core/allocator.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -47,6 +48,8 @@ class AllocatorVK final : public Allocator {
   std::weak_ptr<Context> context_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
   ISize max_texture_size_;
+  mutable fml::MemoryUsageCounter memory_usage_{
+      fml::MemoryCategory::kDeviceAllocator};
   bool is_valid_ = false;
   bool supports_memoryless_textures_ = false;
   // TODO(jonahwilliams): figure out why CI can't create these buffer pools.
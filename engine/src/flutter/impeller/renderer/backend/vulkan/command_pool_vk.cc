@@ -30,10 +30,12 @@ class BackgroundCommandPoolVK final {
   explicit BackgroundCommandPoolVK(
       vk::UniqueCommandPool&& pool,
       std::vector<vk::UniqueCommandBuffer>&& buffers,
+      std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
       size_t unused_count,
       std::weak_ptr<CommandPoolRecyclerVK> recycler)
       : pool_(std::move(pool)),
         buffers_(std::move(buffers)),
+        secondary_buffers_(std::move(secondary_buffers)),
         unused_count_(unused_count),
         recycler_(std::move(recycler)) {}
 
@@ -47,6 +49,9 @@ class BackgroundCommandPoolVK final {
     if (!recycler) {
       return;
     }
+    // Secondary command buffers are not reused. Nothing else references the
+    // pool at this point, so they can be freed before it is reset.
+    secondary_buffers_.clear();
     // If there are many unused command buffers, release some of them and
     // trim the command pool.
     bool should_trim = unused_count_ > kUnusedCommandBufferLimit;
@@ -65,6 +70,7 @@ class BackgroundCommandPoolVK final {
   // wrapper type will attempt to reset the cmd buffer, and doing so may be a
   // thread safety violation as this may happen on the fence waiter thread.
   std::vector<vk::UniqueCommandBuffer> buffers_;
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_;
   const size_t unused_count_;
   std::weak_ptr<CommandPoolRecyclerVK> recycler_;
 };
@@ -91,14 +97,16 @@ CommandPoolVK::~CommandPoolVK() {
   unused_command_buffers_.clear();
 
   auto reset_pool_when_dropped = BackgroundCommandPoolVK(
-      std::move(pool_), std::move(collected_buffers_), unused_count, recycler);
+      std::move(pool_), std::move(collected_buffers_),
+      std::move(collected_secondary_buffers_), unused_count, recycler);
 
   UniqueResourceVKT<BackgroundCommandPoolVK> pool(
       context->GetResourceManager(), std::move(reset_pool_when_dropped));
 }
 
 // TODO(matanlurey): Return a status_or<> instead of {} when we have one.
-vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   auto const context = context_.lock();
   if (!context) {
     return {};
@@ -108,7 +116,8 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   if (!pool_) {
     return {};
   }
-  if (!unused_command_buffers_.empty()) {
+  if (level == vk::CommandBufferLevel::ePrimary &&
+      !unused_command_buffers_.empty()) {
     vk::UniqueCommandBuffer buffer = std::move(unused_command_buffers_.back());
     unused_command_buffers_.pop_back();
     return buffer;
@@ -118,7 +127,7 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
@@ -126,7 +135,8 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   return std::move(buffers[0]);
 }
 
-void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
+void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer,
+                                         vk::CommandBufferLevel level) {
   Lock lock(pool_mutex_);
   if (!pool_) {
     // If the command pool has already been destroyed, then its buffers have
@@ -134,6 +144,10 @@ void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
     buffer.release();
     return;
   }
+  if (level == vk::CommandBufferLevel::eSecondary) {
+    collected_secondary_buffers_.push_back(std::move(buffer));
+    return;
+  }
   collected_buffers_.push_back(std::move(buffer));
 }
 
@@ -146,11 +160,15 @@ void CommandPoolVK::Destroy() {
   for (auto& buffer : collected_buffers_) {
     buffer.release();
   }
+  for (auto& buffer : collected_secondary_buffers_) {
+    buffer.release();
+  }
   for (auto& buffer : unused_command_buffers_) {
     buffer.release();
   }
   unused_command_buffers_.clear();
   collected_buffers_.clear();
+  collected_secondary_buffers_.clear();
 }
 
 // Associates a resource with a thread and context.
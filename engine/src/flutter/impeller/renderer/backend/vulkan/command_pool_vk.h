@@ -46,17 +46,24 @@ class CommandPoolVK final {
 
   /// @brief      Creates and returns a new |vk::CommandBuffer|.
   ///
+  /// @param[in]  level   Whether to create a primary or a secondary command
+  ///                     buffer. Only primary command buffers are recycled.
+  ///
   /// @return     Always returns a new |vk::CommandBuffer|, but if for any
   ///             reason a valid command buffer could not be created, it will be
   ///             a `{}` default instance (i.e. while being torn down).
-  vk::UniqueCommandBuffer CreateCommandBuffer();
+  vk::UniqueCommandBuffer CreateCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Collects the given |vk::CommandBuffer| to be retained.
   ///
   /// @param[in]  buffer  The |vk::CommandBuffer| to collect.
+  /// @param[in]  level   The level the buffer was created with.
   ///
   /// @see        |GarbageCollectBuffersIfAble|
-  void CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer);
+  void CollectCommandBuffer(
+      vk::UniqueCommandBuffer&& buffer,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Delete all Vulkan objects in this command pool.
   void Destroy();
@@ -74,6 +81,11 @@ class CommandPoolVK final {
   // Used to retain a reference on these until the pool is reset.
   std::vector<vk::UniqueCommandBuffer> collected_buffers_
       IPLR_GUARDED_BY(pool_mutex_);
+
+  // Secondary command buffers are retained the same way, but are freed instead
+  // of being handed out again as primary command buffers.
+  std::vector<vk::UniqueCommandBuffer> collected_secondary_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
 };
 
 //------------------------------------------------------------------------------
@@ -175,6 +175,48 @@ TEST(CommandPoolRecyclerVKTest, CommandBuffersAreRecycled) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, SecondaryCommandBuffersAreNotRecycled) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto pool = recycler->Get();
+
+    auto buffer = pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    pool->CollectCommandBuffer(std::move(buffer),
+                               vk::CommandBufferLevel::eSecondary);
+
+    // This normally is called at the end of a frame.
+    recycler->Dispose();
+  }
+
+  WaitForReclaim(context);
+
+  {
+    // The recycled pool must not hand out the secondary command buffer as a
+    // primary one.
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto pool = recycler->Get();
+
+    auto buffer = pool->CreateCommandBuffer();
+    pool->CollectCommandBuffer(std::move(buffer));
+
+    // This normally is called at the end of a frame.
+    recycler->Dispose();
+  }
+
+  auto const called = ReclaimAndGetMockVulkanFunctions(context);
+  EXPECT_EQ(std::count(called->begin(), called->end(), "vkCreateCommandPool"),
+            1u);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateCommandBuffers"),
+      2u);
+  EXPECT_EQ(std::count(called->begin(), called->end(), "vkFreeCommandBuffers"),
+            1u);
+
+  context->Shutdown();
+}
+
 TEST(CommandPoolRecyclerVKTest, ExtraCommandBufferAllocationsTriggerTrim) {
   auto const context = MockVulkanContextBuilder().Build();
 
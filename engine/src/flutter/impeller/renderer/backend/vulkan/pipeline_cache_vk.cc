@@ -15,6 +15,9 @@
 
 namespace impeller {
 
+static constexpr const char* kPipelineUsageFileName =
+    "flutter.impeller.vkusage";
+
 PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
                                  std::shared_ptr<DeviceHolderVK> device_holder,
                                  fml::UniqueFD cache_directory)
@@ -108,20 +111,52 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
 }
 
 void PipelineCacheVK::PersistCacheToDisk() {
+  PersistCacheToDirectory(cache_directory_);
+}
+
+bool PipelineCacheVK::PersistCacheToDirectory(const fml::UniqueFD& directory) {
   // PersistCacheToDisk is run on a worker thread pool.  Calls to
   // PipelineCacheDataPersist should be serialized so that multiple worker
   // threads do not concurrently write to the cache file.
   Lock persist_lock(persist_mutex_);
   if (!is_valid_) {
-    return;
+    return false;
   }
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
-  PipelineCacheDataPersist(cache_directory_,                       //
-                           vk_caps.GetPhysicalDeviceProperties(),  //
-                           cache_                                  //
+  return PipelineCacheDataPersist(directory,                              //
+                                  vk_caps.GetPhysicalDeviceProperties(),  //
+                                  cache_                                  //
   );
 }
 
+std::optional<PipelineUsageRecord> PipelineCacheVK::RetrievePipelineUsage()
+    const {
+  if (!cache_directory_.is_valid()) {
+    return std::nullopt;
+  }
+  std::unique_ptr<fml::FileMapping> data = fml::FileMapping::CreateReadOnly(
+      cache_directory_, kPipelineUsageFileName);
+  if (!data) {
+    return std::nullopt;
+  }
+  std::optional<PipelineUsageRecord> record =
+      PipelineUsageRecord::Deserialize(*data);
+  if (!record.has_value()) {
+    FML_LOG(WARNING) << "Persisted pipeline usage is malformed. Ignoring.";
+  }
+  return record;
+}
+
+void PipelineCacheVK::PersistPipelineUsage(const fml::Mapping& data) {
+  Lock persist_lock(persist_mutex_);
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  if (!fml::WriteAtomically(cache_directory_, kPipelineUsageFileName, data)) {
+    VALIDATION_LOG << "Could not write pipeline usage to disk.";
+  }
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
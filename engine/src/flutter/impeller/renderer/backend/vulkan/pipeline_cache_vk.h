@@ -9,6 +9,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 
 namespace impeller {
 
@@ -34,6 +35,18 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the cache to the given directory instead of the cache
+  ///             directory of the context. Used to generate caches offline.
+  ///
+  /// @return     If the cache data was written.
+  ///
+  bool PersistCacheToDirectory(const fml::UniqueFD& directory);
+
+  std::optional<PipelineUsageRecord> RetrievePipelineUsage() const;
+
+  void PersistPipelineUsage(const fml::Mapping& data);
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
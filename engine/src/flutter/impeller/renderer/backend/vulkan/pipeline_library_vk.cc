@@ -308,4 +308,24 @@ PipelineCompileQueue* PipelineLibraryVK::GetPipelineCompileQueue() const {
   return compile_queue_.get();
 }
 
+// |PipelineLibrary|
+std::optional<PipelineUsageRecord>
+PipelineLibraryVK::GetPersistedPipelineUsage() const {
+  return pso_cache_->RetrievePipelineUsage();
+}
+
+// |PipelineLibrary|
+void PipelineLibraryVK::PersistPipelineUsage(
+    const PipelineUsageRecord& record) {
+  worker_task_runner_->PostTask(
+      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_),
+       data = std::shared_ptr<fml::Mapping>(record.Serialize())]() {
+        auto cache = weak_cache.lock();
+        if (!cache) {
+          return;
+        }
+        cache->PersistPipelineUsage(*data);
+      });
+}
+
 }  // namespace impeller
@@ -81,6 +81,12 @@ class PipelineLibraryVK final
   // |PipelineLibrary|
   PipelineCompileQueue* GetPipelineCompileQueue() const override;
 
+  // |PipelineLibrary|
+  std::optional<PipelineUsageRecord> GetPersistedPipelineUsage() const override;
+
+  // |PipelineLibrary|
+  void PersistPipelineUsage(const PipelineUsageRecord& record) override;
+
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc,
       PipelineKey pipeline_key);
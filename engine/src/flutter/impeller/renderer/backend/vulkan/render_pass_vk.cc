@@ -4,10 +4,16 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 #include "fml/status.h"
+#include "fml/synchronization/count_down_latch.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/device_buffer.h"
@@ -16,6 +22,7 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
@@ -49,6 +56,21 @@ static vk::ClearDepthStencilValue VKClearValueFromDepthStencil(uint32_t stencil,
   return value;
 }
 
+static vk::Viewport ToVKViewport(const Viewport& viewport) {
+  return vk::Viewport()
+      .setWidth(viewport.rect.GetWidth())
+      .setHeight(-viewport.rect.GetHeight())
+      .setY(viewport.rect.GetHeight())
+      .setMinDepth(0.0f)
+      .setMaxDepth(1.0f);
+}
+
+static vk::Rect2D ToVKRect2D(IRect32 rect) {
+  return vk::Rect2D()
+      .setOffset(vk::Offset2D(rect.GetX(), rect.GetY()))
+      .setExtent(vk::Extent2D(rect.GetWidth(), rect.GetHeight()));
+}
+
 static size_t GetVKClearValues(
     const RenderTarget& target,
     std::array<vk::ClearValue, kMaxAttachments>& values) {
@@ -138,7 +160,6 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
   resolve_image_vk_ = color0.resolve_texture;
 
   const auto& vk_context = ContextVK::Cast(*context);
-  command_buffer_vk_ = command_buffer_->GetCommandBuffer();
   render_target_.IterateAllAttachments([&](const auto& attachment) -> bool {
     command_buffer_->Track(attachment.texture);
     command_buffer_->Track(attachment.resolve_texture);
@@ -213,19 +234,8 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
     }
   }
 
-  std::array<vk::ClearValue, kMaxAttachments> clears;
-  size_t clear_count = GetVKClearValues(render_target_, clears);
-
-  vk::RenderPassBeginInfo pass_info;
-  pass_info.renderPass = *render_pass_;
-  pass_info.framebuffer = *framebuffer;
-  pass_info.renderArea.extent.width = static_cast<uint32_t>(target_size.width);
-  pass_info.renderArea.extent.height =
-      static_cast<uint32_t>(target_size.height);
-  pass_info.setPClearValues(clears.data());
-  pass_info.setClearValueCount(clear_count);
-
-  command_buffer_vk_.beginRenderPass(pass_info, vk::SubpassContents::eInline);
+  clear_value_count_ = GetVKClearValues(render_target_, clear_values_);
+  framebuffer_ = std::move(framebuffer);
 
   if (resolve_image_vk_) {
     TextureVK::Cast(*resolve_image_vk_)
@@ -238,27 +248,11 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
         .SetLayoutWithoutEncoding(vk::ImageLayout::eGeneral);
   }
 
-  // Set the initial viewport.
-  const auto vp = Viewport{.rect = Rect::MakeSize(target_size)};
-  vk::Viewport viewport = vk::Viewport()
-                              .setWidth(vp.rect.GetWidth())
-                              .setHeight(-vp.rect.GetHeight())
-                              .setY(vp.rect.GetHeight())
-                              .setMinDepth(0.0f)
-                              .setMaxDepth(1.0f);
-  command_buffer_vk_.setViewport(0, 1, &viewport);
-
-  // Set the initial scissor.
-  const auto sc = IRect32::MakeSize(target_size);
-  vk::Rect2D scissor =
-      vk::Rect2D()
-          .setOffset(vk::Offset2D(sc.GetX(), sc.GetY()))
-          .setExtent(vk::Extent2D(sc.GetWidth(), sc.GetHeight()));
-  command_buffer_vk_.setScissor(0, 1, &scissor);
-
-  // Set the initial stencil reference.
-  command_buffer_vk_.setStencilReference(
-      vk::StencilFaceFlagBits::eVkStencilFrontAndBack, 0u);
+  // Set the initial viewport, scissor and stencil reference.
+  current_viewport_ =
+      ToVKViewport(Viewport{.rect = Rect::MakeSize(target_size)});
+  current_scissor_ = ToVKRect2D(IRect32::MakeSize(target_size));
+  current_stencil_ = 0u;
 
   is_valid_ = true;
 }
@@ -365,19 +359,13 @@ void RenderPassVK::SetPipeline(PipelineRef pipeline) {
 // |RenderPass|
 void RenderPassVK::SetCommandLabel(std::string_view label) {
 #ifdef IMPELLER_DEBUG
-  command_buffer_->PushDebugGroup(label);
-  has_label_ = true;
+  label_ = label;
 #endif  // IMPELLER_DEBUG
 }
 
 // |RenderPass|
 void RenderPassVK::SetStencilReference(uint32_t value) {
-  if (current_stencil_ == value) {
-    return;
-  }
   current_stencil_ = value;
-  command_buffer_vk_.setStencilReference(
-      vk::StencilFaceFlagBits::eVkStencilFrontAndBack, value);
 }
 
 // |RenderPass|
@@ -387,22 +375,12 @@ void RenderPassVK::SetBaseVertex(uint64_t value) {
 
 // |RenderPass|
 void RenderPassVK::SetViewport(Viewport viewport) {
-  vk::Viewport viewport_vk = vk::Viewport()
-                                 .setWidth(viewport.rect.GetWidth())
-                                 .setHeight(-viewport.rect.GetHeight())
-                                 .setY(viewport.rect.GetHeight())
-                                 .setMinDepth(0.0f)
-                                 .setMaxDepth(1.0f);
-  command_buffer_vk_.setViewport(0, 1, &viewport_vk);
+  current_viewport_ = ToVKViewport(viewport);
 }
 
 // |RenderPass|
 void RenderPassVK::SetScissor(IRect32 scissor) {
-  vk::Rect2D scissor_vk =
-      vk::Rect2D()
-          .setOffset(vk::Offset2D(scissor.GetX(), scissor.GetY()))
-          .setExtent(vk::Extent2D(scissor.GetWidth(), scissor.GetHeight()));
-  command_buffer_vk_.setScissor(0, 1, &scissor_vk);
+  current_scissor_ = ToVKRect2D(scissor);
 }
 
 // |RenderPass|
@@ -422,12 +400,12 @@ bool RenderPassVK::SetVertexBuffer(BufferView vertex_buffers[],
     return false;
   }
 
-  vk::Buffer buffers[kMaxVertexBuffers];
-  vk::DeviceSize vertex_buffer_offsets[kMaxVertexBuffers];
+  current_vertex_buffer_index_ = vertex_buffers_.size();
+  current_vertex_buffer_count_ = vertex_buffer_count;
   for (size_t i = 0; i < vertex_buffer_count; i++) {
-    buffers[i] =
-        DeviceBufferVK::Cast(*vertex_buffers[i].GetBuffer()).GetBuffer();
-    vertex_buffer_offsets[i] = vertex_buffers[i].GetRange().offset;
+    vertex_buffers_.push_back(
+        DeviceBufferVK::Cast(*vertex_buffers[i].GetBuffer()).GetBuffer());
+    vertex_buffer_offsets_.push_back(vertex_buffers[i].GetRange().offset);
     std::shared_ptr<const DeviceBuffer> device_buffer =
         vertex_buffers[i].TakeBuffer();
     if (device_buffer) {
@@ -435,10 +413,6 @@ bool RenderPassVK::SetVertexBuffer(BufferView vertex_buffers[],
     }
   }
 
-  // Bind the vertex buffers.
-  command_buffer_vk_.bindVertexBuffers(0u, vertex_buffer_count, buffers,
-                                       vertex_buffer_offsets);
-
   return true;
 }
 
@@ -469,11 +443,10 @@ bool RenderPassVK::SetIndexBuffer(BufferView index_buffer,
       return false;
     }
 
-    vk::Buffer index_buffer_handle =
+    current_index_buffer_ =
         DeviceBufferVK::Cast(*index_buffer_view.GetBuffer()).GetBuffer();
-    command_buffer_vk_.bindIndexBuffer(index_buffer_handle,
-                                       index_buffer_view.GetRange().offset,
-                                       ToVKIndexType(index_type));
+    current_index_buffer_offset_ = index_buffer_view.GetRange().offset;
+    current_index_type_ = ToVKIndexType(index_type);
   } else {
     has_index_buffer_ = false;
   }
@@ -528,9 +501,6 @@ fml::Status RenderPassVK::Draw() {
                        "Could not allocate descriptor sets.");
   }
   const auto descriptor_set = descriptor_result.value();
-  const auto pipeline_layout = pipeline_vk.GetPipelineLayout();
-  command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                  pipeline_vk.GetPipeline());
 
   for (auto i = 0u; i < descriptor_write_offset_; i++) {
     write_workspace_[i].dstSet = descriptor_set;
@@ -539,42 +509,29 @@ fml::Status RenderPassVK::Draw() {
   context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
                                               write_workspace_.data(), 0u, {});
 
-  command_buffer_vk_.bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_layout,                   // layout
-      0,                                 // first set
-      1,                                 // set count
-      &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
-  );
-
-  if (pipeline_uses_input_attachments_) {
-    InsertBarrierForInputAttachmentRead(
-        command_buffer_vk_, TextureVK::Cast(*color_image_vk_).GetImage());
-  }
-
-  if (has_index_buffer_) {
-    command_buffer_vk_.drawIndexed(element_count_,   // index count
-                                   instance_count_,  // instance count
-                                   0u,               // first index
-                                   base_vertex_,     // vertex offset
-                                   0u                // first instance
-    );
-  } else {
-    command_buffer_vk_.draw(element_count_,   // vertex count
-                            instance_count_,  // instance count
-                            base_vertex_,     // vertex offset
-                            0u                // first instance
-    );
-  }
+  DrawCommandVK& draw = draws_.emplace_back();
+  draw.pipeline = pipeline_vk.GetPipeline();
+  draw.pipeline_layout = pipeline_vk.GetPipelineLayout();
+  draw.descriptor_set = descriptor_set;
+  draw.viewport = current_viewport_;
+  draw.scissor = current_scissor_;
+  draw.stencil_reference = current_stencil_;
+  draw.vertex_buffer_index = current_vertex_buffer_index_;
+  draw.vertex_buffer_count = current_vertex_buffer_count_;
+  draw.index_buffer = current_index_buffer_;
+  draw.index_buffer_offset = current_index_buffer_offset_;
+  draw.index_type = current_index_type_;
+  draw.element_count = element_count_;
+  draw.instance_count = instance_count_;
+  draw.base_vertex = base_vertex_;
+  draw.has_index_buffer = has_index_buffer_;
+  draw.uses_input_attachments = pipeline_uses_input_attachments_;
+  uses_input_attachments_ |= pipeline_uses_input_attachments_;
 
 #ifdef IMPELLER_DEBUG
-  if (has_label_) {
-    command_buffer_->PopDebugGroup();
-  }
+  draw.label = std::move(label_);
+  label_.clear();
 #endif  // IMPELLER_DEBUG
-  has_label_ = false;
   has_index_buffer_ = false;
   bound_image_offset_ = 0u;
   bound_buffer_offset_ = 0u;
@@ -689,8 +646,279 @@ bool RenderPassVK::BindResource(ShaderStage stage,
   return true;
 }
 
+vk::RenderPassBeginInfo RenderPassVK::GetRenderPassBeginInfo() const {
+  const auto& target_size = render_target_.GetRenderTargetSize();
+  vk::RenderPassBeginInfo pass_info;
+  pass_info.renderPass = *render_pass_;
+  pass_info.framebuffer = *framebuffer_;
+  pass_info.renderArea.extent.width = static_cast<uint32_t>(target_size.width);
+  pass_info.renderArea.extent.height =
+      static_cast<uint32_t>(target_size.height);
+  pass_info.setPClearValues(clear_values_.data());
+  pass_info.setClearValueCount(clear_value_count_);
+  return pass_info;
+}
+
+void RenderPassVK::RecordDraws(vk::CommandBuffer buffer,
+                               size_t begin,
+                               size_t end,
+                               bool set_initial_state) const {
+  // Dynamic state is not inherited by secondary command buffers, so every
+  // buffer starts out not knowing any of it.
+  std::optional<vk::Viewport> viewport;
+  std::optional<vk::Rect2D> scissor;
+  std::optional<uint32_t> stencil_reference;
+  std::optional<uint32_t> vertex_buffer_index;
+  std::optional<std::tuple<vk::Buffer, vk::DeviceSize, vk::IndexType>>
+      index_buffer;
+  vk::Pipeline pipeline;
+
+  auto set_viewport = [&](const vk::Viewport& value) {
+    if (viewport != value) {
+      viewport = value;
+      buffer.setViewport(0, 1, &value);
+    }
+  };
+  auto set_scissor = [&](const vk::Rect2D& value) {
+    if (scissor != value) {
+      scissor = value;
+      buffer.setScissor(0, 1, &value);
+    }
+  };
+  auto set_stencil_reference = [&](uint32_t value) {
+    if (stencil_reference != value) {
+      stencil_reference = value;
+      buffer.setStencilReference(
+          vk::StencilFaceFlagBits::eVkStencilFrontAndBack, value);
+    }
+  };
+
+  if (set_initial_state) {
+    const auto& target_size = render_target_.GetRenderTargetSize();
+    set_viewport(ToVKViewport(Viewport{.rect = Rect::MakeSize(target_size)}));
+    set_scissor(ToVKRect2D(IRect32::MakeSize(target_size)));
+    set_stencil_reference(0u);
+  }
+
+#ifdef IMPELLER_DEBUG
+  const bool has_validation_layers = HasValidationLayers();
+#endif  // IMPELLER_DEBUG
+
+  for (size_t i = begin; i < end; i++) {
+    const DrawCommandVK& draw = draws_[i];
+#ifdef IMPELLER_DEBUG
+    const bool has_label = has_validation_layers && !draw.label.empty();
+    if (has_label) {
+      vk::DebugUtilsLabelEXT label_info;
+      label_info.pLabelName = draw.label.c_str();
+      buffer.beginDebugUtilsLabelEXT(label_info);
+    }
+#endif  // IMPELLER_DEBUG
+
+    set_viewport(draw.viewport);
+    set_scissor(draw.scissor);
+    set_stencil_reference(draw.stencil_reference);
+
+    if (pipeline != draw.pipeline) {
+      pipeline = draw.pipeline;
+      buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, draw.pipeline);
+    }
+
+    buffer.bindDescriptorSets(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        draw.pipeline_layout,              // layout
+        0,                                 // first set
+        1,                                 // set count
+        &draw.descriptor_set,              // sets
+        0,                                 // offset count
+        nullptr                            // offsets
+    );
+
+    if (draw.vertex_buffer_count > 0u &&
+        vertex_buffer_index != draw.vertex_buffer_index) {
+      vertex_buffer_index = draw.vertex_buffer_index;
+      buffer.bindVertexBuffers(
+          0u, draw.vertex_buffer_count,
+          &vertex_buffers_[draw.vertex_buffer_index],
+          &vertex_buffer_offsets_[draw.vertex_buffer_index]);
+    }
+
+    if (draw.uses_input_attachments) {
+      InsertBarrierForInputAttachmentRead(
+          buffer, TextureVK::Cast(*color_image_vk_).GetImage());
+    }
+
+    if (draw.has_index_buffer) {
+      auto draw_index_buffer = std::make_tuple(
+          draw.index_buffer, draw.index_buffer_offset, draw.index_type);
+      if (index_buffer != draw_index_buffer) {
+        index_buffer = draw_index_buffer;
+        buffer.bindIndexBuffer(draw.index_buffer, draw.index_buffer_offset,
+                               draw.index_type);
+      }
+      buffer.drawIndexed(draw.element_count,   // index count
+                         draw.instance_count,  // instance count
+                         0u,                   // first index
+                         draw.base_vertex,     // vertex offset
+                         0u                    // first instance
+      );
+    } else {
+      buffer.draw(draw.element_count,   // vertex count
+                  draw.instance_count,  // instance count
+                  draw.base_vertex,     // vertex offset
+                  0u                    // first instance
+      );
+    }
+
+#ifdef IMPELLER_DEBUG
+    if (has_label) {
+      buffer.endDebugUtilsLabelEXT();
+    }
+#endif  // IMPELLER_DEBUG
+  }
+}
+
+namespace {
+
+// Keeps a secondary command buffer, and the pool it was allocated from, alive
+// until the primary command buffer executing it is done on the GPU.
+class SecondaryCommandBufferVK final : public SharedObjectVK {
+ public:
+  SecondaryCommandBufferVK(std::shared_ptr<CommandPoolVK> pool,
+                           vk::UniqueCommandBuffer buffer)
+      : pool_(std::move(pool)), buffer_(std::move(buffer)) {}
+
+  ~SecondaryCommandBufferVK() override {
+    pool_->CollectCommandBuffer(std::move(buffer_),
+                                vk::CommandBufferLevel::eSecondary);
+  }
+
+  vk::CommandBuffer Get() const { return *buffer_; }
+
+ private:
+  std::shared_ptr<CommandPoolVK> pool_;
+  vk::UniqueCommandBuffer buffer_;
+
+  SecondaryCommandBufferVK(const SecondaryCommandBufferVK&) = delete;
+
+  SecondaryCommandBufferVK& operator=(const SecondaryCommandBufferVK&) =
+      delete;
+};
+
+// The chunks of a render pass being recorded in parallel. Chunks are claimed
+// by both the workers and the encoding thread, so the encoding thread never
+// waits on a worker that hasn't started yet.
+struct ParallelRecordingVK {
+  explicit ParallelRecordingVK(size_t chunk_count)
+      : buffers(chunk_count), latch(chunk_count) {}
+
+  std::vector<std::shared_ptr<SecondaryCommandBufferVK>> buffers;
+  std::atomic<size_t> next_chunk = 0u;
+  std::atomic<bool> failed = false;
+  fml::CountDownLatch latch;
+};
+
+}  // namespace
+
+bool RenderPassVK::EncodeParallel(const ContextVK& context) const {
+  const size_t chunk_count =
+      std::min(kMaxRecordingChunks, draws_.size() / kMinDrawsPerRecordingChunk);
+  const size_t draws_per_chunk =
+      (draws_.size() + chunk_count - 1u) / chunk_count;
+
+  std::shared_ptr<CommandPoolRecyclerVK> recycler =
+      context.GetCommandPoolRecycler();
+  auto recording = std::make_shared<ParallelRecordingVK>(chunk_count);
+
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.renderPass = *render_pass_;
+  inheritance_info.subpass = 0u;
+  inheritance_info.framebuffer = *framebuffer_;
+
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                     vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+  begin_info.pInheritanceInfo = &inheritance_info;
+
+  // Records chunks until there are none left. Must only touch the render pass
+  // after claiming a chunk, as it may be gone by the time a late worker runs.
+  auto record_chunks = [this, recycler, recording, chunk_count,
+                        draws_per_chunk, begin_info]() {
+    std::shared_ptr<CommandPoolVK> pool;
+    while (true) {
+      const size_t chunk = recording->next_chunk.fetch_add(1u);
+      if (chunk >= chunk_count) {
+        return;
+      }
+      if (!pool) {
+        pool = recycler->Get();
+      }
+      vk::UniqueCommandBuffer buffer =
+          pool ? pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary)
+               : vk::UniqueCommandBuffer{};
+      if (buffer && buffer->begin(begin_info) == vk::Result::eSuccess) {
+        const size_t begin = chunk * draws_per_chunk;
+        const size_t end = std::min(begin + draws_per_chunk, draws_.size());
+        RecordDraws(*buffer, begin, end, /*set_initial_state=*/false);
+        if (buffer->end() == vk::Result::eSuccess) {
+          recording->buffers[chunk] =
+              std::make_shared<SecondaryCommandBufferVK>(pool,
+                                                         std::move(buffer));
+        }
+      }
+      if (!recording->buffers[chunk]) {
+        recording->failed = true;
+      }
+      recording->latch.CountDown();
+    }
+  };
+
+  auto worker_task_runner = context.GetConcurrentWorkerTaskRunner();
+  for (size_t i = 1u; i < chunk_count; i++) {
+    worker_task_runner->PostTask([record_chunks, recycler]() {
+      record_chunks();
+      // Workers never reach the end of a frame, so their pools are released
+      // right away. The secondary command buffers keep them alive until the
+      // GPU is done with them, after which they are recycled.
+      recycler->Dispose();
+    });
+  }
+  record_chunks();
+  recording->latch.Wait();
+
+  if (recording->failed) {
+    return false;
+  }
+
+  std::vector<vk::CommandBuffer> buffers;
+  buffers.reserve(chunk_count);
+  for (const auto& buffer : recording->buffers) {
+    buffers.push_back(buffer->Get());
+    command_buffer_->Track(buffer);
+  }
+
+  vk::CommandBuffer primary = command_buffer_->GetCommandBuffer();
+  primary.beginRenderPass(GetRenderPassBeginInfo(),
+                          vk::SubpassContents::eSecondaryCommandBuffers);
+  primary.executeCommands(buffers.size(), buffers.data());
+  primary.endRenderPass();
+  return true;
+}
+
 bool RenderPassVK::OnEncodeCommands(const Context& context) const {
-  command_buffer_->GetCommandBuffer().endRenderPass();
+  const auto& context_vk = ContextVK::Cast(context);
+  // Passes that read from the framebuffer need barriers between their draws,
+  // so they are always recorded inline.
+  if (draws_.size() >= kParallelRecordingDrawThreshold &&
+      !uses_input_attachments_ && EncodeParallel(context_vk)) {
+    return true;
+  }
+
+  vk::CommandBuffer primary = command_buffer_->GetCommandBuffer();
+  primary.beginRenderPass(GetRenderPassBeginInfo(),
+                          vk::SubpassContents::eInline);
+  RecordDraws(primary, 0u, draws_.size(), /*set_initial_state=*/true);
+  primary.endRenderPass();
   return true;
 }
 
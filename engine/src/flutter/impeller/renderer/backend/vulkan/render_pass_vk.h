@@ -5,9 +5,15 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 
+#include <array>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
+#include "impeller/renderer/backend/vulkan/render_pass_builder_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_pass.h"
@@ -15,26 +21,97 @@
 
 namespace impeller {
 
+namespace testing {
+FML_TEST_CLASS(RenderPassVK, DoesNotRedundantlySetStencil);
+FML_TEST_CLASS(RenderPassVK, RecordsLargePassesInParallel);
+}  // namespace testing
+
 class CommandBufferVK;
 class SamplerVK;
 
+/// @brief A draw call along with all the state it needs to be recorded into a
+///        command buffer. Descriptor sets are already allocated and updated.
+struct DrawCommandVK {
+  vk::Pipeline pipeline;
+  vk::PipelineLayout pipeline_layout;
+  vk::DescriptorSet descriptor_set;
+  vk::Viewport viewport;
+  vk::Rect2D scissor;
+  uint32_t stencil_reference = 0u;
+  // Range in the vertex buffer bindings of the render pass.
+  uint32_t vertex_buffer_index = 0u;
+  uint32_t vertex_buffer_count = 0u;
+  vk::Buffer index_buffer;
+  vk::DeviceSize index_buffer_offset = 0u;
+  vk::IndexType index_type = vk::IndexType::eUint16;
+  uint32_t element_count = 0u;
+  uint32_t instance_count = 1u;
+  uint32_t base_vertex = 0u;
+  bool has_index_buffer = false;
+  bool uses_input_attachments = false;
+#ifdef IMPELLER_DEBUG
+  std::string label;
+#endif  // IMPELLER_DEBUG
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A render pass that records its draws into the command buffer
+///             when it is encoded.
+///
+///             Passes with many draws are split into chunks that are recorded
+///             into secondary command buffers on the concurrent worker threads
+///             of the context, and executed from the primary command buffer.
+///             Smaller passes are recorded inline.
+///
 class RenderPassVK final : public RenderPass {
  public:
+  /// The number of draws a render pass needs before its recording is split
+  /// across worker threads. Below this, handing chunks off to workers costs
+  /// more than recording them inline.
+  static constexpr size_t kParallelRecordingDrawThreshold = 256u;
+
+  /// The fewest draws recorded into a single secondary command buffer.
+  static constexpr size_t kMinDrawsPerRecordingChunk = 64u;
+
+  /// The most secondary command buffers a render pass is split into.
+  static constexpr size_t kMaxRecordingChunks = 4u;
+
+  static_assert(kParallelRecordingDrawThreshold >= kMinDrawsPerRecordingChunk);
+
   // |RenderPass|
   ~RenderPassVK() override;
 
  private:
   friend class CommandBufferVK;
+  FML_FRIEND_TEST(testing::RenderPassVK, DoesNotRedundantlySetStencil);
+  FML_FRIEND_TEST(testing::RenderPassVK, RecordsLargePassesInParallel);
 
   std::shared_ptr<CommandBufferVK> command_buffer_;
   std::string debug_label_;
   SharedHandleVK<vk::RenderPass> render_pass_;
+  SharedHandleVK<vk::Framebuffer> framebuffer_;
   bool is_valid_ = false;
 
-  vk::CommandBuffer command_buffer_vk_;
   std::shared_ptr<Texture> color_image_vk_;
   std::shared_ptr<Texture> resolve_image_vk_;
+  std::array<vk::ClearValue, kMaxAttachments> clear_values_;
+  size_t clear_value_count_ = 0u;
+
+  // Recorded when the pass is encoded.
+  std::vector<DrawCommandVK> draws_;
+  std::vector<vk::Buffer> vertex_buffers_;
+  std::vector<vk::DeviceSize> vertex_buffer_offsets_;
+  bool uses_input_attachments_ = false;
+
+  // Dynamic state.
+  vk::Viewport current_viewport_;
+  vk::Rect2D current_scissor_;
   uint32_t current_stencil_ = 0;
+  uint32_t current_vertex_buffer_index_ = 0u;
+  uint32_t current_vertex_buffer_count_ = 0u;
+  vk::Buffer current_index_buffer_;
+  vk::DeviceSize current_index_buffer_offset_ = 0u;
+  vk::IndexType current_index_type_ = vk::IndexType::eUint16;
 
   // Per-command state.
   std::array<vk::DescriptorImageInfo, kMaxBindings> image_workspace_;
@@ -48,7 +125,9 @@ class RenderPassVK final : public RenderPass {
   size_t base_vertex_ = 0u;
   size_t element_count_ = 0u;
   bool has_index_buffer_ = false;
-  bool has_label_ = false;
+#ifdef IMPELLER_DEBUG
+  std::string label_;
+#endif  // IMPELLER_DEBUG
   PipelineRef pipeline_ = PipelineRef(nullptr);
   bool pipeline_uses_input_attachments_ = false;
   std::shared_ptr<SamplerVK> immutable_sampler_;
@@ -142,6 +221,22 @@ class RenderPassVK final : public RenderPass {
       const ContextVK& context,
       const vk::RenderPass& pass) const;
 
+  vk::RenderPassBeginInfo GetRenderPassBeginInfo() const;
+
+  /// @brief Records the draws in `[begin, end)` into the command buffer, which
+  ///        must be inside this render pass.
+  void RecordDraws(vk::CommandBuffer buffer,
+                   size_t begin,
+                   size_t end,
+                   bool set_initial_state) const;
+
+  /// @brief Records the draws into secondary command buffers on the worker
+  ///        threads and executes them from the primary command buffer.
+  ///
+  /// @return Whether the draws were recorded. Nothing is recorded into the
+  ///         primary command buffer if they weren't.
+  bool EncodeParallel(const ContextVK& context) const;
+
   RenderPassVK(const RenderPassVK&) = delete;
 
   RenderPassVK& operator=(const RenderPassVK&) = delete;
@@ -2,9 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "gtest/gtest.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_builder_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -14,6 +21,58 @@
 namespace impeller {
 namespace testing {
 
+namespace {
+
+VkCommandBuffer GetPrimaryCommandBuffer(
+    const std::shared_ptr<CommandBuffer>& cmd_buffer) {
+  return CommandBufferVK::Cast(*cmd_buffer).GetCommandBuffer();
+}
+
+template <class T>
+T MakeFakeHandle(uint64_t value) {
+  return T(reinterpret_cast<typename T::CType>(value));
+}
+
+// Replays the commands recorded into a mock command buffer and describes each
+// draw along with the state bound when it was issued. Executed secondary
+// command buffers are replayed in place, without inheriting any state.
+void DescribeDraws(VkCommandBuffer buffer, std::vector<std::string>& draws) {
+  std::map<std::string, std::vector<uint64_t>> state;
+  auto describe = [](std::ostream& stream, const MockCommand& command) {
+    stream << command.name << "(";
+    for (size_t i = 0; i < command.arguments.size(); i++) {
+      stream << (i > 0 ? ", " : "") << command.arguments[i];
+    }
+    stream << ")";
+  };
+  for (const MockCommand& command : GetMockCommands(buffer)) {
+    if (command.name == "vkCmdExecuteCommands") {
+      for (uint64_t secondary : command.arguments) {
+        DescribeDraws(reinterpret_cast<VkCommandBuffer>(secondary), draws);
+      }
+    } else if (command.name == "vkCmdDraw" ||
+               command.name == "vkCmdDrawIndexed") {
+      std::stringstream draw;
+      describe(draw, command);
+      for (const auto& [name, arguments] : state) {
+        // Non-indexed draws don't read the index buffer, so it doesn't matter
+        // whether one is still bound.
+        if (name == "vkCmdBindIndexBuffer" && command.name == "vkCmdDraw") {
+          continue;
+        }
+        draw << " ";
+        describe(draw, MockCommand{name, arguments});
+      }
+      draws.push_back(draw.str());
+    } else if (command.name.starts_with("vkCmdBind") ||
+               command.name.starts_with("vkCmdSet")) {
+      state[command.name] = command.arguments;
+    }
+  }
+}
+
+}  // namespace
+
 TEST(RenderPassVK, DoesNotRedundantlySetStencil) {
   std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
   std::shared_ptr<Context> copy = context;
@@ -24,29 +83,149 @@ TEST(RenderPassVK, DoesNotRedundantlySetStencil) {
 
   std::shared_ptr<RenderPass> render_pass =
       cmd_buffer->CreateRenderPass(target);
+  auto& render_pass_vk = static_cast<RenderPassVK&>(*render_pass);
 
-  // Stencil reference set once at buffer start.
-  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
-  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
-                       "vkCmdSetStencilReference"),
-            1);
+  // Stands in for RenderPass::Draw, which needs a pipeline.
+  auto add_draw = [&render_pass_vk]() {
+    DrawCommandVK& draw = render_pass_vk.draws_.emplace_back();
+    draw.stencil_reference = render_pass_vk.current_stencil_;
+  };
 
   // Duplicate stencil ref is not replaced.
   render_pass->SetStencilReference(0);
+  add_draw();
   render_pass->SetStencilReference(0);
+  add_draw();
   render_pass->SetStencilReference(0);
-
-  called_functions = GetMockVulkanFunctions(context->GetDevice());
-  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
-                       "vkCmdSetStencilReference"),
-            1);
+  add_draw();
 
   // Different stencil value is updated.
   render_pass->SetStencilReference(1);
-  called_functions = GetMockVulkanFunctions(context->GetDevice());
+  add_draw();
+
+  ASSERT_TRUE(render_pass->EncodeCommands());
+
+  // Stencil reference set once at pass start and once when it changes.
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
   EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
                        "vkCmdSetStencilReference"),
             2);
+
+  std::vector<uint64_t> stencil_references;
+  for (const MockCommand& command :
+       GetMockCommands(GetPrimaryCommandBuffer(cmd_buffer))) {
+    if (command.name == "vkCmdSetStencilReference") {
+      stencil_references.push_back(command.arguments[0]);
+    }
+  }
+  EXPECT_EQ(stencil_references, (std::vector<uint64_t>{0u, 1u}));
+}
+
+TEST(RenderPassVK, RecordsCommandsWhenEncoded) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  std::shared_ptr<Context> copy = context;
+  auto cmd_buffer = context->CreateCommandBuffer();
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreenMSAA(*copy.get(), {1, 1}, 1);
+
+  std::shared_ptr<RenderPass> render_pass =
+      cmd_buffer->CreateRenderPass(target);
+  render_pass->SetViewport(Viewport{.rect = Rect::MakeSize(Size(1, 1))});
+  render_pass->SetScissor(IRect32::MakeSize(ISize32(1, 1)));
+
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdSetViewport"),
+            0);
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdSetScissor"),
+            0);
+
+  ASSERT_TRUE(render_pass->EncodeCommands());
+
+  called_functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdSetViewport"),
+            1);
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdSetScissor"),
+            1);
+}
+
+TEST(RenderPassVK, RecordsLargePassesInParallel) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  std::shared_ptr<Context> copy = context;
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreenMSAA(*copy.get(), {1, 1}, 1);
+
+  // Not a multiple of the chunk count, so the last chunk is shorter.
+  const size_t draw_count = RenderPassVK::kParallelRecordingDrawThreshold + 3u;
+
+  // Adds the same draws to every pass, with state that changes at different
+  // rates so that every chunk starts in the middle of a run.
+  auto add_draws = [draw_count](RenderPassVK& render_pass_vk) {
+    render_pass_vk.vertex_buffers_ = {MakeFakeHandle<vk::Buffer>(0x100),
+                                      MakeFakeHandle<vk::Buffer>(0x200)};
+    render_pass_vk.vertex_buffer_offsets_ = {0u, 256u};
+    for (uint32_t i = 0; i < draw_count; i++) {
+      DrawCommandVK& draw = render_pass_vk.draws_.emplace_back();
+      draw.pipeline = MakeFakeHandle<vk::Pipeline>(0x1000 + i / 16);
+      draw.pipeline_layout = MakeFakeHandle<vk::PipelineLayout>(0x2000);
+      draw.descriptor_set = MakeFakeHandle<vk::DescriptorSet>(0x3000 + i);
+      draw.viewport = vk::Viewport().setWidth(64.0f).setHeight(-64.0f);
+      draw.scissor = vk::Rect2D(vk::Offset2D(static_cast<int32_t>(i % 7), 0),
+                                vk::Extent2D(8, 8));
+      draw.stencil_reference = i / 100;
+      draw.vertex_buffer_index = (i / 5) % 2;
+      draw.vertex_buffer_count = 1u;
+      draw.has_index_buffer = i % 3 == 0;
+      draw.index_buffer = MakeFakeHandle<vk::Buffer>(0x4000);
+      draw.index_buffer_offset = (i / 50) * 64u;
+      draw.element_count = 3u + i % 5;
+      draw.base_vertex = i % 4;
+    }
+  };
+
+  auto parallel_cmd_buffer = context->CreateCommandBuffer();
+  std::shared_ptr<RenderPass> parallel_pass =
+      parallel_cmd_buffer->CreateRenderPass(target);
+  add_draws(static_cast<RenderPassVK&>(*parallel_pass));
+  ASSERT_TRUE(parallel_pass->EncodeCommands());
+
+  // Passes that read from the framebuffer are always recorded inline.
+  auto serial_cmd_buffer = context->CreateCommandBuffer();
+  std::shared_ptr<RenderPass> serial_pass =
+      serial_cmd_buffer->CreateRenderPass(target);
+  auto& serial_pass_vk = static_cast<RenderPassVK&>(*serial_pass);
+  add_draws(serial_pass_vk);
+  serial_pass_vk.uses_input_attachments_ = true;
+  ASSERT_TRUE(serial_pass->EncodeCommands());
+
+  // The primary command buffer only executes the secondary command buffers.
+  std::vector<uint64_t> secondary_buffers;
+  for (const MockCommand& command :
+       GetMockCommands(GetPrimaryCommandBuffer(parallel_cmd_buffer))) {
+    EXPECT_NE(command.name, "vkCmdDraw");
+    EXPECT_NE(command.name, "vkCmdDrawIndexed");
+    if (command.name == "vkCmdBeginRenderPass") {
+      EXPECT_EQ(command.arguments[0],
+                static_cast<uint64_t>(
+                    VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
+    } else if (command.name == "vkCmdExecuteCommands") {
+      secondary_buffers = command.arguments;
+    }
+  }
+  EXPECT_EQ(secondary_buffers.size(), RenderPassVK::kMaxRecordingChunks);
+
+  std::vector<std::string> parallel_draws;
+  DescribeDraws(GetPrimaryCommandBuffer(parallel_cmd_buffer), parallel_draws);
+  std::vector<std::string> serial_draws;
+  DescribeDraws(GetPrimaryCommandBuffer(serial_cmd_buffer), serial_draws);
+
+  EXPECT_EQ(serial_draws.size(), draw_count);
+  EXPECT_EQ(parallel_draws, serial_draws);
 }
 
 }  // namespace testing
@@ -20,11 +20,16 @@ namespace testing {
 
 namespace {
 
+class MockDevice;
+
 struct MockCommandBuffer {
-  explicit MockCommandBuffer(
-      std::shared_ptr<std::vector<std::string>> called_functions)
-      : called_functions_(std::move(called_functions)) {}
-  std::shared_ptr<std::vector<std::string>> called_functions_;
+  explicit MockCommandBuffer(MockDevice* device) : device_(device) {}
+
+  void AddCommand(const std::string& name,
+                  std::vector<uint64_t> arguments = {});
+
+  MockDevice* device_;
+  std::vector<MockCommand> commands_;
   std::vector<VkImageMemoryBarrier> image_memory_barriers_;
 };
 
@@ -54,7 +59,7 @@ class MockDevice final {
   explicit MockDevice() : called_functions_(new std::vector<std::string>()) {}
 
   MockCommandBuffer* NewCommandBuffer() {
-    auto buffer = std::make_unique<MockCommandBuffer>(called_functions_);
+    auto buffer = std::make_unique<MockCommandBuffer>(this);
     MockCommandBuffer* result = buffer.get();
     Lock lock(command_buffers_mutex_);
     command_buffers_.emplace_back(std::move(buffer));
@@ -107,6 +112,25 @@ class MockDevice final {
       IPLR_GUARDED_BY(commmand_pools_mutex_);
 };
 
+// Command buffers may be recorded on different threads, but each one is only
+// recorded on one thread at a time.
+void MockCommandBuffer::AddCommand(const std::string& name,
+                                   std::vector<uint64_t> arguments) {
+  device_->AddCalledFunction(name);
+  commands_.push_back(MockCommand{name, std::move(arguments)});
+}
+
+template <class T>
+uint64_t HandleToArgument(T handle) {
+  return reinterpret_cast<uint64_t>(handle);
+}
+
+uint64_t FloatToArgument(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
 void noop() {}
 
 static thread_local std::vector<std::string> g_instance_extensions;
@@ -446,7 +470,8 @@ void vkCmdBindPipeline(VkCommandBuffer commandBuffer,
                        VkPipeline pipeline) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdBindPipeline");
+  mock_command_buffer->AddCommand("vkCmdBindPipeline",
+                                  {HandleToArgument(pipeline)});
 }
 
 void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
@@ -461,7 +486,7 @@ void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
                           const VkImageMemoryBarrier* pImageMemoryBarriers) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+  mock_command_buffer->AddCommand("vkCmdPipelineBarrier");
   if (pImageMemoryBarriers) {
     for (uint32_t i = 0; i < imageMemoryBarrierCount; ++i) {
       mock_command_buffer->image_memory_barriers_.push_back(
@@ -475,7 +500,7 @@ void vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
                               uint32_t reference) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetStencilReference");
+  mock_command_buffer->AddCommand("vkCmdSetStencilReference", {reference});
 }
 
 void vkCmdSetScissor(VkCommandBuffer commandBuffer,
@@ -484,7 +509,15 @@ void vkCmdSetScissor(VkCommandBuffer commandBuffer,
                      const VkRect2D* pScissors) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetScissor");
+  std::vector<uint64_t> arguments;
+  for (uint32_t i = 0; i < scissorCount; i++) {
+    const VkRect2D& scissor = pScissors[i];
+    arguments.insert(arguments.end(),
+                     {static_cast<uint64_t>(scissor.offset.x),
+                      static_cast<uint64_t>(scissor.offset.y),
+                      scissor.extent.width, scissor.extent.height});
+  }
+  mock_command_buffer->AddCommand("vkCmdSetScissor", std::move(arguments));
 }
 
 void vkCmdSetViewport(VkCommandBuffer commandBuffer,
@@ -493,7 +526,113 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
                       const VkViewport* pViewports) {
   MockCommandBuffer* mock_command_buffer =
       reinterpret_cast<MockCommandBuffer*>(commandBuffer);
-  mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
+  std::vector<uint64_t> arguments;
+  for (uint32_t i = 0; i < viewportCount; i++) {
+    const VkViewport& viewport = pViewports[i];
+    arguments.insert(arguments.end(), {FloatToArgument(viewport.x),
+                                       FloatToArgument(viewport.y),
+                                       FloatToArgument(viewport.width),
+                                       FloatToArgument(viewport.height)});
+  }
+  mock_command_buffer->AddCommand("vkCmdSetViewport", std::move(arguments));
+}
+
+void vkCmdBeginRenderPass(VkCommandBuffer commandBuffer,
+                          const VkRenderPassBeginInfo* pRenderPassBegin,
+                          VkSubpassContents contents) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->AddCommand("vkCmdBeginRenderPass",
+                                  {static_cast<uint64_t>(contents)});
+}
+
+void vkCmdEndRenderPass(VkCommandBuffer commandBuffer) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->AddCommand("vkCmdEndRenderPass");
+}
+
+void vkCmdExecuteCommands(VkCommandBuffer commandBuffer,
+                          uint32_t commandBufferCount,
+                          const VkCommandBuffer* pCommandBuffers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  std::vector<uint64_t> arguments;
+  for (uint32_t i = 0; i < commandBufferCount; i++) {
+    arguments.push_back(HandleToArgument(pCommandBuffers[i]));
+  }
+  mock_command_buffer->AddCommand("vkCmdExecuteCommands",
+                                  std::move(arguments));
+}
+
+void vkCmdBindDescriptorSets(VkCommandBuffer commandBuffer,
+                             VkPipelineBindPoint pipelineBindPoint,
+                             VkPipelineLayout layout,
+                             uint32_t firstSet,
+                             uint32_t descriptorSetCount,
+                             const VkDescriptorSet* pDescriptorSets,
+                             uint32_t dynamicOffsetCount,
+                             const uint32_t* pDynamicOffsets) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  std::vector<uint64_t> arguments = {HandleToArgument(layout), firstSet};
+  for (uint32_t i = 0; i < descriptorSetCount; i++) {
+    arguments.push_back(HandleToArgument(pDescriptorSets[i]));
+  }
+  mock_command_buffer->AddCommand("vkCmdBindDescriptorSets",
+                                  std::move(arguments));
+}
+
+void vkCmdBindVertexBuffers(VkCommandBuffer commandBuffer,
+                            uint32_t firstBinding,
+                            uint32_t bindingCount,
+                            const VkBuffer* pBuffers,
+                            const VkDeviceSize* pOffsets) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  std::vector<uint64_t> arguments = {firstBinding};
+  for (uint32_t i = 0; i < bindingCount; i++) {
+    arguments.push_back(HandleToArgument(pBuffers[i]));
+    arguments.push_back(pOffsets[i]);
+  }
+  mock_command_buffer->AddCommand("vkCmdBindVertexBuffers",
+                                  std::move(arguments));
+}
+
+void vkCmdBindIndexBuffer(VkCommandBuffer commandBuffer,
+                          VkBuffer buffer,
+                          VkDeviceSize offset,
+                          VkIndexType indexType) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->AddCommand(
+      "vkCmdBindIndexBuffer",
+      {HandleToArgument(buffer), offset, static_cast<uint64_t>(indexType)});
+}
+
+void vkCmdDraw(VkCommandBuffer commandBuffer,
+               uint32_t vertexCount,
+               uint32_t instanceCount,
+               uint32_t firstVertex,
+               uint32_t firstInstance) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->AddCommand(
+      "vkCmdDraw", {vertexCount, instanceCount, firstVertex, firstInstance});
+}
+
+void vkCmdDrawIndexed(VkCommandBuffer commandBuffer,
+                      uint32_t indexCount,
+                      uint32_t instanceCount,
+                      uint32_t firstIndex,
+                      int32_t vertexOffset,
+                      uint32_t firstInstance) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->AddCommand(
+      "vkCmdDrawIndexed",
+      {indexCount, instanceCount, firstIndex,
+       static_cast<uint64_t>(vertexOffset), firstInstance});
 }
 
 void vkFreeCommandBuffers(VkDevice device,
@@ -893,6 +1032,22 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return reinterpret_cast<PFN_vkVoidFunction>(vkCmdSetScissor);
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return reinterpret_cast<PFN_vkVoidFunction>(vkCmdSetViewport);
+  } else if (strcmp("vkCmdBeginRenderPass", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdBeginRenderPass);
+  } else if (strcmp("vkCmdEndRenderPass", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdEndRenderPass);
+  } else if (strcmp("vkCmdExecuteCommands", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdExecuteCommands);
+  } else if (strcmp("vkCmdBindDescriptorSets", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdBindDescriptorSets);
+  } else if (strcmp("vkCmdBindVertexBuffers", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdBindVertexBuffers);
+  } else if (strcmp("vkCmdBindIndexBuffer", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdBindIndexBuffer);
+  } else if (strcmp("vkCmdDraw", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdDraw);
+  } else if (strcmp("vkCmdDrawIndexed", pName) == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(vkCmdDrawIndexed);
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return reinterpret_cast<PFN_vkVoidFunction>(vkDestroyCommandPool);
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
@@ -1019,5 +1174,11 @@ std::vector<VkImageMemoryBarrier>& GetImageMemoryBarriers(
   return mock_command_buffer->image_memory_barriers_;
 }
 
+const std::vector<MockCommand>& GetMockCommands(VkCommandBuffer buffer) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(buffer);
+  return mock_command_buffer->commands_;
+}
+
 }  // namespace testing
 }  // namespace impeller
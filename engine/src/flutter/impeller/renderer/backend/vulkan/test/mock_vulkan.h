@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEST_MOCK_VULKAN_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_TEST_MOCK_VULKAN_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -134,6 +135,17 @@ void SetSwapchainImageSize(ISize size);
 std::vector<VkImageMemoryBarrier>& GetImageMemoryBarriers(
     VkCommandBuffer buffer);
 
+/// A command recorded into a mock command buffer, along with the arguments
+/// that determine what it binds or draws. Handles are stored as integers.
+struct MockCommand {
+  std::string name;
+  std::vector<uint64_t> arguments;
+};
+
+/// @brief Returns the commands recorded into the given mock command buffer, in
+///        the order they were recorded.
+const std::vector<MockCommand>& GetMockCommands(VkCommandBuffer buffer);
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -44,6 +44,7 @@ bool PipelineCompileQueue::PostJobForDescriptor(const PipelineDescriptor& desc,
       worker_task_runner_->PostTask(job);
       return true;
     }
+    pending_order_.push_back(desc);
   }
 
   worker_task_runner_->PostTask([weak_queue = weak_from_this()]() {
@@ -56,19 +57,30 @@ bool PipelineCompileQueue::PostJobForDescriptor(const PipelineDescriptor& desc,
 
 fml::closure PipelineCompileQueue::TakeNextJob() {
   Lock lock(pending_jobs_mutex_);
-  if (pending_jobs_.empty()) {
-    return nullptr;
+  while (!pending_order_.empty()) {
+    PipelineDescriptor desc = std::move(pending_order_.front());
+    pending_order_.pop_front();
+    auto found = pending_jobs_.find(desc);
+    if (found == pending_jobs_.end()) {
+      // Already performed eagerly.
+      continue;
+    }
+    auto job = found->second;
+    pending_jobs_.erase(found);
+    background_jobs_.insert(std::move(desc));
+    return job;
   }
-  auto job_iterator = pending_jobs_.begin();
-  auto job = job_iterator->second;
-  pending_jobs_.erase(job_iterator);
-  return job;
+  return nullptr;
 }
 
 fml::closure PipelineCompileQueue::TakeJob(const PipelineDescriptor& desc) {
   Lock lock(pending_jobs_mutex_);
   auto found = pending_jobs_.find(desc);
   if (found == pending_jobs_.end()) {
+    if (background_jobs_.erase(desc) > 0u) {
+      stats_.background_hits++;
+      TraceStats();
+    }
     return nullptr;
   }
   // The pipeline compile job was somewhere in the task queue. However, a
@@ -77,10 +89,8 @@ fml::closure PipelineCompileQueue::TakeJob(const PipelineDescriptor& desc) {
   // waiting on the job just decided to take the job from the queue and do it
   // itself. If there were jobs ahead of this one, it means that they were
   // mis-prioritized. This counter dumps the number of job re-prioritizations.
-  priorities_elevated_++;
-  FML_TRACE_COUNTER("impeller", "PipelineCompileQueue",
-                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
-                    "PrioritiesElevated", priorities_elevated_);
+  stats_.eager_compiles++;
+  TraceStats();
   auto job = found->second;
   pending_jobs_.erase(found);
   return job;
@@ -115,4 +125,36 @@ void PipelineCompileQueue::PerformJobEagerly(const PipelineDescriptor& desc) {
   }
 }
 
+void PipelineCompileQueue::PrioritizeJobs(
+    const std::vector<PipelineDescriptor>& descs) {
+  Lock lock(pending_jobs_mutex_);
+  std::unordered_set<PipelineDescriptor, ComparableHash<PipelineDescriptor>,
+                     ComparableEqual<PipelineDescriptor>>
+      prioritized;
+  std::deque<PipelineDescriptor> order;
+  for (const PipelineDescriptor& desc : descs) {
+    if (pending_jobs_.contains(desc) && prioritized.insert(desc).second) {
+      order.push_back(desc);
+    }
+  }
+  for (PipelineDescriptor& desc : pending_order_) {
+    if (!prioritized.contains(desc)) {
+      order.push_back(std::move(desc));
+    }
+  }
+  pending_order_ = std::move(order);
+}
+
+PipelineCompileQueue::Stats PipelineCompileQueue::GetStats() const {
+  Lock lock(pending_jobs_mutex_);
+  return stats_;
+}
+
+void PipelineCompileQueue::TraceStats() const {
+  FML_TRACE_COUNTER("impeller", "PipelineCompileQueue",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "EagerCompiles", stats_.eager_compiles,
+                    "BackgroundHits", stats_.background_hits);
+}
+
 }  // namespace impeller
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_COMPILE_QUEUE_H_
 #define FLUTTER_IMPELLER_RENDERER_PIPELINE_COMPILE_QUEUE_H_
 
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -34,6 +37,9 @@ namespace impeller {
 ///             skipping to the front of the line and being done on the callers
 ///             thread.
 ///
+///             Jobs are performed in the order they were posted unless
+///             reordered with `PrioritizeJobs`.
+///
 ///             Again, the entire point of this class is the reduce startup
 ///             times on the lowest end devices. On high end device, a queue is
 ///             entirely optional. The queue skipping mechanism all assume the
@@ -42,6 +48,15 @@ namespace impeller {
 class PipelineCompileQueue final
     : public std::enable_shared_from_this<PipelineCompileQueue> {
  public:
+  struct Stats {
+    /// The number of jobs that were still pending when their pipeline was
+    /// needed and had to be performed on the waiting thread.
+    size_t eager_compiles = 0u;
+    /// The number of jobs that had already been picked up by a worker when
+    /// their pipeline was needed.
+    size_t background_hits = 0u;
+  };
+
   static std::shared_ptr<PipelineCompileQueue> Create(
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
 
@@ -72,16 +87,41 @@ class PipelineCompileQueue final
   ///
   void PerformJobEagerly(const PipelineDescriptor& desc);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Move the pending jobs for the specified descriptors to the
+  ///             front of the queue, in the order given. Descriptors without
+  ///             a pending job are ignored. The relative order of all other
+  ///             jobs is unchanged.
+  ///
+  /// @param[in]  descs  The descriptors, most urgent first.
+  ///
+  void PrioritizeJobs(const std::vector<PipelineDescriptor>& descs);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Counters of how often waiting on a pipeline found its job
+  ///             still pending versus already picked up by a worker.
+  ///
+  Stats GetStats() const;
+
  private:
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
-  Mutex pending_jobs_mutex_;
-  size_t priorities_elevated_ = {};
+  mutable Mutex pending_jobs_mutex_;
+  Stats stats_ IPLR_GUARDED_BY(pending_jobs_mutex_);
 
   std::unordered_map<PipelineDescriptor,
                      fml::closure,
                      ComparableHash<PipelineDescriptor>,
                      ComparableEqual<PipelineDescriptor>>
       pending_jobs_ IPLR_GUARDED_BY(pending_jobs_mutex_);
+  // The order in which workers take jobs. May contain descriptors whose jobs
+  // have already been taken eagerly, those are skipped.
+  std::deque<PipelineDescriptor> pending_order_
+      IPLR_GUARDED_BY(pending_jobs_mutex_);
+  // Descriptors whose jobs were taken by a worker but not yet waited on.
+  std::unordered_set<PipelineDescriptor,
+                     ComparableHash<PipelineDescriptor>,
+                     ComparableEqual<PipelineDescriptor>>
+      background_jobs_ IPLR_GUARDED_BY(pending_jobs_mutex_);
 
   explicit PipelineCompileQueue(
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
@@ -93,6 +133,8 @@ class PipelineCompileQueue final
   void DoOneJob();
 
   void FinishAllJobs();
+
+  void TraceStats() const IPLR_REQUIRES(pending_jobs_mutex_);
 };
 
 }  // namespace impeller
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/pipeline_compile_queue.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+PipelineDescriptor MakeDescriptor(std::string_view label) {
+  PipelineDescriptor desc;
+  desc.SetLabel(label);
+  return desc;
+}
+}  // namespace
+
+TEST(PipelineCompileQueueTest, PerformsJobsInPostedOrderUnlessPrioritized) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto queue = PipelineCompileQueue::Create(loop->GetTaskRunner());
+
+  // Occupy the only worker so that the order of the remaining jobs is decided
+  // by the queue alone.
+  fml::AutoResetWaitableEvent blocker_started;
+  fml::ManualResetWaitableEvent unblock;
+  queue->PostJobForDescriptor(MakeDescriptor("blocker"), [&]() {
+    blocker_started.Signal();
+    unblock.Wait();
+  });
+  blocker_started.Wait();
+
+  std::mutex order_mutex;
+  std::vector<std::string> order;
+  fml::CountDownLatch done(4u);
+  for (const char* label : {"a", "b", "c", "d"}) {
+    queue->PostJobForDescriptor(MakeDescriptor(label), [&, label]() {
+      {
+        std::scoped_lock lock(order_mutex);
+        order.push_back(label);
+      }
+      done.CountDown();
+    });
+  }
+  queue->PrioritizeJobs({MakeDescriptor("d"), MakeDescriptor("not-posted"),
+                         MakeDescriptor("c")});
+
+  unblock.Signal();
+  done.Wait();
+  EXPECT_EQ(order, (std::vector<std::string>{"d", "c", "a", "b"}));
+}
+
+TEST(PipelineCompileQueueTest, CountsEagerCompilesAndBackgroundHits) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto queue = PipelineCompileQueue::Create(loop->GetTaskRunner());
+
+  fml::AutoResetWaitableEvent blocker_started;
+  fml::ManualResetWaitableEvent unblock;
+  queue->PostJobForDescriptor(MakeDescriptor("blocker"), [&]() {
+    blocker_started.Signal();
+    unblock.Wait();
+  });
+  blocker_started.Wait();
+
+  // The worker is busy, the waiter has to do the job itself.
+  std::thread::id eager_thread;
+  queue->PostJobForDescriptor(MakeDescriptor("eager"), [&]() {
+    eager_thread = std::this_thread::get_id();
+  });
+  queue->PerformJobEagerly(MakeDescriptor("eager"));
+  EXPECT_EQ(eager_thread, std::this_thread::get_id());
+  EXPECT_EQ(queue->GetStats().eager_compiles, 1u);
+  EXPECT_EQ(queue->GetStats().background_hits, 0u);
+
+  // The worker got to the job before it was needed.
+  unblock.Signal();
+  fml::AutoResetWaitableEvent background_done;
+  queue->PostJobForDescriptor(MakeDescriptor("background"),
+                              [&]() { background_done.Signal(); });
+  background_done.Wait();
+  queue->PerformJobEagerly(MakeDescriptor("background"));
+  EXPECT_EQ(queue->GetStats().eager_compiles, 1u);
+  EXPECT_EQ(queue->GetStats().background_hits, 1u);
+
+  // Jobs that were never posted count as neither.
+  queue->PerformJobEagerly(MakeDescriptor("not-posted"));
+  EXPECT_EQ(queue->GetStats().eager_compiles, 1u);
+  EXPECT_EQ(queue->GetStats().background_hits, 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
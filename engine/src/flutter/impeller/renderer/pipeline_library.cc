@@ -78,4 +78,11 @@ PipelineCompileQueue* PipelineLibrary::GetPipelineCompileQueue() const {
   return nullptr;
 }
 
+std::optional<PipelineUsageRecord> PipelineLibrary::GetPersistedPipelineUsage()
+    const {
+  return std::nullopt;
+}
+
+void PipelineLibrary::PersistPipelineUsage(const PipelineUsageRecord& record) {}
+
 }  // namespace impeller
@@ -14,6 +14,7 @@
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_compile_queue.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 
 namespace impeller {
 
@@ -95,6 +96,24 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   ///
   virtual PipelineCompileQueue* GetPipelineCompileQueue() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the pipeline usage persisted by a previous run of the
+  ///             application.
+  ///
+  /// @return     The record or std::nullopt if there is none or this library
+  ///             cannot persist pipeline usage.
+  ///
+  virtual std::optional<PipelineUsageRecord> GetPersistedPipelineUsage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Persist the pipeline usage of this run so that the next launch
+  ///             can create the same pipelines before its first frame. The
+  ///             default implementation discards the record.
+  ///
+  /// @param[in]  record  The record.
+  ///
+  virtual void PersistPipelineUsage(const PipelineUsageRecord& record);
+
  protected:
   PipelineLibrary();
 
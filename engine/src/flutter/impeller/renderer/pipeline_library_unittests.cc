@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/mapping.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 #include "impeller/renderer/testing/mocks.h"
 
 namespace impeller {
@@ -50,5 +52,45 @@ TEST(MockPipelineLibrary, LogAndGetPipelineUsageMultiplePipelines) {
 #endif
 }
 
+TEST(PipelineUsageRecordTest, AddIgnoresDuplicates) {
+  PipelineUsageRecord record;
+  EXPECT_TRUE(record.IsEmpty());
+  EXPECT_TRUE(record.Add("SolidFill Pipeline", 4u));
+  EXPECT_TRUE(record.Add("SolidFill Pipeline", 5u));
+  EXPECT_TRUE(record.Add("Texture Pipeline", 4u));
+  EXPECT_FALSE(record.Add("SolidFill Pipeline", 4u));
+  EXPECT_FALSE(record.Add("", 1u));
+  EXPECT_FALSE(record.Add("Multi\nLine", 1u));
+  EXPECT_EQ(record.GetEntries().size(), 3u);
+}
+
+TEST(PipelineUsageRecordTest, SerializationRoundTripsInOrder) {
+  PipelineUsageRecord record;
+  record.Add("Texture Pipeline 1", 0x4000000020400ull);
+  record.Add("SolidFill Pipeline", 0u);
+  record.Add("SolidFill Pipeline", ~0ull);
+
+  std::unique_ptr<fml::Mapping> data = record.Serialize();
+  ASSERT_TRUE(data);
+  std::optional<PipelineUsageRecord> decoded =
+      PipelineUsageRecord::Deserialize(*data);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->GetEntries(), record.GetEntries());
+}
+
+TEST(PipelineUsageRecordTest, RejectsMalformedData) {
+  auto deserialize = [](const std::string& data) {
+    return PipelineUsageRecord::Deserialize(fml::DataMapping(data));
+  };
+  EXPECT_TRUE(deserialize("impeller-pipeline-usage-v1\n").has_value());
+  EXPECT_FALSE(deserialize("").has_value());
+  EXPECT_FALSE(deserialize("impeller-pipeline-usage-v0\n").has_value());
+  EXPECT_FALSE(
+      deserialize("impeller-pipeline-usage-v1\nzz Pipeline\n").has_value());
+  EXPECT_FALSE(
+      deserialize("impeller-pipeline-usage-v1\n4 Pipeline").has_value());
+  EXPECT_FALSE(deserialize("impeller-pipeline-usage-v1\n4\n").has_value());
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_usage_record.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace impeller {
+
+// Bump the version whenever the meaning of families or variant keys changes
+// so that stale records are ignored instead of creating unused pipelines.
+static constexpr std::string_view kPipelineUsageRecordHeader =
+    "impeller-pipeline-usage-v1";
+
+std::optional<PipelineUsageRecord> PipelineUsageRecord::Deserialize(
+    const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return std::nullopt;
+  }
+  std::string_view data(reinterpret_cast<const char*>(mapping.GetMapping()),
+                        mapping.GetSize());
+  auto next_line = [&data]() -> std::optional<std::string_view> {
+    size_t end = data.find('\n');
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    std::string_view line = data.substr(0, end);
+    data.remove_prefix(end + 1);
+    return line;
+  };
+
+  if (next_line() != kPipelineUsageRecordHeader) {
+    return std::nullopt;
+  }
+
+  PipelineUsageRecord record;
+  while (!data.empty()) {
+    std::optional<std::string_view> line = next_line();
+    if (!line.has_value()) {
+      return std::nullopt;
+    }
+    // Each line is "<hex variant key> <family>".
+    size_t separator = line->find(' ');
+    if (separator == std::string_view::npos || separator == 0u ||
+        separator + 1 == line->size()) {
+      return std::nullopt;
+    }
+    uint64_t variant_key = 0u;
+    const char* key_end = line->data() + separator;
+    auto [ptr, error] =
+        std::from_chars(line->data(), key_end, variant_key, /*base=*/16);
+    if (error != std::errc() || ptr != key_end) {
+      return std::nullopt;
+    }
+    record.Add(line->substr(separator + 1), variant_key);
+  }
+  return record;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageRecord::Serialize() const {
+  std::string data(kPipelineUsageRecordHeader);
+  data.push_back('\n');
+  for (const Entry& entry : entries_) {
+    data += std::format("{:x} {}\n", entry.variant_key, entry.family);
+  }
+  return std::make_unique<fml::DataMapping>(data);
+}
+
+bool PipelineUsageRecord::Add(std::string_view family, uint64_t variant_key) {
+  if (family.empty() || family.find('\n') != std::string_view::npos) {
+    return false;
+  }
+  Entry entry{.family = std::string(family), .variant_key = variant_key};
+  if (std::find(entries_.begin(), entries_.end(), entry) != entries_.end()) {
+    return false;
+  }
+  entries_.push_back(std::move(entry));
+  return true;
+}
+
+const std::vector<PipelineUsageRecord::Entry>& PipelineUsageRecord::GetEntries()
+    const {
+  return entries_;
+}
+
+bool PipelineUsageRecord::IsEmpty() const {
+  return entries_.empty();
+}
+
+}  // namespace impeller
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
+#define FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The ordered list of pipelines an application needed during its
+///             first frames.
+///
+///             Pipeline descriptors reference shader functions and cannot
+///             outlive the process. Instead, each entry names the family of
+///             pipelines it belongs to and an opaque key that selects the
+///             variant within that family. Interpreting both is left to the
+///             creator of the pipelines (see `ContentContext`), which can then
+///             create the same pipelines ahead of time in the next run.
+///
+class PipelineUsageRecord {
+ public:
+  struct Entry {
+    std::string family;
+    uint64_t variant_key = 0u;
+
+    constexpr bool operator==(const Entry& other) const = default;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decode a record previously returned by `Serialize`.
+  ///
+  /// @return     The record or std::nullopt if the data is malformed or was
+  ///             written by an incompatible version.
+  ///
+  static std::optional<PipelineUsageRecord> Deserialize(
+      const fml::Mapping& mapping);
+
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append an entry unless an equal one was already recorded.
+  ///
+  /// @return     If the entry was added.
+  ///
+  bool Add(std::string_view family, uint64_t variant_key);
+
+  const std::vector<Entry>& GetEntries() const;
+
+  bool IsEmpty() const;
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
@@ -4,6 +4,7 @@
 
 #include "impeller/toolkit/interop/dl_builder.h"
 
+#include "flutter/fml/logging.h"
 #include "impeller/toolkit/interop/formats.h"
 
 namespace impeller::interop {
@@ -88,6 +89,26 @@ void DisplayListBuilder::DrawRect(const Rect& rect, const Paint& paint) {
   builder_.DrawRect(rect, paint.GetPaint());
 }
 
+void DisplayListBuilder::DrawRects(const std::vector<Rect>& rects,
+                                   const std::vector<flutter::DlColor>& colors,
+                                   const Paint& paint) {
+  // The builder only records the attributes of a paint that change between
+  // draws. So drawing all rectangles with the same paint and only changing
+  // its color records each rectangle as a single op.
+  if (colors.empty()) {
+    for (const auto& rect : rects) {
+      builder_.DrawRect(rect, paint.GetPaint());
+    }
+    return;
+  }
+  FML_DCHECK(colors.size() == rects.size());
+  flutter::DlPaint item_paint = paint.GetPaint();
+  for (size_t i = 0; i < rects.size(); i++) {
+    item_paint.setColor(colors[i]);
+    builder_.DrawRect(rects[i], item_paint);
+  }
+}
+
 void DisplayListBuilder::DrawOval(const Rect& oval_bounds, const Paint& paint) {
   builder_.DrawOval(oval_bounds, paint.GetPaint());
 }
@@ -172,6 +193,31 @@ void DisplayListBuilder::DrawTextureRect(const Texture& texture,
   );
 }
 
+void DisplayListBuilder::DrawAtlas(const Texture& texture,
+                                   const std::vector<RSTransform>& transforms,
+                                   const std::vector<Rect>& src_rects,
+                                   const std::vector<flutter::DlColor>& colors,
+                                   flutter::DlBlendMode mode,
+                                   flutter::DlImageSampling sampling,
+                                   const Rect* cull_rect,
+                                   const Paint* paint) {
+  FML_DCHECK(transforms.size() == src_rects.size());
+  FML_DCHECK(colors.empty() || colors.size() == transforms.size());
+  if (transforms.empty()) {
+    return;
+  }
+  builder_.DrawAtlas(texture.MakeImage(),                             //
+                     transforms.data(),                               //
+                     src_rects.data(),                                //
+                     colors.empty() ? nullptr : colors.data(),        //
+                     static_cast<int>(transforms.size()),             //
+                     mode,                                            //
+                     sampling,                                        //
+                     cull_rect,                                       //
+                     paint == nullptr ? nullptr : &paint->GetPaint()  //
+  );
+}
+
 void DisplayListBuilder::DrawParagraph(const Paragraph& paragraph,
                                        Point point) {
   const auto& handle = paragraph.GetHandle();
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_TOOLKIT_INTEROP_DL_BUILDER_H_
 #define FLUTTER_IMPELLER_TOOLKIT_INTEROP_DL_BUILDER_H_
 
+#include <vector>
+
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_canvas.h"
 #include "impeller/geometry/scalar.h"
@@ -81,6 +83,10 @@ class DisplayListBuilder final
 
   void DrawRect(const Rect& rect, const Paint& paint);
 
+  void DrawRects(const std::vector<Rect>& rects,
+                 const std::vector<flutter::DlColor>& colors,
+                 const Paint& paint);
+
   void DrawOval(const Rect& oval_bounds, const Paint& paint);
 
   void DrawRoundedRect(const Rect& rect,
@@ -106,6 +112,15 @@ class DisplayListBuilder final
                        flutter::DlImageSampling sampling,
                        const Paint* paint);
 
+  void DrawAtlas(const Texture& texture,
+                 const std::vector<RSTransform>& transforms,
+                 const std::vector<Rect>& src_rects,
+                 const std::vector<flutter::DlColor>& colors,
+                 flutter::DlBlendMode mode,
+                 flutter::DlImageSampling sampling,
+                 const Rect* cull_rect,
+                 const Paint* paint);
+
   void DrawDisplayList(const DisplayList& dl, Scalar opacity);
 
   void DrawParagraph(const Paragraph& paragraph, Point point);
@@ -18,6 +18,7 @@
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/rect.h"
+#include "impeller/geometry/rstransform.h"
 #include "impeller/geometry/size.h"
 #include "impeller/toolkit/interop/impeller.h"
 
@@ -253,6 +254,11 @@ constexpr Rect ToImpellerType(const ImpellerRect& rect) {
   return Rect::MakeXYWH(rect.x, rect.y, rect.width, rect.height);
 }
 
+constexpr RSTransform ToImpellerType(const ImpellerRSTransform& transform) {
+  return RSTransform{transform.scaled_cos, transform.scaled_sin,
+                     transform.translate_x, transform.translate_y};
+}
+
 constexpr flutter::DlTileMode ToDisplayListType(ImpellerTileMode mode) {
   switch (mode) {
     case kImpellerTileModeClamp:
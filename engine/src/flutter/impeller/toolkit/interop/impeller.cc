@@ -6,7 +6,9 @@
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
 #include <sstream>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "impeller/base/validation.h"
@@ -551,6 +553,40 @@ void ImpellerDisplayListBuilderDrawRect(ImpellerDisplayListBuilder builder,
   GetPeer(builder)->DrawRect(ToImpellerType(*rect), *GetPeer(paint));
 }
 
+static std::vector<flutter::DlColor> ReadColors(uint32_t count,
+                                                const ImpellerColor* colors) {
+  std::vector<flutter::DlColor> result;
+  if (colors == nullptr) {
+    return result;
+  }
+  result.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    result.emplace_back(ToDisplayListType(colors[i]));
+  }
+  return result;
+}
+
+static std::vector<Rect> ReadRects(uint32_t count, const ImpellerRect* rects) {
+  std::vector<Rect> result;
+  result.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    result.emplace_back(ToImpellerType(rects[i]));
+  }
+  return result;
+}
+
+IMPELLER_EXTERN_C
+void ImpellerDisplayListBuilderDrawRects(ImpellerDisplayListBuilder builder,
+                                         uint32_t rect_count,
+                                         const ImpellerRect* rects,
+                                         const ImpellerColor* colors,
+                                         ImpellerPaint paint) {
+  GetPeer(builder)->DrawRects(ReadRects(rect_count, rects),    //
+                              ReadColors(rect_count, colors),  //
+                              *GetPeer(paint)                  //
+  );
+}
+
 IMPELLER_EXTERN_C
 void ImpellerDisplayListBuilderDrawOval(ImpellerDisplayListBuilder builder,
                                         const ImpellerRect* oval_bounds,
@@ -815,6 +851,39 @@ void ImpellerDisplayListBuilderDrawTextureRect(
   );
 }
 
+IMPELLER_EXTERN_C
+void ImpellerDisplayListBuilderDrawAtlas(
+    ImpellerDisplayListBuilder builder,
+    ImpellerTexture texture,
+    uint32_t sprite_count,
+    const ImpellerRSTransform* transforms,
+    const ImpellerRect* src_rects,
+    const ImpellerColor* colors,
+    ImpellerBlendMode mode,
+    ImpellerTextureSampling sampling,
+    const ImpellerRect* cull_rect,
+    ImpellerPaint paint) {
+  std::vector<RSTransform> sprite_transforms;
+  sprite_transforms.reserve(sprite_count);
+  for (size_t i = 0; i < sprite_count; i++) {
+    sprite_transforms.emplace_back(ToImpellerType(transforms[i]));
+  }
+  std::optional<Rect> cull;
+  if (cull_rect != nullptr) {
+    cull = ToImpellerType(*cull_rect);
+  }
+  GetPeer(builder)->DrawAtlas(
+      *GetPeer(texture),                           //
+      sprite_transforms,                           //
+      ReadRects(sprite_count, src_rects),          //
+      ReadColors(sprite_count, colors),            //
+      ToDisplayListType(ToImpellerType(mode)),     //
+      ToDisplayListType(sampling),                 //
+      cull.has_value() ? &cull.value() : nullptr,  //
+      GetPeer(paint)                               //
+  );
+}
+
 IMPELLER_EXTERN_C
 void ImpellerColorSourceRetain(ImpellerColorSource color_source) {
   ObjectBase::SafeRetain(color_source);
@@ -1239,6 +1308,18 @@ void ImpellerDisplayListBuilderDrawParagraph(ImpellerDisplayListBuilder builder,
   GetPeer(builder)->DrawParagraph(*GetPeer(paragraph), ToImpellerType(*point));
 }
 
+IMPELLER_EXTERN_C
+void ImpellerDisplayListBuilderDrawParagraphs(
+    ImpellerDisplayListBuilder builder,
+    uint32_t paragraph_count,
+    ImpellerParagraph* paragraphs,
+    const ImpellerPoint* points) {
+  auto* peer = GetPeer(builder);
+  for (size_t i = 0; i < paragraph_count; i++) {
+    peer->DrawParagraph(*GetPeer(paragraphs[i]), ToImpellerType(points[i]));
+  }
+}
+
 IMPELLER_EXTERN_C
 void ImpellerDisplayListBuilderDrawShadow(ImpellerDisplayListBuilder builder,
                                           ImpellerPath path,
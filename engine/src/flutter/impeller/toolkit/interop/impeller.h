@@ -609,6 +609,24 @@ typedef struct ImpellerRoundingRadii {
   ImpellerPoint bottom_right;
 } ImpellerRoundingRadii;
 
+//------------------------------------------------------------------------------
+/// A transform composed of a rotation and uniform scale followed by a
+/// translation. Mirrors the `RSTransform` class in Flutter.
+///
+/// A point (x, y) is transformed to:
+///
+/// ```
+/// (scaled_cos * x - scaled_sin * y + translate_x,
+///  scaled_sin * x + scaled_cos * y + translate_y)
+/// ```
+///
+typedef struct ImpellerRSTransform {
+  float scaled_cos;
+  float scaled_sin;
+  float translate_x;
+  float translate_y;
+} ImpellerRSTransform;
+
 typedef struct ImpellerColor {
   float red;
   float green;
@@ -2172,6 +2190,29 @@ void ImpellerDisplayListBuilderDrawRect(
     const ImpellerRect* IMPELLER_NONNULL rect,
     ImpellerPaint IMPELLER_NONNULL paint);
 
+//------------------------------------------------------------------------------
+/// @brief      Draws many rectangles with the same paint. This is equivalent
+///             to calling `ImpellerDisplayListBuilderDrawRect` once per
+///             rectangle but only needs a single call across the API boundary.
+///
+///             If colors are specified, each rectangle is drawn with the paint
+///             but with its color replaced by the color at the same index.
+///
+/// @param[in]  builder     The builder.
+/// @param[in]  rect_count  The rectangle count.
+/// @param[in]  rects       The rectangles.
+/// @param[in]  colors      The per-rectangle colors or NULL to use the color
+///                         of the paint for all rectangles.
+/// @param[in]  paint       The paint.
+///
+IMPELLER_EXPORT
+void ImpellerDisplayListBuilderDrawRects(
+    ImpellerDisplayListBuilder IMPELLER_NONNULL builder,
+    uint32_t rect_count,
+    const ImpellerRect* IMPELLER_NONNULL rects,
+    const ImpellerColor* IMPELLER_NULLABLE colors,
+    ImpellerPaint IMPELLER_NONNULL paint);
+
 //------------------------------------------------------------------------------
 /// @brief      Draws an oval.
 ///
@@ -2260,6 +2301,24 @@ void ImpellerDisplayListBuilderDrawParagraph(
     ImpellerParagraph IMPELLER_NONNULL paragraph,
     const ImpellerPoint* IMPELLER_NONNULL point);
 
+//------------------------------------------------------------------------------
+/// @brief      Draw many paragraphs, each at the point with the same index.
+///             This is equivalent to calling
+///             `ImpellerDisplayListBuilderDrawParagraph` once per paragraph
+///             but only needs a single call across the API boundary.
+///
+/// @param[in]  builder          The builder.
+/// @param[in]  paragraph_count  The paragraph count.
+/// @param[in]  paragraphs       The paragraphs.
+/// @param[in]  points           The points.
+///
+IMPELLER_EXPORT
+void ImpellerDisplayListBuilderDrawParagraphs(
+    ImpellerDisplayListBuilder IMPELLER_NONNULL builder,
+    uint32_t paragraph_count,
+    IMPELLER_NONNULL ImpellerParagraph* IMPELLER_NONNULL paragraphs,
+    const ImpellerPoint* IMPELLER_NONNULL points);
+
 //------------------------------------------------------------------------------
 /// @brief      Draw a shadow for a Path given a material elevation. If the
 ///             occluding object is not opaque, additional hints (via the
@@ -2324,6 +2383,39 @@ void ImpellerDisplayListBuilderDrawTextureRect(
     ImpellerTextureSampling sampling,
     ImpellerPaint IMPELLER_NULLABLE paint);
 
+//------------------------------------------------------------------------------
+/// @brief      Draw many sprites from a single texture in one operation. Each
+///             sprite is the portion of the texture in the source rectangle
+///             transformed by the transform with the same index.
+///
+///             If colors are specified, the color at the same index is
+///             blended with each sprite using the specified blend mode.
+///
+/// @param[in]  builder       The builder.
+/// @param[in]  texture       The texture containing all the sprites.
+/// @param[in]  sprite_count  The sprite count.
+/// @param[in]  transforms    The transforms of the sprites.
+/// @param[in]  src_rects     The source rectangles of the sprites.
+/// @param[in]  colors        The per-sprite colors or NULL.
+/// @param[in]  mode          The blend mode used to apply the colors.
+/// @param[in]  sampling      The sampling.
+/// @param[in]  cull_rect     An optional bounds of all the sprites. Can be
+///                           NULL.
+/// @param[in]  paint         The paint.
+///
+IMPELLER_EXPORT
+void ImpellerDisplayListBuilderDrawAtlas(
+    ImpellerDisplayListBuilder IMPELLER_NONNULL builder,
+    ImpellerTexture IMPELLER_NONNULL texture,
+    uint32_t sprite_count,
+    const ImpellerRSTransform* IMPELLER_NONNULL transforms,
+    const ImpellerRect* IMPELLER_NONNULL src_rects,
+    const ImpellerColor* IMPELLER_NULLABLE colors,
+    ImpellerBlendMode mode,
+    ImpellerTextureSampling sampling,
+    const ImpellerRect* IMPELLER_NULLABLE cull_rect,
+    ImpellerPaint IMPELLER_NULLABLE paint);
+
 //------------------------------------------------------------------------------
 // Typography Context
 //------------------------------------------------------------------------------
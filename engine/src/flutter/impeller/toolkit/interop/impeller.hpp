@@ -69,14 +69,17 @@ struct Proc {
   PROC(ImpellerDisplayListBuilderClipRect)                        \
   PROC(ImpellerDisplayListBuilderClipRoundedRect)                 \
   PROC(ImpellerDisplayListBuilderCreateDisplayListNew)            \
+  PROC(ImpellerDisplayListBuilderDrawAtlas)                       \
   PROC(ImpellerDisplayListBuilderDrawDashedLine)                  \
   PROC(ImpellerDisplayListBuilderDrawDisplayList)                 \
   PROC(ImpellerDisplayListBuilderDrawLine)                        \
   PROC(ImpellerDisplayListBuilderDrawOval)                        \
   PROC(ImpellerDisplayListBuilderDrawPaint)                       \
   PROC(ImpellerDisplayListBuilderDrawParagraph)                   \
+  PROC(ImpellerDisplayListBuilderDrawParagraphs)                  \
   PROC(ImpellerDisplayListBuilderDrawPath)                        \
   PROC(ImpellerDisplayListBuilderDrawRect)                        \
+  PROC(ImpellerDisplayListBuilderDrawRects)                       \
   PROC(ImpellerDisplayListBuilderDrawRoundedRect)                 \
   PROC(ImpellerDisplayListBuilderDrawRoundedRectDifference)       \
   PROC(ImpellerDisplayListBuilderDrawShadow)                      \
@@ -1587,6 +1590,31 @@ class DisplayListBuilder : public Object<ImpellerDisplayListBuilder,
     return *this;
   }
 
+  //----------------------------------------------------------------------------
+  /// @see      ImpellerDisplayListBuilderDrawAtlas
+  ///
+  DisplayListBuilder& DrawAtlas(const Texture& texture,
+                                uint32_t sprite_count,
+                                const ImpellerRSTransform* transforms,
+                                const ImpellerRect* src_rects,
+                                const ImpellerColor* colors,
+                                ImpellerBlendMode mode,
+                                ImpellerTextureSampling sampling,
+                                const ImpellerRect* cull_rect,
+                                const Paint& paint) {
+    gGlobalProcTable.ImpellerDisplayListBuilderDrawAtlas(
+        Get(), texture.Get(),  //
+        sprite_count,          //
+        transforms,            //
+        src_rects,             //
+        colors,                //
+        mode,                  //
+        sampling,              //
+        cull_rect,             //
+        paint.Get());
+    return *this;
+  }
+
   //----------------------------------------------------------------------------
   /// @see      ImpellerDisplayListBuilderDrawDashedLine
   ///
@@ -1658,6 +1686,17 @@ class DisplayListBuilder : public Object<ImpellerDisplayListBuilder,
     return *this;
   }
 
+  //----------------------------------------------------------------------------
+  /// @see      ImpellerDisplayListBuilderDrawParagraphs
+  ///
+  DisplayListBuilder& DrawParagraphs(uint32_t paragraph_count,
+                                     ImpellerParagraph* paragraphs,
+                                     const ImpellerPoint* points) {
+    gGlobalProcTable.ImpellerDisplayListBuilderDrawParagraphs(
+        Get(), paragraph_count, paragraphs, points);
+    return *this;
+  }
+
   //----------------------------------------------------------------------------
   /// @see      ImpellerDisplayListBuilderDrawShadow
   ///
@@ -1690,6 +1729,18 @@ class DisplayListBuilder : public Object<ImpellerDisplayListBuilder,
     return *this;
   }
 
+  //----------------------------------------------------------------------------
+  /// @see      ImpellerDisplayListBuilderDrawRects
+  ///
+  DisplayListBuilder& DrawRects(uint32_t rect_count,
+                                const ImpellerRect* rects,
+                                const ImpellerColor* colors,
+                                const Paint& paint) {
+    gGlobalProcTable.ImpellerDisplayListBuilderDrawRects(
+        Get(), rect_count, rects, colors, paint.Get());
+    return *this;
+  }
+
   //----------------------------------------------------------------------------
   /// @see      ImpellerDisplayListBuilderDrawRoundedRect
   ///
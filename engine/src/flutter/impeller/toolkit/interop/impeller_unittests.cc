@@ -30,6 +30,10 @@ INSTANTIATE_PLAYGROUND_SUITE(InteropPlaygroundTest);
 // Just ensures that context can be subclassed.
 class ContextSub : public hpp::Context {};
 
+static sk_sp<flutter::DisplayList> GetDisplayList(const hpp::DisplayList& dl) {
+  return reinterpret_cast<DisplayList*>(dl.Get())->GetDisplayList();
+}
+
 TEST_P(InteropPlaygroundTest, CanCreateContext) {
   auto context = CreateContext();
   ASSERT_TRUE(context);
@@ -96,6 +100,41 @@ TEST_P(InteropPlaygroundTest, CanDrawRect) {
       }));
 }
 
+TEST_P(InteropPlaygroundTest, CanDrawRectsInBatches) {
+  std::vector<ImpellerRect> rects;
+  std::vector<ImpellerColor> colors;
+  for (int i = 0; i < 16; i++) {
+    rects.push_back({10.0f + 60.0f * (i % 4), 10.0f + 60.0f * (i / 4), 50, 50});
+    colors.push_back({i / 15.0f, 0.0, 1.0f - i / 15.0f, 1.0});
+  }
+  hpp::Paint paint;
+  paint.SetColor({0.0, 1.0, 0.0, 1.0});
+
+  // Batched draws must record the same display list as one call per rect.
+  hpp::DisplayListBuilder per_call;
+  for (const auto& rect : rects) {
+    per_call.DrawRect(rect, paint);
+  }
+  for (size_t i = 0; i < rects.size(); i++) {
+    per_call.DrawRect(rects[i], hpp::Paint{}.SetColor(colors[i]));
+  }
+  auto expected = per_call.Build();
+
+  auto dl = hpp::DisplayListBuilder{}
+                .DrawRects(rects.size(), rects.data(), nullptr, paint)
+                .DrawRects(rects.size(), rects.data(), colors.data(), paint)
+                .Build();
+  ASSERT_TRUE(dl);
+  ASSERT_TRUE(GetDisplayList(dl)->Equals(GetDisplayList(expected)));
+
+  ASSERT_TRUE(
+      OpenPlaygroundHere([&](const auto& context, const auto& surface) -> bool {
+        hpp::Surface window(surface.GetC());
+        window.Draw(dl);
+        return true;
+      }));
+}
+
 TEST_P(InteropPlaygroundTest, CanDrawImage) {
   auto compressed = LoadFixtureImageCompressed(
       flutter::testing::OpenFixtureAsMapping("boston.jpg"));
@@ -130,6 +169,63 @@ TEST_P(InteropPlaygroundTest, CanDrawImage) {
       }));
 }
 
+TEST_P(InteropPlaygroundTest, CanDrawAtlas) {
+  auto compressed = LoadFixtureImageCompressed(
+      flutter::testing::OpenFixtureAsMapping("boston.jpg"));
+  ASSERT_NE(compressed, nullptr);
+  auto decompressed = std::make_shared<impeller::DecompressedImage>(
+      compressed->Decode().ConvertToRGBA());
+  ASSERT_TRUE(decompressed->IsValid());
+  auto mapping = std::make_unique<hpp::Mapping>(
+      decompressed->GetAllocation()->GetMapping(),
+      decompressed->GetAllocation()->GetSize(), [decompressed]() {
+        // Mapping will be dropped on the floor.
+      });
+
+  auto context = GetHPPContext();
+  ImpellerTextureDescriptor desc = {};
+  desc.pixel_format = ImpellerPixelFormat::kImpellerPixelFormatRGBA8888;
+  desc.size = {decompressed->GetSize().width, decompressed->GetSize().height};
+  desc.mip_count = 1u;
+  auto texture = hpp::Texture::WithContents(context, desc, std::move(mapping));
+  ASSERT_TRUE(texture);
+
+  // Tile the four quadrants of the image, each rotated and tinted.
+  const float half_width = desc.size.width / 2.0f;
+  const float half_height = desc.size.height / 2.0f;
+  std::vector<ImpellerRSTransform> transforms;
+  std::vector<ImpellerRect> src_rects;
+  std::vector<ImpellerColor> colors;
+  for (int i = 0; i < 4; i++) {
+    const float angle = kPiOver4 * i / 4.0f;
+    transforms.push_back({0.5f * std::cos(angle),     //
+                          0.5f * std::sin(angle),     //
+                          100.0f + 300.0f * (i % 2),  //
+                          100.0f + 300.0f * (i / 2)});
+    src_rects.push_back(
+        {half_width * (i % 2), half_height * (i / 2), half_width, half_height});
+    colors.push_back({i == 0 ? 1.0f : 0.0f, i == 1 ? 1.0f : 0.0f,
+                      i == 2 ? 1.0f : 0.0f, 1.0});
+  }
+
+  auto dl =
+      hpp::DisplayListBuilder{}
+          .DrawAtlas(texture, transforms.size(), transforms.data(),
+                     src_rects.data(), colors.data(),
+                     kImpellerBlendModeModulate, kImpellerTextureSamplingLinear,
+                     nullptr, hpp::Paint{})
+          .Build();
+  ASSERT_TRUE(dl);
+  ASSERT_EQ(GetDisplayList(dl)->op_count(), 1u);
+
+  ASSERT_TRUE(
+      OpenPlaygroundHere([&](const auto& context, const auto& surface) -> bool {
+        hpp::Surface window(surface.GetC());
+        window.Draw(dl);
+        return true;
+      }));
+}
+
 TEST_P(InteropPlaygroundTest, CanCreateOpenGLImage) {
   auto context = GetInteropContext();
 
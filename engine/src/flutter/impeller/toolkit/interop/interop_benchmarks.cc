@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/toolkit/interop/impeller.h"
+
+namespace impeller::interop {
+
+namespace {
+
+std::vector<ImpellerRect> CreateRects(size_t count) {
+  std::vector<ImpellerRect> rects;
+  rects.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    rects.push_back(ImpellerRect{
+        .x = static_cast<float>(i % 64) * 16.0f,
+        .y = static_cast<float>(i / 64) * 16.0f,
+        .width = 12.0f,
+        .height = 12.0f,
+    });
+  }
+  return rects;
+}
+
+std::vector<ImpellerColor> CreateColors(size_t count) {
+  std::vector<ImpellerColor> colors;
+  colors.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    colors.push_back(ImpellerColor{
+        .red = static_cast<float>(i % 3) / 2.0f,
+        .green = static_cast<float>(i % 5) / 4.0f,
+        .blue = static_cast<float>(i % 7) / 6.0f,
+        .alpha = 1.0f,
+        .color_space = kImpellerColorSpaceSRGB,
+    });
+  }
+  return colors;
+}
+
+/// Records `state.range(0)` rectangles into a display list, either with one
+/// call per rectangle or with a single batched call. When `colored` is set,
+/// every rectangle has a different color.
+template <class... Args>
+static void BM_DrawRects(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  bool batched = std::get<0>(args_tuple);
+  bool colored = std::get<1>(args_tuple);
+
+  const size_t count = state.range(0);
+  const auto rects = CreateRects(count);
+  const auto colors = CreateColors(count);
+
+  ImpellerPaint paint = ImpellerPaintNew();
+  ImpellerPaintSetColor(paint, &colors[0]);
+
+  while (state.KeepRunning()) {
+    ImpellerDisplayListBuilder builder = ImpellerDisplayListBuilderNew(nullptr);
+    if (batched) {
+      ImpellerDisplayListBuilderDrawRects(builder, count, rects.data(),
+                                          colored ? colors.data() : nullptr,
+                                          paint);
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        if (colored) {
+          ImpellerPaintSetColor(paint, &colors[i]);
+        }
+        ImpellerDisplayListBuilderDrawRect(builder, &rects[i], paint);
+      }
+    }
+    ImpellerDisplayList display_list =
+        ImpellerDisplayListBuilderCreateDisplayListNew(builder);
+    benchmark::DoNotOptimize(display_list);
+    ImpellerDisplayListRelease(display_list);
+    ImpellerDisplayListBuilderRelease(builder);
+  }
+
+  ImpellerPaintRelease(paint);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+}  // namespace
+
+#define MAKE_DRAW_RECTS_BENCHMARK_CAPTURE(name, batched, colored) \
+  BENCHMARK_CAPTURE(BM_DrawRects, name, batched, colored)         \
+      ->RangeMultiplier(8)                                        \
+      ->Range(64, 32768)
+
+MAKE_DRAW_RECTS_BENCHMARK_CAPTURE(per_call, false, false);
+MAKE_DRAW_RECTS_BENCHMARK_CAPTURE(batched, true, false);
+MAKE_DRAW_RECTS_BENCHMARK_CAPTURE(per_call_colored, false, true);
+MAKE_DRAW_RECTS_BENCHMARK_CAPTURE(batched_colored, true, true);
+
+}  // namespace impeller::interop
@@ -36,6 +36,9 @@ bool Surface::DrawDisplayList(const DisplayList& dl) const {
 
   auto result = RenderToTarget(content_context, render_target, display_list,
                                cull_rect, /*reset_host_buffer=*/true);
+  if (result) {
+    content_context.MarkFrameEnd();
+  }
   context_->GetContext()->ResetThreadLocalState();
   return result;
 }
@@ -65,6 +65,9 @@ const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
   texture_ = std::move(texture);
+  memory_usage_.Set(
+      texture_ ? texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel()
+               : 0u);
 }
 
 size_t GlyphAtlas::GetAtlasGeneration() const {
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/memory/memory_usage.h"
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/typographer/font_glyph_pair.h"
@@ -159,6 +160,7 @@ class GlyphAtlas {
   const Type type_;
   std::shared_ptr<Texture> texture_;
   size_t generation_ = 0;
+  fml::MemoryUsageCounter memory_usage_{fml::MemoryCategory::kGlyphAtlas};
 
   using FontAtlasMap = absl::flat_hash_map<ScaledFont,
                                            FontGlyphAtlas,
@@ -10,15 +10,18 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/renderer/blit_pass.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/display_list/skia_conversions.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -34,6 +37,17 @@
 namespace flutter {
 
 namespace {
+
+/// Wraps a texture holding the pixels of a decoded image. The texture counts
+/// towards the decoded images of the process while the image is alive.
+sk_sp<DlImage> MakeDecodedImage(std::shared_ptr<impeller::Texture> texture) {
+  auto image = impeller::DlImageImpeller::Make(std::move(texture));
+  if (image) {
+    image->ReportMemoryUsage(fml::MemoryCategory::kDecodedImages);
+  }
+  return image;
+}
+
 /**
  *  Loads the gamut as a set of three points (triangle).
  */
@@ -162,7 +176,8 @@ absl::StatusOr<DecodedBitmap> DecodeToBitmap(
     ImageDescriptor* descriptor,
     const SkImageInfo& image_info,
     const SkImageInfo& base_image_info,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   std::shared_ptr<SkBitmap> bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
   std::shared_ptr<ImpellerAllocator> bitmap_allocator =
@@ -175,7 +190,7 @@ absl::StatusOr<DecodedBitmap> DecodeToBitmap(
       FML_DLOG(ERROR) << error;
       return absl::InvalidArgumentError(error);
     }
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    if (!descriptor->get_pixels(bitmap->pixmap(), concurrent_task_runner)) {
       std::string error = "Could not decompress image.";
       FML_DLOG(ERROR) << error;
       return absl::InvalidArgumentError(error);
@@ -285,6 +300,97 @@ impeller::PixelFormat ToImpellerPixelFormat(
       return impeller::PixelFormat::kUnknown;
   }
 }
+
+impeller::TextureDescriptor MakePrivateTextureDescriptor(
+    const std::shared_ptr<impeller::Context>& context,
+    const ImageDecoderImpeller::ImageInfo& image_info,
+    const std::optional<SkImageInfo>& resize_info) {
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format = image_info.format;
+  texture_descriptor.size = {image_info.size.width, image_info.size.height};
+  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+  if (context->GetBackendType() == impeller::Context::BackendType::kMetal &&
+      resize_info.has_value()) {
+    // The MPS used to resize images on iOS does not require mip generation.
+    // Remove mip count if we are resizing the image on the GPU.
+    texture_descriptor.mip_count = 1;
+  }
+  return texture_descriptor;
+}
+
+/// Records mipmap generation for the uploaded texture and, if requested, the
+/// resize into a new texture. Returns the texture holding the final image.
+absl::StatusOr<std::shared_ptr<impeller::Texture>> EncodeMipmapsAndResize(
+    const std::shared_ptr<impeller::Context>& context,
+    impeller::BlitPass& blit_pass,
+    const std::shared_ptr<impeller::Texture>& dest_texture,
+    const std::optional<SkImageInfo>& resize_info) {
+  if (dest_texture->GetTextureDescriptor().mip_count > 1) {
+    blit_pass.GenerateMipmap(dest_texture);
+  }
+  if (!resize_info.has_value()) {
+    return dest_texture;
+  }
+
+  impeller::TextureDescriptor resize_desc;
+  resize_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  resize_desc.format = dest_texture->GetTextureDescriptor().format;
+  resize_desc.size = {resize_info->width(), resize_info->height()};
+  resize_desc.mip_count = resize_desc.size.MipCount();
+  resize_desc.usage = impeller::TextureUsage::kShaderRead;
+  if (context->GetBackendType() == impeller::Context::BackendType::kMetal) {
+    // Resizing requires a MPS on Metal platforms.
+    resize_desc.usage |= impeller::TextureUsage::kShaderWrite;
+    resize_desc.compression_type = impeller::CompressionType::kLossless;
+  }
+  auto resize_texture =
+      context->GetResourceAllocator()->CreateTexture(resize_desc);
+  if (!resize_texture) {
+    std::string decode_error("Could not create resized Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return absl::ResourceExhaustedError(decode_error);
+  }
+
+  blit_pass.ResizeTexture(/*source=*/dest_texture,
+                          /*destination=*/resize_texture);
+  if (resize_desc.mip_count > 1) {
+    blit_pass.GenerateMipmap(resize_texture);
+  }
+  return resize_texture;
+}
+
+/// Submits the command buffer that finishes an upload and makes sure its
+/// output becomes visible to the raster thread.
+absl::Status SubmitAndFlush(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::CommandBuffer>& command_buffer,
+    const std::shared_ptr<impeller::Texture>& result_texture) {
+  if (!context->GetCommandQueue()
+           ->Submit(
+               {command_buffer},
+               [](impeller::CommandBuffer::Status status) {
+                 if (status == impeller::CommandBuffer::Status::kError) {
+                   FML_LOG(ERROR)
+                       << "GPU Error submitting image decoding command buffer.";
+                 }
+               },
+               /*block_on_schedule=*/true)
+           .ok()) {
+    std::string decode_error("Failed to submit image decoding command buffer.");
+    FML_DLOG(ERROR) << decode_error;
+    return absl::InternalError(decode_error);
+  }
+
+  // Flush the pending command buffer to ensure that its output becomes visible
+  // to the raster thread.
+  if (context->AddTrackingFence(result_texture)) {
+    command_buffer->WaitUntilScheduled();
+  } else {
+    command_buffer->WaitUntilCompleted();
+  }
+  return absl::OkStatus();
+}
 }  // namespace
 
 std::optional<impeller::PixelFormat> ImageDecoderImpeller::ToPixelFormat(
@@ -336,7 +442,8 @@ ImageDecoderImpeller::DecompressTexture(
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
     const std::shared_ptr<const impeller::Capabilities>& capabilities,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -403,8 +510,9 @@ ImageDecoderImpeller::DecompressTexture(
     return absl::InvalidArgumentError(decode_error);
   }
 
-  absl::StatusOr<DecodedBitmap> decoded = DecodeToBitmap(
-      descriptor, image_info.value(), base_image_info, allocator);
+  absl::StatusOr<DecodedBitmap> decoded =
+      DecodeToBitmap(descriptor, image_info.value(), base_image_info,
+                     allocator, concurrent_task_runner);
   if (!decoded.ok()) {
     return decoded.status();
   }
@@ -456,20 +564,8 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
     const ImageDecoderImpeller::ImageInfo& image_info,
     const std::optional<SkImageInfo>& resize_info) {
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
-  texture_descriptor.format = image_info.format;
-  texture_descriptor.size = {image_info.size.width, image_info.size.height};
-  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
-  if (context->GetBackendType() == impeller::Context::BackendType::kMetal &&
-      resize_info.has_value()) {
-    // The MPS used to resize images on iOS does not require mip generation.
-    // Remove mip count if we are resizing the image on the GPU.
-    texture_descriptor.mip_count = 1;
-  }
-
-  auto dest_texture =
-      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  auto dest_texture = context->GetResourceAllocator()->CreateTexture(
+      MakePrivateTextureDescriptor(context, image_info, resize_info));
   if (!dest_texture) {
     std::string decode_error("Could not create Impeller texture.");
     FML_DLOG(ERROR) << decode_error;
@@ -499,69 +595,217 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
   blit_pass->SetLabel("Mipmap Blit Pass");
   blit_pass->AddCopy(impeller::DeviceBuffer::AsBufferView(buffer),
                      dest_texture);
-  if (texture_descriptor.mip_count > 1) {
-    blit_pass->GenerateMipmap(dest_texture);
-  }
-
-  std::shared_ptr<impeller::Texture> result_texture = dest_texture;
-  if (resize_info.has_value()) {
-    impeller::TextureDescriptor resize_desc;
-    resize_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
-    resize_desc.format = image_info.format;
-    resize_desc.size = {resize_info->width(), resize_info->height()};
-    resize_desc.mip_count = resize_desc.size.MipCount();
-    resize_desc.usage = impeller::TextureUsage::kShaderRead;
-    if (context->GetBackendType() == impeller::Context::BackendType::kMetal) {
-      // Resizing requires a MPS on Metal platforms.
-      resize_desc.usage |= impeller::TextureUsage::kShaderWrite;
-      resize_desc.compression_type = impeller::CompressionType::kLossless;
-    }
-    auto resize_texture =
-        context->GetResourceAllocator()->CreateTexture(resize_desc);
-    if (!resize_texture) {
-      std::string decode_error("Could not create resized Impeller texture.");
-      FML_DLOG(ERROR) << decode_error;
-      return std::make_pair(nullptr, decode_error);
-    }
-
-    blit_pass->ResizeTexture(/*source=*/dest_texture,
-                             /*destination=*/resize_texture);
-    if (resize_desc.mip_count > 1) {
-      blit_pass->GenerateMipmap(resize_texture);
-    }
 
-    result_texture = std::move(resize_texture);
+  absl::StatusOr<std::shared_ptr<impeller::Texture>> result_texture =
+      EncodeMipmapsAndResize(context, *blit_pass, dest_texture, resize_info);
+  if (!result_texture.ok()) {
+    return std::make_pair(nullptr,
+                          std::string(result_texture.status().message()));
   }
   blit_pass->EncodeCommands();
-  if (!context->GetCommandQueue()
-           ->Submit(
-               {command_buffer},
-               [](impeller::CommandBuffer::Status status) {
-                 if (status == impeller::CommandBuffer::Status::kError) {
-                   FML_LOG(ERROR)
-                       << "GPU Error submitting image decoding command buffer.";
-                 }
-               },
-               /*block_on_schedule=*/true)
-           .ok()) {
-    std::string decode_error("Failed to submit image decoding command buffer.");
+
+  absl::Status submitted =
+      SubmitAndFlush(context, command_buffer, result_texture.value());
+  if (!submitted.ok()) {
+    return std::make_pair(nullptr, std::string(submitted.message()));
+  }
+
+  context->DisposeThreadLocalCachedResources();
+
+  return std::make_pair(MakeDecodedImage(std::move(result_texture.value())),
+                        std::string());
+}
+
+// static
+std::optional<std::pair<sk_sp<DlImage>, std::string>>
+ImageDecoderImpeller::DecodeAndUploadInStrips(
+    ImageDescriptor* descriptor,
+    const ImageDecoder::Options& options,
+    bool supports_wide_gamut,
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch) {
+  // Every exit, including the ones that fall back to a full decode part way
+  // through the upload, releases the resources cached for this thread.
+  fml::ScopedCleanupClosure dispose_cached_resources(
+      [&context]() { context->DisposeThreadLocalCachedResources(); });
+  if (!descriptor->is_compressed() ||
+      options.target_format != ImageDecoder::TargetPixelFormat::kDontCare ||
+      // The I/O image uploads are not threadsafe on GLES, and decoding on the
+      // I/O thread would defeat the purpose.
+      context->GetBackendType() == impeller::Context::BackendType::kOpenGLES) {
+    return std::nullopt;
+  }
+
+  const impeller::ISize max_texture_size =
+      context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+  const SkISize source_size = SkISize::Make(descriptor->image_info().width,
+                                            descriptor->image_info().height);
+  const SkISize target_size =
+      SkISize::Make(std::min(max_texture_size.width,
+                             static_cast<int64_t>(options.target_width)),
+                    std::min(max_texture_size.height,
+                             static_cast<int64_t>(options.target_height)));
+  // Images that are resized on the CPU need the whole image at once.
+  if (source_size.width() > max_texture_size.width ||
+      source_size.height() > max_texture_size.height) {
+    return std::nullopt;
+  }
+
+  const SkISize decode_size = descriptor->get_scaled_dimensions(std::max(
+      static_cast<float>(target_size.width()) / source_size.width(),
+      static_cast<float>(target_size.height()) / source_size.height()));
+  if (decode_size != target_size &&
+      !context->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    return std::nullopt;
+  }
+
+  const absl::StatusOr<SkImageInfo> sk_image_info =
+      CreateImageInfo(ImageDescriptor::ToSkImageInfo(descriptor->image_info()),
+                      decode_size, supports_wide_gamut, options.target_format);
+  if (!sk_image_info.ok() ||
+      sk_image_info->alphaType() == kUnpremul_SkAlphaType ||
+      sk_image_info->computeMinByteSize() < kStripDecodeMinBytes ||
+      // Images this large show up sooner when decoded on several threads,
+      // even if that needs more memory.
+      descriptor->should_decode_concurrently(sk_image_info.value())) {
+    return std::nullopt;
+  }
+  const absl::StatusOr<ImageInfo> image_info =
+      ToImageInfo(sk_image_info.value());
+  if (!image_info.ok() ||
+      !descriptor->start_row_decode(sk_image_info.value())) {
+    return std::nullopt;
+  }
+
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  const std::optional<SkImageInfo> resize_info =
+      decode_size == target_size
+          ? std::nullopt
+          : std::optional<SkImageInfo>(
+                sk_image_info->makeDimensions(target_size));
+  const std::shared_ptr<impeller::Allocator>& allocator =
+      context->GetResourceAllocator();
+
+  auto dest_texture = allocator->CreateTexture(
+      MakePrivateTextureDescriptor(context, image_info.value(), resize_info));
+  if (!dest_texture) {
+    std::string decode_error("Could not create Impeller texture.");
     FML_DLOG(ERROR) << decode_error;
     return std::make_pair(nullptr, decode_error);
   }
+  dest_texture->SetLabel(
+      std::format("ui.Image({})", static_cast<const void*>(dest_texture.get()))
+          .c_str());
 
-  // Flush the pending command buffer to ensure that its output becomes visible
-  // to the raster thread.
-  if (context->AddTrackingFence(result_texture)) {
-    command_buffer->WaitUntilScheduled();
-  } else {
-    command_buffer->WaitUntilCompleted();
-  }
+  // Each strip is decoded into its own staging buffer and submitted right
+  // away. The command buffer keeps the buffer alive until the copy is done,
+  // so the next strip can be decoded while the GPU copies the last one.
+  const size_t row_bytes = sk_image_info->minRowBytes();
+  const int strip_rows =
+      std::max(1, static_cast<int>(kStripDecodeStripBytes / row_bytes));
+  const int height = sk_image_info->height();
+  for (int y = 0; y < height; y += strip_rows) {
+    const int rows = std::min(strip_rows, height - y);
+
+    impeller::DeviceBufferDescriptor buffer_desc;
+    buffer_desc.storage_mode = impeller::StorageMode::kHostVisible;
+    buffer_desc.size = rows * row_bytes;
+    std::shared_ptr<impeller::DeviceBuffer> buffer =
+        allocator->CreateBuffer(buffer_desc);
+    if (!buffer) {
+      std::string decode_error(
+          "Could not allocate intermediate for image decompression.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
 
-  context->DisposeThreadLocalCachedResources();
+    const SkPixmap strip(sk_image_info->makeWH(sk_image_info->width(), rows),
+                         buffer->OnGetContents(), row_bytes);
+    if (descriptor->decode_rows(strip) != rows) {
+      std::string decode_error("Could not decompress image.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    buffer->Flush();
+
+    auto command_buffer = context->CreateCommandBuffer();
+    if (!command_buffer) {
+      std::string decode_error("Could not create command buffer for upload.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    command_buffer->SetLabel("Image Strip Command Buffer");
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass) {
+      std::string decode_error("Could not create blit pass for upload.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    blit_pass->AddCopy(
+        impeller::DeviceBuffer::AsBufferView(buffer), dest_texture,
+        impeller::IRect::MakeXYWH(0, y, sk_image_info->width(), rows));
+    blit_pass->EncodeCommands();
+
+    bool submitted = false;
+    gpu_disabled_switch->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([&] {
+          submitted =
+              context->GetCommandQueue()
+                  ->Submit({command_buffer},
+                           [](impeller::CommandBuffer::Status status) {
+                             if (status ==
+                                 impeller::CommandBuffer::Status::kError) {
+                               FML_LOG(ERROR) << "GPU Error submitting image "
+                                                 "strip command buffer.";
+                             }
+                           })
+                  .ok();
+        }));
+    if (!submitted) {
+      // The GPU went away part way through. Start over with a full decode
+      // that can be uploaded once it comes back.
+      return std::nullopt;
+    }
+  }
 
-  return std::make_pair(
-      impeller::DlImageImpeller::Make(std::move(result_texture)),
-      std::string());
+  std::optional<std::pair<sk_sp<DlImage>, std::string>> result;
+  gpu_disabled_switch->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto command_buffer = context->CreateCommandBuffer();
+        if (!command_buffer) {
+          result = std::make_pair(
+              nullptr,
+              "Could not create command buffer for mipmap generation.");
+          return;
+        }
+        command_buffer->SetLabel("Mipmap Command Buffer");
+        auto blit_pass = command_buffer->CreateBlitPass();
+        if (!blit_pass) {
+          result = std::make_pair(
+              nullptr, "Could not create blit pass for mipmap generation.");
+          return;
+        }
+        blit_pass->SetLabel("Mipmap Blit Pass");
+        absl::StatusOr<std::shared_ptr<impeller::Texture>> result_texture =
+            EncodeMipmapsAndResize(context, *blit_pass, dest_texture,
+                                   resize_info);
+        if (!result_texture.ok()) {
+          result = std::make_pair(
+              nullptr, std::string(result_texture.status().message()));
+          return;
+        }
+        blit_pass->EncodeCommands();
+        absl::Status submitted =
+            SubmitAndFlush(context, command_buffer, result_texture.value());
+        if (!submitted.ok()) {
+          result = std::make_pair(nullptr, std::string(submitted.message()));
+          return;
+        }
+        result = std::make_pair(
+            MakeDecodedImage(std::move(result_texture.value())), std::string());
+      }));
+  // A nullopt result means the GPU went away after the last strip.
+  return result;
 }
 
 void ImageDecoderImpeller::UploadTextureToPrivate(
@@ -662,8 +906,7 @@ ImageDecoderImpeller::UploadTextureToStorage(
 
   context->DisposeThreadLocalCachedResources();
 
-  return std::make_pair(impeller::DlImageImpeller::Make(std::move(texture)),
-                        std::string());
+  return std::make_pair(MakeDecodedImage(std::move(texture)), std::string());
 }
 
 // |ImageDecoder|
@@ -691,6 +934,7 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        context = context_.get(),  //
        options,
        io_runner = runners_.GetIOTaskRunner(),  //
+       concurrent_task_runner = concurrent_task_runner_,
        result,
        wide_gamut_enabled = wide_gamut_enabled_,  //
        gpu_disabled_switch = gpu_disabled_switch_]() {
@@ -707,13 +951,25 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         }
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+        const bool supports_wide_gamut =
+            wide_gamut_enabled &&
+            context->GetCapabilities()->SupportsExtendedRangeFormats();
+
+        // Large images are uploaded as they are decoded where possible.
+        std::optional<std::pair<sk_sp<DlImage>, std::string>> streamed =
+            DecodeAndUploadInStrips(raw_descriptor, options,
+                                    supports_wide_gamut, context,
+                                    gpu_disabled_switch);
+        if (streamed.has_value()) {
+          result(streamed->first, streamed->second);
+          return;
+        }
 
         // Always decompress on the concurrent runner.
         auto bitmap_result = DecompressTexture(
-            raw_descriptor, options, max_size_supported,
-            /*supports_wide_gamut=*/wide_gamut_enabled &&
-                context->GetCapabilities()->SupportsExtendedRangeFormats(),
-            context->GetCapabilities(), context->GetResourceAllocator());
+            raw_descriptor, options, max_size_supported, supports_wide_gamut,
+            context->GetCapabilities(), context->GetResourceAllocator(),
+            concurrent_task_runner);
         if (!bitmap_result.ok()) {
           result(nullptr, std::string(bitmap_result.status().message()));
           return;
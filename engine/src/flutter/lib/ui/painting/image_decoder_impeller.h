@@ -51,6 +51,13 @@ class ImageDecoderImpeller final : public ImageDecoder {
 
   ~ImageDecoderImpeller() override;
 
+  /// Images that take up at least this many bytes once decoded are decoded a
+  /// strip of rows at a time, see `DecodeAndUploadInStrips`.
+  static constexpr size_t kStripDecodeMinBytes = 4 * 1024 * 1024;
+
+  /// The number of bytes of decoded pixels in each strip.
+  static constexpr size_t kStripDecodeStripBytes = 256 * 1024;
+
   static std::optional<impeller::PixelFormat> ToPixelFormat(SkColorType type);
 
   // |ImageDecoder|
@@ -75,7 +82,9 @@ class ImageDecoderImpeller final : public ImageDecoder {
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
       const std::shared_ptr<const impeller::Capabilities>& capabilities,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner =
+          nullptr);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///
@@ -94,6 +103,30 @@ class ImageDecoderImpeller final : public ImageDecoder {
       const std::optional<SkImageInfo>& resize_info,
       const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch);
 
+  /// @brief Decode the image a strip of rows at a time and upload each strip
+  ///        into a device private texture as soon as it is decoded.
+  ///
+  ///        This overlaps decoding with the upload and bounds the host memory
+  ///        used to a few strips instead of the whole image. Only large
+  ///        images that the generator can decode in row order are handled.
+  ///
+  /// @param descriptor          The image to decode.
+  /// @param options             The decode options.
+  /// @param supports_wide_gamut Whether wide gamut images can be decoded into
+  ///                            extended range formats.
+  /// @param context             The Impeller graphics context.
+  /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @return The image or an error message, or `std::nullopt` if the image
+  ///         has to go through `DecompressTexture` and
+  ///         `UploadTextureToPrivate` instead.
+  static std::optional<std::pair<sk_sp<DlImage>, std::string>>
+  DecodeAndUploadInStrips(
+      ImageDescriptor* descriptor,
+      const ImageDecoder::Options& options,
+      bool supports_wide_gamut,
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch);
+
   /// @brief Create a texture from the provided bitmap.
   /// @param context     The Impeller graphics context.
   /// @param bitmap      A bitmap containg the image to be uploaded.
@@ -104,18 +104,35 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     ImageDescriptor* descriptor,
     uint32_t target_width,
     uint32_t target_height,
-    const fml::tracing::TraceFlow& flow) {
+    const fml::tracing::TraceFlow& flow,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
 
+  const SkImageInfo image_info =
+      ImageDescriptor::ToSkImageInfo(descriptor->image_info());
+
   if (!descriptor->should_resize(target_width, target_height)) {
     // No resizing requested. Just decode & rasterize the image.
+    if (concurrent_task_runner &&
+        descriptor->should_decode_concurrently(image_info)) {
+      SkBitmap bitmap;
+      if (!bitmap.tryAllocPixels(image_info)) {
+        FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                       << image_info.computeMinByteSize() << "B";
+        return nullptr;
+      }
+      if (!descriptor->get_pixels(bitmap.pixmap(), concurrent_task_runner)) {
+        FML_LOG(ERROR) << "Could not decompress image.";
+        return nullptr;
+      }
+      bitmap.setImmutable();
+      return SkImages::RasterFromBitmap(bitmap);
+    }
     sk_sp<SkImage> image = descriptor->image();
     return image ? image->makeRasterImage(nullptr) : nullptr;
   }
 
-  const SkImageInfo image_info =
-      ImageDescriptor::ToSkImageInfo(descriptor->image_info());
   const SkISize source_dimensions = image_info.dimensions();
   const SkISize resized_dimensions = {static_cast<int32_t>(target_width),
                                       static_cast<int32_t>(target_height)};
@@ -139,7 +156,7 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     }
 
     const auto& pixmap = scaled_bitmap.pixmap();
-    if (descriptor->get_pixels(pixmap)) {
+    if (descriptor->get_pixels(pixmap, concurrent_task_runner)) {
       // Marking this as immutable makes the MakeFromBitmap call share
       // the pixels instead of copying.
       scaled_bitmap.setImmutable();
@@ -271,6 +288,7 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
       fml::MakeCopyable([raw_descriptor,                          //
                          io_manager = io_manager_,                //
                          io_runner = runners_.GetIOTaskRunner(),  //
+                         concurrent_task_runner = concurrent_task_runner_,
                          result,                                  //
                          target_width = options.target_width,     //
                          target_height = options.target_height,   //
@@ -279,15 +297,18 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
+        auto decompressed =
+            raw_descriptor->is_compressed()
+                ? ImageFromCompressedData(raw_descriptor,         //
+                                          target_width,           //
+                                          target_height,          //
+                                          flow,                   //
+                                          concurrent_task_runner  //
+                                          )
+                : ImageFromDecompressedData(raw_descriptor,  //
+                                            target_width,    //
+                                            target_height,   //
+                                            flow);
 
         if (!decompressed) {
           FML_DLOG(ERROR) << "Could not decompress image.";
@@ -29,6 +29,7 @@
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
 #include "third_party/skia/include/codec/SkJpegDecoder.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -951,6 +952,77 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   ASSERT_EQ(200, image->height());
 }
 
+TEST(ImageDecoderTest, DecodingRowsMatchesDecodingTheWholeImage) {
+  auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  const SkImageInfo info = generator->GetInfo();
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(info));
+  ASSERT_TRUE(generator->GetPixels(info, expected.getPixels(),
+                                   expected.rowBytes()));
+
+  SkBitmap actual;
+  ASSERT_TRUE(actual.tryAllocPixels(info));
+  ASSERT_TRUE(generator->StartRowDecode(info));
+  // Use a strip height that doesn't divide the image height.
+  const int strip_rows = 64;
+  for (int y = 0; y < info.height(); y += strip_rows) {
+    const int rows = std::min(strip_rows, info.height() - y);
+    ASSERT_EQ(generator->DecodeRows(actual.getAddr(0, y), actual.rowBytes(),
+                                    rows),
+              rows);
+  }
+
+  EXPECT_EQ(memcmp(expected.getPixels(), actual.getPixels(),
+                   info.computeByteSize(expected.rowBytes())),
+            0);
+}
+
+TEST(ImageDecoderTest, ConcurrentDecodeMatchesDecodingOnOneThread) {
+  auto data = flutter::testing::OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+
+  const SkImageInfo info =
+      ImageDescriptor::ToSkImageInfo(descriptor->image_info());
+  ASSERT_TRUE(descriptor->should_decode_concurrently(info));
+
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(info));
+  ASSERT_TRUE(descriptor->get_pixels(expected.pixmap()));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  SkBitmap actual;
+  ASSERT_TRUE(actual.tryAllocPixels(info));
+  ASSERT_TRUE(descriptor->get_pixels(actual.pixmap(), loop->GetTaskRunner()));
+
+  EXPECT_EQ(memcmp(expected.getPixels(), actual.getPixels(),
+                   info.computeByteSize(expected.rowBytes())),
+            0);
+}
+
+TEST(ImageDecoderTest, RowDecodingIsNotUsedForRotatedImages) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  // The EXIF orientation means rows can't be handed out as they're decoded.
+  EXPECT_FALSE(generator->StartRowDecode(generator->GetInfo()));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
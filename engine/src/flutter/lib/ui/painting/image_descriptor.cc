@@ -4,8 +4,12 @@
 
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
@@ -212,10 +216,98 @@ sk_sp<SkImage> ImageDescriptor::image() const {
   return generator_->GetImage();
 }
 
-bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
+namespace {
+
+// The most bands an image is split into, and the fewest rows in each.
+constexpr int kMaxConcurrentDecodeBands = 8;
+constexpr int kMinConcurrentDecodeBandRows = 256;
+
+// Shared by all the threads decoding bands of one image. Threads claim bands
+// until there are none left, so tasks that only get to run after all bands
+// are done just return.
+struct ConcurrentDecode {
+  ConcurrentDecode(std::shared_ptr<ImageGenerator> p_generator,
+                   const SkPixmap& p_pixmap,
+                   int p_band_rows,
+                   int p_band_count)
+      : generator(std::move(p_generator)),
+        pixmap(p_pixmap),
+        band_rows(p_band_rows),
+        band_count(p_band_count),
+        latch(p_band_count) {}
+
+  const std::shared_ptr<ImageGenerator> generator;
+  const SkPixmap pixmap;
+  const int band_rows;
+  const int band_count;
+  std::atomic_int next_band = 0;
+  std::atomic_bool failed = false;
+  fml::CountDownLatch latch;
+
+  void DecodeBands() {
+    for (int band = next_band++; band < band_count; band = next_band++) {
+      const int first_row = band * band_rows;
+      const int row_count = std::min(band_rows, pixmap.height() - first_row);
+      if (!failed &&
+          !generator->GetPixelRows(pixmap.info(),
+                                   pixmap.writable_addr(0, first_row),
+                                   pixmap.rowBytes(), first_row, row_count)) {
+        failed = true;
+      }
+      latch.CountDown();
+    }
+  }
+};
+
+}  // namespace
+
+bool ImageDescriptor::get_pixels(
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner)
+    const {
+  FML_DCHECK(generator_);
+  if (!concurrent_task_runner || !should_decode_concurrently(pixmap.info())) {
+    return generator_->GetPixels(pixmap.info(), pixmap.writable_addr(),
+                                 pixmap.rowBytes());
+  }
+  TRACE_EVENT0("flutter", "ImageDescriptor::DecodeConcurrently");
+
+  const int height = pixmap.height();
+  const int band_count = std::clamp(height / kMinConcurrentDecodeBandRows, 1,
+                                    kMaxConcurrentDecodeBands);
+  constexpr int kAlignment = ImageGenerator::kConcurrentRowAlignment;
+  const int band_rows =
+      ((height + band_count - 1) / band_count + kAlignment - 1) / kAlignment *
+      kAlignment;
+  auto decode = std::make_shared<ConcurrentDecode>(
+      generator_, pixmap, band_rows, (height + band_rows - 1) / band_rows);
+
+  for (int i = 1; i < decode->band_count; i++) {
+    concurrent_task_runner->PostTask([decode]() { decode->DecodeBands(); });
+  }
+  decode->DecodeBands();
+  decode->latch.Wait();
+  return !decode->failed;
+}
+
+bool ImageDescriptor::should_decode_concurrently(
+    const SkImageInfo& info) const {
+  return generator_ &&
+         static_cast<int64_t>(info.width()) * info.height() >=
+             kConcurrentDecodeMinPixels &&
+         info.height() >= 2 * kMinConcurrentDecodeBandRows &&
+         generator_->SupportsConcurrentRowDecode(info);
+}
+
+bool ImageDescriptor::start_row_decode(const SkImageInfo& info) const {
+  FML_DCHECK(generator_);
+  return generator_->StartRowDecode(info);
+}
+
+int ImageDescriptor::decode_rows(const SkPixmap& pixmap) const {
   FML_DCHECK(generator_);
-  return generator_->GetPixels(pixmap.info(), pixmap.writable_addr(),
-                               pixmap.rowBytes());
+  return generator_->DecodeRows(pixmap.writable_addr(), pixmap.rowBytes(),
+                                pixmap.height());
 }
 
 int ImageDescriptor::bytesPerPixel() const {
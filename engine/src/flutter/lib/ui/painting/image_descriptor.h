@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
@@ -124,7 +125,32 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
 
   /// @brief  Gets pixels for this image transformed based on the EXIF
   ///         orientation tag, if applicable.
-  bool get_pixels(const SkPixmap& pixmap) const;
+  ///
+  ///         If a concurrent task runner is given and
+  ///         `should_decode_concurrently` is true for the pixmap, the image is
+  ///         split into bands of rows that are decoded in parallel on it. The
+  ///         calling thread decodes bands too, so this is safe to call from a
+  ///         task on the same runner.
+  bool get_pixels(const SkPixmap& pixmap,
+                  const std::shared_ptr<fml::ConcurrentTaskRunner>&
+                      concurrent_task_runner = nullptr) const;
+
+  /// @brief  Whether `get_pixels` decodes an image with the given info on
+  ///         several threads when given a concurrent task runner.
+  bool should_decode_concurrently(const SkImageInfo& info) const;
+
+  /// Images with fewer pixels than this are always decoded on one thread.
+  static constexpr int64_t kConcurrentDecodeMinPixels = 8 * 1024 * 1024;
+
+  /// @brief  Starts decoding the image a few rows at a time with
+  ///         `decode_rows`. Returns false if the generator can't do that for
+  ///         the given info.
+  /// @see    `ImageGenerator::StartRowDecode`
+  bool start_row_decode(const SkImageInfo& info) const;
+
+  /// @brief  Decodes the next `pixmap.height()` rows of the image into the
+  ///         pixmap. Returns the number of rows that were decoded.
+  int decode_rows(const SkPixmap& pixmap) const;
 
   void dispose() {
     buffer_.reset();
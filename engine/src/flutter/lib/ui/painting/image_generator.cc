@@ -35,6 +35,27 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+bool ImageGenerator::StartRowDecode(const SkImageInfo& info) {
+  return false;
+}
+
+int ImageGenerator::DecodeRows(void* pixels, size_t row_bytes, int row_count) {
+  return 0;
+}
+
+bool ImageGenerator::SupportsConcurrentRowDecode(
+    const SkImageInfo& info) const {
+  return false;
+}
+
+bool ImageGenerator::GetPixelRows(const SkImageInfo& info,
+                                  void* pixels,
+                                  size_t row_bytes,
+                                  int first_row,
+                                  int row_count) {
+  return false;
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -103,7 +124,15 @@ BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     sk_sp<SkData> buffer)
-    : codec_(SkCodec::MakeFromData(std::move(buffer)).release()) {
+    : codec_(SkCodec::MakeFromData(buffer).release()),
+      data_(std::move(buffer)) {
+  image_info_ = getInfoIncludingExif(codec_.get());
+}
+
+BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
+    std::unique_ptr<SkCodec> codec,
+    sk_sp<SkData> buffer)
+    : codec_(std::move(codec)), data_(std::move(buffer)) {
   image_info_ = getInfoIncludingExif(codec_.get());
 }
 
@@ -188,13 +217,92 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::StartRowDecode(const SkImageInfo& info) {
+  // Rows can only be handed out as they are decoded if they don't need to be
+  // re-oriented afterwards.
+  if (codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getFrameCount() > 1) {
+    return false;
+  }
+  // Codecs without a scanline decoder, like GIF and WebP, return
+  // kUnimplemented here.
+  SkCodec::Result result = codec_->startScanlineDecode(info);
+  if (result != SkCodec::kSuccess) {
+    return false;
+  }
+  return codec_->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder;
+}
+
+int BuiltinSkiaCodecImageGenerator::DecodeRows(void* pixels,
+                                               size_t row_bytes,
+                                               int row_count) {
+  return codec_->getScanlines(pixels, row_count, row_bytes);
+}
+
+bool BuiltinSkiaCodecImageGenerator::SupportsConcurrentRowDecode(
+    const SkImageInfo& info) const {
+  if (!data_ || codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getFrameCount() > 1) {
+    return false;
+  }
+  switch (codec_->getEncodedFormat()) {
+    case SkEncodedImageFormat::kJPEG:
+      // Rows above the range are skipped without running the inverse DCT or
+      // color conversion, which is where most of the time goes.
+      return true;
+    case SkEncodedImageFormat::kWEBP:
+      // WebP decodes subsets directly, but not scaled ones.
+      return info.dimensions() == codec_->dimensions();
+    default:
+      // Skipping rows of other formats costs as much as decoding them.
+      return false;
+  }
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetPixelRows(const SkImageInfo& info,
+                                                  void* pixels,
+                                                  size_t row_bytes,
+                                                  int first_row,
+                                                  int row_count) {
+  FML_DCHECK(first_row % kConcurrentRowAlignment == 0);
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data_);
+  if (!codec) {
+    return false;
+  }
+
+  SkCodec::Result result;
+  if (codec->getEncodedFormat() == SkEncodedImageFormat::kWEBP) {
+    const SkIRect subset =
+        SkIRect::MakeXYWH(0, first_row, info.width(), row_count);
+    SkCodec::Options options;
+    options.fSubset = &subset;
+    result = codec->getPixels(info.makeWH(info.width(), row_count), pixels,
+                              row_bytes, &options);
+  } else {
+    result = codec->startScanlineDecode(info);
+    if (result == SkCodec::kSuccess) {
+      if (!codec->skipScanlines(first_row) ||
+          codec->getScanlines(pixels, row_count, row_bytes) != row_count) {
+        result = SkCodec::kIncompleteInput;
+      }
+    }
+  }
+  if (result != SkCodec::kSuccess) {
+    FML_DLOG(WARNING) << "codec could not get pixel rows. "
+                      << SkCodec::ResultToString(result);
+    return false;
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
-  auto codec = SkCodec::MakeFromData(std::move(data));
+  auto codec = SkCodec::MakeFromData(data);
   if (!codec) {
     return nullptr;
   }
-  return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
+  return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec),
+                                                          std::move(data));
 }
 
 }  // namespace flutter
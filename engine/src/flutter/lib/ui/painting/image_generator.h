@@ -135,6 +135,61 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Prepare to decode the first frame of the image from top to
+  ///             bottom a few rows at a time with `DecodeRows`. This lets
+  ///             callers hand off parts of the image as soon as they are
+  ///             decoded without holding on to the whole image.
+  /// @param[in]  info  The desired size and color info of the decoded image,
+  ///                   as with `GetPixels`.
+  /// @return     True if the generator can decode rows in order for the given
+  ///             info. The default implementation doesn't support this.
+  /// @note       A call to `GetPixels` abandons a row decode in progress.
+  /// @see        `DecodeRows`
+  virtual bool StartRowDecode(const SkImageInfo& info);
+
+  /// @brief      Decode the next rows of an image after `StartRowDecode`.
+  /// @param[in]  pixels     The location where the decoded rows should be
+  ///                        written.
+  /// @param[in]  row_bytes  The number of bytes between the start of two rows
+  ///                        in `pixels`.
+  /// @param[in]  row_count  The number of rows to decode.
+  /// @return     The number of rows that were decoded. Anything less than
+  ///             `row_count` means the data was invalid or incomplete.
+  /// @note       Like `GetPixels`, this should never be called on the UI
+  ///             thread.
+  virtual int DecodeRows(void* pixels, size_t row_bytes, int row_count);
+
+  /// @brief      Whether `GetPixelRows` can be used to decode the first frame
+  ///             of the image with the given info.
+  /// @return     False unless the generator can decode separate ranges of rows
+  ///             independently and from several threads at once. The default
+  ///             implementation doesn't support this.
+  /// @see        `GetPixelRows`
+  virtual bool SupportsConcurrentRowDecode(const SkImageInfo& info) const;
+
+  /// @brief      Decode a range of rows of the first frame of the image. Unlike
+  ///             every other method, this may be called from several threads
+  ///             at once once `SupportsConcurrentRowDecode` returned true.
+  /// @param[in]  info       The size and color info of the whole decoded image,
+  ///                        as with `GetPixels`.
+  /// @param[in]  pixels     The location where the first row of the range
+  ///                        should be written.
+  /// @param[in]  row_bytes  The number of bytes between the start of two rows
+  ///                        in `pixels`.
+  /// @param[in]  first_row  The first row to decode. Must be a multiple of
+  ///                        `kConcurrentRowAlignment`.
+  /// @param[in]  row_count  The number of rows to decode.
+  /// @return     True if the rows were successfully decoded.
+  virtual bool GetPixelRows(const SkImageInfo& info,
+                            void* pixels,
+                            size_t row_bytes,
+                            int first_row,
+                            int row_count);
+
+  /// The alignment of the rows ranges passed to `GetPixelRows`. This matches
+  /// the largest JPEG MCU height and keeps WebP subsets on even rows.
+  static constexpr int kConcurrentRowAlignment = 16;
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -188,6 +243,9 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
 
   explicit BuiltinSkiaCodecImageGenerator(sk_sp<SkData> buffer);
 
+  BuiltinSkiaCodecImageGenerator(std::unique_ptr<SkCodec> codec,
+                                 sk_sp<SkData> buffer);
+
   // |ImageGenerator|
   const SkImageInfo& GetInfo() override;
 
@@ -212,12 +270,31 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool StartRowDecode(const SkImageInfo& info) override;
+
+  // |ImageGenerator|
+  int DecodeRows(void* pixels, size_t row_bytes, int row_count) override;
+
+  // |ImageGenerator|
+  bool SupportsConcurrentRowDecode(const SkImageInfo& info) const override;
+
+  // |ImageGenerator|
+  bool GetPixelRows(const SkImageInfo& info,
+                    void* pixels,
+                    size_t row_bytes,
+                    int first_row,
+                    int row_count) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
   std::unique_ptr<SkCodec> codec_;
   SkImageInfo image_info_;
+  // The encoded data, if known. Concurrent row decodes each create their own
+  // codec from it since codecs are not thread safe.
+  sk_sp<SkData> data_;
 };
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 
 #include <cstring>
+#include <string>
 
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
@@ -108,8 +109,7 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping != nullptr) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -171,16 +171,8 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   dart_state->GetConcurrentTaskRunner()->PostTask(
       [file_path = std::move(file_path),
        ui_task_runner = std::move(ui_task_runner), ui_task] {
-        auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
-            file_path.c_str(), false, fml::FilePermission::kRead));
-
-        sk_sp<SkData> sk_data;
-        size_t buffer_size = 0;
-        if (mapping->IsValid()) {
-          buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
-        }
+        sk_sp<SkData> sk_data = MakeSkDataFromFile(file_path);
+        size_t buffer_size = sk_data ? sk_data->size() : 0;
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
               ui_task(sk_data, buffer_size);
@@ -189,6 +181,45 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromFile(
+    const std::string& file_path) {
+  fml::FileMapping mapping(
+      fml::OpenFile(file_path.c_str(), false, fml::FilePermission::kRead));
+  if (!mapping.IsValid()) {
+    return nullptr;
+  }
+  // An arbitrary file may be written to or truncated by someone else while
+  // the buffer is alive. Private read-only pages that haven't been touched
+  // still reflect such writes and truncation turns accesses into SIGBUS, so
+  // the contents are always copied out of the mapping.
+  return MakeSkDataWithCopy(mapping.GetMapping(), mapping.GetSize());
+}
+
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping->GetSize() == 0) {
+    return SkData::MakeEmpty();
+  }
+
+  // Asset mappings that are safe to madvise(DONTNEED) are read-only views of
+  // files the application ships with (or of the binary itself). Nothing
+  // writes to them while the engine is running and the kernel can page them
+  // back in on demand, so the SkData can just take ownership of the mapping
+  // instead of copying what may be several megabytes of image data. Anything
+  // else may be backed by memory we don't control the lifetime or mutability
+  // of, so it is copied.
+  if (!mapping->IsDontNeedSafe()) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), mapping->GetSize());
+  }
+
+  fml::Mapping* mapping_ptr = mapping.release();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(mapping_ptr->GetMapping(),
+                              mapping_ptr->GetSize(), proc, mapping_ptr);
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
@@ -6,8 +6,11 @@
 #define FLUTTER_LIB_UI_PAINTING_IMMUTABLE_BUFFER_H_
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -16,6 +19,14 @@
 
 namespace flutter {
 
+namespace testing {
+FML_TEST_CLASS(ImmutableBufferTest, CopiesFileContents);
+FML_TEST_CLASS(ImmutableBufferTest, CopiesEmptyFiles);
+FML_TEST_CLASS(ImmutableBufferTest, WrapsReadOnlyMappingsWithoutCopying);
+FML_TEST_CLASS(ImmutableBufferTest, CopiesMutableMappings);
+FML_TEST_CLASS(ImmutableBufferTest, WrapsEmptyMappings);
+}  // namespace testing
+
 //------------------------------------------------------------------------------
 /// A simple opaque handle to an immutable byte buffer suitable for use
 /// internally by the engine.
@@ -96,6 +107,23 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  // Copies the contents of the file at |file_path|, which the engine doesn't
+  // own and which may change while the buffer is alive. Returns nullptr if
+  // the file can't be opened.
+  static sk_sp<SkData> MakeSkDataFromFile(const std::string& file_path);
+
+  // Wraps read-only asset and symbol mappings without copying them and
+  // copies everything else.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
+  FML_FRIEND_TEST(testing::ImmutableBufferTest, CopiesFileContents);
+  FML_FRIEND_TEST(testing::ImmutableBufferTest, CopiesEmptyFiles);
+  FML_FRIEND_TEST(testing::ImmutableBufferTest,
+                  WrapsReadOnlyMappingsWithoutCopying);
+  FML_FRIEND_TEST(testing::ImmutableBufferTest, CopiesMutableMappings);
+  FML_FRIEND_TEST(testing::ImmutableBufferTest, WrapsEmptyMappings);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
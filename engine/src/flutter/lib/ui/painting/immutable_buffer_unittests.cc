@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::string WriteFile(const fml::ScopedTemporaryDirectory& dir,
+                      const std::string& name,
+                      const std::string& contents) {
+  std::string path = fml::paths::JoinPaths({dir.path(), name});
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  stream << contents;
+  return path;
+}
+
+}  // namespace
+
+TEST(ImmutableBufferTest, CopiesFileContents) {
+  fml::ScopedTemporaryDirectory dir;
+  std::string path = WriteFile(dir, "image.bin", "original contents");
+
+  sk_sp<SkData> data = ImmutableBuffer::MakeSkDataFromFile(path);
+  ASSERT_TRUE(data);
+  ASSERT_EQ(data->size(), 17u);
+
+  // Rewriting and truncating the file in place must neither change the
+  // buffer nor fault when it is read.
+  WriteFile(dir, "image.bin", "new");
+  EXPECT_EQ(std::memcmp(data->data(), "original contents", 17u), 0);
+
+  EXPECT_FALSE(ImmutableBuffer::MakeSkDataFromFile(
+      fml::paths::JoinPaths({dir.path(), "missing.bin"})));
+}
+
+TEST(ImmutableBufferTest, CopiesEmptyFiles) {
+  fml::ScopedTemporaryDirectory dir;
+  std::string path = WriteFile(dir, "empty.bin", "");
+
+  sk_sp<SkData> data = ImmutableBuffer::MakeSkDataFromFile(path);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->size(), 0u);
+}
+
+TEST(ImmutableBufferTest, WrapsReadOnlyMappingsWithoutCopying) {
+  static const uint8_t kBytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto mapping = std::make_unique<fml::NonOwnedMapping>(
+      kBytes, sizeof(kBytes), nullptr, /*dontneed_safe=*/true);
+
+  sk_sp<SkData> data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->size(), sizeof(kBytes));
+  EXPECT_EQ(data->data(), kBytes);
+}
+
+TEST(ImmutableBufferTest, CopiesMutableMappings) {
+  static const uint8_t kBytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto mapping = std::make_unique<fml::NonOwnedMapping>(
+      kBytes, sizeof(kBytes), nullptr, /*dontneed_safe=*/false);
+
+  sk_sp<SkData> data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_TRUE(data);
+  ASSERT_EQ(data->size(), sizeof(kBytes));
+  EXPECT_NE(data->data(), kBytes);
+  EXPECT_EQ(std::memcmp(data->data(), kBytes, sizeof(kBytes)), 0);
+}
+
+TEST(ImmutableBufferTest, WrapsEmptyMappings) {
+  auto mapping = std::make_unique<fml::NonOwnedMapping>(
+      nullptr, 0u, nullptr, /*dontneed_safe=*/true);
+
+  sk_sp<SkData> data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,10 +4,12 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "display_list/image/dl_image.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -24,18 +26,48 @@
 namespace flutter {
 
 MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+    : MultiFrameCodec(std::move(generator), Options{}) {}
+
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 Options options)
+    : state_(new State(std::move(generator),
+                       options,
+                       UIDartState::Current()->IsImpellerEnabled(),
+                       UIDartState::Current()->GetConcurrentTaskRunner())) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+MultiFrameCodec::State::State(
+    std::shared_ptr<ImageGenerator> generator,
+    Options options,
+    bool is_impeller_enabled,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
+      options_(options),
+      frameByteSize_(generator_->GetInfo()
+                         .makeColorType(kN32_SkColorType)
+                         .computeMinByteSize()),
+      lookaheadFrames_(
+          options_.lookahead_frames <= 0 || frameByteSize_ == 0
+              ? 0
+              : std::min(static_cast<size_t>(options_.lookahead_frames),
+                         options_.lookahead_bytes / frameByteSize_)),
+      is_impeller_enabled_(is_impeller_enabled),
+      concurrent_task_runner_(std::move(concurrent_task_runner)),
+      // Only animations that loop are worth keeping around.
+      cache_frames_(repetitionCount_ != 0 && frameCount_ > 0 &&
+                    options_.frame_cache_bytes > 0 &&
+                    frameByteSize_ * frameCount_ <=
+                        options_.frame_cache_bytes) {
+  if (cache_frames_) {
+    cachedFrames_.resize(frameCount_);
+  }
+}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -55,12 +87,13 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    const fml::WeakPtr<GrDirectContext>& resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  DecodedFrame frame;
+  frame.index = nextDecodeIndex_;
+  nextDecodeIndex_ = (nextDecodeIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -71,13 +104,12 @@ MultiFrameCodec::State::GetNextFrameImage(
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.error = ostr.str();
+    FML_LOG(ERROR) << frame.error;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame.index);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -88,7 +120,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frame.index << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -104,12 +136,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frame.index, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frame.index;
+    frame.error = ostr.str();
+    FML_LOG(ERROR) << frame.error;
+    return frame;
   }
 
   const bool keep_current_frame =
@@ -134,7 +166,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frame.index;
   }
 
   if (frameInfo.disposal_method ==
@@ -144,6 +176,75 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  frame.bitmap = std::move(bitmap);
+  return frame;
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeDecodedFrame(
+    int index) {
+  std::scoped_lock lock(decode_mutex_);
+  while (!decodedFrames_.empty()) {
+    DecodedFrame frame = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+    if (frame.index == index) {
+      return frame;
+    }
+  }
+  // Frames may depend on the ones before them, so the generator can't skip
+  // ahead. This only happens if frames were served from the cache.
+  while (nextDecodeIndex_ != index) {
+    DecodeNextFrame();
+  }
+  return DecodeNextFrame();
+}
+
+void MultiFrameCodec::State::ScheduleLookahead() {
+  if (lookaheadFrames_ == 0 || !concurrent_task_runner_ || allFramesCached_) {
+    return;
+  }
+  {
+    std::scoped_lock lock(decode_mutex_);
+    if (lookaheadPending_ || decodedFrames_.size() >= lookaheadFrames_) {
+      return;
+    }
+    lookaheadPending_ = true;
+  }
+  concurrent_task_runner_->PostTask([weak_state = weak_from_this()]() {
+    if (auto state = weak_state.lock()) {
+      state->DecodeAhead();
+    }
+  });
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  while (true) {
+    // The lock is released between frames so that the IO thread never waits
+    // on more than one of them.
+    std::scoped_lock lock(decode_mutex_);
+    if (allFramesCached_ || decodedFrames_.size() >= lookaheadFrames_) {
+      lookaheadPending_ = false;
+      return;
+    }
+    DecodedFrame frame = DecodeNextFrame();
+    // The IO thread may have cached the last frame while this one was being
+    // decoded. Nothing will take it then.
+    if (allFramesCached_) {
+      lookaheadPending_ = false;
+      return;
+    }
+    decodedFrames_.push_back(std::move(frame));
+  }
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    SkBitmap bitmap,
+    const fml::WeakPtr<GrDirectContext>& resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+  const SkImageInfo& info = bitmap.info();
+
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
 #ifdef FML_OS_IOS
@@ -222,6 +323,44 @@ MultiFrameCodec::State::GetNextFrameImage(
 #endif  //  !SLIMPELLER
 }
 
+std::pair<sk_sp<DlImage>, std::string>
+MultiFrameCodec::State::GetNextFrameImage(
+    const fml::WeakPtr<GrDirectContext>& resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+  if (cache_frames_ && cachedFrames_[nextFrameIndex_]) {
+    return std::make_pair(cachedFrames_[nextFrameIndex_], std::string());
+  }
+
+  DecodedFrame frame = TakeDecodedFrame(nextFrameIndex_);
+  // Decode the following frames while this one is uploaded and shown.
+  ScheduleLookahead();
+  if (!frame.bitmap.has_value()) {
+    return std::make_pair(nullptr, std::move(frame.error));
+  }
+
+  auto result =
+      UploadFrame(std::move(frame.bitmap.value()), resourceContext,
+                  gpu_disable_sync_switch, impeller_context, unref_queue);
+  if (cache_frames_ && result.first) {
+    cachedFrames_[nextFrameIndex_] = result.first;
+    cachedFrameCount_++;
+    if (cachedFrameCount_ == frameCount_) {
+      // Nothing needs to be decoded anymore.
+      allFramesCached_ = true;
+      std::scoped_lock lock(decode_mutex_);
+      decodedFrames_.clear();
+      lastRequiredFrame_.reset();
+    }
+    FML_TRACE_COUNTER("flutter", "MultiFrameCodec",
+                      reinterpret_cast<int64_t>(this), "CachedFrames",
+                      cachedFrameCount_, "CachedBytes",
+                      cachedFrameCount_ * frameByteSize_);
+  }
+  return result;
+}
+
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<tonic::DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
@@ -250,6 +389,8 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
+    // The generator may be decoding ahead of time on another thread.
+    std::scoped_lock lock(decode_mutex_);
     ImageGenerator::FrameInfo frameInfo =
         generator_->GetFrameInfo(nextFrameIndex_);
     duration = frameInfo.duration;
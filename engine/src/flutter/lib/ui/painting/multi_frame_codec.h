@@ -5,18 +5,51 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace flutter {
 
+namespace testing {
+FML_TEST_CLASS(MultiFrameCodecTest, DecodesAheadInOrder);
+FML_TEST_CLASS(MultiFrameCodecTest, DecodesAheadAcrossLoops);
+FML_TEST_CLASS(MultiFrameCodecTest, LimitsDecodeAheadByBytes);
+FML_TEST_CLASS(MultiFrameCodecTest, DropsFramesDecodedOnceAllAreCached);
+FML_TEST_CLASS(MultiFrameCodecTest, DoesNotDecodeAheadForCollectedCodecs);
+}  // namespace testing
+
 class MultiFrameCodec : public Codec {
  public:
+  struct Options {
+    /// The number of frames decoded ahead of the one Dart asks for, on the
+    /// concurrent worker threads. Zero decodes each frame only once it is
+    /// requested.
+    int lookahead_frames = 2;
+
+    /// The most memory the frames decoded ahead may take up. Fewer frames are
+    /// decoded ahead if they are large, and none if a single frame doesn't
+    /// fit.
+    size_t lookahead_bytes = 16 * 1024 * 1024;
+
+    /// If every frame of a looping animation fits in this many bytes, uploaded
+    /// frames are kept so that later loops don't decode them again. Zero
+    /// disables the cache.
+    size_t frame_cache_bytes = 4 * 1024 * 1024;
+  };
+
   explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
 
+  MultiFrameCodec(std::shared_ptr<ImageGenerator> generator, Options options);
+
   ~MultiFrameCodec() override;
 
   // |Codec|
@@ -38,26 +71,81 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  //
+  // Frames may also be decoded ahead of time on the concurrent task runner.
+  // That work only holds a weak reference to the state.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator,
+          Options options,
+          bool is_impeller_enabled,
+          std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const Options options_;
+    const size_t frameByteSize_;
+    // The number of frames decoded ahead, within both limits of `options_`.
+    const size_t lookaheadFrames_;
     bool is_impeller_enabled_ = false;
-
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
-    int nextFrameIndex_ = 0;
+    const std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+    // Whether every frame fits in the frame cache.
+    const bool cache_frames_;
+
+    // A frame decoded into CPU memory, waiting to be uploaded.
+    struct DecodedFrame {
+      int index = 0;
+      std::optional<SkBitmap> bitmap;
+      std::string error;
+    };
+
+    // The members below are read and written by both the IO thread and the
+    // decoding done ahead of time, and are guarded by `decode_mutex_`.
+    std::mutex decode_mutex_;
+    // The index of the next frame the generator will decode.
+    int nextDecodeIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
-
     // The rectangle that should be cleared if the previous frame's disposal
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
+    // Frames decoded ahead of time, in decoding order.
+    std::deque<DecodedFrame> decodedFrames_;
+    // Whether a task that decodes ahead of time is scheduled or running.
+    bool lookaheadPending_ = false;
+
+    // Set on the IO thread once every frame is in the frame cache.
+    std::atomic_bool allFramesCached_ = false;
+
+    // The non-const members and functions below here are only read or written
+    // to on the IO thread. They are not safe to access or write on the UI
+    // thread.
+    int nextFrameIndex_ = 0;
+    // Uploaded frames, by index. Only used if `cache_frames_` is set.
+    std::vector<sk_sp<DlImage>> cachedFrames_;
+    int cachedFrameCount_ = 0;
+
+    // Decodes the frame at `nextDecodeIndex_`. `decode_mutex_` must be held.
+    DecodedFrame DecodeNextFrame();
+
+    // Returns the decoded frame at `index`, either from the frames decoded
+    // ahead of time or by decoding it now.
+    DecodedFrame TakeDecodedFrame(int index);
+
+    // Schedules decoding the frames after the one being uploaded on the
+    // concurrent task runner, if not already scheduled.
+    void ScheduleLookahead();
+
+    void DecodeAhead();
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        SkBitmap bitmap,
+        const fml::WeakPtr<GrDirectContext>& resourceContext,
+        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+        const std::shared_ptr<impeller::Context>& impeller_context,
+        const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue);
 
     std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
         const fml::WeakPtr<GrDirectContext>& resourceContext,
@@ -78,6 +166,13 @@ class MultiFrameCodec : public Codec {
   // Shared across the UI and IO task runners.
   std::shared_ptr<State> state_;
 
+  FML_FRIEND_TEST(testing::MultiFrameCodecTest, DecodesAheadInOrder);
+  FML_FRIEND_TEST(testing::MultiFrameCodecTest, DecodesAheadAcrossLoops);
+  FML_FRIEND_TEST(testing::MultiFrameCodecTest, LimitsDecodeAheadByBytes);
+  FML_FRIEND_TEST(testing::MultiFrameCodecTest,
+                  DropsFramesDecodedOnceAllAreCached);
+  FML_FRIEND_TEST(testing::MultiFrameCodecTest,
+                  DoesNotDecodeAheadForCollectedCodecs);
   FML_FRIEND_MAKE_REF_COUNTED(MultiFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(MultiFrameCodec);
 };
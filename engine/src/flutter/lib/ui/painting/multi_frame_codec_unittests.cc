@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_codec.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Decodes blank frames and records the order they were decoded in.
+class RecordingImageGenerator : public ImageGenerator {
+ public:
+  explicit RecordingImageGenerator(unsigned int frame_count)
+      : info_(SkImageInfo::MakeN32Premul(4, 4)), frame_count_(frame_count) {}
+
+  ~RecordingImageGenerator() override = default;
+
+  const SkImageInfo& GetInfo() override { return info_; }
+
+  unsigned int GetFrameCount() const override { return frame_count_; }
+
+  unsigned int GetPlayCount() const override { return kInfinitePlayCount; }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override {
+    return {std::nullopt, 16, SkCodecAnimation::DisposalMethod::kKeep};
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return info_.dimensions();
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    decoded_frames.push_back(frame_index);
+    if (on_decode) {
+      on_decode();
+    }
+    return true;
+  }
+
+  std::vector<unsigned int> decoded_frames;
+  std::function<void()> on_decode;
+
+ private:
+  SkImageInfo info_;
+  unsigned int frame_count_;
+};
+
+MultiFrameCodec::Options MakeOptions(int lookahead_frames) {
+  MultiFrameCodec::Options options;
+  options.lookahead_frames = lookahead_frames;
+  options.frame_cache_bytes = 0;
+  return options;
+}
+
+}  // namespace
+
+TEST(MultiFrameCodecTest, DecodesAheadInOrder) {
+  auto generator = std::make_shared<RecordingImageGenerator>(4);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, MakeOptions(2), /*is_impeller_enabled=*/false,
+      /*concurrent_task_runner=*/nullptr);
+
+  MultiFrameCodec::State::DecodedFrame first = state->TakeDecodedFrame(0);
+  EXPECT_EQ(first.index, 0);
+  EXPECT_TRUE(first.bitmap.has_value());
+
+  // Decoding ahead stops once the look-ahead limit is reached.
+  state->DecodeAhead();
+  EXPECT_EQ(generator->decoded_frames, (std::vector<unsigned int>{0, 1, 2}));
+  EXPECT_FALSE(state->lookaheadPending_);
+
+  EXPECT_EQ(state->TakeDecodedFrame(1).index, 1);
+  EXPECT_EQ(state->TakeDecodedFrame(2).index, 2);
+  // Frames that weren't decoded ahead are decoded when they're taken.
+  EXPECT_EQ(state->TakeDecodedFrame(3).index, 3);
+  EXPECT_EQ(generator->decoded_frames,
+            (std::vector<unsigned int>{0, 1, 2, 3}));
+}
+
+TEST(MultiFrameCodecTest, DecodesAheadAcrossLoops) {
+  auto generator = std::make_shared<RecordingImageGenerator>(3);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, MakeOptions(2), /*is_impeller_enabled=*/false,
+      /*concurrent_task_runner=*/nullptr);
+
+  EXPECT_EQ(state->TakeDecodedFrame(0).index, 0);
+  state->DecodeAhead();
+  EXPECT_EQ(state->TakeDecodedFrame(1).index, 1);
+  // The look-ahead wraps around to the first frame of the next loop.
+  state->DecodeAhead();
+  EXPECT_EQ(generator->decoded_frames,
+            (std::vector<unsigned int>{0, 1, 2, 0}));
+
+  EXPECT_EQ(state->TakeDecodedFrame(2).index, 2);
+  EXPECT_EQ(state->TakeDecodedFrame(0).index, 0);
+  EXPECT_EQ(generator->decoded_frames.size(), 4u);
+}
+
+TEST(MultiFrameCodecTest, LimitsDecodeAheadByBytes) {
+  auto generator = std::make_shared<RecordingImageGenerator>(10);
+  const size_t frame_bytes = generator->GetInfo().computeMinByteSize();
+
+  MultiFrameCodec::Options options = MakeOptions(8);
+  options.lookahead_bytes = frame_bytes * 3 + frame_bytes / 2;
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, options, /*is_impeller_enabled=*/false,
+      /*concurrent_task_runner=*/nullptr);
+  EXPECT_EQ(state->lookaheadFrames_, 3u);
+
+  state->TakeDecodedFrame(0);
+  state->DecodeAhead();
+  EXPECT_EQ(generator->decoded_frames,
+            (std::vector<unsigned int>{0, 1, 2, 3}));
+
+  // Frames larger than the budget are never decoded ahead.
+  auto large_frames = std::make_shared<RecordingImageGenerator>(10);
+  options.lookahead_bytes = frame_bytes / 2;
+  auto unbuffered_state = std::make_shared<MultiFrameCodec::State>(
+      large_frames, options, /*is_impeller_enabled=*/false,
+      /*concurrent_task_runner=*/nullptr);
+  EXPECT_EQ(unbuffered_state->lookaheadFrames_, 0u);
+
+  unbuffered_state->TakeDecodedFrame(0);
+  unbuffered_state->DecodeAhead();
+  EXPECT_EQ(large_frames->decoded_frames, (std::vector<unsigned int>{0}));
+}
+
+TEST(MultiFrameCodecTest, DropsFramesDecodedOnceAllAreCached) {
+  auto generator = std::make_shared<RecordingImageGenerator>(4);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, MakeOptions(2), /*is_impeller_enabled=*/false,
+      /*concurrent_task_runner=*/nullptr);
+
+  state->TakeDecodedFrame(0);
+  // Simulate the IO thread caching the last frame while the next one is being
+  // decoded ahead.
+  MultiFrameCodec::State* raw_state = state.get();
+  generator->on_decode = [raw_state]() { raw_state->allFramesCached_ = true; };
+  state->DecodeAhead();
+
+  EXPECT_EQ(generator->decoded_frames, (std::vector<unsigned int>{0, 1}));
+  EXPECT_TRUE(state->decodedFrames_.empty());
+  EXPECT_FALSE(state->lookaheadPending_);
+}
+
+TEST(MultiFrameCodecTest, DoesNotDecodeAheadForCollectedCodecs) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+
+  // Keep the only worker busy until the codec state is gone.
+  fml::AutoResetWaitableEvent release_worker;
+  task_runner->PostTask([&release_worker]() { release_worker.Wait(); });
+
+  auto generator = std::make_shared<RecordingImageGenerator>(4);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, MakeOptions(2), /*is_impeller_enabled=*/false, task_runner);
+  state->TakeDecodedFrame(0);
+  state->ScheduleLookahead();
+  EXPECT_TRUE(state->lookaheadPending_);
+  state.reset();
+
+  release_worker.Signal();
+  fml::AutoResetWaitableEvent drained;
+  task_runner->PostTask([&drained]() { drained.Signal(); });
+  drained.Wait();
+
+  EXPECT_EQ(generator->decoded_frames, (std::vector<unsigned int>{0}));
+  loop->Terminate();
+}
+
+}  // namespace testing
+}  // namespace flutter
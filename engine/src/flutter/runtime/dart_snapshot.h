@@ -159,6 +159,22 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///
   const uint8_t* GetInstructionsMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the mapping that backs the heap snapshot.
+  ///
+  /// @return     The data mapping or nullptr.
+  ///
+  const std::shared_ptr<const fml::Mapping>& GetData() const { return data_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the mapping that backs the instructions snapshot.
+  ///
+  /// @return     The instructions mapping or nullptr.
+  ///
+  const std::shared_ptr<const fml::Mapping>& GetInstructions() const {
+    return instructions_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Returns whether both the data and instructions mappings are
   ///             safe to use with madvise(DONTNEED).
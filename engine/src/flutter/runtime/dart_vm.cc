@@ -295,6 +295,24 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  if (!settings_.snapshot_page_profile_path.empty()) {
+    // Snapshot pages are faulted in as the VM and the root isolate read them,
+    // so the profile has to be started before the VM is initialized.
+    auto regions = SnapshotPageProfile::GetSnapshotRegions(*vm_data_);
+    if (settings_.record_snapshot_page_profile) {
+      snapshot_page_profile_recorder_ =
+          std::make_unique<SnapshotPageProfileRecorder>(
+              std::move(regions), settings_.snapshot_page_profile_path,
+              fml::TimeDelta::FromMilliseconds(
+                  settings_.snapshot_page_profile_duration_ms),
+              concurrent_message_loop_->GetTaskRunner());
+    } else {
+      SnapshotPageProfile::ReadAheadInBackground(
+          std::move(regions), settings_.snapshot_page_profile_path,
+          concurrent_message_loop_->GetTaskRunner());
+    }
+  }
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
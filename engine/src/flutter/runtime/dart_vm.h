@@ -22,6 +22,7 @@
 #include "flutter/runtime/dart_vm_data.h"
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/runtime/skia_concurrent_executor.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
@@ -167,6 +168,7 @@ class DartVM {
   std::shared_ptr<const DartVMData> vm_data_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   const std::shared_ptr<ServiceProtocol> service_protocol_;
+  std::unique_ptr<SnapshotPageProfileRecorder> snapshot_page_profile_recorder_;
 
   friend class DartVMRef;
   friend class DartIsolate;
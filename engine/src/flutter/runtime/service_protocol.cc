@@ -41,6 +41,8 @@ const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
 const std::string_view ServiceProtocol::kGetPipelineUsageExtensionName =
     "_flutter.getPipelineUsage";
+const std::string_view ServiceProtocol::kGetMemoryUsageExtensionName =
+    "_flutter.getMemoryUsage";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -62,6 +64,7 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kReloadAssetFonts,
           kGetPipelineUsageExtensionName,
+          kGetMemoryUsageExtensionName,
       }) {}
 
 ServiceProtocol::~ServiceProtocol() {
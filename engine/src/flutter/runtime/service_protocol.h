@@ -30,6 +30,7 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kReloadAssetFonts;
   static const std::string_view kGetPipelineUsageExtensionName;
+  static const std::string_view kGetMemoryUsageExtensionName;
 
   class Handler {
    public:
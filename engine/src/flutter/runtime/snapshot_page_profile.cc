@@ -0,0 +1,372 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include <charconv>
+#include <sstream>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
+#if FML_OS_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // FML_OS_POSIX
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+#include <cstdio>
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+namespace flutter {
+
+namespace {
+
+constexpr std::string_view kHeader = "flutter-snapshot-page-profile 1";
+
+// The end of the memory mapping of the process that contains |address|, or
+// nullptr if it can't be determined.
+const uint8_t* FindMappingEnd(const uint8_t* address) {
+#if FML_OS_LINUX || FML_OS_ANDROID
+  FILE* maps = std::fopen("/proc/self/maps", "r");
+  if (maps == nullptr) {
+    return nullptr;
+  }
+  const auto target = reinterpret_cast<uintptr_t>(address);
+  const uint8_t* end = nullptr;
+  unsigned long map_start = 0;
+  unsigned long map_end = 0;
+  while (std::fscanf(maps, "%lx-%lx%*[^\n]\n", &map_start, &map_end) == 2) {
+    if (target >= map_start && target < map_end) {
+      end = reinterpret_cast<const uint8_t*>(map_end);
+      break;
+    }
+  }
+  std::fclose(maps);
+  return end;
+#else
+  return nullptr;
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+}
+
+bool IsResident(const uint8_t* start,
+                size_t size,
+                std::vector<unsigned char>& residency) {
+#if FML_OS_POSIX
+  residency.resize(size / SnapshotPageProfile::GetPageSize());
+  void* address = const_cast<uint8_t*>(start);
+#if FML_OS_MACOSX
+  // mincore takes a char vector on Apple platforms.
+  return ::mincore(address, size,
+                   reinterpret_cast<char*>(residency.data())) == 0;
+#else
+  return ::mincore(address, size, residency.data()) == 0;
+#endif  // FML_OS_MACOSX
+#else
+  return false;
+#endif  // FML_OS_POSIX
+}
+
+void AdviseWillNeed(const uint8_t* start, size_t size) {
+#if FML_OS_POSIX
+  if (::madvise(const_cast<uint8_t*>(start), size, MADV_WILLNEED) != 0) {
+    FML_DLOG(ERROR) << "Could not advise the kernel of snapshot pages.";
+  }
+#endif  // FML_OS_POSIX
+}
+
+bool ParseSize(std::string_view text, size_t& value) {
+  const char* end = text.data() + text.size();
+  auto result = std::from_chars(text.data(), end, value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+bool WriteProfile(const SnapshotPageProfile& profile,
+                  const std::string& path) {
+  auto directory = fml::OpenDirectory(
+      fml::paths::GetDirectoryName(path).c_str(), false,
+      fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return false;
+  }
+  const std::string file_name = path.substr(path.find_last_of('/') + 1);
+  fml::DataMapping mapping(profile.Serialize());
+  return fml::WriteAtomically(directory, file_name.c_str(), mapping);
+}
+
+}  // namespace
+
+size_t SnapshotPageProfile::GetPageSize() {
+#if FML_OS_POSIX
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+#else
+  return 4096u;
+#endif  // FML_OS_POSIX
+}
+
+std::vector<SnapshotPageProfile::Region> SnapshotPageProfile::ResolveRegions(
+    const std::vector<NamedMapping>& mappings) {
+  const uintptr_t page_mask = ~(GetPageSize() - 1);
+  std::vector<Region> regions;
+  std::vector<bool> unsized;
+  for (const auto& [name, mapping] : mappings) {
+    if (!mapping || mapping->GetMapping() == nullptr) {
+      continue;
+    }
+    const uint8_t* begin = mapping->GetMapping();
+    const uint8_t* end = mapping->GetSize() > 0
+                             ? begin + mapping->GetSize()
+                             : FindMappingEnd(begin);
+    if (end == nullptr) {
+      continue;
+    }
+    Region region;
+    region.name = name;
+    region.mapping = mapping;
+    region.start = reinterpret_cast<const uint8_t*>(
+        reinterpret_cast<uintptr_t>(begin) & page_mask);
+    region.size = end - region.start;
+    regions.push_back(std::move(region));
+    unsized.push_back(mapping->GetSize() == 0);
+  }
+
+  // Unsized snapshots extend to the end of their memory mapping, which may
+  // contain the snapshots that follow them.
+  for (size_t i = 0; i < regions.size(); i++) {
+    if (!unsized[i]) {
+      continue;
+    }
+    const uint8_t* end = regions[i].start + regions[i].size;
+    for (const Region& other : regions) {
+      if (other.start > regions[i].start && other.start < end) {
+        end = other.start;
+      }
+    }
+    regions[i].size = end - regions[i].start;
+  }
+
+  for (Region& region : regions) {
+    region.size = (region.size + GetPageSize() - 1) & page_mask;
+  }
+  return regions;
+}
+
+std::vector<SnapshotPageProfile::Region>
+SnapshotPageProfile::GetSnapshotRegions(const DartVMData& vm_data) {
+  std::vector<NamedMapping> mappings = {
+      {"vm_data", vm_data.GetVMSnapshot().GetData()},
+      {"vm_instructions", vm_data.GetVMSnapshot().GetInstructions()},
+  };
+  if (auto isolate_snapshot = vm_data.GetIsolateSnapshot()) {
+    mappings.emplace_back("isolate_data", isolate_snapshot->GetData());
+    mappings.emplace_back("isolate_instructions",
+                          isolate_snapshot->GetInstructions());
+  }
+  return ResolveRegions(mappings);
+}
+
+SnapshotPageProfile::SnapshotPageProfile() = default;
+
+SnapshotPageProfile::~SnapshotPageProfile() = default;
+
+SnapshotPageProfile::SnapshotPageProfile(SnapshotPageProfile&&) = default;
+
+SnapshotPageProfile& SnapshotPageProfile::operator=(SnapshotPageProfile&&) =
+    default;
+
+size_t SnapshotPageProfile::FindOrAddRegion(const std::string& name,
+                                            size_t page_count) {
+  for (size_t i = 0; i < regions_.size(); i++) {
+    if (regions_[i].name == name) {
+      return i;
+    }
+  }
+  regions_.push_back({name, page_count, std::vector<bool>(page_count)});
+  return regions_.size() - 1;
+}
+
+bool SnapshotPageProfile::AddPage(size_t region, size_t index) {
+  std::vector<bool>& recorded = regions_[region].recorded;
+  if (index >= recorded.size() || recorded[index]) {
+    return false;
+  }
+  recorded[index] = true;
+  pages_.push_back({region, index});
+  return true;
+}
+
+// The format is a header, the page size, one line per region with its name
+// and size in pages, and one line per page with its region and index.
+//
+//   flutter-snapshot-page-profile 1
+//   4096
+//   region isolate_data 1200
+//   page 0 17
+std::string SnapshotPageProfile::Serialize() const {
+  std::ostringstream stream;
+  stream << kHeader << "\n" << GetPageSize() << "\n";
+  for (const RecordedRegion& region : regions_) {
+    stream << "region " << region.name << " " << region.page_count << "\n";
+  }
+  for (const Page& page : pages_) {
+    stream << "page " << page.region << " " << page.index << "\n";
+  }
+  return stream.str();
+}
+
+std::optional<SnapshotPageProfile> SnapshotPageProfile::Parse(
+    std::string_view text) {
+  std::vector<std::string_view> lines;
+  while (!text.empty()) {
+    size_t newline = text.find('\n');
+    lines.push_back(text.substr(0, newline));
+    text.remove_prefix(newline == std::string_view::npos ? text.size()
+                                                         : newline + 1);
+  }
+
+  size_t page_size = 0;
+  if (lines.size() < 2 || lines[0] != kHeader ||
+      !ParseSize(lines[1], page_size) || page_size != GetPageSize()) {
+    return std::nullopt;
+  }
+
+  SnapshotPageProfile profile;
+  for (size_t i = 2; i < lines.size(); i++) {
+    std::string_view line = lines[i];
+    size_t first = line.find(' ');
+    size_t second = line.find(' ', first + 1);
+    if (first == std::string_view::npos || second == std::string_view::npos) {
+      return std::nullopt;
+    }
+    std::string_view kind = line.substr(0, first);
+    std::string_view key = line.substr(first + 1, second - first - 1);
+    size_t value = 0;
+    if (!ParseSize(line.substr(second + 1), value)) {
+      return std::nullopt;
+    }
+    if (kind == "region" && !key.empty() && profile.pages_.empty()) {
+      profile.FindOrAddRegion(std::string(key), value);
+      continue;
+    }
+    size_t region = 0;
+    if (kind != "page" || !ParseSize(key, region) ||
+        region >= profile.regions_.size() || !profile.AddPage(region, value)) {
+      return std::nullopt;
+    }
+  }
+  return profile;
+}
+
+size_t SnapshotPageProfile::Sample(const std::vector<Region>& regions) {
+  const size_t page_size = GetPageSize();
+  size_t added = 0;
+  std::vector<unsigned char> residency;
+  for (const Region& region : regions) {
+    if (!IsResident(region.start, region.size, residency)) {
+      continue;
+    }
+    size_t index = FindOrAddRegion(region.name, region.size / page_size);
+    for (size_t page = 0; page < residency.size(); page++) {
+      if ((residency[page] & 1) != 0 && AddPage(index, page)) {
+        added++;
+      }
+    }
+  }
+  return added;
+}
+
+size_t SnapshotPageProfile::ReadAhead(
+    const std::vector<Region>& regions) const {
+  const size_t page_size = GetPageSize();
+  // The live region of each recorded region, if it is still the same size.
+  std::vector<const Region*> live_regions(regions_.size(), nullptr);
+  for (size_t i = 0; i < regions_.size(); i++) {
+    for (const Region& region : regions) {
+      if (region.name == regions_[i].name &&
+          region.size == regions_[i].page_count * page_size) {
+        live_regions[i] = &region;
+      }
+    }
+  }
+
+  size_t advised = 0;
+  size_t run_start = 0;
+  while (run_start < pages_.size()) {
+    const Page& first = pages_[run_start];
+    size_t run_end = run_start + 1;
+    while (run_end < pages_.size() &&
+           pages_[run_end].region == first.region &&
+           pages_[run_end].index == first.index + (run_end - run_start)) {
+      run_end++;
+    }
+    if (const Region* region = live_regions[first.region]) {
+      const size_t run_pages = run_end - run_start;
+      AdviseWillNeed(region->start + first.index * page_size,
+                     run_pages * page_size);
+      advised += run_pages;
+    }
+    run_start = run_end;
+  }
+  return advised;
+}
+
+void SnapshotPageProfile::ReadAheadInBackground(
+    std::vector<Region> regions,
+    std::string path,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  task_runner->PostTask(
+      [regions = std::move(regions), path = std::move(path)]() {
+        TRACE_EVENT0("flutter", "SnapshotPageProfile::ReadAhead");
+        auto file = fml::FileMapping::CreateReadOnly(path);
+        if (!file || file->GetMapping() == nullptr) {
+          FML_LOG(INFO) << "No snapshot page profile at " << path;
+          return;
+        }
+        auto profile = Parse(std::string_view(
+            reinterpret_cast<const char*>(file->GetMapping()),
+            file->GetSize()));
+        if (!profile.has_value()) {
+          FML_LOG(ERROR) << "Could not parse the snapshot page profile at "
+                         << path;
+          return;
+        }
+        profile->ReadAhead(regions);
+      });
+}
+
+SnapshotPageProfileRecorder::SnapshotPageProfileRecorder(
+    std::vector<SnapshotPageProfile::Region> regions,
+    std::string path,
+    fml::TimeDelta duration,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner)
+    : stop_(std::make_shared<fml::ManualResetWaitableEvent>()) {
+  const fml::TimePoint deadline = fml::TimePoint::Now() + duration;
+  task_runner->PostTask([regions = std::move(regions),
+                         path = std::move(path), deadline, stop = stop_]() {
+    TRACE_EVENT0("flutter", "SnapshotPageProfileRecorder::Record");
+    SnapshotPageProfile profile;
+    do {
+      profile.Sample(regions);
+    } while (fml::TimePoint::Now() < deadline &&
+             stop->WaitWithTimeout(kSampleInterval));
+    if (!WriteProfile(profile, path)) {
+      FML_LOG(ERROR) << "Could not write the snapshot page profile to "
+                     << path;
+      return;
+    }
+    FML_LOG(INFO) << "Recorded " << profile.GetPageCount()
+                  << " snapshot pages to " << path;
+  });
+}
+
+SnapshotPageProfileRecorder::~SnapshotPageProfileRecorder() {
+  stop_->Signal();
+}
+
+}  // namespace flutter
@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/runtime/dart_vm_data.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The pages of the Dart snapshots that were touched while an
+///             application started, in the order in which they were first
+///             found to be resident.
+///
+///             Snapshot pages are faulted in lazily as the VM and the root
+///             isolate read them, and every fault that misses the page cache
+///             stalls startup on a read from storage. A profile recorded on
+///             one launch lets later launches ask the kernel to read the same
+///             pages ahead, on a background thread, before the isolate gets
+///             to them.
+///
+///             Residency is sampled with `mincore`, which reports the pages in
+///             the page cache rather than the pages this process touched, so
+///             profiles should be recorded on a cold start. Recording and
+///             replaying are no-ops on platforms without `mincore`.
+///
+class SnapshotPageProfile {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      A named, page aligned span of snapshot memory.
+  ///
+  struct Region {
+    std::string name;
+    /// Keeps the memory of the span mapped.
+    std::shared_ptr<const fml::Mapping> mapping;
+    const uint8_t* start = nullptr;
+    size_t size = 0;
+  };
+
+  using NamedMapping =
+      std::pair<std::string, std::shared_ptr<const fml::Mapping>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the pages that profiles are recorded in.
+  ///
+  static size_t GetPageSize();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resolves the spans of memory covered by the given mappings.
+  ///
+  ///             Snapshots that are referenced as symbols of a native library
+  ///             don't know their own size. Where the platform allows it,
+  ///             these extend to the end of the memory mapping that contains
+  ///             them or to the start of the next region, whichever comes
+  ///             first. Mappings whose extent can't be determined are dropped.
+  ///
+  static std::vector<Region> ResolveRegions(
+      const std::vector<NamedMapping>& mappings);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The regions covered by the VM and isolate snapshots that a
+  ///             VM is launched with.
+  ///
+  static std::vector<Region> GetSnapshotRegions(const DartVMData& vm_data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a profile written by `Serialize`.
+  ///
+  /// @return     The profile or `std::nullopt` if the text is malformed or was
+  ///             recorded with a different page size.
+  ///
+  static std::optional<SnapshotPageProfile> Parse(std::string_view text);
+
+  SnapshotPageProfile();
+
+  ~SnapshotPageProfile();
+
+  SnapshotPageProfile(SnapshotPageProfile&&);
+
+  SnapshotPageProfile& operator=(SnapshotPageProfile&&);
+
+  std::string Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the pages of the regions that are resident and
+  ///             haven't been recorded yet.
+  ///
+  /// @return     The number of pages appended.
+  ///
+  size_t Sample(const std::vector<Region>& regions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to read the recorded pages of the regions
+  ///             ahead, in the order in which they were recorded. Runs of
+  ///             consecutive pages are advised together. Regions whose size
+  ///             differs from the recorded one belong to a different build
+  ///             and are skipped.
+  ///
+  /// @return     The number of pages advised.
+  ///
+  size_t ReadAhead(const std::vector<Region>& regions) const;
+
+  size_t GetPageCount() const { return pages_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the profile at |path| and reads its pages ahead on
+  ///             |task_runner|.
+  ///
+  static void ReadAheadInBackground(
+      std::vector<Region> regions,
+      std::string path,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
+ private:
+  struct RecordedRegion {
+    std::string name;
+    size_t page_count = 0;
+    /// Whether each page of the region has been recorded.
+    std::vector<bool> recorded;
+  };
+
+  struct Page {
+    size_t region = 0;
+    size_t index = 0;
+  };
+
+  std::vector<RecordedRegion> regions_;
+  std::vector<Page> pages_;
+
+  size_t FindOrAddRegion(const std::string& name, size_t page_count);
+
+  bool AddPage(size_t region, size_t index);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SnapshotPageProfile);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Samples the residency of snapshot regions on a background
+///             thread for a fixed duration after construction and writes the
+///             resulting profile to a file. Destroying the recorder ends the
+///             recording early, and the pages recorded so far are written.
+///
+class SnapshotPageProfileRecorder {
+ public:
+  /// The interval at which the residency of the regions is sampled.
+  static constexpr fml::TimeDelta kSampleInterval =
+      fml::TimeDelta::FromMilliseconds(10);
+
+  SnapshotPageProfileRecorder(
+      std::vector<SnapshotPageProfile::Region> regions,
+      std::string path,
+      fml::TimeDelta duration,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
+  ~SnapshotPageProfileRecorder();
+
+ private:
+  std::shared_ptr<fml::ManualResetWaitableEvent> stop_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SnapshotPageProfileRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
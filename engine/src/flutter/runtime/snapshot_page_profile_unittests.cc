@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+#if FML_OS_POSIX
+#include <sys/mman.h>
+#endif  // FML_OS_POSIX
+
+namespace flutter {
+namespace testing {
+
+#if FML_OS_POSIX
+
+namespace {
+
+// Anonymous memory that is only resident once it has been written to.
+std::shared_ptr<const fml::Mapping> MapPages(size_t page_count) {
+  const size_t size = page_count * SnapshotPageProfile::GetPageSize();
+  void* pages = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (pages == MAP_FAILED) {
+    return nullptr;
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      static_cast<const uint8_t*>(pages), size,
+      [](const uint8_t* data, size_t size) {
+        ::munmap(const_cast<uint8_t*>(data), size);
+      });
+}
+
+void Touch(const SnapshotPageProfile::Region& region, size_t page) {
+  uint8_t* start = const_cast<uint8_t*>(region.start);
+  start[page * SnapshotPageProfile::GetPageSize()] = 1;
+}
+
+}  // namespace
+
+TEST(SnapshotPageProfileTest, RecordsPagesInTheOrderTheyBecomeResident) {
+  auto regions = SnapshotPageProfile::ResolveRegions({{"data", MapPages(4)}});
+  ASSERT_EQ(regions.size(), 1u);
+  ASSERT_EQ(regions[0].size, 4 * SnapshotPageProfile::GetPageSize());
+
+  SnapshotPageProfile profile;
+  EXPECT_EQ(profile.Sample(regions), 0u);
+  Touch(regions[0], 2);
+  EXPECT_EQ(profile.Sample(regions), 1u);
+  Touch(regions[0], 0);
+  Touch(regions[0], 3);
+  EXPECT_EQ(profile.Sample(regions), 2u);
+  EXPECT_EQ(profile.Sample(regions), 0u);
+
+  EXPECT_EQ(profile.Serialize(),
+            "flutter-snapshot-page-profile 1\n" +
+                std::to_string(SnapshotPageProfile::GetPageSize()) +
+                "\n"
+                "region data 4\n"
+                "page 0 2\n"
+                "page 0 0\n"
+                "page 0 3\n");
+}
+
+TEST(SnapshotPageProfileTest, UnsizedRegionsEndAtTheNextRegion) {
+  const size_t page_size = SnapshotPageProfile::GetPageSize();
+  auto pages = MapPages(8);
+  ASSERT_TRUE(pages);
+  auto unsized =
+      std::make_shared<fml::NonOwnedMapping>(pages->GetMapping(), 0);
+  auto sized = std::make_shared<fml::NonOwnedMapping>(
+      pages->GetMapping() + 4 * page_size, 3 * page_size);
+
+  auto regions =
+      SnapshotPageProfile::ResolveRegions({{"unsized", unsized},
+                                           {"sized", sized},
+                                           {"missing", nullptr}});
+#if FML_OS_LINUX || FML_OS_ANDROID
+  ASSERT_EQ(regions.size(), 2u);
+  EXPECT_EQ(regions[0].name, "unsized");
+  EXPECT_EQ(regions[0].start, pages->GetMapping());
+  EXPECT_EQ(regions[0].size, 4 * page_size);
+  EXPECT_EQ(regions[1].name, "sized");
+  EXPECT_EQ(regions[1].size, 3 * page_size);
+#else
+  ASSERT_EQ(regions.size(), 1u);
+  EXPECT_EQ(regions[0].name, "sized");
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+}
+
+TEST(SnapshotPageProfileTest, ParsesWhatItSerializes) {
+  auto regions = SnapshotPageProfile::ResolveRegions(
+      {{"data", MapPages(4)}, {"instructions", MapPages(2)}});
+  ASSERT_EQ(regions.size(), 2u);
+  Touch(regions[1], 1);
+  Touch(regions[0], 0);
+
+  SnapshotPageProfile profile;
+  ASSERT_EQ(profile.Sample(regions), 2u);
+  auto parsed = SnapshotPageProfile::Parse(profile.Serialize());
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->GetPageCount(), 2u);
+  EXPECT_EQ(parsed->Serialize(), profile.Serialize());
+
+  EXPECT_FALSE(SnapshotPageProfile::Parse("").has_value());
+  EXPECT_FALSE(SnapshotPageProfile::Parse("flutter-snapshot-page-profile 1\n"
+                                          "3\n")
+                   .has_value());
+  EXPECT_FALSE(SnapshotPageProfile::Parse(
+                   "flutter-snapshot-page-profile 1\n" +
+                   std::to_string(SnapshotPageProfile::GetPageSize()) +
+                   "\n"
+                   "region data 4\n"
+                   "page 1 0\n")
+                   .has_value());
+}
+
+TEST(SnapshotPageProfileTest, ReadsAheadRegionsOfTheRecordedSize) {
+  const std::string header =
+      "flutter-snapshot-page-profile 1\n" +
+      std::to_string(SnapshotPageProfile::GetPageSize()) + "\n";
+  auto profile = SnapshotPageProfile::Parse(header +
+                                            "region data 4\n"
+                                            "region instructions 3\n"
+                                            "page 0 1\n"
+                                            "page 0 2\n"
+                                            "page 1 0\n"
+                                            "page 0 0\n");
+  ASSERT_TRUE(profile.has_value());
+
+  auto regions = SnapshotPageProfile::ResolveRegions(
+      {{"data", MapPages(4)}, {"instructions", MapPages(2)}});
+  // The instructions were recorded with a different size and are skipped.
+  EXPECT_EQ(profile->ReadAhead(regions), 3u);
+  EXPECT_EQ(profile->ReadAhead({}), 0u);
+}
+
+TEST(SnapshotPageProfileTest, RecorderWritesTheProfileWhenStopped) {
+  fml::ScopedTemporaryDirectory directory;
+  const std::string path =
+      fml::paths::JoinPaths({directory.path(), "snapshot_pages.txt"});
+  auto regions = SnapshotPageProfile::ResolveRegions({{"data", MapPages(2)}});
+  ASSERT_EQ(regions.size(), 1u);
+  Touch(regions[0], 1);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto recorder = std::make_unique<SnapshotPageProfileRecorder>(
+      regions, path, fml::TimeDelta::FromSeconds(60), loop->GetTaskRunner());
+  recorder.reset();
+  // Joins the worker, which writes the profile once it has been stopped.
+  loop.reset();
+
+  auto file = fml::FileMapping::CreateReadOnly(path);
+  ASSERT_TRUE(file);
+  auto profile = SnapshotPageProfile::Parse(
+      std::string_view(reinterpret_cast<const char*>(file->GetMapping()),
+                       file->GetSize()));
+  ASSERT_TRUE(profile.has_value());
+  EXPECT_EQ(profile->GetPageCount(), 1u);
+}
+
+#endif  // FML_OS_POSIX
+
+}  // namespace testing
+}  // namespace flutter
@@ -23,6 +23,7 @@
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -600,6 +601,10 @@ Shell::Shell(DartVMRef vm,
       {task_runners_.GetIOTaskRunner(),
        std::bind(&Shell::OnServiceProtocolGetPipelineUsage, this,
                  std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetMemoryUsageExtensionName] =
+      {task_runners_.GetUITaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetMemoryUsage, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -2205,6 +2210,28 @@ bool Shell::OnServiceProtocolGetPipelineUsage(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  const fml::MemoryUsage usage = fml::GetMemoryUsage();
+
+  rapidjson::Value bytes_json(rapidjson::kObjectType);
+  for (size_t i = 0; i < fml::kMemoryCategoryCount; i++) {
+    auto category = static_cast<fml::MemoryCategory>(i);
+    bytes_json.AddMember(
+        rapidjson::StringRef(fml::MemoryCategoryToString(category)),
+        static_cast<uint64_t>(usage.GetBytes(category)),
+        response->GetAllocator());
+  }
+
+  response->SetObject();
+  response->AddMember("type", "MemoryUsage", response->GetAllocator());
+  response->AddMember("bytes", bytes_json, response->GetAllocator());
+  return true;
+}
+
 void Shell::SendFontChangeNotification() {
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
@@ -335,6 +335,9 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetMemoryUsage:
+            shell->OnServiceProtocolGetMemoryUsage(params, response);
+            break;
         }
         finished.set_value(true);
       });
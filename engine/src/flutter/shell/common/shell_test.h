@@ -142,6 +142,7 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetMemoryUsage,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
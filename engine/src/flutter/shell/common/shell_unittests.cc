@@ -29,6 +29,7 @@
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -2603,6 +2604,30 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  fml::MemoryUsageCounter counter(fml::MemoryCategory::kGlyphAtlas);
+  counter.Set(4096u);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetMemoryUsage,
+                    shell->GetTaskRunners().GetUITaskRunner(), empty_params,
+                    &document);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "MemoryUsage");
+  const auto& bytes = document["bytes"];
+  ASSERT_TRUE(bytes.IsObject());
+  EXPECT_EQ(bytes.MemberCount(), fml::kMemoryCategoryCount);
+  ASSERT_TRUE(bytes.HasMember("GlyphAtlas"));
+  EXPECT_GE(bytes["GlyphAtlas"].GetUint64(), 4096u);
+
+  DestroyShell(std::move(shell));
+}
+
 // TODO(https://github.com/flutter/flutter/issues/100273): Disabled due to
 // flakiness.
 // TODO(https://github.com/flutter/flutter/issues/100299): Fix it when
@@ -178,6 +178,20 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(SnapshotPageProfile,
+           "snapshot-page-profile",
+           "Path to a profile of the Dart snapshot pages touched during "
+           "startup. The recorded pages are read ahead on a background thread "
+           "when the VM is launched.")
+DEF_SWITCH(RecordSnapshotPageProfile,
+           "record-snapshot-page-profile",
+           "Record the Dart snapshot pages that become resident during startup "
+           "to the file given by --snapshot-page-profile instead of reading "
+           "them ahead. Profiles should be recorded on a cold start.")
+DEF_SWITCH(SnapshotPageProfileDuration,
+           "snapshot-page-profile-duration",
+           "How long, in milliseconds, Dart snapshot pages are recorded for "
+           "after the VM is launched. Defaults to 3000.")
 DEF_SWITCH(ProfileMicrotasks,
            "profile-microtasks",
            "Enable collection of information about each microtask. Information "
@@ -339,6 +339,18 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPageProfile),
+                              &settings.snapshot_page_profile_path);
+  settings.record_snapshot_page_profile =
+      command_line.HasOption(FlagForSwitch(Switch::RecordSnapshotPageProfile));
+  std::string snapshot_page_profile_duration;
+  if (command_line.GetOptionValue(
+          FlagForSwitch(Switch::SnapshotPageProfileDuration),
+          &snapshot_page_profile_duration)) {
+    settings.snapshot_page_profile_duration_ms =
+        std::stoi(snapshot_page_profile_duration);
+  }
+
   settings.profile_microtasks =
       command_line.HasOption(FlagForSwitch(Switch::ProfileMicrotasks));
 
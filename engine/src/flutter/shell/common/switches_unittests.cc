@@ -139,6 +139,28 @@ TEST(SwitchesTest, ProfileStartup) {
   }
 }
 
+TEST(SwitchesTest, SnapshotPageProfile) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--snapshot-page-profile=/data/pages.txt",
+         "--record-snapshot-page-profile",
+         "--snapshot-page-profile-duration=500"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.snapshot_page_profile_path, "/data/pages.txt");
+    EXPECT_EQ(settings.record_snapshot_page_profile, true);
+    EXPECT_EQ(settings.snapshot_page_profile_duration_ms, 500);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.snapshot_page_profile_path.empty());
+    EXPECT_EQ(settings.record_snapshot_page_profile, false);
+    EXPECT_EQ(settings.snapshot_page_profile_duration_ms, 3000);
+  }
+}
+
 #if !FLUTTER_RELEASE
 TEST(SwitchesTest, EnableAsserts) {
   fml::CommandLine command_line = fml::CommandLineFromInitializerList(
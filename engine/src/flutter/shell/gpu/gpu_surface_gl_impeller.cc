@@ -116,12 +116,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
 
     auto cull_rect =
         impeller::Rect::MakeSize(render_target.GetRenderTargetSize());
-    return impeller::RenderToTarget(aiks_context->GetContentContext(),  //
-                                    render_target,                      //
-                                    display_list,                       //
-                                    cull_rect,                          //
-                                    /*reset_host_buffer=*/true          //
-    );
+    if (!impeller::RenderToTarget(aiks_context->GetContentContext(),  //
+                                  render_target,                      //
+                                  display_list,                       //
+                                  cull_rect,                          //
+                                  /*reset_host_buffer=*/true          //
+                                  )) {
+      return false;
+    }
+    aiks_context->GetContentContext().MarkFrameEnd();
     return true;
   };
 
@@ -23,6 +23,17 @@ static_assert(__has_feature(objc_arc), "ARC must be enabled.");
 
 namespace flutter {
 
+// The area underneath backdrop filters that changed since the previous frame,
+// or std::nullopt if the rasterizer did not diff this frame.
+static std::optional<impeller::IRect> GetReadbackDamage(const SurfaceFrame& surface_frame) {
+  const std::optional<DlIRect>& readback_damage = surface_frame.submit_info().readback_damage;
+  if (!readback_damage.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(readback_damage->GetLeft(), readback_damage->GetTop(),
+                                   readback_damage->GetRight(), readback_damage->GetBottom());
+}
+
 GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(
     GPUSurfaceMetalDelegate* delegate,
     const std::shared_ptr<impeller::AiksContext>& context,
@@ -113,7 +124,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
                          drawable,                                            //
                          weak_last_texture,                                   //
                          weak_layer,                                          //
-                         swapchain_transients = swapchain_transients_         //
+                         swapchain_transients = swapchain_transients_,        //
+                         backdrop_filter_cache = backdrop_filter_cache_       //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         id<MTLTexture> strong_last_texture = weak_last_texture;
         CAMetalLayer* strong_layer = weak_layer;
@@ -175,15 +187,21 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
         surface->SetFrameBoundary(surface_frame.submit_info().frame_boundary);
 
         const bool reset_host_buffer = surface_frame.submit_info().frame_boundary;
-        auto render_result = impeller::RenderToTarget(aiks_context->GetContentContext(),       //
-                                                      surface->GetRenderTarget(),              //
-                                                      display_list,                            //
-                                                      cull_rect,                               //
-                                                      /*reset_host_buffer=*/reset_host_buffer  //
+        backdrop_filter_cache->SetFrameDamage(GetReadbackDamage(surface_frame));
+        auto render_result = impeller::RenderToTarget(aiks_context->GetContentContext(),        //
+                                                      surface->GetRenderTarget(),               //
+                                                      display_list,                             //
+                                                      cull_rect,                                //
+                                                      /*reset_host_buffer=*/reset_host_buffer,  //
+                                                      /*is_onscreen=*/true,                     //
+                                                      backdrop_filter_cache.get()               //
         );
         if (!render_result) {
           return false;
         }
+        if (reset_host_buffer) {
+          aiks_context->GetContentContext().MarkFrameEnd();
+        }
 
         if (!surface->PreparePresent()) {
           return false;
@@ -238,9 +256,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
   SurfaceFrame::EncodeCallback encode_callback =
       fml::MakeCopyable([disable_partial_repaint = disable_partial_repaint_,  //
                          damage = damage_,
-                         aiks_context = aiks_context_,                 //
-                         weak_texture,                                 //
-                         swapchain_transients = swapchain_transients_  //
+                         aiks_context = aiks_context_,                    //
+                         weak_texture,                                    //
+                         swapchain_transients = swapchain_transients_,    //
+                         backdrop_filter_cache = backdrop_filter_cache_   //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         id<MTLTexture> strong_texture = weak_texture;
         if (!strong_texture) {
@@ -290,16 +309,20 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
         }
 
         impeller::Rect cull_rect = impeller::Rect::Make(surface->coverage());
+        backdrop_filter_cache->SetFrameDamage(GetReadbackDamage(surface_frame));
         auto render_result = impeller::RenderToTarget(aiks_context->GetContentContext(),  //
                                                       surface->GetRenderTarget(),         //
                                                       display_list,                       //
                                                       cull_rect,                          //
-                                                      /*reset_host_buffer=*/true          //
+                                                      /*reset_host_buffer=*/true,         //
+                                                      /*is_onscreen=*/true,               //
+                                                      backdrop_filter_cache.get()         //
         );
         if (!render_result) {
           FML_LOG(ERROR) << "Failed to render Impeller frame";
           return false;
         }
+        aiks_context->GetContentContext().MarkFrameEnd();
         if (!surface->PreparePresent()) {
           return false;
         }
@@ -15,10 +15,15 @@
 namespace flutter {
 
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+                                       bool render_to_surface,
+                                       size_t raster_thread_count)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  if (raster_thread_count > 1) {
+    tiler_ = std::make_unique<GPUSurfaceSoftwareTiler>(raster_thread_count);
+  }
+}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
 
@@ -67,6 +72,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  if (tiler_) {
+    return AcquireTiledFrame(logical_size, framebuffer_info, backing_store);
+  }
+
   SurfaceFrame::EncodeCallback encode_callback =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           DlCanvas* canvas) -> bool {
@@ -93,6 +102,40 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         logical_size);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    const DlISize& logical_size,
+    const SurfaceFrame::FramebufferInfo& framebuffer_info,
+    const sk_sp<SkSurface>& backing_store) {
+  // The frame is recorded into a DisplayList with an rtree so that each tile
+  // only dispatches the ops that intersect it, and is then rendered into the
+  // backing store by the tiler once the frame is encoded.
+  SurfaceFrame::EncodeCallback encode_callback =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid() || canvas == nullptr) {
+      return false;
+    }
+
+    return self->tiler_->Rasterize(surface_frame.BuildDisplayList(),
+                                   backing_store.get());
+  };
+  SurfaceFrame::SubmitCallback submit_callback =
+      [self = weak_factory_.GetWeakPtr(),
+       backing_store](const SurfaceFrame& surface_frame) {
+        // If the surface itself went away, there is nothing more to do.
+        if (!self || !self->IsValid()) {
+          return false;
+        }
+        return self->delegate_->PresentBackingStore(backing_store);
+      };
+
+  return std::make_unique<SurfaceFrame>(
+      nullptr, framebuffer_info, encode_callback, submit_callback,
+      logical_size, /*context_result=*/nullptr,
+      /*display_list_fallback=*/true, /*prepare_rtree=*/true);
+}
+
 // |Surface|
 DlMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -5,17 +5,31 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
+#include "flutter/shell/gpu/gpu_surface_software_tiler.h"
 
 namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders into the backing stores of
+  ///             |delegate|.
+  ///
+  /// @param[in]  raster_thread_count  The number of threads that render each
+  ///             frame. With more than one thread, frames are recorded into
+  ///             a |DisplayList| and rendered in parallel tiles by a
+  ///             |GPUSurfaceSoftwareTiler|. Otherwise frames render directly
+  ///             into the backing store on the raster thread.
+  ///
   GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+                     bool render_to_surface,
+                     size_t raster_thread_count = 1);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +52,15 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  // Only present when frames are rendered in tiles on several threads.
+  std::unique_ptr<GPUSurfaceSoftwareTiler> tiler_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      const DlISize& logical_size,
+      const SurfaceFrame::FramebufferInfo& framebuffer_info,
+      const sk_sp<SkSurface>& backing_store);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
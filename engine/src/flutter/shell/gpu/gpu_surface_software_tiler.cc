@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_software_tiler.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+namespace {
+
+// Scans a DisplayList, including any nested DisplayLists, for saveLayer
+// calls with a backdrop filter.
+class BackdropDetector final : public virtual DlOpReceiver,
+                               private IgnoreAttributeDispatchHelper,
+                               private IgnoreClipDispatchHelper,
+                               private IgnoreTransformDispatchHelper,
+                               private IgnoreDrawDispatchHelper {
+ public:
+  bool found_backdrop() const { return found_backdrop_; }
+
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override {
+    found_backdrop_ = found_backdrop_ || backdrop != nullptr;
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    if (!found_backdrop_ && display_list) {
+      display_list->Dispatch(*this);
+    }
+  }
+
+ private:
+  bool found_backdrop_ = false;
+};
+
+// Renders the tiles claimed from |next_tile| until none remain.
+void RenderTiles(const DisplayList& display_list,
+                 const SkPixmap& pixmap,
+                 const std::vector<DlIRect>& tiles,
+                 std::atomic<size_t>& next_tile) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftwareTiler::RenderTiles");
+  // Each thread needs a canvas of its own. All of them write directly into
+  // the pixels of the surface, and the tiles they render never overlap.
+  std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+      pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+  if (!canvas) {
+    return;
+  }
+  for (size_t i = next_tile++; i < tiles.size(); i = next_tile++) {
+    const DlIRect& tile = tiles[i];
+    canvas->save();
+    canvas->clipIRect(SkIRect::MakeLTRB(tile.GetLeft(), tile.GetTop(),
+                                        tile.GetRight(), tile.GetBottom()));
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    display_list.Dispatch(dispatcher, tile);
+    canvas->restore();
+  }
+}
+
+}  // namespace
+
+GPUSurfaceSoftwareTiler::GPUSurfaceSoftwareTiler(size_t thread_count) {
+  if (thread_count > 1) {
+    worker_loop_ = fml::ConcurrentMessageLoop::Create(thread_count - 1);
+  }
+}
+
+GPUSurfaceSoftwareTiler::~GPUSurfaceSoftwareTiler() {
+  if (worker_loop_) {
+    worker_loop_->Terminate();
+  }
+}
+
+size_t GPUSurfaceSoftwareTiler::GetThreadCount() const {
+  return worker_loop_ ? worker_loop_->GetWorkerCount() + 1 : 1;
+}
+
+std::vector<DlIRect> GPUSurfaceSoftwareTiler::ComputeTiles(
+    const DlISize& size) {
+  std::vector<DlIRect> tiles;
+  for (int64_t top = 0; top < size.height; top += kTileSize) {
+    int64_t bottom = std::min<int64_t>(top + kTileSize, size.height);
+    for (int64_t left = 0; left < size.width; left += kTileSize) {
+      int64_t right = std::min<int64_t>(left + kTileSize, size.width);
+      tiles.push_back(DlIRect::MakeLTRB(left, top, right, bottom));
+    }
+  }
+  return tiles;
+}
+
+bool GPUSurfaceSoftwareTiler::CanRenderInTiles(
+    const DisplayList& display_list) {
+  if (display_list.root_has_backdrop_filter()) {
+    return false;
+  }
+  // Backdrop filters below the root level are not summarized by the
+  // DisplayList, so the ops have to be scanned.
+  BackdropDetector detector;
+  display_list.Dispatch(detector);
+  return !detector.found_backdrop();
+}
+
+bool GPUSurfaceSoftwareTiler::Rasterize(const sk_sp<DisplayList>& display_list,
+                                        SkSurface* surface) const {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftwareTiler::Rasterize");
+  if (!surface) {
+    return false;
+  }
+  if (!display_list) {
+    return true;
+  }
+
+  SkPixmap pixmap;
+  if (!surface->peekPixels(&pixmap)) {
+    return false;
+  }
+
+  std::vector<DlIRect> tiles =
+      ComputeTiles(DlISize(pixmap.width(), pixmap.height()));
+  if (!worker_loop_ || tiles.size() < 2 || !CanRenderInTiles(*display_list)) {
+    DlSkCanvasDispatcher dispatcher(surface->getCanvas());
+    display_list->Dispatch(dispatcher);
+    return true;
+  }
+
+  // The tile canvases write behind the back of the surface, so any snapshot
+  // of the surface must be detached from its pixels first.
+  surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+  const size_t worker_count =
+      std::min(worker_loop_->GetWorkerCount(), tiles.size() - 1);
+  std::atomic<size_t> next_tile = 0;
+  fml::CountDownLatch latch(worker_count);
+  auto task_runner = worker_loop_->GetTaskRunner();
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner->PostTask([&display_list, &pixmap, &tiles, &next_tile,
+                           &latch]() {
+      RenderTiles(*display_list, pixmap, tiles, next_tile);
+      latch.CountDown();
+    });
+  }
+  RenderTiles(*display_list, pixmap, tiles, next_tile);
+  latch.Wait();
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_TILER_H_
+#define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_TILER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Rasterizes a frame |DisplayList| into a raster |SkSurface| by
+///             splitting the surface into tiles and rendering the tiles in
+///             parallel.
+///
+///             Each tile renders only the ops that the |DlRTree| of the
+///             display list reports as intersecting the tile, into its own
+///             |SkCanvas| that shares the pixels of the surface and is
+///             clipped to the tile. Since every tile canvas uses the same
+///             device coordinates as the surface, the tiles produce exactly
+///             the pixels that a single canvas would have produced.
+///
+///             Frames that contain backdrop filters read back pixels that
+///             may belong to other tiles and are rendered on the calling
+///             thread in a single pass.
+///
+class GPUSurfaceSoftwareTiler {
+ public:
+  /// The width and height of each tile. This is a multiple of the sizes of
+  /// the dither matrices used by the raster pipeline so that tiling never
+  /// shifts a dither pattern.
+  static constexpr int kTileSize = 256;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a tiler that renders on |thread_count| threads, the
+  ///             calling thread and |thread_count - 1| worker threads.
+  ///
+  explicit GPUSurfaceSoftwareTiler(size_t thread_count);
+
+  ~GPUSurfaceSoftwareTiler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of threads, including the calling thread, that
+  ///             render the tiles of a frame.
+  ///
+  size_t GetThreadCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders |display_list| into |surface| and blocks until all
+  ///             of the tiles have been rendered.
+  ///
+  /// @return     false if the pixels of |surface| are not directly
+  ///             accessible.
+  ///
+  bool Rasterize(const sk_sp<DisplayList>& display_list,
+                 SkSurface* surface) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The tiles that cover a surface of the indicated size, in
+  ///             row major order.
+  ///
+  static std::vector<DlIRect> ComputeTiles(const DlISize& size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the tiles of |display_list| can be rendered
+  ///             independently of each other.
+  ///
+  static bool CanRenderInTiles(const DisplayList& display_list);
+
+ private:
+  std::shared_ptr<fml::ConcurrentMessageLoop> worker_loop_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftwareTiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_TILER_H_
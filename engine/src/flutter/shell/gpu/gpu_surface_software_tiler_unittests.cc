@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_software_tiler.h"
+
+#include <cstring>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr int kWidth = 700;
+constexpr int kHeight = 520;
+
+sk_sp<DisplayList> MakeScene(bool prepare_rtree) {
+  DisplayListBuilder builder(DlRect::MakeWH(kWidth, kHeight), prepare_rtree);
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  for (int i = 0; i < 40; i++) {
+    DlPaint paint(DlColor::kBlue().withAlpha(0x40 + i * 4));
+    paint.setAntiAlias(i % 2 == 0);
+    builder.DrawCircle(DlPoint(i * 17 + 5, i * 13 + 7), 30 + i, paint);
+  }
+  builder.Save();
+  builder.Translate(250, 250);
+  builder.Rotate(30);
+  builder.ClipRect(DlRect::MakeLTRB(-200, -100, 200, 100));
+  builder.DrawRect(DlRect::MakeLTRB(-300, -50, 300, 50),
+                   DlPaint(DlColor::kRed()).setAntiAlias(true));
+  builder.Restore();
+  DlPaint layer_paint = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(DlRect::MakeLTRB(100, 300, 600, 500), &layer_paint);
+  builder.DrawOval(DlRect::MakeLTRB(100, 300, 600, 500),
+                   DlPaint(DlColor::kGreen()).setAntiAlias(true));
+  builder.DrawRect(DlRect::MakeLTRB(200, 350, 500, 450),
+                   DlPaint(DlColor::kYellow()));
+  builder.Restore();
+  builder.DrawLine(DlPoint(0, 0), DlPoint(kWidth, kHeight),
+                   DlPaint(DlColor::kBlack()).setStrokeWidth(3));
+  return builder.Build();
+}
+
+sk_sp<SkSurface> Render(const GPUSurfaceSoftwareTiler& tiler,
+                        const sk_sp<DisplayList>& display_list) {
+  sk_sp<SkSurface> surface =
+      SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kWidth, kHeight));
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  EXPECT_TRUE(tiler.Rasterize(display_list, surface.get()));
+  return surface;
+}
+
+bool SamePixels(SkSurface* a, SkSurface* b) {
+  SkPixmap pa, pb;
+  if (!a->peekPixels(&pa) || !b->peekPixels(&pb)) {
+    return false;
+  }
+  if (pa.info() != pb.info()) {
+    return false;
+  }
+  for (int y = 0; y < pa.height(); y++) {
+    if (std::memcmp(pa.addr32(0, y), pb.addr32(0, y),
+                    pa.width() * sizeof(uint32_t)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(GPUSurfaceSoftwareTiler, ThreadCount) {
+  EXPECT_EQ(GPUSurfaceSoftwareTiler(0).GetThreadCount(), 1u);
+  EXPECT_EQ(GPUSurfaceSoftwareTiler(1).GetThreadCount(), 1u);
+  EXPECT_EQ(GPUSurfaceSoftwareTiler(4).GetThreadCount(), 4u);
+}
+
+TEST(GPUSurfaceSoftwareTiler, TilesCoverTheSurfaceExactly) {
+  auto tiles = GPUSurfaceSoftwareTiler::ComputeTiles(DlISize(kWidth, kHeight));
+  ASSERT_EQ(tiles.size(), 9u);
+  int64_t area = 0;
+  for (size_t i = 0; i < tiles.size(); i++) {
+    EXPECT_FALSE(tiles[i].IsEmpty());
+    EXPECT_LE(tiles[i].GetWidth(), GPUSurfaceSoftwareTiler::kTileSize);
+    EXPECT_LE(tiles[i].GetHeight(), GPUSurfaceSoftwareTiler::kTileSize);
+    for (size_t j = i + 1; j < tiles.size(); j++) {
+      EXPECT_FALSE(tiles[i].IntersectsWithRect(tiles[j]));
+    }
+    area += tiles[i].Area();
+  }
+  EXPECT_EQ(area, kWidth * kHeight);
+  EXPECT_EQ(tiles.back(), DlIRect::MakeLTRB(512, 512, kWidth, kHeight));
+
+  EXPECT_TRUE(GPUSurfaceSoftwareTiler::ComputeTiles(DlISize()).empty());
+}
+
+TEST(GPUSurfaceSoftwareTiler, TiledRenderingMatchesSingleThreadedRendering) {
+  GPUSurfaceSoftwareTiler single_threaded(1);
+  GPUSurfaceSoftwareTiler tiled(4);
+
+  auto expected = Render(single_threaded, MakeScene(false));
+  EXPECT_TRUE(SamePixels(Render(tiled, MakeScene(true)).get(),
+                         expected.get()));
+  // Without an rtree every tile dispatches every op, but the tile clip
+  // still produces the same pixels.
+  EXPECT_TRUE(SamePixels(Render(tiled, MakeScene(false)).get(),
+                         expected.get()));
+}
+
+TEST(GPUSurfaceSoftwareTiler, NestedBackdropFiltersPreventTiling) {
+  EXPECT_TRUE(GPUSurfaceSoftwareTiler::CanRenderInTiles(*MakeScene(true)));
+
+  // The builder only summarizes backdrop filters that apply at the root
+  // level of a DisplayList, so bury one inside a layer of a nested list.
+  auto blur = DlImageFilter::MakeBlur(5, 5, DlTileMode::kClamp);
+  DisplayListBuilder child_builder;
+  child_builder.SaveLayer(std::nullopt, nullptr);
+  child_builder.SaveLayer(std::nullopt, nullptr, blur.get());
+  child_builder.Restore();
+  child_builder.Restore();
+
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.DrawDisplayList(child_builder.Build());
+  auto display_list = builder.Build();
+  ASSERT_FALSE(display_list->root_has_backdrop_filter());
+
+  EXPECT_FALSE(GPUSurfaceSoftwareTiler::CanRenderInTiles(*display_list));
+}
+
+}  // namespace testing
+}  // namespace flutter
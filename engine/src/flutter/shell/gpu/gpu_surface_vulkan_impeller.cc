@@ -119,13 +119,19 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         return false;
       }
 
-      return impeller::RenderToTarget(
-          aiks_context->GetContentContext(),                                //
-          render_target,                                                    //
-          display_list,                                                     //
-          cull_rect,                                                        //
-          /*reset_host_buffer=*/surface_frame.submit_info().frame_boundary  //
-      );
+      const bool frame_boundary = surface_frame.submit_info().frame_boundary;
+      if (!impeller::RenderToTarget(aiks_context->GetContentContext(),    //
+                                    render_target,                        //
+                                    display_list,                         //
+                                    cull_rect,                            //
+                                    /*reset_host_buffer=*/frame_boundary  //
+                                    )) {
+        return false;
+      }
+      if (frame_boundary) {
+        aiks_context->GetContentContext().MarkFrameEnd();
+      }
+      return true;
     };
 
     return std::make_unique<SurfaceFrame>(
@@ -217,12 +223,16 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         return false;
       }
 
-      return impeller::RenderToTarget(aiks_context->GetContentContext(),  //
-                                      render_target,                      //
-                                      display_list,                       //
-                                      cull_rect,                          //
-                                      /*reset_host_buffer=*/true          //
-      );
+      if (!impeller::RenderToTarget(aiks_context->GetContentContext(),  //
+                                    render_target,                      //
+                                    display_list,                       //
+                                    cull_rect,                          //
+                                    /*reset_host_buffer=*/true          //
+                                    )) {
+        return false;
+      }
+      aiks_context->GetContentContext().MarkFrameEnd();
+      return true;
     };
 
     SurfaceFrame::SubmitCallback submit_callback =
@@ -902,6 +902,21 @@ public class FlutterLoaderTest {
         "--isolate-snapshot-data=" + expectedIsolateSnapshotData);
   }
 
+  @Test
+  public void itSetsSnapshotPageProfileFromMetadata() {
+    String expectedProfilePath = "/path/to/snapshot/page/profile";
+    // Test debug mode.
+    testFlagFromMetadataPresent(
+        "io.flutter.embedding.android.SnapshotPageProfile",
+        expectedProfilePath,
+        "--snapshot-page-profile=" + expectedProfilePath);
+    // Test release mode.
+    testFlagFromMetadataPresentInReleaseMode(
+        "io.flutter.embedding.android.SnapshotPageProfile",
+        expectedProfilePath,
+        "--snapshot-page-profile=" + expectedProfilePath);
+  }
+
   @Test
   public void itSetsUseTestFontsFromMetadata() {
     testFlagFromMetadataPresent(
@@ -1010,6 +1025,68 @@ public class FlutterLoaderTest {
         "--trace-to-file=" + expectedTraceToFilePath);
   }
 
+  @Test
+  public void itSetsRecordSnapshotPageProfileFromMetadata() {
+    testFlagFromMetadataPresent(
+        "io.flutter.embedding.android.RecordSnapshotPageProfile",
+        true,
+        "--record-snapshot-page-profile");
+    // Recording is not allowed in release mode.
+    testFlagFromMetadata(
+        "io.flutter.embedding.android.RecordSnapshotPageProfile",
+        true,
+        "--record-snapshot-page-profile",
+        false,
+        true);
+  }
+
+  @Test
+  public void itSetsSnapshotPageProfileDurationFromMetadata() {
+    int expectedDuration = 5000;
+    testFlagFromMetadataPresent(
+        "io.flutter.embedding.android.SnapshotPageProfileDuration",
+        expectedDuration,
+        "--snapshot-page-profile-duration=" + expectedDuration);
+  }
+
+  @Test
+  public void itSetsSnapshotPageProfileFromCommandLine() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    FlutterLoader flutterLoader = new FlutterLoader(mockFlutterJNI);
+
+    String[] snapshotPageProfileArgs = {
+      "--snapshot-page-profile=/path/to/snapshot/page/profile",
+      "--record-snapshot-page-profile",
+      "--snapshot-page-profile-duration=5000"
+    };
+
+    FlutterLoader.Settings settings = new FlutterLoader.Settings();
+    assertFalse(flutterLoader.initialized());
+    flutterLoader.startInitialization(ctx, settings);
+    flutterLoader.ensureInitializationComplete(ctx, snapshotPageProfileArgs);
+    shadowOf(getMainLooper()).idle();
+
+    ArgumentCaptor<String[]> shellArgsCaptor = ArgumentCaptor.forClass(String[].class);
+    verify(mockFlutterJNI, times(1))
+        .init(
+            eq(ctx),
+            shellArgsCaptor.capture(),
+            anyString(),
+            anyString(),
+            anyString(),
+            anyLong(),
+            anyInt());
+    List<String> arguments = Arrays.asList(shellArgsCaptor.getValue());
+
+    for (String arg : snapshotPageProfileArgs) {
+      assertTrue(
+          "Expected argument '"
+              + arg
+              + "' was not found in the arguments passed to FlutterJNI.init",
+          arguments.contains(arg));
+    }
+  }
+
   @Test
   public void itSetsProfileMicrotasksFromMetadata() {
     testFlagFromMetadataPresent(
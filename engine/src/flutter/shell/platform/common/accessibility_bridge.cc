@@ -19,6 +19,42 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+// Whether applying |new_data| to a node whose current data is |old_data|
+// would leave the node unchanged.
+//
+// The offset container of the relative bounds is not part of a Flutter
+// semantics update, it is filled in from the node's parent once the update
+// has been applied, so it is not compared.
+static bool IsNodeDataUnchanged(const ui::AXNodeData& old_data,
+                                const ui::AXNodeData& new_data) {
+  if (old_data.role != new_data.role || old_data.state != new_data.state ||
+      old_data.actions != new_data.actions ||
+      old_data.child_ids != new_data.child_ids) {
+    return false;
+  }
+  if (old_data.relative_bounds.bounds != new_data.relative_bounds.bounds) {
+    return false;
+  }
+  const gfx::Transform* old_transform =
+      old_data.relative_bounds.transform.get();
+  const gfx::Transform* new_transform =
+      new_data.relative_bounds.transform.get();
+  if (old_transform && new_transform) {
+    if (*old_transform != *new_transform) {
+      return false;
+    }
+  } else if (old_transform || new_transform) {
+    return false;
+  }
+  return old_data.bool_attributes == new_data.bool_attributes &&
+         old_data.int_attributes == new_data.int_attributes &&
+         old_data.float_attributes == new_data.float_attributes &&
+         old_data.string_attributes == new_data.string_attributes &&
+         old_data.intlist_attributes == new_data.intlist_attributes &&
+         old_data.stringlist_attributes == new_data.stringlist_attributes &&
+         old_data.html_attributes == new_data.html_attributes;
+}
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -83,11 +119,11 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
@@ -267,15 +303,20 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  // The children are visited through the stored node since |result| may
+  // reallocate while they are being appended.
+  size_t index = result.size();
+  result.push_back(std::move(target));
+  for (size_t i = 0; i < result[index].children_in_traversal_order.size();
+       i++) {
+    int32_t child = result[index].children_in_traversal_order[i];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -303,11 +344,17 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
       node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
       node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
       0, 0);
-  for (auto child : node.children_in_traversal_order) {
-    node_data.child_ids.push_back(child);
-  }
+  node_data.child_ids = node.children_in_traversal_order;
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+
+  // Most nodes of a semantics update are resent unchanged. Leaving them out
+  // of the tree update spares the tree from diffing and notifying observers
+  // about nodes that did not change.
+  ui::AXNode* existing_node = tree_->GetFromId(node.id);
+  if (existing_node && IsNodeDataUnchanged(existing_node->data(), node_data)) {
+    return;
+  }
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
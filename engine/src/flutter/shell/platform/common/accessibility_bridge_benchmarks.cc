@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/accessibility_bridge.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+FlutterSemanticsFlags kEmptyFlags = FlutterSemanticsFlags{};
+
+// A semantics tree shaped like a long list: a root with |node_count - 1|
+// leaf children.
+class ListSemanticsTree {
+ public:
+  explicit ListSemanticsTree(size_t node_count) {
+    labels_.reserve(node_count);
+    for (size_t i = 0; i < node_count; i++) {
+      labels_.push_back("item " + std::to_string(i));
+    }
+    for (size_t i = 1; i < node_count; i++) {
+      children_.push_back(static_cast<int32_t>(i));
+    }
+    nodes_.reserve(node_count);
+    for (size_t i = 0; i < node_count; i++) {
+      bool is_root = i == 0;
+      nodes_.push_back({
+          .id = static_cast<int32_t>(i),
+          .text_selection_base = -1,
+          .text_selection_extent = -1,
+          .label = labels_[i].c_str(),
+          .hint = "",
+          .value = "",
+          .increased_value = "",
+          .decreased_value = "",
+          .rect = {0, 50.0 * i, 400, 50.0 * (i + 1)},
+          .transform = {1, 0, 0, 0, 1, 0, 0, 0, 1},
+          .child_count = is_root ? children_.size() : 0,
+          .children_in_traversal_order = is_root ? children_.data() : nullptr,
+          .tooltip = "",
+          .flags2 = &kEmptyFlags,
+      });
+    }
+  }
+
+  // Changes the label of the node with the given id.
+  void Relabel(size_t id, const std::string& label) {
+    labels_[id] = label;
+    nodes_[id].label = labels_[id].c_str();
+  }
+
+  void AddTo(AccessibilityBridge& bridge) const {
+    for (const FlutterSemanticsNode2& node : nodes_) {
+      bridge.AddFlutterSemanticsNodeUpdate(node);
+    }
+  }
+
+ private:
+  std::vector<std::string> labels_;
+  std::vector<int32_t> children_;
+  std::vector<FlutterSemanticsNode2> nodes_;
+};
+
+}  // namespace
+
+// The cost of a semantics update that resends a whole tree in which only a
+// single node changed, as the framework does when an item of a list updates.
+static void BM_AccessibilityBridgeCommitSingleChange(benchmark::State& state) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  ListSemanticsTree tree(state.range(0));
+  tree.AddTo(*bridge);
+  bridge->CommitUpdates();
+  bool toggle = false;
+  for (auto _ : state) {
+    tree.Relabel(1, toggle ? "item 1" : "changed item 1");
+    toggle = !toggle;
+    tree.AddTo(*bridge);
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// The cost of a semantics update that resends a whole tree without any
+// change.
+static void BM_AccessibilityBridgeCommitUnchanged(benchmark::State& state) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  ListSemanticsTree tree(state.range(0));
+  tree.AddTo(*bridge);
+  bridge->CommitUpdates();
+  for (auto _ : state) {
+    tree.AddTo(*bridge);
+    bridge->CommitUpdates();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_AccessibilityBridgeCommitSingleChange)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_AccessibilityBridgeCommitUnchanged)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+}  // namespace flutter
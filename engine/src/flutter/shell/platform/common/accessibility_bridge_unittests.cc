@@ -14,6 +14,7 @@ namespace flutter {
 namespace testing {
 
 using ::testing::Contains;
+using ::testing::ElementsAre;
 
 FlutterSemanticsFlags kEmptyFlags = FlutterSemanticsFlags{};
 
@@ -563,6 +564,62 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+TEST(AccessibilityBridgeTest, UnchangedNodesAreNotUpdated) {
+  // Records the nodes that are touched by each update of a tree.
+  class ChangedNodesObserver : public ui::AXTreeObserver {
+   public:
+    void OnNodeChanged(ui::AXTree* tree, ui::AXNode* node) override {
+      changed_node_ids.push_back(node->id());
+    }
+
+    std::vector<int32_t> changed_node_ids;
+  };
+
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  ChangedNodesObserver observer;
+  bridge->GetTree()->AddObserver(&observer);
+
+  // Resend every node, but only change the label of child 2.
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_THAT(observer.changed_node_ids, ElementsAre(2));
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(2).lock()->GetName(),
+            "new child 2");
+
+  // An update that changes nothing leaves the tree untouched.
+  observer.changed_node_ids.clear();
+  bridge->accessibility_events.clear();
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_TRUE(observer.changed_node_ids.empty());
+  EXPECT_TRUE(bridge->accessibility_events.empty());
+
+  // The relative bounds of a node are still relative to its parent.
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  EXPECT_EQ(child1_node->GetData().relative_bounds.offset_container_id, 0);
+
+  bridge->GetTree()->RemoveObserver(&observer);
+}
+
 TEST(AccessibilityBridgeTest, AXTreeManagerTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
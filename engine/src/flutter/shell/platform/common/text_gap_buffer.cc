@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// The smallest gap left after the buffer grows.
+constexpr size_t kMinimumGapLength = 64;
+
+}  // namespace
+
+TextGapBuffer::TextGapBuffer() = default;
+
+TextGapBuffer::TextGapBuffer(const std::u16string& text) {
+  Assign(text);
+}
+
+TextGapBuffer::~TextGapBuffer() = default;
+
+char16_t TextGapBuffer::at(size_t position) const {
+  FML_DCHECK(position < length());
+  return position < gap_start_ ? buffer_[position]
+                               : buffer_[position + gap_length()];
+}
+
+void TextGapBuffer::Assign(const std::u16string& text) {
+  buffer_ = text;
+  gap_start_ = buffer_.length();
+  gap_end_ = buffer_.length();
+}
+
+void TextGapBuffer::Insert(size_t position, const std::u16string& text) {
+  FML_DCHECK(position <= length());
+  if (text.empty()) {
+    return;
+  }
+  MoveGap(position);
+  ReserveGap(text.length());
+  std::copy(text.begin(), text.end(), buffer_.begin() + gap_start_);
+  gap_start_ += text.length();
+}
+
+void TextGapBuffer::Erase(size_t position, size_t count) {
+  FML_DCHECK(position <= length());
+  count = std::min(count, length() - position);
+  if (count == 0) {
+    return;
+  }
+  MoveGap(position);
+  gap_end_ += count;
+}
+
+void TextGapBuffer::Replace(size_t position,
+                            size_t count,
+                            const std::u16string& text) {
+  Erase(position, count);
+  Insert(position, text);
+}
+
+std::u16string TextGapBuffer::Substring(size_t position, size_t count) const {
+  FML_DCHECK(position <= length());
+  count = std::min(count, length() - position);
+  std::u16string result;
+  result.reserve(count);
+  size_t end = position + count;
+  if (position < gap_start_) {
+    size_t before_gap_end = std::min(end, gap_start_);
+    result.append(buffer_, position, before_gap_end - position);
+    position = before_gap_end;
+  }
+  if (position < end) {
+    result.append(buffer_, position + gap_length(), end - position);
+  }
+  return result;
+}
+
+std::u16string TextGapBuffer::ToString() const {
+  return Substring(0, length());
+}
+
+void TextGapBuffer::MoveGap(size_t position) {
+  if (position < gap_start_) {
+    // Shift the text between |position| and the gap to the end of the gap.
+    std::copy_backward(buffer_.begin() + position,
+                       buffer_.begin() + gap_start_,
+                       buffer_.begin() + gap_end_);
+    gap_end_ -= gap_start_ - position;
+    gap_start_ = position;
+  } else if (position > gap_start_) {
+    // Shift the text between the gap and |position| to the start of the gap.
+    size_t count = position - gap_start_;
+    std::copy(buffer_.begin() + gap_end_, buffer_.begin() + gap_end_ + count,
+              buffer_.begin() + gap_start_);
+    gap_start_ += count;
+    gap_end_ += count;
+  }
+}
+
+void TextGapBuffer::ReserveGap(size_t count) {
+  if (gap_length() >= count) {
+    return;
+  }
+  // Grow geometrically so that a run of insertions is amortized O(1) per
+  // code unit.
+  size_t new_gap_length = std::max({count, length(), kMinimumGapLength});
+  size_t after_gap_length = buffer_.length() - gap_end_;
+  std::u16string grown;
+  grown.reserve(length() + new_gap_length);
+  grown.append(buffer_, 0, gap_start_);
+  grown.append(new_gap_length, u'\0');
+  grown.append(buffer_, gap_end_, after_gap_length);
+  buffer_ = std::move(grown);
+  gap_end_ = gap_start_ + new_gap_length;
+}
+
+}  // namespace flutter
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+
+#include <string>
+
+namespace flutter {
+
+// UTF-16 text stored with a movable gap of unused code units.
+//
+// Edits happen at the gap, so a run of edits around the same position (such
+// as typing or deleting at the cursor) only moves the text between the
+// previous and the current edit, rather than all of the text that follows
+// the edit as an insertion into a |std::u16string| would.
+//
+// All positions and lengths are in UTF-16 code units.
+class TextGapBuffer {
+ public:
+  TextGapBuffer();
+  explicit TextGapBuffer(const std::u16string& text);
+  ~TextGapBuffer();
+
+  TextGapBuffer(const TextGapBuffer&) = default;
+  TextGapBuffer& operator=(const TextGapBuffer&) = default;
+
+  // The number of code units of text.
+  size_t length() const { return buffer_.length() - gap_length(); }
+
+  bool empty() const { return length() == 0; }
+
+  // Returns the code unit at |position|, which must be less than |length|.
+  char16_t at(size_t position) const;
+
+  // Replaces all of the text.
+  void Assign(const std::u16string& text);
+
+  // Inserts |text| before the code unit at |position|.
+  void Insert(size_t position, const std::u16string& text);
+
+  // Removes up to |count| code units starting at |position|.
+  void Erase(size_t position, size_t count);
+
+  // Replaces up to |count| code units starting at |position| with |text|.
+  void Replace(size_t position, size_t count, const std::u16string& text);
+
+  // Returns up to |count| code units starting at |position|.
+  std::u16string Substring(size_t position, size_t count) const;
+
+  // Returns all of the text.
+  std::u16string ToString() const;
+
+ private:
+  size_t gap_length() const { return gap_end_ - gap_start_; }
+
+  // Moves the gap so that it starts at |position|.
+  void MoveGap(size_t position);
+
+  // Grows the buffer so that the gap holds at least |count| code units.
+  void ReserveGap(size_t count);
+
+  // The text before the gap, the gap and the text after the gap.
+  std::u16string buffer_;
+  size_t gap_start_ = 0;
+  size_t gap_end_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
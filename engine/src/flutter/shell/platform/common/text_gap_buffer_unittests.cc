@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextGapBuffer, EmptyBuffer) {
+  TextGapBuffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.length(), 0u);
+  EXPECT_EQ(buffer.ToString(), u"");
+}
+
+TEST(TextGapBuffer, Assign) {
+  TextGapBuffer buffer(u"ABCDE");
+  EXPECT_EQ(buffer.length(), 5u);
+  EXPECT_EQ(buffer.ToString(), u"ABCDE");
+  buffer.Assign(u"xyz");
+  EXPECT_EQ(buffer.ToString(), u"xyz");
+}
+
+TEST(TextGapBuffer, InsertAtStartMiddleAndEnd) {
+  TextGapBuffer buffer(u"ACE");
+  buffer.Insert(3, u"F");
+  buffer.Insert(0, u"_");
+  buffer.Insert(2, u"B");
+  buffer.Insert(4, u"D");
+  EXPECT_EQ(buffer.ToString(), u"_ABCDEF");
+  EXPECT_EQ(buffer.length(), 7u);
+}
+
+TEST(TextGapBuffer, EraseIsClampedToTheText) {
+  TextGapBuffer buffer(u"ABCDE");
+  buffer.Erase(1, 2);
+  EXPECT_EQ(buffer.ToString(), u"ADE");
+  buffer.Erase(2, 100);
+  EXPECT_EQ(buffer.ToString(), u"AD");
+  buffer.Erase(2, 1);
+  EXPECT_EQ(buffer.ToString(), u"AD");
+}
+
+TEST(TextGapBuffer, Replace) {
+  TextGapBuffer buffer(u"ABCDE");
+  buffer.Replace(1, 3, u"xy");
+  EXPECT_EQ(buffer.ToString(), u"AxyE");
+  buffer.Replace(0, 0, u"<");
+  buffer.Replace(5, 0, u">");
+  EXPECT_EQ(buffer.ToString(), u"<AxyE>");
+}
+
+TEST(TextGapBuffer, AtAndSubstringSpanTheGap) {
+  TextGapBuffer buffer(u"ABCDEF");
+  // Move the gap into the middle of the text.
+  buffer.Insert(3, u"x");
+  buffer.Erase(3, 1);
+  std::u16string expected = u"ABCDEF";
+  for (size_t i = 0; i < expected.length(); i++) {
+    EXPECT_EQ(buffer.at(i), expected[i]);
+  }
+  EXPECT_EQ(buffer.Substring(1, 4), u"BCDE");
+  EXPECT_EQ(buffer.Substring(0, 3), u"ABC");
+  EXPECT_EQ(buffer.Substring(3, 100), u"DEF");
+  EXPECT_EQ(buffer.Substring(6, 1), u"");
+}
+
+TEST(TextGapBuffer, MatchesStringAcrossManyEdits) {
+  TextGapBuffer buffer;
+  std::u16string expected;
+  // Type, move around and delete, growing the buffer several times.
+  for (size_t i = 0; i < 500; i++) {
+    size_t position = (i * 7) % (expected.length() + 1);
+    std::u16string text(i % 5 + 1, static_cast<char16_t>(u'a' + i % 26));
+    buffer.Insert(position, text);
+    expected.insert(position, text);
+    if (i % 3 == 0) {
+      size_t erase_position = (i * 13) % (expected.length() + 1);
+      buffer.Erase(erase_position, 4);
+      expected.erase(erase_position, 4);
+    }
+    ASSERT_EQ(buffer.length(), expected.length());
+  }
+  EXPECT_EQ(buffer.ToString(), expected);
+}
+
+}  // namespace flutter
@@ -31,7 +31,8 @@ TextInputModel::~TextInputModel() = default;
 bool TextInputModel::SetText(const std::string& text,
                              const TextRange& selection,
                              const TextRange& composing_range) {
-  text_ = fml::Utf8ToUtf16(text);
+  text_.Assign(fml::Utf8ToUtf16(text));
+  utf8_text_.reset();
   if (!text_range().Contains(selection) ||
       !text_range().Contains(composing_range)) {
     return false;
@@ -77,7 +78,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text,
   }
   const TextRange& rangeToDelete =
       composing_range_.collapsed() ? selection_ : composing_range_;
-  text_.replace(rangeToDelete.start(), rangeToDelete.length(), text);
+  ReplaceText(rangeToDelete.start(), rangeToDelete.length(), text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(selection.start() + composing_range_.start(),
                          selection.extent() + composing_range_.start());
@@ -110,7 +111,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  ReplaceText(start, selection_.length(), u"");
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -137,12 +138,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    ReplaceText(composing_range_.start(), composing_range_.length(), u"");
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  ReplaceText(position, 0, text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -158,7 +159,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    ReplaceText(position - count, count, u"");
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -176,7 +177,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    ReplaceText(position, count, u"");
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -214,7 +215,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  ReplaceText(start, deleted_length, u"");
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -294,15 +295,79 @@ bool TextInputModel::MoveCursorBack() {
   return false;
 }
 
-std::string TextInputModel::GetText() const {
-  return fml::Utf16ToUtf8(text_);
+const std::string& TextInputModel::GetText() const {
+  if (!utf8_text_.has_value()) {
+    utf8_text_ = fml::Utf16ToUtf8(text_.ToString());
+    utf8_anchor_position_ = 0;
+    utf8_anchor_offset_ = 0;
+  }
+  return utf8_text_.value();
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  return fml::Utf16ToUtf8(leading_text).size();
+  // Measure the UTF-8 length of the current text up to the selection extent
+  // without converting it.
+  size_t extent = std::min(selection_.extent(), text_.length());
+  bool splits_surrogate_pair = extent > 0 && extent < text_.length() &&
+                               IsLeadingSurrogate(text_.at(extent - 1)) &&
+                               IsTrailingSurrogate(text_.at(extent));
+  if (utf8_text_.has_value() && !splits_surrogate_pair) {
+    return static_cast<int>(Utf8Offset(extent));
+  }
+  return static_cast<int>(CountUtf8Bytes(0, extent));
+}
+
+void TextInputModel::ReplaceText(size_t position,
+                                 size_t count,
+                                 const std::u16string& text) {
+  count = std::min(count, text_.length() - position);
+  size_t end = position + count;
+  // The UTF-8 text can only be edited in place if the edit neither splits nor
+  // joins a surrogate pair. Otherwise it is converted again when next read.
+  bool in_place =
+      utf8_text_.has_value() &&
+      !(position > 0 && IsLeadingSurrogate(text_.at(position - 1))) &&
+      !(end < text_.length() && IsTrailingSurrogate(text_.at(end))) &&
+      (text.empty() || (!IsTrailingSurrogate(text.front()) &&
+                        !IsLeadingSurrogate(text.back())));
+  if (in_place) {
+    size_t start_offset = Utf8Offset(position);
+    size_t end_offset = start_offset + CountUtf8Bytes(position, end);
+    std::string utf8 = fml::Utf16ToUtf8(text);
+    utf8_text_->replace(start_offset, end_offset - start_offset, utf8);
+    utf8_anchor_position_ = position + text.length();
+    utf8_anchor_offset_ = start_offset + utf8.length();
+  } else {
+    utf8_text_.reset();
+  }
+  text_.Replace(position, count, text);
+}
+
+size_t TextInputModel::CountUtf8Bytes(size_t start, size_t end) const {
+  size_t count = 0;
+  for (size_t i = start; i < end; i++) {
+    char16_t code_unit = text_.at(i);
+    if (IsLeadingSurrogate(code_unit) && i + 1 < end &&
+        IsTrailingSurrogate(text_.at(i + 1))) {
+      count += 4;
+      i++;
+    } else if (code_unit < 0x80) {
+      count += 1;
+    } else if (code_unit < 0x800) {
+      count += 2;
+    } else {
+      count += 3;
+    }
+  }
+  return count;
+}
+
+size_t TextInputModel::Utf8Offset(size_t position) const {
+  if (position >= utf8_anchor_position_) {
+    return utf8_anchor_offset_ +
+           CountUtf8Bytes(utf8_anchor_position_, position);
+  }
+  return utf8_anchor_offset_ - CountUtf8Bytes(position, utf8_anchor_position_);
 }
 
 }  // namespace flutter
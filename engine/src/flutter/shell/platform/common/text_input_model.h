@@ -6,8 +6,10 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_INPUT_MODEL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "flutter/shell/platform/common/text_gap_buffer.h"
 #include "flutter/shell/platform/common/text_range.h"
 
 namespace flutter {
@@ -188,7 +190,11 @@ class TextInputModel {
   bool SelectToEnd();
 
   // Gets the current text as UTF-8.
-  std::string GetText() const;
+  //
+  // The text is converted once and then kept up to date by edits, so calls
+  // after an edit near the cursor don't convert the whole text again. The
+  // returned reference is only valid until the next change to the text.
+  const std::string& GetText() const;
 
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
@@ -223,7 +229,30 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
-  std::u16string text_;
+  // Replaces |count| code units of the text at |position| with |text|, and
+  // applies the same edit to the cached UTF-8 text.
+  void ReplaceText(size_t position, size_t count, const std::u16string& text);
+
+  // Returns the number of UTF-8 bytes needed for the code units of the text
+  // in [start, end). Surrogate pairs are only counted as such if both of
+  // their code units are in the range.
+  size_t CountUtf8Bytes(size_t start, size_t end) const;
+
+  // Returns the offset in |utf8_text_| of the UTF-16 |position|, which must
+  // not be in the middle of a surrogate pair.
+  size_t Utf8Offset(size_t position) const;
+
+  // The text, stored in a gap buffer so that edits near the cursor do not
+  // move the rest of a long text.
+  TextGapBuffer text_;
+  // The UTF-8 conversion of |text_|, if it has been requested since the
+  // text was last set in a way that couldn't be applied to it in place.
+  mutable std::optional<std::string> utf8_text_;
+  // A position in |text_| that is not in the middle of a surrogate pair and
+  // its offset in |utf8_text_|. Edits cluster around the cursor, so offsets
+  // are measured from the last edit rather than from the start of the text.
+  mutable size_t utf8_anchor_position_ = 0;
+  mutable size_t utf8_anchor_offset_ = 0;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
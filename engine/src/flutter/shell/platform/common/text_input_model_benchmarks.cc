@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_input_model.h"
+
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+
+namespace {
+
+// Creates a model with |length| code units of text and the cursor in the
+// middle of the text.
+void InitializeModel(TextInputModel& model, size_t length) {
+  model.SetText(std::string(length, 'a'), TextRange(length / 2));
+}
+
+}  // namespace
+
+// The cost of a keystroke, followed by its undo so that the length of the
+// text stays constant.
+static void BM_TextInputModelTypeInMiddle(benchmark::State& state) {
+  TextInputModel model;
+  InitializeModel(model, state.range(0));
+  for (auto _ : state) {
+    model.AddText(u"b");
+    model.Backspace();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// The cost of a run of keystrokes at the same position.
+static void BM_TextInputModelTypeWord(benchmark::State& state) {
+  TextInputModel model;
+  InitializeModel(model, state.range(0));
+  const std::u16string word = u"flutter ";
+  for (auto _ : state) {
+    for (char16_t c : word) {
+      model.AddText(std::u16string(1, c));
+    }
+    for (size_t i = 0; i < word.length(); i++) {
+      model.Backspace();
+    }
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// The cost of an IME composing update, replacing the composing text.
+static void BM_TextInputModelUpdateComposingText(benchmark::State& state) {
+  TextInputModel model;
+  InitializeModel(model, state.range(0));
+  model.BeginComposing();
+  bool longer = false;
+  for (auto _ : state) {
+    model.UpdateComposingText(longer ? u"nihao" : u"ni");
+    longer = !longer;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// The cost of a keystroke including the state that the embedders send to
+// the framework after each edit.
+static void BM_TextInputModelTypeAndGetState(benchmark::State& state) {
+  TextInputModel model;
+  InitializeModel(model, state.range(0));
+  for (auto _ : state) {
+    model.AddText(u"b");
+    benchmark::DoNotOptimize(model.GetText());
+    benchmark::DoNotOptimize(model.GetCursorOffset());
+    model.Backspace();
+    benchmark::DoNotOptimize(model.GetText());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_TextInputModelTypeInMiddle)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity();
+BENCHMARK(BM_TextInputModelTypeWord)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity();
+BENCHMARK(BM_TextInputModelUpdateComposingText)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity();
+BENCHMARK(BM_TextInputModelTypeAndGetState)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity();
+
+}  // namespace flutter
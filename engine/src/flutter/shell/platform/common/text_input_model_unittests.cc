@@ -1729,4 +1729,61 @@ TEST(TextInputModel, GetCursorOffsetReverseSelection) {
   EXPECT_EQ(model->GetCursorOffset(), 1);
 }
 
+TEST(TextInputModel, GetTextFollowsEdits) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("héllo", TextRange(2));
+  EXPECT_EQ(model->GetText(), "héllo");
+
+  model->AddText(u"€");
+  EXPECT_EQ(model->GetText(), "hé€llo");
+  EXPECT_EQ(model->GetCursorOffset(), 6);
+
+  model->AddText(u"😀");
+  EXPECT_EQ(model->GetText(), "hé€😀llo");
+  EXPECT_EQ(model->GetCursorOffset(), 10);
+
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), "héllo");
+  EXPECT_EQ(model->GetCursorOffset(), 3);
+
+  EXPECT_TRUE(model->SetSelection(TextRange(0)));
+  EXPECT_TRUE(model->Delete());
+  EXPECT_EQ(model->GetText(), "éllo");
+  EXPECT_EQ(model->GetCursorOffset(), 0);
+
+  model->MoveCursorToEnd();
+  model->BeginComposing();
+  model->UpdateComposingText(u"你");
+  model->UpdateComposingText(u"你好");
+  EXPECT_EQ(model->GetText(), "éllo你好");
+  model->CommitComposing();
+  model->EndComposing();
+  EXPECT_EQ(model->GetText(), "éllo你好");
+  EXPECT_EQ(model->GetCursorOffset(), 11);
+}
+
+TEST(TextInputModel, GetTextFollowsEditsNextToSurrogatePairs) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("a😀b", TextRange(1));
+  EXPECT_EQ(model->GetText(), "a😀b");
+
+  // Insert a surrogate pair one code unit at a time.
+  std::u16string pair = u"😁";
+  model->AddText(pair.substr(0, 1));
+  model->AddText(pair.substr(1));
+  EXPECT_EQ(model->GetText(), "a😁😀b");
+  EXPECT_EQ(model->GetCursorOffset(), 5);
+
+  EXPECT_TRUE(model->SetSelection(TextRange(5)));
+  EXPECT_TRUE(model->Delete());
+  EXPECT_EQ(model->GetText(), "a😁😀");
+  EXPECT_EQ(model->GetCursorOffset(), 9);
+
+  EXPECT_TRUE(model->SetSelection(TextRange(3)));
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), "a😀");
+  EXPECT_EQ(model->GetCursorOffset(), 1);
+}
+
 }  // namespace flutter
@@ -47,6 +47,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -788,9 +789,13 @@ InferSoftwarePlatformViewCreationCallback(
     return ptr(user_data, allocation, row_bytes, height);
   };
 
+  const size_t raster_thread_count =
+      SAFE_ACCESS(&config->software, raster_thread_count, 0);
+
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
           software_present_backing_store,  // required
+          raster_thread_count,             // optional
       };
 
   return fml::MakeCopyable(
@@ -3596,6 +3601,34 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    "Could not dispatch the low memory notification message.");
 }
 
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineMemoryUsage* usage) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (usage == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid memory usage.");
+  }
+
+  const fml::MemoryUsage memory_usage = fml::GetMemoryUsage();
+#define SET_BYTES(member, category)                                       \
+  if (STRUCT_HAS_MEMBER(usage, member)) {                                 \
+    usage->member = memory_usage.GetBytes(fml::MemoryCategory::category); \
+  }
+  SET_BYTES(raster_cache_bytes, kRasterCache);
+  SET_BYTES(render_target_cache_bytes, kRenderTargetCache);
+  SET_BYTES(glyph_atlas_bytes, kGlyphAtlas);
+  SET_BYTES(host_buffer_bytes, kHostBuffer);
+  SET_BYTES(decoded_images_bytes, kDecodedImages);
+  SET_BYTES(device_allocator_bytes, kDeviceAllocator);
+#undef SET_BYTES
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -3774,6 +3807,7 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
   SET_PROC(SendViewFocusEvent, FlutterEngineSendViewFocusEvent);
+  SET_PROC(GetMemoryUsage, FlutterEngineGetMemoryUsage);
 #undef SET_PROC
 
   return kSuccess;
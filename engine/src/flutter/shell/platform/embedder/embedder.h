@@ -1032,6 +1032,12 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The number of threads the engine may use to rasterize each frame. When
+  /// this is greater than one, every frame is split into tiles that are
+  /// rasterized in parallel on the raster thread and `raster_thread_count - 1`
+  /// worker threads owned by the engine. Zero or one rasterize each frame on
+  /// the raster thread alone.
+  size_t raster_thread_count;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -3512,6 +3518,49 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+/// The bytes of memory held by the caches and allocators of the engine, by
+/// category. Categories may overlap and are not meant to be summed.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineMemoryUsage).
+  size_t struct_size;
+  /// Layers and pictures rasterized by the raster cache.
+  uint64_t raster_cache_bytes;
+  /// Offscreen render targets kept alive across frames by Impeller.
+  uint64_t render_target_cache_bytes;
+  /// Textures of the glyph atlases used to render text.
+  uint64_t glyph_atlas_bytes;
+  /// Device buffers that per-frame vertex and uniform data is written to.
+  uint64_t host_buffer_bytes;
+  /// Textures of the images decoded for the framework.
+  uint64_t decoded_images_bytes;
+  /// All device memory allocated by the GPU allocator of the engine,
+  /// including the memory of the GPU categories above. This is only tracked
+  /// by the Vulkan backend, and by the Metal backend in debug builds.
+  uint64_t device_allocator_bytes;
+} FlutterEngineMemoryUsage;
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the memory currently held by the caches and allocators of
+///             the engine. The usage is tracked as it changes, so this call is
+///             cheap and may be made from any thread, for example once per
+///             frame.
+///
+///             The usage is tracked for the whole process rather than per
+///             engine. When several engines run in the same process, every
+///             one of them reports the memory held by all of them.
+///
+/// @param[in]  engine  A running engine instance. It is only used to
+///                     validate the call and does not scope the usage.
+/// @param[out] usage   The usage to fill in. Its struct_size must be set.
+///                     Fields beyond struct_size are left untouched.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetMemoryUsage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryUsage* usage);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -3733,6 +3782,9 @@ typedef FlutterEngineResult (*FlutterEngineRemoveViewFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendViewFocusEventFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterViewFocusEvent* event);
+typedef FlutterEngineResult (*FlutterEngineGetMemoryUsageFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryUsage* usage);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3783,6 +3835,7 @@ typedef struct {
   FlutterEngineRemoveViewFnPtr RemoveView;
   FlutterEngineSendViewFocusEventFnPtr SendViewFocusEvent;
   FlutterEngineSendSemanticsActionFnPtr SendSemanticsAction;
+  FlutterEngineGetMemoryUsageFnPtr GetMemoryUsage;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -20,6 +20,7 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
         software_present_backing_store;  // required
+    size_t raster_thread_count = 0;      // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -15,6 +15,7 @@
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/memory_usage.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
@@ -2671,6 +2672,36 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanGetMemoryUsage) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::MemoryUsageCounter counter(fml::MemoryCategory::kRasterCache);
+  counter.Set(1024u);
+
+  FlutterEngineMemoryUsage usage = {};
+  usage.struct_size = sizeof(FlutterEngineMemoryUsage);
+  ASSERT_EQ(FlutterEngineGetMemoryUsage(engine.get(), &usage), kSuccess);
+  EXPECT_GE(usage.raster_cache_bytes, 1024u);
+
+  // Fields beyond the size of the struct are not written to.
+  FlutterEngineMemoryUsage truncated = {};
+  truncated.struct_size = offsetof(FlutterEngineMemoryUsage, glyph_atlas_bytes);
+  truncated.glyph_atlas_bytes = 42u;
+  ASSERT_EQ(FlutterEngineGetMemoryUsage(engine.get(), &truncated), kSuccess);
+  EXPECT_GE(truncated.raster_cache_bytes, 1024u);
+  EXPECT_EQ(truncated.glyph_atlas_bytes, 42u);
+
+  ASSERT_EQ(FlutterEngineGetMemoryUsage(engine.get(), nullptr),
+            kInvalidArguments);
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
@@ -19,3 +19,5 @@ ${ENGINE_PATH}/src/out/${VARIANT}/display_list_builder_benchmarks --benchmark_fo
 ${ENGINE_PATH}/src/out/${VARIANT}/display_list_region_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_region_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/display_list_transform_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_transform_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/geometry_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/geometry_benchmarks.json
+VK_ICD_FILENAMES=${ENGINE_PATH}/src/out/${VARIANT}/vk_swiftshader_icd.json IMPELLER_VULKAN_LIBRARY=${ENGINE_PATH}/src/out/${VARIANT}/libvulkan.so.1 ${ENGINE_PATH}/src/out/${VARIANT}/dl_complexity_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/dl_complexity_benchmarks.json
+VK_ICD_FILENAMES=${ENGINE_PATH}/src/out/${VARIANT}/vk_swiftshader_icd.json IMPELLER_VULKAN_LIBRARY=${ENGINE_PATH}/src/out/${VARIANT}/libvulkan.so.1 ${ENGINE_PATH}/src/out/${VARIANT}/entity_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/entity_benchmarks.json
@@ -14,6 +14,7 @@ import argparse
 import errno
 import glob
 import io
+import json
 import logging
 import logging.handlers
 import multiprocessing
@@ -468,6 +469,7 @@ def run_cc_tests(
       make_test('embedder_unittests'),
       make_test('fml_unittests'),
       make_test('geometry_unittests'),
+      make_test('gpu_surface_software_unittests'),
       make_test('no_dart_plugin_registrant_unittests'),
       make_test('runtime_unittests'),
       make_test('testing_unittests'),
@@ -642,9 +644,18 @@ def run_engine_benchmarks(
 
   run_engine_executable(build_dir, 'geometry_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'interop_benchmarks', executable_filter, icu_flags)
+
+  run_engine_executable(build_dir, 'common_cpp_benchmarks', executable_filter, icu_flags)
+
   if is_linux():
     run_engine_executable(build_dir, 'txt_benchmarks', executable_filter, icu_flags)
 
+    # These render with Vulkan through SwiftShader, see run_engine_executable.
+    run_engine_executable(build_dir, 'dl_complexity_benchmarks', executable_filter, icu_flags)
+
+    run_engine_executable(build_dir, 'entity_benchmarks', executable_filter, icu_flags)
+
 
 class FlutterTesterOptions():
 
@@ -1180,6 +1191,37 @@ def contains_png_recursive(directory: str) -> bool:
   return False
 
 
+def run_impeller_pipeline_cache_warmer(
+    build_dir: str, executable_filter: typing.Optional[typing.List[str]]
+) -> None:
+  """
+  Primes a Vulkan pipeline cache against SwiftShader and checks that the cache
+  and its manifest were written.
+  """
+  executable_name = 'impeller_pipeline_cache_warmer'
+  if executable_filter is not None and executable_name not in executable_filter:
+    _logger.info('Skipping %s due to filter.', executable_name)
+    return
+
+  with tempfile.TemporaryDirectory(prefix='impeller_pipeline_cache') as temp_dir:
+    run_engine_executable(
+        build_dir,
+        executable_name,
+        executable_filter,
+        [f'--output={temp_dir}', '--enable-validation'],
+        extra_env=vulkan_validation_env(build_dir),
+    )
+
+    cache_path = os.path.join(temp_dir, 'flutter.impeller.vkcache')
+    manifest_path = os.path.join(temp_dir, 'flutter.impeller.vkcache.json')
+    if not os.path.exists(cache_path) or not os.path.exists(manifest_path):
+      raise RuntimeError(f'{executable_name} did not write a pipeline cache.')
+    with open(manifest_path, encoding='utf-8') as manifest_file:
+      manifest = json.load(manifest_file)
+    if manifest['pipeline_count'] == 0 or manifest['data_size'] == 0:
+      raise RuntimeError(f'{executable_name} wrote an empty pipeline cache.')
+
+
 def run_impeller_golden_tests(build_dir: str, require_skia_gold: bool = False):
   """
   Executes the impeller golden image tests from in the `variant` build.
@@ -1424,6 +1466,8 @@ Flutter Wiki page on the subject: https://github.com/flutter/flutter/wiki/Testin
           gtest=True,
           extra_env=extra_env,
       )
+      if is_linux():
+        run_impeller_pipeline_cache_warmer(build_dir, engine_filter)
     finally:
       xvfb.stop_virtual_x(build_name)
 